@@ -5,6 +5,7 @@
 
 #include "Macro.h"
 #include "Patch.h"
+#include "PatchTable.h"
 
 #ifdef PARTICLE
 #  include "Particle.h"
@@ -31,6 +32,7 @@ void Aux_Error( const char *File, const int Line, const char *Func, const char *
 // Description :  Data structure of the AMR implementation
 //
 // Data Member :  patch        : Pointers of all patches
+//                               --> Growable table indexed as patch[Sg][lv][PID] (see PatchTable.h)
 //                num          : Number of patches (real patch + buffer patch) at each level
 //                scale        : Grid scale at each level (grid size normalized to that at the finest level)
 //                FluSg        : Sandglass of the current fluid          data [0/1]
@@ -65,18 +67,19 @@ void Aux_Error( const char *File, const int Line, const char *Func, const char *
 //                               --> Mainly used for estimating the weighted load-imbalance factor to determine
 //                                   when to redistribute all patches (when LOAD_BALANCE is on)
 //
-// Method      :  AMR_t    : Constructor
-//               ~AMR_t    : Destructor
-//                pnew     : Allocate one patch
-//                pdelete  : Deallocate one patch
-//                Lvdelete : Deallocate all patches in the given level
+// Method      :  AMR_t         : Constructor
+//               ~AMR_t         : Destructor
+//                pnew          : Allocate one patch
+//                pdelete       : Deallocate one patch
+//                Lvdelete      : Deallocate all patches in the given level
+//                CountInactive : Count the number of inactive patches in the given level
 //-------------------------------------------------------------------------------------------------------
 struct AMR_t
 {
 
 // data members
 // ===================================================================================
-   patch_t    *patch[2][NLEVEL][MAX_PATCH];
+   PatchTable_t patch[2][NLEVEL];
 
 #  ifdef PARTICLE
    Particle_t *Par;
@@ -154,11 +157,6 @@ struct AMR_t
 #        endif
       }
 
-      for (int Sg=0; Sg<2; Sg++)
-      for (int lv=0; lv<NLEVEL; lv++)
-      for (int PID=0; PID<MAX_PATCH; PID++)
-         patch[Sg][lv][PID] = NULL;
-
       for (int lv=0; lv<NLEVEL; lv++)
       for (int m=0; m<28; m++)
          NPatchComma[lv][m] = 0;
@@ -231,6 +229,8 @@ struct AMR_t
    // Note        :  1. Each patch contains two patch pointers --> SANDGLASS (Sg) = 0 / 1
    //                2. Sg = 0 : Store both data and relation (father,son.sibling,corner,flag,flux)
    //                   Sg = 1 : Store only data
+   //                3. The patch tables grow automatically and thus there is no upper limit on the
+   //                   number of patches (except for the range of int)
    //
    // Parameter   :  lv          : Target refinement level
    //                scale_x/y/z : Grid scale indices (not physical coordinates) of the patch corner
@@ -245,8 +245,12 @@ struct AMR_t
 
       const int NewPID = num[lv];
 
-      if ( NewPID > MAX_PATCH-1 )
-         Aux_Error( ERROR_INFO, "exceed MAX_PATCH (%d) => please reset it in the Makefile !!\n", MAX_PATCH );
+//    grow the patch tables if necessary
+      if ( NewPID >= patch[0][lv].Capacity() )
+      {
+         patch[0][lv].Grow( NewPID+1 );
+         patch[1][lv].Grow( NewPID+1 );
+      }
 
 //    allocate new patches if there are no inactive patches
       if ( patch[0][lv][NewPID] == NULL )
@@ -409,6 +413,37 @@ struct AMR_t
    } // METHOD : Lvdelete
 
 
+
+   //===================================================================================
+   // Method      :  CountInactive
+   // Description :  Count the number of inactive patches (i.e., the memory pool for OPT__REUSE_MEMORY) in the
+   //                target level
+   //
+   // Note        :  1. Inactive patches are assumed to be stored contiguously right after the active patches
+   //                   --> Count from PID = num[lv] until reaching a non-allocated patch
+   //
+   // Parameter   :  lv : Target refinement level
+   //===================================================================================
+   int CountInactive( const int lv ) const
+   {
+
+      int PID = num[lv];
+
+      while ( PID < patch[0][lv].Capacity()  &&  patch[0][lv][PID] != NULL )
+      {
+#        ifdef GAMER_DEBUG
+         if ( patch[0][lv][PID]->Active )
+            Aux_Error( ERROR_INFO, "active patch beyond num[%d] (PID %d) !!\n", lv, PID );
+#        endif
+
+         PID ++;
+      }
+
+      return PID - num[lv];
+
+   } // METHOD : CountInactive
+
+
 }; // struct AMR_t
 
 
@@ -486,5 +486,9 @@
 #endif
 
 
+// compile-time specialization of the built-in EoS for the CPU solvers
+#include "EoS_Inline.h"
+
+
 
 #endif // #ifndef __CUFLU_H__
@@ -0,0 +1,153 @@
+#ifndef __EOS_INLINE_H__
+#define __EOS_INLINE_H__
+
+
+
+// ***************************************************************************
+// ** This header will be included by all CPU/GPU fluid solvers via CUFLU.h **
+// ***************************************************************************
+
+
+// compile-time specialization of the built-in EoS for the CPU fluid solvers
+// --> for EOS_GAMMA and EOS_ISOTHERMAL, the EoS routines invoked per cell by the CPU fluid solvers are replaced
+//     by the inline functions below so that compilers can inline and vectorize them
+// --> other EoS (e.g., EOS_USER and tabulated EoS) and the GPU solvers still invoke the EoS routines through
+//     the function pointers
+// --> must be consistent with EoS/Gamma/CPU_EoS_Gamma.cpp and EoS/Isothermal/CPU_EoS_Isothermal.cpp
+#if (  MODEL == HYDRO  &&  !defined __CUDACC__  &&  ( EOS == EOS_GAMMA || EOS == EOS_ISOTHERMAL )  )
+#  define EOS_INLINE
+#endif
+
+
+// EOS_FUNC( FuncPtr ) returns the EoS routine to be invoked
+// --> FuncPtr must be one of the following names of function-pointer parameters:
+//        EoS_DensEint2Pres, EoS_DensPres2Eint, EoS_DensPres2CSqr
+// --> Example: Pres = EOS_FUNC( EoS_DensEint2Pres )( Dens, Eint, Passive, EoS_AuxArray_Flt, EoS_AuxArray_Int, EoS_Table );
+#ifdef EOS_INLINE
+#  define EOS_FUNC( FuncPtr )    FuncPtr##_Inline
+#else
+#  define EOS_FUNC( FuncPtr )    FuncPtr
+#endif
+
+
+
+#ifdef EOS_INLINE
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  EoS_DensEint2Pres_Inline
+// Description :  Convert gas mass density and internal energy density to gas pressure
+//
+// Note        :  1. Inline version of EoS_DensEint2Pres_Gamma/Isothermal()
+//
+// Parameter   :  See EoS_DensEint2Pres_Gamma/Isothermal()
+//
+// Return      :  Gas pressure
+//-------------------------------------------------------------------------------------------------------
+static inline real EoS_DensEint2Pres_Inline( const real Dens, const real Eint, const real Passive[],
+                                             const double AuxArray_Flt[], const int AuxArray_Int[],
+                                             const real *const Table[EOS_NTABLE_MAX] )
+{
+
+#  ifdef GAMER_DEBUG
+   if ( AuxArray_Flt == NULL )   printf( "ERROR : AuxArray_Flt == NULL in %s !!\n", __FUNCTION__ );
+
+   Hydro_CheckUnphysical( UNPHY_MODE_SING, &Dens, "input density",         ERROR_INFO, UNPHY_VERBOSE );
+#  if ( EOS == EOS_GAMMA )
+   Hydro_CheckUnphysical( UNPHY_MODE_SING, &Eint, "input internal energy", ERROR_INFO, UNPHY_VERBOSE );
+#  endif
+#  endif // GAMER_DEBUG
+
+#  if   ( EOS == EOS_GAMMA )
+   const real Gamma_m1 = (real)AuxArray_Flt[1];
+
+   return Eint * Gamma_m1;
+
+#  elif ( EOS == EOS_ISOTHERMAL )
+   const real Cs2 = AuxArray_Flt[0];
+
+   return Cs2*Dens;
+#  endif
+
+} // FUNCTION : EoS_DensEint2Pres_Inline
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  EoS_DensPres2Eint_Inline
+// Description :  Convert gas mass density and pressure to gas internal energy density
+//
+// Note        :  1. Inline version of EoS_DensPres2Eint_Gamma/Isothermal()
+//
+// Parameter   :  See EoS_DensPres2Eint_Gamma/Isothermal()
+//
+// Return      :  Gas internal energy density
+//-------------------------------------------------------------------------------------------------------
+static inline real EoS_DensPres2Eint_Inline( const real Dens, const real Pres, const real Passive[],
+                                             const double AuxArray_Flt[], const int AuxArray_Int[],
+                                             const real *const Table[EOS_NTABLE_MAX] )
+{
+
+#  ifdef GAMER_DEBUG
+#  if ( EOS == EOS_GAMMA )
+   if ( AuxArray_Flt == NULL )   printf( "ERROR : AuxArray_Flt == NULL in %s !!\n", __FUNCTION__ );
+
+   Hydro_CheckUnphysical( UNPHY_MODE_SING, &Dens, "input density",  ERROR_INFO, UNPHY_VERBOSE );
+#  endif
+   Hydro_CheckUnphysical( UNPHY_MODE_SING, &Pres, "input pressure", ERROR_INFO, UNPHY_VERBOSE );
+#  endif // GAMER_DEBUG
+
+#  if   ( EOS == EOS_GAMMA )
+   const real _Gamma_m1 = (real)AuxArray_Flt[2];
+
+   return Pres * _Gamma_m1;
+
+#  elif ( EOS == EOS_ISOTHERMAL )
+   return (real)1.0e4*Pres;
+#  endif
+
+} // FUNCTION : EoS_DensPres2Eint_Inline
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  EoS_DensPres2CSqr_Inline
+// Description :  Convert gas mass density and pressure to sound speed squared
+//
+// Note        :  1. Inline version of EoS_DensPres2CSqr_Gamma/Isothermal()
+//
+// Parameter   :  See EoS_DensPres2CSqr_Gamma/Isothermal()
+//
+// Return      :  Sound speed squared
+//-------------------------------------------------------------------------------------------------------
+static inline real EoS_DensPres2CSqr_Inline( const real Dens, const real Pres, const real Passive[],
+                                             const double AuxArray_Flt[], const int AuxArray_Int[],
+                                             const real *const Table[EOS_NTABLE_MAX] )
+{
+
+#  ifdef GAMER_DEBUG
+   if ( AuxArray_Flt == NULL )   printf( "ERROR : AuxArray_Flt == NULL in %s !!\n", __FUNCTION__ );
+
+#  if ( EOS == EOS_GAMMA )
+   Hydro_CheckUnphysical( UNPHY_MODE_SING, &Dens, "input density",  ERROR_INFO, UNPHY_VERBOSE );
+   Hydro_CheckUnphysical( UNPHY_MODE_SING, &Pres, "input pressure", ERROR_INFO, UNPHY_VERBOSE );
+#  endif
+#  endif // GAMER_DEBUG
+
+#  if   ( EOS == EOS_GAMMA )
+   const real Gamma = (real)AuxArray_Flt[0];
+
+   return Gamma * Pres / Dens;
+
+#  elif ( EOS == EOS_ISOTHERMAL )
+   const real Cs2 = AuxArray_Flt[0];
+
+   return Cs2;
+#  endif
+
+} // FUNCTION : EoS_DensPres2CSqr_Inline
+
+#endif // #ifdef EOS_INLINE
+
+
+
+#endif // #ifndef __EOS_INLINE_H__
@@ -0,0 +1,93 @@
+#ifndef __FFT_PENCIL_H__
+#define __FFT_PENCIL_H__
+
+
+
+#if ( defined GRAVITY  &&  !defined SERIAL )
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Structure   :  FFT_Pencil_t
+// Description :  Data structure for the 2D pencil domain decomposition of the base-level 3D FFT
+//
+// Note        :  1. Used by the base-level Poisson solver and Output_BasePowerSpectrum() for OPT__FFT_PENCIL
+//                   --> Set by FFT_Pencil_Init() and freed by FFT_Pencil_End()
+//                2. MPI ranks are arranged into a 2D process grid of "NRank[0]*NRank[1]" with
+//                   "MPI_Rank = Coord[1]*NRank[0] + Coord[0]"
+//                3. Three data layouts are involved (the last index varies fastest)
+//                   (1) x pencil (real space) : [z][y][x], complete x and y/z in R_Start[0/1]
+//                       --> x is padded to 2*(N[0]/2+1) real numbers to store the complex data after the x-FFT
+//                       --> Identical to the slab layout of "rfftwnd_mpi" when NRank[0] == 1
+//                   (2) y pencil              : [z][x][y], complete y, x in K_Start[0], and z in R_Start[1]
+//                   (3) z pencil (k space)    : [x][y][z], complete z and x/y in K_Start[0/1]
+//                   --> Forward FFT : x pencil -> y pencil -> z pencil
+//                       Backward FFT: z pencil -> y pencil -> x pencil
+//                4. y ranges in the real space are aligned with PATCH_SIZE so that each patch slice
+//                   (PATCH_SIZE^2 cells at a given z) belongs to a single rank
+//                5. Some ranks may have no data if the number of ranks is large
+//
+// Data Member :  N           : FFT size
+//                Nx_Padded   : Number of complex numbers along x after the r2c FFT (N[0]/2+1)
+//                NRank       : Number of ranks along the two decomposed directions
+//                Coord       : Coordinates of this rank in the 2D process grid
+//                R_Start     : Starting y/z coordinates of each rank in the x pencils
+//                              --> R_Start[0]: [NRank[0]+1], R_Start[1]: [NRank[1]+1]
+//                K_Start     : Starting x/y coordinates of each rank in the z pencils
+//                              --> K_Start[0]: [NRank[0]+1], K_Start[1]: [NRank[1]+1]
+//                Comm        : Communicators along the two decomposed directions
+//                              --> Comm[0]: ranks with the same Coord[1] (x pencil <-> y pencil)
+//                                  Comm[1]: ranks with the same Coord[0] (y pencil <-> z pencil)
+//                LocalSize   : Number of real numbers to be allocated for the data array in this rank
+//                Plan_X/Y/Z  : FFTW plans along x/y/z
+//-------------------------------------------------------------------------------------------------------
+struct FFT_Pencil_t
+{
+
+// data members
+// ===================================================================================
+   int        N[3];
+   int        Nx_Padded;
+   int        NRank[2];
+   int        Coord[2];
+   int       *R_Start[2];
+   int       *K_Start[2];
+   MPI_Comm   Comm[2];
+   long       LocalSize;
+
+   rfftw_plan Plan_X_Fw, Plan_X_Bw;
+   fftw_plan  Plan_Y_Fw, Plan_Y_Bw;
+   fftw_plan  Plan_Z_Fw, Plan_Z_Bw;
+
+
+   //===================================================================================
+   // Constructor :  FFT_Pencil_t
+   // Description :  Constructor of the structure "FFT_Pencil_t"
+   //
+   // Note        :  Initialize the data members
+   //
+   // Parameter   :  None
+   //===================================================================================
+   FFT_Pencil_t()
+   {
+
+      for (int d=0; d<2; d++)
+      {
+         R_Start[d] = NULL;
+         K_Start[d] = NULL;
+      }
+
+      LocalSize = 0;
+
+   } // METHOD : FFT_Pencil_t
+
+}; // struct FFT_Pencil_t
+
+
+
+#endif // #if ( defined GRAVITY  &&  !defined SERIAL )
+
+
+
+#endif // #ifndef __FFT_PENCIL_H__
@@ -63,8 +63,10 @@ extern "C" {
 #include "Timer.h"
 #include "RandomNumber.h"
 #include "Profile.h"
+#include "PrepCache.h"
 #include "SrcTerms.h"
 #include "EoS.h"
+#include "FFT_Pencil.h"
 #include "Global.h"
 #include "Field.h"
 #include "Prototype.h"
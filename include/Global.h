@@ -24,6 +24,8 @@ extern double     Time_Prev[NLEVEL];                  // "previous" physical tim
 extern double     dTime_AllLv[NLEVEL];                // current evolution physical time interval at each level
 extern long       AdvanceCounter[NLEVEL];             // number of sub-steps that each level has been evolved
 extern long       NCorrUnphy[NLEVEL];                 // number of cells corrected by either OPT__1ST_FLUX_CORR or MIN_DENS/PRES
+extern long       PrepCache_NHit [NLEVEL];            // number of patch groups found in the cache of OPT__PREP_CACHE
+extern long       PrepCache_NMiss[NLEVEL];            // number of patch groups not found in the cache of OPT__PREP_CACHE
 extern long       Step;                               // number of main steps
 extern double     dTime_Base;                         // physical time interval at the base level
 
@@ -51,26 +53,28 @@ extern int        PassiveIntFrac_NVar, PassiveIntFrac_VarIdx[NCOMP_PASSIVE];
 
 extern double     BOX_SIZE, DT__MAX, DT__FLUID, DT__FLUID_INIT, END_T, OUTPUT_DT, DT__SYNC_PARENT_LV, DT__SYNC_CHILDREN_LV;
 extern long int   END_STEP;
-extern int        NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, SRC_GPU_NPGROUP, OMP_NTHREAD;
+extern int        NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, SRC_GPU_NPGROUP, OMP_NTHREAD, CPU_PIPELINE_NTHREAD;
 extern int        MPI_NRank, MPI_NRank_X[3];
 extern int        GPU_NSTREAM, FLAG_BUFFER_SIZE, FLAG_BUFFER_SIZE_MAXM1_LV, FLAG_BUFFER_SIZE_MAXM2_LV, MAX_LEVEL;
 
 extern int        OPT__UM_IC_LEVEL, OPT__UM_IC_NLEVEL, OPT__UM_IC_NVAR, OPT__UM_IC_LOAD_NRANK, OPT__GPUID_SELECT, OPT__PATCH_COUNT;
 extern int        INIT_DUMPID, INIT_SUBSAMPLING_NCELL, OPT__TIMING_BARRIER, OPT__REUSE_MEMORY, RESTART_LOAD_NRANK;
-extern double     OUTPUT_PART_X, OUTPUT_PART_Y, OUTPUT_PART_Z, AUTO_REDUCE_DT_FACTOR, AUTO_REDUCE_DT_FACTOR_MIN;
+extern double     OUTPUT_PART_X, OUTPUT_PART_Y, OUTPUT_PART_Z, AUTO_REDUCE_DT_FACTOR, AUTO_REDUCE_DT_FACTOR_MIN, OUTPUT_ASYNC_MAX_MB, PREP_CACHE_MAX_MB;
 extern double     OPT__CK_MEMFREE, INT_MONO_COEFF, UNIT_L, UNIT_M, UNIT_T, UNIT_V, UNIT_D, UNIT_E, UNIT_P;
+extern double     MEMORY_POOL_HEADROOM, MEMORY_POOL_MAX_MB;
 extern bool       OPT__FLAG_RHO, OPT__FLAG_RHO_GRADIENT, OPT__FLAG_USER, OPT__FLAG_LOHNER_DENS, OPT__FLAG_REGION;
 extern int        OPT__FLAG_USER_NUM, MONO_MAX_ITER;
-extern bool       OPT__DT_USER, OPT__RECORD_DT, OPT__RECORD_MEMORY, OPT__MEMORY_POOL, OPT__RESTART_RESET;
+extern bool       OPT__DT_USER, OPT__DT_FLU_FUSED, OPT__RECORD_DT, OPT__RECORD_MEMORY, OPT__RESTART_RESET, OPT__SLAB_ALLOC;
 extern bool       OPT__FIXUP_RESTRICT, OPT__INIT_RESTRICT, OPT__VERBOSE, OPT__MANUAL_CONTROL, OPT__UNIT;
-extern bool       OPT__INT_TIME, OPT__OUTPUT_USER, OPT__OUTPUT_BASE, OPT__OUTPUT_RESTART, OPT__OVERLAP_MPI, OPT__TIMING_BALANCE;
+extern bool       OPT__INT_TIME, OPT__OUTPUT_USER, OPT__OUTPUT_BASE, OPT__OUTPUT_RESTART, OPT__OVERLAP_MPI, OPT__TIMING_BALANCE, OPT__CPU_PIPELINE;
+extern bool       OPT__PREP_CACHE;
 extern bool       OPT__OUTPUT_BASEPS, OPT__CK_REFINE, OPT__CK_PROPER_NESTING, OPT__CK_FINITE, OPT__RECORD_PERFORMANCE;
 extern bool       OPT__CK_RESTRICT, OPT__CK_PATCH_ALLOCATE, OPT__FIXUP_FLUX, OPT__CK_FLUX_ALLOCATE, OPT__CK_NORMALIZE_PASSIVE;
 extern bool       OPT__UM_IC_DOWNGRADE, OPT__UM_IC_REFINE, OPT__TIMING_MPI;
 extern bool       OPT__CK_CONSERVATION, OPT__RESET_FLUID, OPT__FREEZE_FLUID, OPT__RECORD_USER, OPT__NORMALIZE_PASSIVE, AUTO_REDUCE_DT;
 extern bool       OPT__OPTIMIZE_AGGRESSIVE, OPT__INIT_GRID_WITH_OMP, OPT__NO_FLAG_NEAR_BOUNDARY;
 extern bool       OPT__RECORD_NOTE, OPT__RECORD_UNPHY, INT_OPP_SIGN_0TH_ORDER;
-extern bool       OPT__INT_FRAC_PASSIVE_LR;
+extern bool       OPT__INT_FRAC_PASSIVE_LR, OPT__OUTPUT_HDF5_MPIIO, OPT__OUTPUT_ASYNC;
 
 extern UM_IC_Format_t     OPT__UM_IC_FORMAT;
 extern TestProbID_t       TESTPROB_ID;
@@ -82,6 +86,7 @@ extern OptOutputMode_t    OPT__OUTPUT_MODE;
 extern OptFluBC_t         OPT__BC_FLU[6];          // boundary conditions of fluid at (-x,+x,-y,+y,-z,+z) faces
 extern OptLohnerForm_t    OPT__FLAG_LOHNER_FORM;
 extern OptCorrAfterSync_t OPT__CORR_AFTER_ALL_SYNC;
+extern OptMemoryPool_t    OPT__MEMORY_POOL;
 extern OptTimeStepLevel_t OPT__DT_LEVEL;
 
 
@@ -139,17 +144,20 @@ extern real         *GreenFuncK;
 extern double        GFUNC_COEFF0;
 extern double        DT__GRAVITY;
 extern double        NEWTON_G;
-extern int           POT_GPU_NPGROUP;
+extern int           POT_GPU_NPGROUP, OPT__FFT_PENCIL;
 extern bool          OPT__OUTPUT_POT, OPT__GRA_P5_GRADIENT, OPT__SELF_GRAVITY, OPT__GRAVITY_EXTRA_MASS;
 extern double        SOR_OMEGA;
 extern int           SOR_MAX_ITER, SOR_MIN_ITER;
 extern double        MG_TOLERATED_ERROR;
 extern int           MG_MAX_ITER, MG_NPRE_SMOOTH, MG_NPOST_SMOOTH;
+extern bool          OPT__POI_LEVEL_MG;
 extern char          EXT_POT_TABLE_NAME[MAX_STRING];
 extern double        EXT_POT_TABLE_DH[3], EXT_POT_TABLE_EDGEL[3];
 extern int           EXT_POT_TABLE_NPOINT[3], EXT_POT_TABLE_FLOAT8;
 extern IntScheme_t   OPT__POT_INT_SCHEME, OPT__RHO_INT_SCHEME, OPT__GRA_INT_SCHEME, OPT__REF_POT_INT_SCHEME;
 extern OptPotBC_t    OPT__BC_POT;
+extern OptFFTWStartup_t OPT__FFTW_STARTUP;
+extern bool          OPT__FFTW_WISDOM;
 extern OptExtAcc_t   OPT__EXT_ACC;
 extern OptExtPot_t   OPT__EXT_POT;
 
@@ -179,7 +187,8 @@ extern double     LB_INPUT__WLI_MAX;                  // LB->WLI_Max loaded from
 #ifdef PARTICLE
 extern double     LB_INPUT__PAR_WEIGHT;               // LB->Par_Weight loaded from "Input__Parameter"
 #endif
-extern bool       OPT__RECORD_LOAD_BALANCE;
+extern bool       OPT__RECORD_LOAD_BALANCE, OPT__LB_DIFFUSE, OPT__LB_MEASURE_COST, OPT__LB_NEIGHBOR_MPI;
+extern double     LB_MEASURE_COST_WEIGHT;
 #endif
 extern bool       OPT__MINIMIZE_MPI_BARRIER;
 
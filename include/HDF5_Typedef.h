@@ -61,6 +61,7 @@ struct KeyInfo_t
 
    long   Step;
    long   AdvanceCounter[NLEVEL];
+   int    NPatchAlloc   [NLEVEL];   // number of allocated (active+inactive) patches summed over all ranks
    int    NFieldStored;             // number of grid fields to be stored (excluding B field)
    int    NMagStored;               // NCOMP_MAG (declare it even when MHD is off)
 #  ifdef PARTICLE
@@ -371,6 +372,8 @@ struct InputPara_t
    int    Par_GhostSize;
    int    Par_GhostSizeTracer;
    int    Par_TracerVelCorr;
+   int    Par_FixedPointDepo;
+   int    Par_SortInterval;
    char  *ParAttLabel[PAR_NATT_TOTAL];
 #  endif
 
@@ -403,6 +406,9 @@ struct InputPara_t
    double Dt__SyncChildrenLv;
    int    Opt__DtUser;
    int    Opt__DtLevel;
+#  if ( MODEL == HYDRO )
+   int    Opt__DtFluFused;
+#  endif
    int    Opt__RecordDt;
    int    AutoReduceDt;
    double AutoReduceDtFactor;
@@ -450,6 +456,9 @@ struct InputPara_t
 #  endif
    int    Opt__ReuseMemory;
    int    Opt__MemoryPool;
+   double MemoryPool_Headroom;
+   double MemoryPool_MaxMB;
+   int    Opt__SlabAlloc;
 
 // load balance
 #  ifdef LOAD_BALANCE
@@ -458,6 +467,10 @@ struct InputPara_t
    double LB_Par_Weight;
 #  endif
    int    Opt__RecordLoadBalance;
+   int    Opt__LB_Diffuse;
+   int    Opt__LB_MeasureCost;
+   double LB_MeasureCostWeight;
+   int    Opt__LB_NeighborMPI;
 #  endif
    int    Opt__MinimizeMPIBarrier;
 
@@ -504,6 +517,10 @@ struct InputPara_t
    char  *MagLabel[NCOMP_MAG];
 #  endif
    int    Opt__OverlapMPI;
+   int    Opt__CPU_Pipeline;
+   int    CPU_Pipeline_NThread;
+   int    Opt__PrepCache;
+   double PrepCache_MaxMB;
    int    Opt__ResetFluid;
    int    Opt__FreezeFluid;
 #  if ( MODEL == HYDRO  ||  MODEL == ELBDM )
@@ -536,10 +553,14 @@ struct InputPara_t
    int    MG_NPreSmooth;
    int    MG_NPostSmooth;
    double MG_ToleratedError;
+   int    Opt__PoiLevelMG;
 #  endif
    int    Pot_GPU_NPGroup;
    int    Opt__GraP5Gradient;
    int    Opt__SelfGravity;
+   int    Opt__FFT_Pencil;
+   int    Opt__FFTW_Startup;
+   int    Opt__FFTW_Wisdom;
    int    Opt__ExtAcc;
    int    Opt__ExtPot;
    char  *ExtPotTable_Name;
@@ -661,6 +682,9 @@ struct InputPara_t
    int    Opt__Output_UserField;
    int    Opt__Output_Mode;
    int    Opt__Output_Restart;
+   int    Opt__Output_HDF5_MPIIO;
+   int    Opt__Output_Async;
+   double Output_Async_MaxMB;
    int    Opt__Output_Step;
    double Opt__Output_Dt;
    double Output_PartX;
@@ -36,8 +36,11 @@
 //                CutPoint                : Cut points in the space filling curve
 //                IdxList_Real            : Sorted LB_Idx list of all real patches
 //                IdxList_Real_IdxTable   : Index table for LB_IdxList_Real
-//                PaddedCr1DList          : Sorted PaddedCr1D list of all patches (real + buffer)
-//                PaddedCr1DList_IdxTable : Index table for LB_PaddedC1DrList
+//                PaddedCr1DHash_Key      : Open-addressing hash table of the PaddedCr1D of all patches (real + buffer)
+//                                          --> Empty slots have PaddedCr1DHash_PID == -1
+//                                          --> See LB_PaddedCr1DHash_Build() and LB_PaddedCr1DHash_Find()
+//                PaddedCr1DHash_PID      : Patch indices corresponding to PaddedCr1DHash_Key
+//                PaddedCr1DHash_NBit     : log2 of the number of slots in PaddedCr1DHash_Key/PID
 //
 //                SendH_NList             : Number of patches    for sending   hydrodynamic data
 //                SendH_IDList            : Patch indices        for sending   hydrodynamic data
@@ -135,8 +138,9 @@ struct LB_t
    long  *CutPoint               [NLEVEL];
    long  *IdxList_Real           [NLEVEL];
    int   *IdxList_Real_IdxTable  [NLEVEL];
-   ulong *PaddedCr1DList         [NLEVEL];
-   int   *PaddedCr1DList_IdxTable[NLEVEL];
+   ulong *PaddedCr1DHash_Key     [NLEVEL];
+   int   *PaddedCr1DHash_PID     [NLEVEL];
+   int    PaddedCr1DHash_NBit    [NLEVEL];
 
    int   *SendH_NList            [NLEVEL];
    int  **SendH_IDList           [NLEVEL];
@@ -218,8 +222,8 @@ struct LB_t
    //
    // Note        :  1. Allocate memory for pointers whose sizes depend on the number of MPI ranks
    //                2. Initialize pointers as NULL and counters as zero.
-   //                3. "IdxList_Real, IdxList_Real_IdxTable, PaddedCr1DList, and
-   //                   PaddedCr1DList_IdxTable", whose sizes can not be determined during
+   //                3. "IdxList_Real, IdxList_Real_IdxTable, PaddedCr1DHash_Key, and
+   //                   PaddedCr1DHash_PID", whose sizes can not be determined during
    //                   initialization, are NOT allocated with memory
    //
    // Parameter   :  NRank             : Number of MPI ranks
@@ -251,8 +255,9 @@ struct LB_t
          CutPoint               [lv] = new long [MPI_NRank+1];
          IdxList_Real           [lv] = NULL;
          IdxList_Real_IdxTable  [lv] = NULL;
-         PaddedCr1DList         [lv] = NULL;
-         PaddedCr1DList_IdxTable[lv] = NULL;
+         PaddedCr1DHash_Key     [lv] = NULL;
+         PaddedCr1DHash_PID     [lv] = NULL;
+         PaddedCr1DHash_NBit    [lv] = 0;
 
          SendH_NList            [lv] = new int   [MPI_NRank];
          SendH_IDList           [lv] = new int*  [MPI_NRank];
@@ -606,8 +611,8 @@ struct LB_t
 #     endif
       if ( IdxList_Real           [lv] != NULL )   delete [] IdxList_Real           [lv];
       if ( IdxList_Real_IdxTable  [lv] != NULL )   delete [] IdxList_Real_IdxTable  [lv];
-      if ( PaddedCr1DList         [lv] != NULL )   free(     PaddedCr1DList         [lv] );
-      if ( PaddedCr1DList_IdxTable[lv] != NULL )   free(     PaddedCr1DList_IdxTable[lv] );
+      if ( PaddedCr1DHash_Key     [lv] != NULL )   delete [] PaddedCr1DHash_Key     [lv];
+      if ( PaddedCr1DHash_PID     [lv] != NULL )   delete [] PaddedCr1DHash_PID     [lv];
 
       OverlapMPI_FluSyncPID0 [lv] = NULL;
       OverlapMPI_FluAsyncPID0[lv] = NULL;
@@ -617,8 +622,9 @@ struct LB_t
 #     endif
       IdxList_Real           [lv] = NULL;
       IdxList_Real_IdxTable  [lv] = NULL;
-      PaddedCr1DList         [lv] = NULL;
-      PaddedCr1DList_IdxTable[lv] = NULL;
+      PaddedCr1DHash_Key     [lv] = NULL;
+      PaddedCr1DHash_PID     [lv] = NULL;
+      PaddedCr1DHash_NBit    [lv] = 0;
 
       for (int r=0; r<MPI_NRank; r++)
       {
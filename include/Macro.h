@@ -862,6 +862,20 @@
 #define TOP_LEVEL          ( NLEVEL - 1 )
 
 
+// log2 of the number of patch pointers in each chunk of PatchTable_t
+#define PATCH_TABLE_CHUNK_NBIT   12
+
+
+// number of patch data types allocated by Mis_SlabAlloc_New() (see SlabType_t)
+// and the target size in bytes of each slab
+#define SLAB_NTYPE               7
+#define SLAB_BYTE                ( 4L*1024L*1024L )
+
+
+// number of recent patch counts used by Aux_AdjustMemoryPool() to estimate the peak usage of the memory pool
+#define MEMORY_POOL_NHISTORY     16
+
+
 // maximum length for strings
 #define MAX_STRING         512
 
@@ -51,6 +51,12 @@ void Aux_Error( const char *File, const int Line, const char *Func, const char *
 //                                          the velocity gradient is large
 //                RemoveCell              : remove particles RemoveCell-base-level-cells away from the boundary
 //                                          (for non-periodic BC only)
+//                FixedPointDepo          : Accumulate the deposited mass density with fixed-point numbers
+//                                          --> Independent of the particle order and thus replace sorting particles
+//                                              for BITWISE_REPRODUCIBILITY (see Par_MassAssignment())
+//                SortInterval            : Interval (in root-level steps) of sorting the particle repository by
+//                                          patches (<=0 --> off)
+//                                          --> see Par_SortByPatch()
 //                GhostSize               : Number of ghost zones required for interpolation scheme
 //                Attribute               : Pointer arrays to different particle attributes (Mass, Pos, Vel, ...)
 //                InactiveParList         : List of inactive particle IDs
@@ -102,6 +108,9 @@ void Aux_Error( const char *File, const int Line, const char *Func, const char *
 //                InitRepo          : Initialize particle repository
 //                AddOneParticle    : Add one new particle into the particle list
 //                RemoveOneParticle : Remove one particle from the particle list
+//                AddParticles      : Add multiple new particles into the particle list at once
+//                RemoveParticles   : Remove multiple particles from the particle list at once
+//                Reorder           : Reorder the particle repository
 //-------------------------------------------------------------------------------------------------------
 struct Particle_t
 {
@@ -127,6 +136,8 @@ struct Particle_t
    bool          PredictPos;
    bool          TracerVelCorr;
    double        RemoveCell;
+   bool          FixedPointDepo;
+   int           SortInterval;
    int           GhostSize;
    int           GhostSizeTracer;
    real         *Attribute[PAR_NATT_TOTAL];
@@ -196,6 +207,8 @@ struct Particle_t
       PredictPos          = true;
       TracerVelCorr       = false;
       RemoveCell          = -999.9;
+      FixedPointDepo      = false;
+      SortInterval        = 0;
       GhostSize           = -1;
       GhostSizeTracer     = -1;
 
@@ -550,6 +563,229 @@ struct Particle_t
    } // METHOD : RemoveOneParticle
 
 
+
+   //===================================================================================
+   // Method      :  AddParticles
+   // Description :  Add multiple new particles into the particle list at once
+   //
+   // Note        :  1. Bulk version of AddOneParticle()
+   //                   --> Particle IDs are assigned in the same order as calling AddOneParticle()
+   //                       NNew times (i.e., inactive particle IDs are reassigned first)
+   //                   --> Particle attribute arrays are reallocated at most once
+   //                2. Only the particle IDs are determined here
+   //                   --> Attributes of the new particles must be set by the caller afterward via
+   //                       Attribute[v][ NewParID[p] ], which can be done by multiple OpenMP threads
+   //                       concurrently since all new particles have different IDs
+   //                   --> Do not set pointers to the attribute arrays (e.g., PosX) before calling
+   //                       this function since they may be reallocated
+   //                3. This function will modify several global variables and should be called by
+   //                   a single thread
+   //                4. Note that the global variable "AveDensity_Init" will NOT be recalculated
+   //                   automatically here
+   //
+   // Parameter   :  NNew     : Number of new particles
+   //                NewParID : Array to store the IDs of the new particles
+   //
+   // Return      :  NewParID[]
+   //===================================================================================
+   void AddParticles( const long NNew, long *NewParID )
+   {
+
+//    check
+#     ifdef DEBUG_PARTICLE
+      if ( NPar_AcPlusInac < 0 ) Aux_Error( ERROR_INFO, "NPar_AcPlusInac (%ld) < 0 !!\n", NPar_AcPlusInac );
+
+      if ( NNew < 0 )   Aux_Error( ERROR_INFO, "NNew (%ld) < 0 !!\n", NNew );
+
+      if ( NNew > 0  &&  NewParID == NULL )  Aux_Error( ERROR_INFO, "NewParID == NULL !!\n" );
+#     endif
+
+
+//    1. reuse inactive particle IDs
+      const long NReuse  = MIN( NNew, NPar_Inactive );
+      const long NAppend = NNew - NReuse;
+
+      for (long p=0; p<NReuse; p++)
+      {
+         NewParID[p] = InactiveParList[ NPar_Inactive-1-p ];
+
+#        ifdef DEBUG_PARTICLE
+         if ( NewParID[p] < 0  ||  NewParID[p] >= NPar_AcPlusInac )
+            Aux_Error( ERROR_INFO, "Incorrect ParID (%ld), NPar_AcPlusInac = %ld !!\n", NewParID[p], NPar_AcPlusInac );
+#        endif
+      }
+
+      NPar_Inactive -= NReuse;
+
+
+//    2. add new particle IDs
+//    2-1. allocate enough memory for the particle variable array
+      if ( NPar_AcPlusInac + NAppend > ParListSize )
+      {
+         ParListSize = (long)ceil( PARLIST_GROWTH_FACTOR*(NPar_AcPlusInac+NAppend) );
+
+         for (int v=0; v<PAR_NATT_TOTAL; v++)   Attribute[v] = (real*)realloc( Attribute[v], ParListSize*sizeof(real) );
+
+         Mass = Attribute[PAR_MASS];
+         PosX = Attribute[PAR_POSX];
+         PosY = Attribute[PAR_POSY];
+         PosZ = Attribute[PAR_POSZ];
+         VelX = Attribute[PAR_VELX];
+         VelY = Attribute[PAR_VELY];
+         VelZ = Attribute[PAR_VELZ];
+         Time = Attribute[PAR_TIME];
+         Type = Attribute[PAR_TYPE];
+#        ifdef STORE_PAR_ACC
+         AccX = Attribute[PAR_ACCX];
+         AccY = Attribute[PAR_ACCY];
+         AccZ = Attribute[PAR_ACCZ];
+#        endif
+      }
+
+//    2-2. record the new particle IDs
+      for (long p=0; p<NAppend; p++)   NewParID[ NReuse + p ] = NPar_AcPlusInac + p;
+
+      NPar_AcPlusInac += NAppend;
+
+
+//    3. update the total number of active particles (assuming all new particles are active)
+      NPar_Active += NNew;
+
+   } // METHOD : AddParticles
+
+
+
+   //===================================================================================
+   // Method      :  RemoveParticles
+   // Description :  Remove multiple particles from the particle list at once
+   //
+   // Note        :  1. Bulk version of RemoveOneParticle()
+   //                   --> Equivalent to calling RemoveOneParticle() for RemoveParID[0 ... NRemove-1]
+   //                       in order, but reallocates InactiveParList[] at most once
+   //                2. This function will modify several global variables and should be called by
+   //                   a single thread
+   //                3. Note that the global variable "AveDensity_Init" will NOT be recalculated
+   //                   automatically here
+   //
+   // Parameter   :  NRemove     : Number of particles to be removed
+   //                RemoveParID : Particle IDs to be removed
+   //                Marker      : Value assigned to the mass of the particles being removed
+   //                              (PAR_INACTIVE_OUTSIDE or PAR_INACTIVE_MPI)
+   //
+   // Return      :  None
+   //===================================================================================
+   void RemoveParticles( const long NRemove, const long *RemoveParID, const real Marker )
+   {
+
+//    check
+#     ifdef DEBUG_PARTICLE
+      if ( NRemove < 0 )   Aux_Error( ERROR_INFO, "NRemove (%ld) < 0 !!\n", NRemove );
+
+      if ( NRemove > 0  &&  RemoveParID == NULL )  Aux_Error( ERROR_INFO, "RemoveParID == NULL !!\n" );
+
+      for (long p=0; p<NRemove; p++)
+         if ( RemoveParID[p] < 0  ||  RemoveParID[p] >= NPar_AcPlusInac )
+            Aux_Error( ERROR_INFO, "Wrong ParID (%ld) !!\n", RemoveParID[p] );
+
+      if ( Marker != PAR_INACTIVE_OUTSIDE  &&  Marker != PAR_INACTIVE_MPI )
+         Aux_Error( ERROR_INFO, "Unsupported Marker (%14.7e) !!\n", Marker );
+#     endif
+
+
+//    1. allocate enough memory for InactiveParList
+      if ( NPar_Inactive + NRemove > InactiveParListSize )
+      {
+         InactiveParListSize = (long)ceil( PARLIST_GROWTH_FACTOR*(NPar_Inactive+NRemove) );
+
+         InactiveParList = (long*)realloc( InactiveParList, InactiveParListSize*sizeof(long) );
+      }
+
+
+//    2. record the particle IDs to be removed and remove the target particles
+      for (long p=0; p<NRemove; p++)
+      {
+         InactiveParList[ NPar_Inactive + p ] = RemoveParID[p];
+         Mass[ RemoveParID[p] ] = Marker;
+      }
+
+      NPar_Active   -= NRemove;
+      NPar_Inactive += NRemove;
+
+#     ifdef DEBUG_PARTICLE
+      if ( NPar_Active + NPar_Inactive != NPar_AcPlusInac )
+         Aux_Error( ERROR_INFO, "NPar_Active (%ld) + NPar_Inactive (%ld) != NPar_AcPlusInac (%ld) !!\n",
+                    NPar_Active, NPar_Inactive, NPar_AcPlusInac );
+#     endif
+
+   } // METHOD : RemoveParticles
+
+
+
+   //===================================================================================
+   // Method      :  Reorder
+   // Description :  Reorder the particle repository
+   //
+   // Note        :  1. The new particle n will be the old particle OldParID[n]
+   //                   --> Particles not listed in OldParID[] (e.g., inactive particles) will be discarded
+   //                2. All listed particles must be active
+   //                   --> NPar_Active must equal NPar_New and there will be no inactive particles afterward
+   //                3. Particle lists referring to the old particle IDs (e.g., ParList[] of each patch)
+   //                   must be updated by the caller
+   //                4. ParListSize is kept unchanged and only one temporary attribute array is allocated
+   //                   at a time
+   //
+   // Parameter   :  NPar_New : Number of particles after reordering
+   //                OldParID : Old particle IDs of the new particles
+   //
+   // Return      :  Attribute[], NPar_AcPlusInac, NPar_Inactive
+   //===================================================================================
+   void Reorder( const long NPar_New, const long *OldParID )
+   {
+
+//    check
+#     ifdef DEBUG_PARTICLE
+      if ( NPar_New != NPar_Active )
+         Aux_Error( ERROR_INFO, "NPar_New (%ld) != NPar_Active (%ld) !!\n", NPar_New, NPar_Active );
+
+      if ( NPar_New > 0  &&  OldParID == NULL )    Aux_Error( ERROR_INFO, "OldParID == NULL !!\n" );
+#     endif
+
+
+//    1. gather the attributes in the new order
+      for (int v=0; v<PAR_NATT_TOTAL; v++)
+      {
+         real *NewAtt = (real*)malloc( ParListSize*sizeof(real) );
+
+#        pragma omp parallel for schedule( static )
+         for (long p=0; p<NPar_New; p++)  NewAtt[p] = Attribute[v][ OldParID[p] ];
+
+         free( Attribute[v] );
+         Attribute[v] = NewAtt;
+      }
+
+      Mass = Attribute[PAR_MASS];
+      PosX = Attribute[PAR_POSX];
+      PosY = Attribute[PAR_POSY];
+      PosZ = Attribute[PAR_POSZ];
+      VelX = Attribute[PAR_VELX];
+      VelY = Attribute[PAR_VELY];
+      VelZ = Attribute[PAR_VELZ];
+      Time = Attribute[PAR_TIME];
+      Type = Attribute[PAR_TYPE];
+#     ifdef STORE_PAR_ACC
+      AccX = Attribute[PAR_ACCX];
+      AccY = Attribute[PAR_ACCY];
+      AccZ = Attribute[PAR_ACCZ];
+#     endif
+
+
+//    2. all inactive particles have been discarded
+      NPar_AcPlusInac = NPar_New;
+      NPar_Inactive   = 0;
+
+   } // METHOD : Reorder
+
+
 }; // struct Particle_t
 
 
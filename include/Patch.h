@@ -16,6 +16,8 @@ void Aux_Error( const char *File, const int Line, const char *Func, const char *
 void Aux_Message( FILE *Type, const char *Format, ... );
 ulong Mis_Idx3D2Idx1D( const int Size[], const int Idx3D[] );
 long  LB_Corner2Index( const int lv, const int Corner[], const Check_t Check );
+void *Mis_SlabAlloc_New( const SlabType_t Type );
+void  Mis_SlabAlloc_Delete( const SlabType_t Type, void *Ptr );
 
 
 
@@ -122,6 +124,10 @@ long  LB_Corner2Index( const int lv, const int Corner[], const Check_t Check );
 //                                      3D corner coordinates
 //                                  --> This number is independent of periodicity (because of the padded patches)
 //                LB_Idx          : Space-filling-curve index for load balance
+//                LB_Cost         : Measured workload of this patch for OPT__LB_MEASURE_COST
+//                                  --> Exponential moving average of the wall-clock time per update spent in the
+//                                      CPU/GPU solvers (<0.0 --> not measured yet)
+//                LB_CostNow      : Wall-clock time accumulated since LB_Cost was last updated
 //                NPar            : Number of particles belonging to this leaf patch
 //                NPar_Type       : Number of different types of particles belonging to this leaf patch
 //                ParListSize     : Size of the array ParList (ParListSize can be >= NPar)
@@ -231,6 +237,10 @@ struct patch_t
 
    ulong  PaddedCr1D;
    long   LB_Idx;
+#  ifdef LOAD_BALANCE
+   double LB_Cost;
+   double LB_CostNow;
+#  endif
 
 #  ifdef PARTICLE
    int    NPar;
@@ -352,6 +362,10 @@ struct patch_t
 
       PaddedCr1D = Mis_Idx3D2Idx1D( BoxNScale_Padded, Cr_Padded );   // independent of periodicity
       LB_Idx     = LB_Corner2Index( lv, corner, CHECK_OFF );         // always assumes periodicity
+#     ifdef LOAD_BALANCE
+      LB_Cost    = -1.0;
+      LB_CostNow = 0.0;
+#     endif
 
 //    set the patch edge
       const int PScale = PS1*( 1<<(TOP_LEVEL-lv) );
@@ -535,11 +549,11 @@ struct patch_t
 #     endif
 #     endif
 
-      flux      [SibID]  = new real [NFLUX_TOTAL][PS1][PS1];
+      flux      [SibID]  = (real (*)[PS1][PS1])Mis_SlabAlloc_New( SLAB_FLUX );
       if ( AllocTmp )
-      flux_tmp  [SibID]  = new real [NFLUX_TOTAL][PS1][PS1];
+      flux_tmp  [SibID]  = (real (*)[PS1][PS1])Mis_SlabAlloc_New( SLAB_FLUX );
 #     ifdef BIT_REP_FLUX
-      flux_bitrep[SibID] = new real [NFLUX_TOTAL][PS1][PS1];
+      flux_bitrep[SibID] = (real (*)[PS1][PS1])Mis_SlabAlloc_New( SLAB_FLUX );
 #     endif
 
       for(int v=0; v<NFLUX_TOTAL; v++)
@@ -570,14 +584,14 @@ struct patch_t
 
       for (int s=0; s<6; s++)
       {
-         delete [] flux[s];
+         Mis_SlabAlloc_Delete( SLAB_FLUX, flux[s] );
          flux[s] = NULL;
 
-         delete [] flux_tmp[s];
+         Mis_SlabAlloc_Delete( SLAB_FLUX, flux_tmp[s] );
          flux_tmp[s] = NULL;
 
 #        ifdef BIT_REP_FLUX
-         delete [] flux_bitrep[s];
+         Mis_SlabAlloc_Delete( SLAB_FLUX, flux_bitrep[s] );
          flux_bitrep[s] = NULL;
 #        endif
       }
@@ -615,13 +629,14 @@ struct patch_t
 #     endif
 #     endif
 
-      const int Size = ( SibID < 6 ) ? NCOMP_ELE*PS1M1*PS1 : PS1;
+      const int        Size = ( SibID < 6 ) ? NCOMP_ELE*PS1M1*PS1 : PS1;
+      const SlabType_t Type = ( SibID < 6 ) ? SLAB_ELECTRIC_FACE : SLAB_ELECTRIC_EDGE;
 
-      electric      [SibID]  = new real [Size];
+      electric      [SibID]  = (real*)Mis_SlabAlloc_New( Type );
       if ( AllocTmp )
-      electric_tmp  [SibID]  = new real [Size];
+      electric_tmp  [SibID]  = (real*)Mis_SlabAlloc_New( Type );
 #     ifdef BIT_REP_ELECTRIC
-      electric_bitrep[SibID] = new real [Size];
+      electric_bitrep[SibID] = (real*)Mis_SlabAlloc_New( Type );
 #     endif
 
       for(int t=0; t<Size; t++)
@@ -650,14 +665,16 @@ struct patch_t
 
       for (int s=0; s<18; s++)
       {
-         delete [] electric[s];
+         const SlabType_t Type = ( s < 6 ) ? SLAB_ELECTRIC_FACE : SLAB_ELECTRIC_EDGE;
+
+         Mis_SlabAlloc_Delete( Type, electric[s] );
          electric[s] = NULL;
 
-         delete [] electric_tmp[s];
+         Mis_SlabAlloc_Delete( Type, electric_tmp[s] );
          electric_tmp[s] = NULL;
 
 #        ifdef BIT_REP_ELECTRIC
-         delete [] electric_bitrep[s];
+         Mis_SlabAlloc_Delete( Type, electric_bitrep[s] );
          electric_bitrep[s] = NULL;
 #        endif
       }
@@ -678,7 +695,7 @@ struct patch_t
 
       if ( fluid == NULL )
       {
-         fluid = new real [NCOMP_TOTAL][PS1][PS1][PS1];
+         fluid = (real (*)[PS1][PS1][PS1])Mis_SlabAlloc_New( SLAB_FLUID );
          fluid[0][0][0][0] = (real)-1.0;  // arbitrarily initialized
       }
 
@@ -693,7 +710,7 @@ struct patch_t
    void hdelete()
    {
 
-      delete [] fluid;
+      Mis_SlabAlloc_Delete( SLAB_FLUID, fluid );
       fluid = NULL;
 
 #     ifdef MASSIVE_PARTICLES
@@ -717,7 +734,7 @@ struct patch_t
 
       if ( magnetic == NULL )
       {
-         magnetic = new real [NCOMP_MAG][ PS1P1*SQR(PS1) ];
+         magnetic = (real (*)[ PS1P1*SQR(PS1) ])Mis_SlabAlloc_New( SLAB_MAGNETIC );
          magnetic[0][0] = (real)-1.0;  // arbitrarily initialized
       }
 
@@ -732,7 +749,7 @@ struct patch_t
    void mdelete()
    {
 
-      delete [] magnetic;
+      Mis_SlabAlloc_Delete( SLAB_MAGNETIC, magnetic );
       magnetic = NULL;
 
    } // METHOD : mdelete
@@ -750,10 +767,10 @@ struct patch_t
    void gnew()
    {
 
-      if ( pot == NULL )      pot     = new real [PS1][PS1][PS1];
+      if ( pot == NULL )      pot     = (real (*)[PS1][PS1])Mis_SlabAlloc_New( SLAB_POT );
 
 #     ifdef STORE_POT_GHOST
-      if ( pot_ext == NULL )  pot_ext = new real [GRA_NXT][GRA_NXT][GRA_NXT];
+      if ( pot_ext == NULL )  pot_ext = (real (*)[GRA_NXT][GRA_NXT])Mis_SlabAlloc_New( SLAB_POT_EXT );
 
 //    always initialize pot_ext[] (even if pot_ext != NULL when calling this function) to indicate that this array
 //    has NOT been properly set --> used by Poi_StorePotWithGhostZone()
@@ -771,11 +788,11 @@ struct patch_t
    void gdelete()
    {
 
-      delete [] pot;
+      Mis_SlabAlloc_Delete( SLAB_POT, pot );
       pot = NULL;
 
 #     ifdef STORE_POT_GHOST
-      delete [] pot_ext;
+      Mis_SlabAlloc_Delete( SLAB_POT_EXT, pot_ext );
       pot_ext = NULL;
 #     endif
 
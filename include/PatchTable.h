@@ -0,0 +1,162 @@
+#ifndef __PATCHTABLE_H__
+#define __PATCHTABLE_H__
+
+
+
+#include "Macro.h"
+#include "Patch.h"
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Structure   :  PatchTable_t
+// Description :  Growable table of patch pointers at one refinement level
+//
+// Note        :  1. Replace the static array "patch_t *patch[MAX_PATCH]" so that there is no compile-time limit
+//                   on the number of patches and the memory of the table is proportional to the number of
+//                   patches ever allocated
+//                2. Patch pointers are stored in chunks of 2^PATCH_TABLE_CHUNK_NBIT elements
+//                   --> PatchTable[PID] = Chunk[ PID >> PATCH_TABLE_CHUNK_NBIT ][ PID & ChunkMask ]
+//                   --> Chunks are never moved or deallocated until the table is destroyed. Therefore,
+//                       the address of an element (e.g., &amr->patch[Sg][lv][PID]) remains valid even after
+//                       the table grows
+//                3. Only the array of chunk pointers "Chunk" is reallocated when the table grows
+//                   --> Grow() is not thread-safe and must not be invoked concurrently with operator[]
+//                4. New elements are initialized as NULL
+//
+// Data Member :  Chunk     : Array of chunks of patch pointers
+//                NChunk    : Number of allocated chunks
+//                NChunkMax : Size of the array "Chunk"
+//
+// Method      :  PatchTable_t : Constructor
+//               ~PatchTable_t : Destructor
+//                operator[]   : Return a reference to the patch pointer with the target patch index
+//                Capacity     : Return the number of patch pointers currently allocated
+//                Grow         : Allocate chunks until the table can store the target number of patch pointers
+//-------------------------------------------------------------------------------------------------------
+struct PatchTable_t
+{
+
+// data members
+// ===================================================================================
+   patch_t ***Chunk;
+   int        NChunk;
+   int        NChunkMax;
+
+
+
+   //===================================================================================
+   // Constructor :  PatchTable_t
+   // Description :  Constructor of the structure "PatchTable_t"
+   //
+   // Note        :  Initialize an empty table
+   //===================================================================================
+   PatchTable_t()
+   {
+      Chunk     = NULL;
+      NChunk    = 0;
+      NChunkMax = 0;
+   } // METHOD : PatchTable_t
+
+
+
+   //===================================================================================
+   // Destructor  :  ~PatchTable_t
+   // Description :  Destructor of the structure "PatchTable_t"
+   //
+   // Note        :  1. Deallocate the table but NOT the patches it points to
+   //                   --> Patches must be deallocated by AMR_t::Lvdelete() in advance
+   //===================================================================================
+   ~PatchTable_t()
+   {
+      for (int c=0; c<NChunk; c++)  delete [] Chunk[c];
+      delete [] Chunk;
+
+      Chunk     = NULL;
+      NChunk    = 0;
+      NChunkMax = 0;
+   } // METHOD : ~PatchTable_t
+
+
+
+   //===================================================================================
+   // Method      :  operator[]
+   // Description :  Return a reference to the patch pointer with the target patch index
+   //
+   // Note        :  1. No bound check for efficiency
+   //                   --> PID must be in the range [0 ... Capacity()-1]
+   //
+   // Parameter   :  PID : Target patch index
+   //===================================================================================
+   inline patch_t*& operator[]( const int PID )
+   {
+      return Chunk[ PID >> PATCH_TABLE_CHUNK_NBIT ][ PID & ( (1<<PATCH_TABLE_CHUNK_NBIT) - 1 ) ];
+   } // METHOD : operator[]
+
+   inline patch_t* const& operator[]( const int PID ) const
+   {
+      return Chunk[ PID >> PATCH_TABLE_CHUNK_NBIT ][ PID & ( (1<<PATCH_TABLE_CHUNK_NBIT) - 1 ) ];
+   } // METHOD : operator[] (const)
+
+
+
+   //===================================================================================
+   // Method      :  Capacity
+   // Description :  Return the number of patch pointers currently allocated
+   //===================================================================================
+   inline long Capacity() const
+   {
+      return (long)NChunk << PATCH_TABLE_CHUNK_NBIT;
+   } // METHOD : Capacity
+
+
+
+   //===================================================================================
+   // Method      :  Grow
+   // Description :  Allocate chunks until the table can store at least NPatch patch pointers
+   //
+   // Note        :  1. Do nothing if the current capacity is already large enough
+   //                2. The array of chunk pointers grows geometrically
+   //
+   // Parameter   :  NPatch : Target number of patch pointers
+   //===================================================================================
+   void Grow( const long NPatch )
+   {
+      const long ChunkSize = 1L << PATCH_TABLE_CHUNK_NBIT;
+      const int  NChunkNew = (int)(  ( NPatch + ChunkSize - 1 ) / ChunkSize  );
+
+      if ( NChunkNew <= NChunk )    return;
+
+//    reallocate the array of chunk pointers
+      if ( NChunkNew > NChunkMax )
+      {
+         const int NChunkMaxNew = MAX( NChunkNew, 2*NChunkMax );
+         patch_t ***ChunkNew    = new patch_t** [NChunkMaxNew];
+
+         for (int c=0;      c<NChunk;       c++)  ChunkNew[c] = Chunk[c];
+         for (int c=NChunk; c<NChunkMaxNew; c++)  ChunkNew[c] = NULL;
+
+         delete [] Chunk;
+
+         Chunk     = ChunkNew;
+         NChunkMax = NChunkMaxNew;
+      }
+
+//    allocate new chunks
+      for (int c=NChunk; c<NChunkNew; c++)
+      {
+         Chunk[c] = new patch_t* [ChunkSize];
+
+         for (long t=0; t<ChunkSize; t++)    Chunk[c][t] = NULL;
+      }
+
+      NChunk = NChunkNew;
+   } // METHOD : Grow
+
+
+}; // struct PatchTable_t
+
+
+
+#endif // #ifndef __PATCHTABLE_H__
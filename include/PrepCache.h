@@ -0,0 +1,82 @@
+#ifndef __PREPCACHE_H__
+#define __PREPCACHE_H__
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Structure   :  PrepCacheKey_t
+// Description :  Data structure identifying the data of one patch group prepared by Prepare_PatchData()
+//
+// Note        :  1. Used by the option "OPT__PREP_CACHE"
+//                2. Two calls to Prepare_PatchData() return the same data for a patch group if all the
+//                   input parameters stored here are the same and the AMR data have not changed in between
+//                   --> See PrepCache.cpp for the invalidation of the cache
+//
+// Data Member :  PrepTime ... DE_Consistency : See the corresponding parameters of Prepare_PatchData()
+//
+// Method      :  Match : Return true if two keys are identical
+//-------------------------------------------------------------------------------------------------------
+struct PrepCacheKey_t
+{
+
+// data members
+// ===================================================================================
+   double      PrepTime;
+   long        TVarCC;
+   long        TVarFC;
+   int         GhostSize;
+   IntScheme_t IntScheme_CC;
+   IntScheme_t IntScheme_FC;
+   PrepUnit_t  PrepUnit;
+   NSide_t     NSide;
+   bool        IntPhase;
+   OptFluBC_t  FluBC[6];
+   OptPotBC_t  PotBC;
+   real        MinDens;
+   real        MinPres;
+   real        MinTemp;
+   real        MinEntr;
+   bool        DE_Consistency;
+
+
+   //===================================================================================
+   // Method      :  Match
+   // Description :  Return true if this key is identical to the input key
+   //
+   // Note        :  Floating-point members are compared exactly
+   //
+   // Parameter   :  Key : Key to be compared with
+   //===================================================================================
+   bool Match( const PrepCacheKey_t &Key ) const
+   {
+
+      if ( PrepTime       != Key.PrepTime       )   return false;
+      if ( TVarCC         != Key.TVarCC         )   return false;
+      if ( TVarFC         != Key.TVarFC         )   return false;
+      if ( GhostSize      != Key.GhostSize      )   return false;
+      if ( IntScheme_CC   != Key.IntScheme_CC   )   return false;
+      if ( IntScheme_FC   != Key.IntScheme_FC   )   return false;
+      if ( PrepUnit       != Key.PrepUnit       )   return false;
+      if ( NSide          != Key.NSide          )   return false;
+      if ( IntPhase       != Key.IntPhase       )   return false;
+      if ( PotBC          != Key.PotBC          )   return false;
+      if ( MinDens        != Key.MinDens        )   return false;
+      if ( MinPres        != Key.MinPres        )   return false;
+      if ( MinTemp        != Key.MinTemp        )   return false;
+      if ( MinEntr        != Key.MinEntr        )   return false;
+      if ( DE_Consistency != Key.DE_Consistency )   return false;
+
+      for (int f=0; f<6; f++)
+      if ( FluBC[f]       != Key.FluBC[f]       )   return false;
+
+      return true;
+
+   } // METHOD : Match
+
+
+}; // struct PrepCacheKey_t
+
+
+
+#endif // #ifndef __PREPCACHE_H__
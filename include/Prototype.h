@@ -34,6 +34,8 @@ void Aux_Record_Timing();
 void Aux_Record_PatchCount();
 void Aux_Record_Performance( const double ElapsedTime );
 void Aux_Record_CorrUnphy();
+void Aux_Record_PrepCache();
+void Aux_AdjustMemoryPool( const int NPatchHint[] );
 int  Aux_CountRow( const char *FileName );
 void Aux_ComputeProfile( Profile_t *Prof[], const double Center[], const double r_max_input, const double dr_min,
                          const bool LogBin, const double LogBinRatio, const bool RemoveEmpty, const long TVarBitIdx[],
@@ -112,6 +114,10 @@ real Hydro_CheckMinEintInEngy( const real Dens, const real MomX, const real MomY
                                const real MinEint, const real Emag );
 bool Hydro_CheckUnphysical( const CheckUnphysical_t Mode, const real Fields[], const char SingleFieldName[],
                             const char File[], const int Line, const char Function[], const CheckUnphysical_t Verbose );
+real Hydro_GetMaxCFL( const real Fluid[], const real B[], const real MinPres,
+                      const EoS_DE2P_t EoS_DensEint2Pres, const EoS_DP2C_t EoS_DensPres2CSqr,
+                      const double EoS_AuxArray_Flt[], const int EoS_AuxArray_Int[],
+                      const real *const EoS_Table[EOS_NTABLE_MAX] );
 #ifdef DUAL_ENERGY
 void Hydro_DualEnergyFix( const real Dens, const real MomX, const real MomY, const real MomZ,
                           real &Etot, real &Dual, char &DE_Status, const real Gamma_m1, const real _Gamma_m1,
@@ -127,6 +133,8 @@ real Hydro_DensDual2Pres( const real Dens, const real Dual, const real Gamma_m1,
 #endif // #if ( MODEL == HYDRO )
 int Flu_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, const double dt,
                    const int SaveSg_Flu, const int SaveSg_Mag, const bool OverlapMPI, const bool Overlap_Sync );
+int Flu_AdvanceDt_Finalize( const int lv );
+void Flu_FusedMaxCFL_Invalidate( const int lv );
 void Flu_AllocateFluxArray( const int lv );
 void Flu_Close( const int lv, const int SaveSg_Flu, const int SaveSg_Mag,
                 real h_Flux_Array[][9][NFLUX_TOTAL][ SQR(PS2) ],
@@ -177,6 +185,13 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
                         const IntScheme_t IntScheme_CC, const IntScheme_t IntScheme_FC, const PrepUnit_t PrepUnit,
                         const NSide_t NSide, const bool IntPhase, const OptFluBC_t FluBC[], const OptPotBC_t PotBC,
                         const real MinDens, const real MinPres, const real MinTemp, const real MinEntr, const bool DE_Consistency );
+bool PrepCache_Get( const int lv, const int PID0, const PrepCacheKey_t &Key, real *OutputCC, real *OutputFC,
+                    const long SizeCC, const long SizeFC );
+void PrepCache_Put( const int lv, const int PID0, const PrepCacheKey_t &Key, const real *InputCC, const real *InputFC,
+                    const long SizeCC, const long SizeFC );
+void PrepCache_Invalidate( const int lv );
+void PrepCache_Free();
+double PrepCache_GetMemoryMB();
 
 
 // Init
@@ -231,6 +246,7 @@ template <typename T> int   Mis_BinarySearch_Real( const T Array[], int Min, int
 template <typename T> T     Mis_InterpolateFromTable( const int N, const T Table_x[], const T Table_y[], const T x );
 template <typename T> ulong Mis_Idx3D2Idx1D( const int Size[], const int Idx3D[] );
 template <typename T> void  Mis_Heapsort( const int N, T Array[], int IdxTable[] );
+template <typename T> void  Mis_RadixSort( const int N, T Array[], int IdxTable[] );
 template <typename T> int   Mis_Matching_char( const int N, const T Array[], const int M, const T Key[], char Match[] );
 template <typename T> int   Mis_Matching_int( const int N, const T Array[], const int M, const T Key[], int Match[] );
 template <typename T> bool  Mis_CompareRealValue( const T Input1, const T Input2, const char *comment, const bool Verbose );
@@ -238,6 +254,9 @@ ulong  Mis_Idx3D2Idx1D( const int Size[], const int Idx3D[] );
 double Mis_GetTimeStep( const int lv, const double dTime_SyncFaLv, const double AutoReduceDtCoeff );
 double Mis_dTime2dt( const double Time_In, const double dTime_In );
 void   Mis_GetTotalPatchNumber( const int lv );
+void  *Mis_SlabAlloc_New( const SlabType_t Type );
+void   Mis_SlabAlloc_Delete( const SlabType_t Type, void *Ptr );
+void   Mis_SlabAlloc_Free();
 double Mis_Scale2PhySize( const int Scale );
 double Mis_Cell2PhySize( const int NCell, const int lv );
 int    Mis_Scale2Cell( const int Scale, const int lv );
@@ -275,6 +294,10 @@ void Output_DumpData_Part( const OptOutputPart_t Part, const bool BaseOnly, cons
 void Output_DumpData_Total( const char *FileName );
 #ifdef SUPPORT_HDF5
 void Output_DumpData_Total_HDF5( const char *FileName );
+bool Output_DumpData_Async_Reserve( const long NByte );
+void Output_DumpData_Async_Stage( const long Offset, const long NReal, real *Data );
+void Output_DumpData_Async_Launch( const char *FileName );
+void Output_DumpData_Async_Wait();
 #endif
 void Output_DumpManually( int &Dump_global );
 void Output_FlagMap( const int lv, const int xyz, const char *comment );
@@ -342,13 +365,13 @@ void CPU_ExtPotSolver_BaseLevel( const ExtPot_t Func, const double AuxArray_Flt[
                                  const real Table[], void **GenePtr,
                                  const double Time, const bool PotIsInit, const int SaveSg );
 void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg, const double PrepTime );
+void CPU_PoissonSolver_LevelMG( const int lv, const real Poi_Coeff, const int SaveSg, const double PrepTime );
 void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf_SIdx, long *RecvBuf_SIdx,
                  int **List_PID, int **List_k, int *List_NSend_Rho, int *List_NRecv_Rho,
-                 const int *List_z_start, const int local_nz, const int FFT_Size[], const int NRecvSlice,
+                 const int *List_y_start, const int *List_z_start, const int NRank_y, const int FFT_Size[],
                  const double PrepTime );
 void Slab2Patch( const real *RhoK, real *SendBuf, real *RecvBuf, const int SaveSg, const long *List_SIdx,
-                 int **List_PID, int **List_k, int *List_NSend, int *List_NRecv, const int local_nz, const int FFT_Size[],
-                 const int NSendSlice );
+                 int **List_PID, int **List_k, int *List_NSend, int *List_NRecv, const int FFT_Size[] );
 void End_MemFree_PoissonGravity();
 void Gra_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, const double dt,
                     const int SaveSg_Flu, const int SaveSg_Pot, const bool Poisson, const bool Gravity,
@@ -368,6 +391,12 @@ void Gra_Prepare_USG( const int lv, const double PrepTime,
 #endif
 void End_FFTW();
 void Init_FFTW();
+#ifndef SERIAL
+void FFT_Pencil_Init( FFT_Pencil_t *Pencil, const int FFT_Size[], const int PlanFlag );
+void FFT_Pencil_End( FFT_Pencil_t *Pencil );
+void FFT_Pencil_Forward( const FFT_Pencil_t *Pencil, real *Data );
+void FFT_Pencil_Backward( const FFT_Pencil_t *Pencil, real *Data );
+#endif
 void Init_ExtAccPot();
 void End_ExtAccPot();
 void Init_LoadExtPotTable();
@@ -423,12 +452,17 @@ void LB_GetBufferData( const int lv, const int FluSg, const int MagSg, const int
                        const long TVarCC, const long TVarFC, const int ParaBuf );
 real*LB_GetBufferData_MemAllocate_Send( const int NSend );
 real*LB_GetBufferData_MemAllocate_Recv( const int NRecv );
+void LB_GetBufferData_ResetNeighbor( const int lv );
 void LB_GrandsonCheck( const int lv );
-void LB_Init_LoadBalance( const bool Redistribute, const bool SendGridData, const double ParWeight, const bool Reset, const int TLv );
+void LB_Init_LoadBalance( const bool Redistribute, const bool SendGridData, const double ParWeight, const bool Reset,
+                          const bool Diffuse, const int TLv );
 void LB_Init_ByFunction();
 void LB_Init_Refine( const int FaLv, const bool AllocData );
-void LB_SetCutPoint( const int lv, const int NPG_Total, long *CutPoint, const bool InputLBIdx0AndLoad,
-                     long *LBIdx0_AllRank_Input, double *Load_AllRank_Input, const double ParWeight );
+void LB_SetCutPoint( const int lv, const int NPG_Input, long *CutPoint, const bool InputLBIdx0AndLoad,
+                     long *LBIdx0_Input, double *Load_Input, const double ParWeight );
+bool LB_ShiftCutPoint( const int lv, long *CutPoint, const double ParWeight );
+void LB_AddMeasuredCost( const int lv, const int NPG, const int *PID0_List, const double Time );
+void LB_UpdateMeasuredCost();
 void LB_EstimateWorkload_AllPatchGroup( const int lv, const double ParWeight, double *Load_PG );
 double LB_EstimateLoadImbalance();
 void LB_SetCutPoint( const int lv, long *CutPoint, const bool InputLBIdx0AndLoad, long *LBIdx0_AllRank_Input,
@@ -440,6 +474,8 @@ void LB_RecordExchangeRestrictDataPatchID( const int FaLv );
 void LB_RecordOverlapMPIPatchID( const int Lv );
 void LB_Refine( const int FaLv );
 void LB_SiblingSearch( const int lv, const bool SearchAllPID, const int NInput, int *TargetPID0 );
+void LB_PaddedCr1DHash_Build( const int lv, const int NPatch );
+int  LB_PaddedCr1DHash_Find( const int lv, const ulong PaddedCr1D );
 void LB_Index2Corner( const int lv, const long Index, int Corner[], const Check_t Check );
 int  LB_Index2Rank( const int lv, const long LB_Idx, const Check_t Check );
 #endif // #ifdef LOAD_BALANCE
@@ -637,6 +673,7 @@ void Par_PredictPos( const long NPar, const long *ParList, real *ParPosX, real *
                      const double TargetTime );
 void Par_Init_Attribute();
 void Par_AddParticleAfterInit( const long NNewPar, real *NewParAtt[PAR_NATT_TOTAL] );
+void Par_SortByPatch();
 void Par_ScatterParticleData( const long NPar_ThisRank, const long NPar_AllRank, const long AttBitIdx,
                               real *Data_Send[PAR_NATT_TOTAL], real *Data_Recv[PAR_NATT_TOTAL] );
 void Par_MapMesh2Particles( const double EdgeL[3], const double EdgeR[3],
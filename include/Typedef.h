@@ -281,6 +281,16 @@ const OptPotBC_t
 #endif
 
 
+// FFTW planning strategies
+#ifdef GRAVITY
+typedef int OptFFTWStartup_t;
+const OptFFTWStartup_t
+   FFTW_STARTUP_DEFAULT  = -1,
+   FFTW_STARTUP_ESTIMATE =  0,
+   FFTW_STARTUP_MEASURE  =  1;
+#endif
+
+
 // particle schemes
 #ifdef PARTICLE
 typedef int ParInit_t;
@@ -398,6 +408,14 @@ const OptCorrAfterSync_t
    CORR_AFTER_SYNC_BEFORE_DUMP = 2;
 
 
+// OPT__MEMORY_POOL options
+typedef int OptMemoryPool_t;
+const OptMemoryPool_t
+   MEMORY_POOL_NONE     = 0,
+   MEMORY_POOL_TABLE    = 1,
+   MEMORY_POOL_ADAPTIVE = 2;
+
+
 // OPT__DT_LEVEL options
 typedef int OptTimeStepLevel_t;
 const OptTimeStepLevel_t
@@ -453,6 +471,18 @@ const PatchType_t
    PATCH_LEAF_PLUS_MAXNONLEAF = 3;
 
 
+// types of patch data allocated by Mis_SlabAlloc_New()
+typedef int SlabType_t;
+const SlabType_t
+   SLAB_FLUID         = 0,
+   SLAB_MAGNETIC      = 1,
+   SLAB_POT           = 2,
+   SLAB_POT_EXT       = 3,
+   SLAB_FLUX          = 4,
+   SLAB_ELECTRIC_FACE = 5,
+   SLAB_ELECTRIC_EDGE = 6;
+
+
 // function pointers
 typedef real (*EoS_DE2P_t)     ( const real Dens, const real Eint, const real Passive[],
                                  const double AuxArray_Flt[], const int AuxArray_Int[],
@@ -0,0 +1,184 @@
+#include "GAMER.h"
+
+
+
+// recent numbers of active patches at each level, which are used to estimate the peak usage of the memory pool
+static int NPatchHistory[NLEVEL][MEMORY_POOL_NHISTORY];
+static int HistoryIdx = 0;
+
+static double GetPatchMB();
+static void   ResizePool( const int lv, const int NPatchTarget );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_AdjustMemoryPool
+// Description :  Grow or shrink the memory pool of inactive patches at each level adaptively
+//
+// Note        :  1. Invoked by main() every root-level step for OPT__MEMORY_POOL == MEMORY_POOL_ADAPTIVE,
+//                   right after Aux_Record_PatchCount()
+//                   --> Also invoked by Init_ByRestart_HDF5() to preallocate patches from the sizing hints stored
+//                       in the restart file
+//                2. The pool size is determined from the peak number of active (real+buffer) patches at each
+//                   level in this rank during the last MEMORY_POOL_NHISTORY invocations (NPeak)
+//                   --> Hysteresis: the total number of allocated (active+inactive) patches NAlloc is kept within
+//                          [ (1+MEMORY_POOL_HEADROOM)*NPeak, (1+2*MEMORY_POOL_HEADROOM)*NPeak ]
+//                       --> Pool is grown to the lower bound if NAlloc drops below it and shrunk to the lower
+//                           bound if NAlloc exceeds the upper bound
+//                       --> NAlloc is left unchanged otherwise to avoid allocating and deallocating the same
+//                           patches back and forth
+//                3. The memory of inactive patches in this rank is capped by MEMORY_POOL_MAX_MB (if positive)
+//                   --> Inactive patches are released from the finest level first
+//                4. Inactive patches are assumed to be stored contiguously after the active patches
+//                   (i.e., PID = [ amr->num[lv] ... amr->num[lv]+NInactive-1 ])
+//                   --> Guaranteed by pdelete() being applied either to the last active patches or together
+//                       with the patch-pointer reordering in Refine() and LB_Refine_AllocateNewPatch()
+//                5. Only the memory of this rank is adjusted --> no MPI communication
+//
+// Parameter   :  NPatchHint : Target total number of patches (active+inactive) at each level in this rank
+//                             --> NULL : determine the pool size from the recent numbers of active patches
+//                                 Otherwise : preallocate patches accordingly and use them to initialize
+//                                             the history of active patches
+//-------------------------------------------------------------------------------------------------------
+void Aux_AdjustMemoryPool( const int NPatchHint[] )
+{
+
+   const double PatchMB = GetPatchMB();
+   int NPatchTarget[NLEVEL];
+
+
+// 1. determine the target number of patches at each level
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      const int NActive = amr->num[lv];
+      const int NAlloc  = NActive + amr->CountInactive( lv );
+
+//    1-1. preallocate from the sizing hints
+      if ( NPatchHint != NULL )
+      {
+         NPatchTarget[lv] = MAX( NAlloc, NPatchHint[lv] );
+
+         const int NPeak = (int)ceil( NPatchTarget[lv]/(1.0+MEMORY_POOL_HEADROOM) );
+         for (int t=0; t<MEMORY_POOL_NHISTORY; t++)   NPatchHistory[lv][t] = NPeak;
+      }
+
+//    1-2. adjust from the recent numbers of active patches
+      else
+      {
+         NPatchHistory[lv][HistoryIdx] = NActive;
+
+         int NPeak = 0;
+         for (int t=0; t<MEMORY_POOL_NHISTORY; t++)   NPeak = MAX( NPeak, NPatchHistory[lv][t] );
+
+         const int NLower = (int)ceil( (1.0+    MEMORY_POOL_HEADROOM)*NPeak );
+         const int NUpper = (int)ceil( (1.0+2.0*MEMORY_POOL_HEADROOM)*NPeak );
+
+         if ( NAlloc < NLower  ||  NAlloc > NUpper )  NPatchTarget[lv] = NLower;
+         else                                         NPatchTarget[lv] = NAlloc;
+      }
+   } // for (int lv=0; lv<NLEVEL; lv++)
+
+   if ( NPatchHint == NULL )  HistoryIdx = ( HistoryIdx + 1 ) % MEMORY_POOL_NHISTORY;
+
+
+// 2. apply the memory ceiling from the finest level
+   if ( MEMORY_POOL_MAX_MB > 0.0 )
+   {
+      double PoolMB = 0.0;
+      for (int lv=0; lv<NLEVEL; lv++)  PoolMB += ( NPatchTarget[lv] - amr->num[lv] )*PatchMB;
+
+      for (int lv=NLEVEL-1; lv>=0  &&  PoolMB > MEMORY_POOL_MAX_MB; lv--)
+      {
+         const int NExcess = (int)ceil( ( PoolMB - MEMORY_POOL_MAX_MB )/PatchMB );
+         const int NRemove = MIN( NExcess, NPatchTarget[lv]-amr->num[lv] );
+
+         NPatchTarget[lv] -= NRemove;
+         PoolMB           -= NRemove*PatchMB;
+      }
+   }
+
+
+// 3. grow or shrink the memory pool
+   for (int lv=0; lv<NLEVEL; lv++)  ResizePool( lv, NPatchTarget[lv] );
+
+} // FUNCTION : Aux_AdjustMemoryPool
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetPatchMB
+// Description :  Return the estimated memory in MB of one inactive patch in the memory pool
+//
+// Note        :  1. Include both Sg and all data allocated by pnew() in Init_MemoryPool() and ResizePool()
+//                2. Flux and electric field arrays are excluded since they are always deallocated by pdelete()
+//-------------------------------------------------------------------------------------------------------
+double GetPatchMB()
+{
+
+   long NReal = (long)NCOMP_TOTAL*CUBE(PS1);
+#  ifdef MHD
+   NReal += (long)NCOMP_MAG*PS1P1*SQR(PS1);
+#  endif
+#  ifdef GRAVITY
+   NReal += (long)CUBE(PS1);
+#  ifdef STORE_POT_GHOST
+   NReal += (long)CUBE(GRA_NXT);
+#  endif
+#  endif
+
+   return 2.0*( NReal*sizeof(real) + sizeof(patch_t) )/( 1024.0*1024.0 );
+
+} // FUNCTION : GetPatchMB
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  ResizePool
+// Description :  Preallocate or deallocate inactive patches at the target level so that the total number
+//                of allocated patches becomes NPatchTarget
+//
+// Note        :  1. Active patches are never deallocated
+//                2. Preallocated patches have both fluid, magnetic, and pot data allocated as in Init_MemoryPool()
+//
+// Parameter   :  lv           : Target refinement level
+//                NPatchTarget : Target total number of patches (active+inactive)
+//-------------------------------------------------------------------------------------------------------
+void ResizePool( const int lv, const int NPatchTarget )
+{
+
+   const int NActive   = amr->num[lv];
+   const int NInactive = amr->CountInactive( lv );
+   const int NAlloc    = NActive + NInactive;
+
+
+// 1. preallocate patches (with corner arbitrarily set) and then deactivate them (which does not deallocate memory)
+   if ( NAlloc < NPatchTarget )
+   {
+      const bool WithFluData_Yes = true;
+      const bool WithMagData_Yes = true;
+      const bool WithPotData_Yes = true;
+      const bool ReuseMemory_Yes = true;
+
+      for (int PID=NActive; PID<NPatchTarget; PID++)
+         amr->pnew( lv, 0, 0, 0, NULL_INT, WithFluData_Yes, WithMagData_Yes, WithPotData_Yes );
+
+      for (int PID=NPatchTarget-1; PID>=NActive; PID--)
+         amr->pdelete( lv, PID, ReuseMemory_Yes );
+   }
+
+
+// 2. deallocate the inactive patches beyond NPatchTarget
+   else
+   {
+      for (int PID=MAX(NPatchTarget,NActive); PID<NAlloc; PID++)
+      {
+         for (int Sg=0; Sg<2; Sg++)
+         {
+            delete amr->patch[Sg][lv][PID];
+            amr->patch[Sg][lv][PID] = NULL;
+         }
+      }
+   }
+
+} // FUNCTION : ResizePool
@@ -56,9 +56,9 @@ void Aux_Check_Parameter()
    if ( MPI_Init_Status == false )  Aux_Error( ERROR_INFO, "MPI_Init() has not been called !!\n" );
 
    MPI_Query_thread( &MPI_Thread_Status );
-   if ( OPT__OVERLAP_MPI  &&  MPI_Thread_Status == MPI_THREAD_SINGLE )
-      Aux_Error( ERROR_INFO, "\"%s\" is NOT supported since the level of MPI thread support == %s\n",
-                 "OPT__OVERLAP_MPI", "MPI_THREAD_SINGLE" );
+   if ( OPT__OVERLAP_MPI  &&  MPI_Thread_Status < MPI_THREAD_SERIALIZED )
+      Aux_Error( ERROR_INFO, "\"%s\" is NOT supported since the level of MPI thread support < %s\n",
+                 "OPT__OVERLAP_MPI", "MPI_THREAD_SERIALIZED" );
 
    MPI_Comm_size( MPI_COMM_WORLD, &NRank );
 #  endif
@@ -155,15 +155,23 @@ void Aux_Check_Parameter()
                  "OVERLAP_MPI", "OPT__OVERLAP_MPI" );
 #  endif
 
+#  ifdef MHD
    if ( OPT__OVERLAP_MPI )
-      Aux_Error( ERROR_INFO, "\"%s\" is NOT supported yet !!\n", "OPT__OVERLAP_MPI" );
+      Aux_Error( ERROR_INFO, "\"%s\" is NOT supported for MHD yet !!\n", "OPT__OVERLAP_MPI" );
+#  endif
+
+   if ( OPT__OVERLAP_MPI  &&  OPT__TIMING_BARRIER )
+      Aux_Error( ERROR_INFO, "\"%s\" does NOT work with \"%s\" !!\n", "OPT__OVERLAP_MPI", "OPT__TIMING_BARRIER" );
+
+   if ( OPT__CPU_PIPELINE  &&  OPT__TIMING_BARRIER )
+      Aux_Error( ERROR_INFO, "\"%s\" does NOT work with \"%s\" !!\n", "OPT__CPU_PIPELINE", "OPT__TIMING_BARRIER" );
+
+   if (  OPT__CPU_PIPELINE  &&  ( CPU_PIPELINE_NTHREAD < 1 || CPU_PIPELINE_NTHREAD >= OMP_NTHREAD )  )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d (must be >= 1 and < OMP_NTHREAD = %d) !!\n",
+                 "CPU_PIPELINE_NTHREAD", CPU_PIPELINE_NTHREAD, OMP_NTHREAD );
 
    if ( AUTO_REDUCE_DT )
    {
-      if ( OPT__OVERLAP_MPI )
-         Aux_Error( ERROR_INFO, "currently \"%s\" does not work with \"%s\" !!\n",
-                    "AUTO_REDUCE_DT", "OPT__OVERLAP_MPI" );
-
       if ( OPT__DT_LEVEL != DT_LEVEL_FLEXIBLE )
          Aux_Error( ERROR_INFO, "\"%s\" must work with \"%s\" !!\n",
                     "AUTO_REDUCE_DT", "OPT__DT_LEVEL == DT_LEVEL_FLEXIBLE" );
@@ -199,7 +207,7 @@ void Aux_Check_Parameter()
    if ( INT_MONO_COEFF < 1.0  ||  INT_MONO_COEFF > 4.0 )
       Aux_Error( ERROR_INFO, "INT_MONO_COEFF (%14.7e) is not within the correct range [1.0, 4.0] !!\n", INT_MONO_COEFF );
 
-   if ( OPT__MEMORY_POOL  &&  !OPT__REUSE_MEMORY )
+   if ( OPT__MEMORY_POOL != MEMORY_POOL_NONE  &&  !OPT__REUSE_MEMORY )
       Aux_Error( ERROR_INFO, "please turn on OPT__REUSE_MEMORY for OPT__MEMORY_POOL !!\n" );
 
    if ( OPT__CORR_AFTER_ALL_SYNC != CORR_AFTER_SYNC_NONE  &&  OPT__CORR_AFTER_ALL_SYNC != CORR_AFTER_SYNC_EVERY_STEP  &&
@@ -374,6 +382,24 @@ void Aux_Check_Parameter()
 #     endif
    } // if ( OPT__OVERLAP_MPI )
 
+#  ifdef OPENMP
+   if ( OPT__CPU_PIPELINE )
+   {
+      omp_set_nested( true );
+
+      if ( !omp_get_nested() )
+         Aux_Message( stderr, "WARNING : OpenMP nested parallelism is NOT supported for \"%s\" !!\n",
+                      "OPT__CPU_PIPELINE" );
+
+      omp_set_nested( false );
+   }
+#  endif
+
+   if ( OPT__PREP_CACHE  &&  !AUTO_REDUCE_DT )
+      Aux_Message( stderr, "WARNING : \"%s\" only reuses data prepared with identical parameters "
+                           "(e.g., for \"%s\" and derived fields in outputs) !!\n",
+                   "OPT__PREP_CACHE", "AUTO_REDUCE_DT" );
+
    if ( OPT__TIMING_BARRIER )
       Aux_Message( stderr, "WARNING : \"%s\" may deteriorate performance (especially if %s is on) ...\n",
                    "OPT__TIMING_BARRIER", "OPT__OVERLAP_MPI" );
@@ -1167,6 +1193,9 @@ void Aux_Check_Parameter()
    if ( MG_NPRE_SMOOTH < 0 )           Aux_Error( ERROR_INFO, "MG_NPRE_SMOOTH (%d) < 0 !!\n", MG_NPRE_SMOOTH );
    if ( MG_NPOST_SMOOTH < 0 )          Aux_Error( ERROR_INFO, "MG_NPOST_SMOOTH (%d) < 0 !!\n", MG_NPOST_SMOOTH );
    if ( MG_TOLERATED_ERROR < 0.0 )     Aux_Error( ERROR_INFO, "MG_TOLERATED_ERROR (%14.7e) < 0.0 !!\n", MG_TOLERATED_ERROR );
+#  else
+   if ( OPT__POI_LEVEL_MG )
+      Aux_Error( ERROR_INFO, "\"%s\" only works with \"%s\" !!\n", "OPT__POI_LEVEL_MG", "POT_SCHEME == MG" );
 #  endif
 
    if ( POT_GPU_NPGROUP % GPU_NSTREAM != 0 )
@@ -1210,6 +1239,21 @@ void Aux_Check_Parameter()
    if ( !OPT__SELF_GRAVITY  &&  !OPT__EXT_ACC  &&  !OPT__EXT_POT )
       Aux_Message( stderr, "WARNING : all gravity options are disabled (OPT__SELF_GRAVITY, OPT__EXT_ACC, OPT__EXT_POT) !!\n" );
 
+   if ( OPT__POI_LEVEL_MG  &&  OPT__OVERLAP_MPI )
+      Aux_Message( stderr, "WARNING : \"%s\" is disabled for the gravity solver when \"%s\" is on !!\n",
+                   "OPT__OVERLAP_MPI", "OPT__POI_LEVEL_MG" );
+
+#  ifdef BITWISE_REPRODUCIBILITY
+   if ( OPT__FFTW_STARTUP == FFTW_STARTUP_MEASURE )
+      Aux_Message( stderr, "WARNING : OPT__FFTW_STARTUP = %d (MEASURE) may break BITWISE_REPRODUCIBILITY between runs !!\n",
+                   OPT__FFTW_STARTUP );
+#  endif
+
+#  if ( defined OPENMP  &&  !defined SERIAL )
+   if ( OMP_NTHREAD > 1  &&  !OPT__FFT_PENCIL )
+      Aux_Message( stderr, "WARNING : the base-level FFT is only multithreaded when OPT__FFT_PENCIL is on !!\n" );
+#  endif
+
    } // if ( MPI_Rank == 0 )
 
 
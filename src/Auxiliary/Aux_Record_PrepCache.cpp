@@ -0,0 +1,91 @@
+#include "GAMER.h"
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Aux_Record_PrepCache
+// Description :  Record the number of patch groups found (hit) and not found (miss) in the cache of
+//                Prepare_PatchData() for the option "OPT__PREP_CACHE"
+//
+// Note        :  1. Counters are accumulated in PrepCache_Get() and reset after each record
+//                2. Memory is the sum over all ranks of the data currently stored in the cache
+//-------------------------------------------------------------------------------------------------------
+void Aux_Record_PrepCache()
+{
+
+   const char FileName[] = "Record__PrepCache";
+   static bool FirstTime = true;
+
+   long   NHitAllRank[NLEVEL], NMissAllRank[NLEVEL];
+   double MemMB_ThisRank = PrepCache_GetMemoryMB(), MemMB_AllRank;
+   FILE  *File = NULL;
+
+
+// collect data from all ranks
+   MPI_Reduce( PrepCache_NHit,  NHitAllRank,  NLEVEL, MPI_LONG,   MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( PrepCache_NMiss, NMissAllRank, NLEVEL, MPI_LONG,   MPI_SUM, 0, MPI_COMM_WORLD );
+   MPI_Reduce( &MemMB_ThisRank, &MemMB_AllRank, 1,    MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+
+
+// only rank 0 needs to take a note
+   if ( MPI_Rank == 0 )
+   {
+//    header
+      if ( FirstTime )
+      {
+         if ( Aux_CheckFileExist(FileName) )
+            Aux_Message( stderr, "WARNING : file \"%s\" already exists !!\n", FileName );
+
+         FirstTime = false;
+
+         File = fopen( FileName, "a" );
+
+         fprintf( File, "#%13s %9s %10s %8s", "Time", "Step", "MemMB", "Hit(%)" );
+         for (int lv=0; lv<NLEVEL; lv++)  fprintf( File, "%24s %2d ", "Level", lv );
+
+         fprintf( File, "\n" );
+
+         fclose( File );
+      }
+
+
+//    count the total number of hits and misses
+      long   NHitAllLv=0, NMissAllLv=0;
+      double Frac;
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         NHitAllLv  += NHitAllRank [lv];
+         NMissAllLv += NMissAllRank[lv];
+      }
+
+      Frac = ( NHitAllLv+NMissAllLv == 0 ) ? 0.0 : 100.0*NHitAllLv/( NHitAllLv+NMissAllLv );
+
+      File = fopen( FileName, "a" );
+
+      fprintf( File, "%14.7e %9ld %10.3e %8.2f", Time[0], Step, MemMB_AllRank, Frac );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         if ( NHitAllRank[lv]+NMissAllRank[lv] == 0 )    Frac = 0.0;
+         else  Frac = 100.0*NHitAllRank[lv]/( NHitAllRank[lv]+NMissAllRank[lv] );
+
+         fprintf( File, " %8ld/%8ld(%6.2f%%)", NHitAllRank[lv], NMissAllRank[lv], Frac );
+      }
+
+      fprintf( File, "\n" );
+
+      fclose( File );
+
+   } // if ( MPI_Rank == 0 )
+
+
+// reset the counters
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      PrepCache_NHit [lv] = 0;
+      PrepCache_NMiss[lv] = 0;
+   }
+
+} // FUNCTION : Aux_Record_PrepCache
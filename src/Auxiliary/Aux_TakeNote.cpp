@@ -535,7 +535,6 @@ void Aux_TakeNote()
       fprintf( Note, "#define NCOMP_ELE               %d\n",      NCOMP_ELE             );
 #     endif
       fprintf( Note, "#define PATCH_SIZE              %d\n",      PATCH_SIZE            );
-      fprintf( Note, "#define MAX_PATCH               %d\n",      MAX_PATCH             );
       fprintf( Note, "#define NLEVEL                  %d\n",      NLEVEL                );
       fprintf( Note, "\n" );
       fprintf( Note, "#define FLU_GHOST_SIZE          %d\n",      FLU_GHOST_SIZE        );
@@ -736,6 +735,8 @@ void Aux_TakeNote()
       fprintf( Note, "Par->IntegTracer                %d\n",      amr->Par->IntegTracer         );
       fprintf( Note, "Par->GhostSizeTracer            %d\n",      amr->Par->GhostSizeTracer     );
       fprintf( Note, "Par->TracerVelCorr              %d\n",      amr->Par->TracerVelCorr       );
+      fprintf( Note, "Par->FixedPointDepo             %d\n",      amr->Par->FixedPointDepo      );
+      fprintf( Note, "Par->SortInterval               %d\n",      amr->Par->SortInterval        );
       fprintf( Note, "OPT__FREEZE_PAR                 %d\n",      OPT__FREEZE_PAR               );
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "\n\n");
@@ -778,6 +779,9 @@ void Aux_TakeNote()
       fprintf( Note, "DT__SYNC_CHILDREN_LV            %13.7e\n",  DT__SYNC_CHILDREN_LV      );
       fprintf( Note, "OPT__DT_USER                    %d\n",      OPT__DT_USER              );
       fprintf( Note, "OPT__DT_LEVEL                   %d\n",      OPT__DT_LEVEL             );
+#     if ( MODEL == HYDRO )
+      fprintf( Note, "OPT__DT_FLU_FUSED               %d\n",      OPT__DT_FLU_FUSED         );
+#     endif
       fprintf( Note, "AUTO_REDUCE_DT                  %d\n",      AUTO_REDUCE_DT            );
       fprintf( Note, "AUTO_REDUCE_DT_FACTOR           %13.7e\n",  AUTO_REDUCE_DT_FACTOR     );
       fprintf( Note, "AUTO_REDUCE_DT_FACTOR_MIN       %13.7e\n",  AUTO_REDUCE_DT_FACTOR_MIN );
@@ -834,6 +838,9 @@ void Aux_TakeNote()
 #     endif
       fprintf( Note, "OPT__REUSE_MEMORY               %d\n",      OPT__REUSE_MEMORY         );
       fprintf( Note, "OPT__MEMORY_POOL                %d\n",      OPT__MEMORY_POOL          );
+      fprintf( Note, "MEMORY_POOL_HEADROOM            %20.14e\n", MEMORY_POOL_HEADROOM      );
+      fprintf( Note, "MEMORY_POOL_MAX_MB              %20.14e\n", MEMORY_POOL_MAX_MB        );
+      fprintf( Note, "OPT__SLAB_ALLOC                 %d\n",      OPT__SLAB_ALLOC           );
       fprintf( Note, "***********************************************************************************\n" );
       fprintf( Note, "\n\n");
 
@@ -853,6 +860,11 @@ void Aux_TakeNote()
       fprintf( Note, "LB_PAR_WEIGHT                   %13.7e\n",  amr->LB->Par_Weight       );
 #     endif
       fprintf( Note, "OPT__RECORD_LOAD_BALANCE        %d\n",      OPT__RECORD_LOAD_BALANCE  );
+      fprintf( Note, "OPT__LB_DIFFUSE                 %d\n",      OPT__LB_DIFFUSE           );
+      fprintf( Note, "OPT__LB_MEASURE_COST            %d\n",      OPT__LB_MEASURE_COST      );
+      if ( OPT__LB_MEASURE_COST )
+      fprintf( Note, "LB_MEASURE_COST_WEIGHT          %13.7e\n",  LB_MEASURE_COST_WEIGHT    );
+      fprintf( Note, "OPT__LB_NEIGHBOR_MPI            %d\n",      OPT__LB_NEIGHBOR_MPI      );
 #     endif // #ifdef LOAD_BALANCE
       fprintf( Note, "OPT__MINIMIZE_MPI_BARRIER       %d\n",      OPT__MINIMIZE_MPI_BARRIER );
       fprintf( Note, "***********************************************************************************\n" );
@@ -1015,6 +1027,10 @@ void Aux_TakeNote()
 #     endif
 
       fprintf( Note, "OPT__OVERLAP_MPI                %d\n",      OPT__OVERLAP_MPI         );
+      fprintf( Note, "OPT__CPU_PIPELINE               %d\n",      OPT__CPU_PIPELINE        );
+      fprintf( Note, "CPU_PIPELINE_NTHREAD            %d\n",      CPU_PIPELINE_NTHREAD     );
+      fprintf( Note, "OPT__PREP_CACHE                 %d\n",      OPT__PREP_CACHE          );
+      fprintf( Note, "PREP_CACHE_MAX_MB               %20.14e\n", PREP_CACHE_MAX_MB        );
       fprintf( Note, "OPT__RESET_FLUID                %d\n",      OPT__RESET_FLUID         );
       fprintf( Note, "OPT__FREEZE_FLUID               %d\n",      OPT__FREEZE_FLUID        );
 #     if ( MODEL == HYDRO  ||  MODEL == ELBDM )
@@ -1071,10 +1087,14 @@ void Aux_TakeNote()
       fprintf( Note, "MG_NPRE_SMOOTH                  %d\n",      MG_NPRE_SMOOTH          );
       fprintf( Note, "MG_NPOST_SMOOTH                 %d\n",      MG_NPOST_SMOOTH         );
       fprintf( Note, "MG_TOLERATED_ERROR              %13.7e\n",  MG_TOLERATED_ERROR      );
+      fprintf( Note, "OPT__POI_LEVEL_MG               %d\n",      OPT__POI_LEVEL_MG       );
 #     endif
       fprintf( Note, "POT_GPU_NPGROUP                 %d\n",      POT_GPU_NPGROUP         );
       fprintf( Note, "OPT__GRA_P5_GRADIENT            %d\n",      OPT__GRA_P5_GRADIENT    );
       fprintf( Note, "OPT__SELF_GRAVITY               %d\n",      OPT__SELF_GRAVITY       );
+      fprintf( Note, "OPT__FFT_PENCIL                 %d\n",      OPT__FFT_PENCIL         );
+      fprintf( Note, "OPT__FFTW_STARTUP               %d\n",      OPT__FFTW_STARTUP       );
+      fprintf( Note, "OPT__FFTW_WISDOM                %d\n",      OPT__FFTW_WISDOM        );
       fprintf( Note, "OPT__EXT_ACC                    %d\n",      OPT__EXT_ACC            );
       fprintf( Note, "OPT__EXT_POT                    %d\n",      OPT__EXT_POT            );
       if ( OPT__EXT_POT == EXT_POT_TABLE ) {
@@ -1276,6 +1296,9 @@ void Aux_TakeNote()
 
       fprintf( Note, "OPT__OUTPUT_MODE                %d\n",      OPT__OUTPUT_MODE       );
       fprintf( Note, "OPT__OUTPUT_RESTART             %d\n",      OPT__OUTPUT_RESTART    );
+      fprintf( Note, "OPT__OUTPUT_HDF5_MPIIO          %d\n",      OPT__OUTPUT_HDF5_MPIIO );
+      fprintf( Note, "OPT__OUTPUT_ASYNC               %d\n",      OPT__OUTPUT_ASYNC      );
+      fprintf( Note, "OUTPUT_ASYNC_MAX_MB             %20.14e\n", OUTPUT_ASYNC_MAX_MB    );
       fprintf( Note, "OUTPUT_STEP                     %d\n",      OUTPUT_STEP            );
       fprintf( Note, "OUTPUT_DT                       %20.14e\n", OUTPUT_DT              );
       fprintf( Note, "OUTPUT_PART_X                   %20.14e\n", OUTPUT_PART_X          );
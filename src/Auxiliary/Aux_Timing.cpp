@@ -6,6 +6,12 @@ void Timing__EvolveLevel( const char FileName[], const double Time_LB_Main[][3]
 #ifdef TIMING_SOLVER
 void Timing__Solver( const char FileName[] );
 #endif
+#ifdef LOAD_BALANCE
+void Timing__OverlapMPI( const char FileName[] );
+#endif
+#ifdef OPENMP
+void Timing__CPUPipeline( const char FileName[] );
+#endif
 
 
 // global timing variables
@@ -28,6 +34,8 @@ extern Timer_t *Timer_Par_2Sib   [NLEVEL];
 extern Timer_t *Timer_Par_2Son   [NLEVEL];
 extern Timer_t *Timer_Par_Collect[NLEVEL];
 extern Timer_t *Timer_Par_MPI    [NLEVEL][6];
+extern Timer_t *Timer_OverlapMPI [NLEVEL][3];
+extern Timer_t *Timer_Pipeline   [NLEVEL][3];
 
 #ifdef TIMING_SOLVER
 extern Timer_t *Timer_Pre         [NLEVEL][NSOLVER];
@@ -95,6 +103,8 @@ void Aux_CreateTimer()
       Timer_Par_2Son   [lv] = new Timer_t;
       Timer_Par_Collect[lv] = new Timer_t;
       for (int t=0; t<6; t++)    Timer_Par_MPI   [lv][t] = new Timer_t;
+      for (int t=0; t<3; t++)    Timer_OverlapMPI[lv][t] = new Timer_t;
+      for (int t=0; t<3; t++)    Timer_Pipeline  [lv][t] = new Timer_t;
 
 #     ifdef TIMING_SOLVER
       for (int v=0; v<NSOLVER; v++)
@@ -147,6 +157,8 @@ void Aux_DeleteTimer()
       delete Timer_Par_2Son   [lv];
       delete Timer_Par_Collect[lv];
       for (int t=0; t<6; t++)    delete Timer_Par_MPI   [lv][t];
+      for (int t=0; t<3; t++)    delete Timer_OverlapMPI[lv][t];
+      for (int t=0; t<3; t++)    delete Timer_Pipeline  [lv][t];
 
 #     ifdef TIMING_SOLVER
       for (int v=0; v<NSOLVER; v++)
@@ -193,6 +205,8 @@ void Aux_ResetTimer()
       Timer_Par_2Son   [lv]->Reset();
       Timer_Par_Collect[lv]->Reset();
       for (int t=0; t<6; t++)    Timer_Par_MPI   [lv][t]->Reset();
+      for (int t=0; t<3; t++)    Timer_OverlapMPI[lv][t]->Reset();
+      for (int t=0; t<3; t++)    Timer_Pipeline  [lv][t]->Reset();
 
 #     ifdef TIMING_SOLVER
       for (int v=0; v<NSOLVER; v++)
@@ -364,6 +378,18 @@ void Aux_Record_Timing()
 #  endif
 
 
+// 4. overlapping MPI communication with computation
+#  ifdef LOAD_BALANCE
+   if ( OPT__OVERLAP_MPI )    Timing__OverlapMPI( FileName );
+#  endif
+
+
+// 5. pipelining the CPU solvers
+#  ifdef OPENMP
+   if ( OPT__CPU_PIPELINE )   Timing__CPUPipeline( FileName );
+#  endif
+
+
    if ( MPI_Rank == 0 )
    {
       FILE *File = fopen( FileName, "a" );
@@ -953,6 +979,136 @@ void Timing__Solver( const char FileName[] )
 
 
 
+#ifdef LOAD_BALANCE
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Timing__OverlapMPI
+// Description :  Record the timing results (in second) for the option "OPT__OVERLAP_MPI"
+//
+// Note        :  1. Overlap : elapsed time of the code sections overlapping MPI communication with computation
+//                   MPI     : elapsed time of MPI communication in these sections (included in Buf_*)
+//                   Compute : elapsed time of computation in these sections (included in Flu_Adv and Gra_Adv)
+//                   Hidden  : MPI + Compute - Overlap, which is the MPI time hidden behind computation
+//                2. Record the values averaged over all ranks
+//-------------------------------------------------------------------------------------------------------
+void Timing__OverlapMPI( const char FileName[] )
+{
+
+   double Time_loc[NLEVEL][4], Time_ave[NLEVEL][4];
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      for (int t=0; t<3; t++)    Time_loc[lv][t] = Timer_OverlapMPI[lv][t]->GetValue();
+
+      Time_loc[lv][3] = MAX( Time_loc[lv][1] + Time_loc[lv][2] - Time_loc[lv][0], 0.0 );
+   }
+
+   MPI_Reduce( Time_loc[0], Time_ave[0], NLEVEL*4, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+
+
+   if ( MPI_Rank == 0 )
+   {
+      FILE *File = fopen( FileName, "a" );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      for (int t=0; t<4; t++)    Time_ave[lv][t] /= MPI_NRank;
+
+      fprintf( File, "\nMPI/computation overlap (averaged over all ranks)\n" );
+      fprintf( File, "---------------------------------------------------------------------------------------" );
+      fprintf( File, "---------------------------------------\n" );
+      fprintf( File, "%3s%10s%10s%10s%10s%10s\n", "Lv", "Overlap", "MPI", "Compute", "Hidden", "Hidden%" );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         fprintf( File, "%3d%10.4f%10.4f%10.4f%10.4f%9.3f%%\n",
+                  lv, Time_ave[lv][0], Time_ave[lv][1], Time_ave[lv][2], Time_ave[lv][3],
+                  100.0*Time_ave[lv][3]/( (Time_ave[lv][1]==0.0) ? 1.0 : Time_ave[lv][1] ) );
+      }
+
+//    sum over all levels
+      for (int lv=1; lv<NLEVEL; lv++)
+      for (int t=0; t<4; t++)    Time_ave[0][t] += Time_ave[lv][t];
+
+      fprintf( File, "%3s%10.4f%10.4f%10.4f%10.4f%9.3f%%\n",
+               "Sum", Time_ave[0][0], Time_ave[0][1], Time_ave[0][2], Time_ave[0][3],
+               100.0*Time_ave[0][3]/( (Time_ave[0][1]==0.0) ? 1.0 : Time_ave[0][1] ) );
+      fprintf( File, "\n" );
+
+      fclose( File );
+   } // if ( MPI_Rank == 0 )
+
+} // FUNCTION : Timing__OverlapMPI
+#endif // #ifdef LOAD_BALANCE
+
+
+
+#ifdef OPENMP
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Timing__CPUPipeline
+// Description :  Record the timing results (in second) for the option "OPT__CPU_PIPELINE"
+//
+// Note        :  1. Pipeline : elapsed time of the pipelined CPU solvers (included in dt, Flu_Adv, Gra_Adv, and Src_Adv)
+//                   Solver   : elapsed time of the solver team
+//                   Pre+Clo  : elapsed time of the preparation/closing team
+//                   Sol%     : Solver/Pipeline, which is the utilisation of the solver team
+//                   Pre+Clo% : Pre+Clo/Pipeline, which is the utilisation of the preparation/closing team
+//                   Hidden   : Solver + Pre+Clo - Pipeline, which is the time saved by pipelining
+//                2. Record the values averaged over all ranks
+//-------------------------------------------------------------------------------------------------------
+void Timing__CPUPipeline( const char FileName[] )
+{
+
+   double Time_loc[NLEVEL][4], Time_ave[NLEVEL][4];
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      for (int t=0; t<3; t++)    Time_loc[lv][t] = Timer_Pipeline[lv][t]->GetValue();
+
+      Time_loc[lv][3] = MAX( Time_loc[lv][1] + Time_loc[lv][2] - Time_loc[lv][0], 0.0 );
+   }
+
+   MPI_Reduce( Time_loc[0], Time_ave[0], NLEVEL*4, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+
+
+   if ( MPI_Rank == 0 )
+   {
+      FILE *File = fopen( FileName, "a" );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      for (int t=0; t<4; t++)    Time_ave[lv][t] /= MPI_NRank;
+
+      fprintf( File, "\nCPU solver pipeline (averaged over all ranks)\n" );
+      fprintf( File, "---------------------------------------------------------------------------------------" );
+      fprintf( File, "---------------------------------------\n" );
+      fprintf( File, "%3s%10s%10s%10s%10s%10s%10s\n", "Lv", "Pipeline", "Solver", "Pre+Clo", "Hidden", "Sol%", "Pre+Clo%" );
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         const double Norm = ( Time_ave[lv][0] == 0.0 ) ? 1.0 : Time_ave[lv][0];
+
+         fprintf( File, "%3d%10.4f%10.4f%10.4f%10.4f%9.3f%%%9.3f%%\n",
+                  lv, Time_ave[lv][0], Time_ave[lv][1], Time_ave[lv][2], Time_ave[lv][3],
+                  100.0*Time_ave[lv][1]/Norm, 100.0*Time_ave[lv][2]/Norm );
+      }
+
+//    sum over all levels
+      for (int lv=1; lv<NLEVEL; lv++)
+      for (int t=0; t<4; t++)    Time_ave[0][t] += Time_ave[lv][t];
+
+      const double Norm = ( Time_ave[0][0] == 0.0 ) ? 1.0 : Time_ave[0][0];
+
+      fprintf( File, "%3s%10.4f%10.4f%10.4f%10.4f%9.3f%%%9.3f%%\n",
+               "Sum", Time_ave[0][0], Time_ave[0][1], Time_ave[0][2], Time_ave[0][3],
+               100.0*Time_ave[0][1]/Norm, 100.0*Time_ave[0][2]/Norm );
+      fprintf( File, "\n" );
+
+      fclose( File );
+   } // if ( MPI_Rank == 0 )
+
+} // FUNCTION : Timing__CPUPipeline
+#endif // #ifdef OPENMP
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Aux_AccumulatedTiming
 // Description :  Record the accumulated timing results (in second)
@@ -66,6 +66,15 @@ void Buf_GetBufferData( const int lv, const int FluSg, const int MagSg, const in
 #  endif
 
 
+// the data of buffer patches at lv are about to change --> clear the data cached by Prepare_PatchData()
+// --> fluxes and electric field are not used by Prepare_PatchData()
+#  ifdef MHD
+   if ( GetBufMode != COARSE_FINE_FLUX  &&  GetBufMode != COARSE_FINE_ELECTRIC )    PrepCache_Invalidate( lv );
+#  else
+   if ( GetBufMode != COARSE_FINE_FLUX )                                            PrepCache_Invalidate( lv );
+#  endif
+
+
 // check
    if ( lv < 0  ||  lv >= NLEVEL )
       Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "lv", lv );
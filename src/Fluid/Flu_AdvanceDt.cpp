@@ -4,6 +4,10 @@
 // status of the fluid solver used by AUTO_REDUCE_DT
 int FluStatus_ThisRank;
 
+// maximum CFL speed of the fluid data updated at each level used by OPT__DT_FLU_FUSED
+real Flu_FusedMaxCFL_ThisRank[NLEVEL];
+bool Flu_FusedMaxCFL_Valid   [NLEVEL];
+
 
 // defined in Flu_ManageFixUpTempArray.cpp
 void Flu_SwapFixUpTempArray( const int lv );
@@ -19,6 +23,11 @@ void Flu_InitFixUpTempArray( const int lv );
 // Note        :  1. Invoke InvokeSolver()
 //                2. Currently the updated data can only be stored in the different sandglass from the
 //                   input data
+//                3. For OverlapMPI, this function must be invoked twice, first with Overlap_Sync=true and then with
+//                   Overlap_Sync=false, followed by Flu_AdvanceDt_Finalize()
+//                   --> The first call initializes the fix-up arrays and the second call invokes no MPI function
+//                       so that it can run concurrently with the MPI communication of the patches already advanced
+//                   --> Both calls return GAMER_SUCCESS and Flu_AdvanceDt_Finalize() returns the actual status
 //
 // Parameter   :  lv           : Target refinement level
 //                TimeNew      : Target physical time to reach
@@ -34,34 +43,70 @@ void Flu_InitFixUpTempArray( const int lv );
 //
 // Return      : GAMER_SUCCESS / GAMER_FAILED
 //               --> Mainly used for the option "AUTO_REDUCE_DT"
+//               --> Always return GAMER_SUCCESS for OverlapMPI (see Note 3 above)
 //-------------------------------------------------------------------------------------------------------
 int Flu_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, const double dt,
                    const int SaveSg_Flu, const int SaveSg_Mag, const bool OverlapMPI, const bool Overlap_Sync )
 {
 
-// initialize flux_tmp[] (and electric_tmp[] in MHD) on the parent level for AUTO_REDUCE_DT
-   if ( AUTO_REDUCE_DT  &&  lv != 0 )  Flu_InitFixUpTempArray( lv-1 );
+// initialization
+// --> skip it when advancing the patches that can be overlapped with MPI communication since it has been done
+//     when advancing the patches that cannot be overlapped
+   if ( !OverlapMPI  ||  Overlap_Sync )
+   {
+//    initialize flux_tmp[] (and electric_tmp[] in MHD) on the parent level for AUTO_REDUCE_DT
+      if ( AUTO_REDUCE_DT  &&  lv != 0 )  Flu_InitFixUpTempArray( lv-1 );
 
 
-// initialize patch->ele_corrected[] for correcting the coarse-grid electric field
-#  ifdef MHD
-   if ( OPT__FIXUP_ELECTRIC  &&  lv != 0 )
-   {
-      const int FaLv = lv - 1;
+//    initialize patch->ele_corrected[] for correcting the coarse-grid electric field
+#     ifdef MHD
+      if ( OPT__FIXUP_ELECTRIC  &&  lv != 0 )
+      {
+         const int FaLv = lv - 1;
 
-      for (int FaPID=0; FaPID<amr->NPatchComma[FaLv][19]; FaPID++)
-      for (int e=0; e<12; e++)
-         amr->patch[0][FaLv][FaPID]->ele_corrected[e] = false;
-   }
-#  endif
+         for (int FaPID=0; FaPID<amr->NPatchComma[FaLv][19]; FaPID++)
+         for (int e=0; e<12; e++)
+            amr->patch[0][FaLv][FaPID]->ele_corrected[e] = false;
+      }
+#     endif
 
 
-// invoke the fluid solver
-   FluStatus_ThisRank = GAMER_SUCCESS;
+      FluStatus_ThisRank = GAMER_SUCCESS;
+
+
+//    reset the maximum CFL speed accumulated by Flu_Close() for OPT__DT_FLU_FUSED
+      Flu_FusedMaxCFL_ThisRank[lv] = (real)0.0;
+      Flu_FusedMaxCFL_Valid   [lv] = false;
+   } // if ( !OverlapMPI  ||  Overlap_Sync )
+
 
+// invoke the fluid solver
    InvokeSolver( FLUID_SOLVER, lv, TimeNew, TimeOld, dt, NULL_REAL, SaveSg_Flu, SaveSg_Mag, NULL_INT, OverlapMPI, Overlap_Sync );
 
 
+// collect the fluid solver status later in Flu_AdvanceDt_Finalize() for OverlapMPI
+   if ( OverlapMPI )    return GAMER_SUCCESS;
+   else                 return Flu_AdvanceDt_Finalize( lv );
+
+} // FUNCTION : Flu_AdvanceDt
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Flu_AdvanceDt_Finalize
+// Description :  Collect the fluid solver status from all ranks and finalize the fix-up arrays
+//
+// Note        :  1. Invoked by Flu_AdvanceDt() and EvolveLevel()
+//                2. Must be invoked by all ranks after all patches at lv have been advanced
+//                   --> EvolveLevel() invokes it directly for OPT__OVERLAP_MPI
+//
+// Parameter   :  lv : Target refinement level
+//
+// Return      : GAMER_SUCCESS / GAMER_FAILED
+//-------------------------------------------------------------------------------------------------------
+int Flu_AdvanceDt_Finalize( const int lv )
+{
+
 // collect the fluid solver status from all ranks (only necessary for AUTO_REDUCE_DT)
    int FluStatus_AllRank;
 
@@ -85,9 +130,36 @@ int Flu_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, con
 
 //    swap the flux (and electric in MHD) pointers on the parent level if the fluid solver works successfully
       if ( AUTO_REDUCE_DT  &&  lv != 0 )  Flu_SwapFixUpTempArray( lv-1 );
+
+//    the maximum CFL speed accumulated by Flu_Close() can now be used by dt_InvokeSolver()
+#     if ( MODEL == HYDRO )
+      if ( OPT__DT_FLU_FUSED )   Flu_FusedMaxCFL_Valid[lv] = true;
+#     endif
    }
 
 
    return FluStatus_AllRank;
 
-} // FUNCTION : Flu_AdvanceDt
+} // FUNCTION : Flu_AdvanceDt_Finalize
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Flu_FusedMaxCFL_Invalidate
+// Description :  Discard the maximum CFL speed accumulated by Flu_Close() at levels >= lv
+//
+// Note        :  1. Used by OPT__DT_FLU_FUSED
+//                2. Must be invoked whenever the patches at level lv are created, removed, or redistributed
+//                   (e.g., Refine() and LB_Init_LoadBalance())
+//                   --> dt_InvokeSolver() will then invoke the dt solver at these levels until the next call
+//                       to Flu_AdvanceDt()
+//
+// Parameter   :  lv : Minimum target refinement level
+//                     --> Do nothing if lv > TOP_LEVEL
+//-------------------------------------------------------------------------------------------------------
+void Flu_FusedMaxCFL_Invalidate( const int lv )
+{
+
+   for (int TLv=lv; TLv<NLEVEL; TLv++)    Flu_FusedMaxCFL_Valid[TLv] = false;
+
+} // FUNCTION : Flu_FusedMaxCFL_Invalidate
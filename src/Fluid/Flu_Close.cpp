@@ -8,6 +8,9 @@ extern int FluStatus_ThisRank;
 // whether or not to continue applying AUTO_REDUCE_DT (decalred in Flu_AdvanceDt.cpp)
 extern bool AutoReduceDt_Continue;
 
+// maximum CFL speed used by OPT__DT_FLU_FUSED (declared in Flu_AdvanceDt.cpp)
+extern real Flu_FusedMaxCFL_ThisRank[NLEVEL];
+
 
 static void StoreFlux( const int lv, const real Flux_Array[][9][NFLUX_TOTAL][ SQR(PS2) ],
                        const int NPG, const int *PID0_List, const real dt );
@@ -23,6 +26,8 @@ static void CorrectUnphysical( const int lv, const int NPG, const int *PID0_List
                                const real h_Mag_Array_F_In[][NCOMP_MAG][ FLU_NXT_P1*SQR(FLU_NXT) ],
                                const real h_Mag_Array_F_Out[][NCOMP_MAG][ PS2P1*SQR(PS2) ],
                                const real dt );
+static real GetMaxCFL( const real h_Flu_Array_F_Out[][ CUBE(PS2) ],
+                      const real h_Mag_Array_F_Out[][ PS2P1*SQR(PS2) ] );
 #ifdef MHD
 void StoreElectric( const int lv, const real h_Ele_Array[][9][NCOMP_ELE][ PS2P1*PS2 ],
                     const int NPG, const int *PID0_List, const real dt );
@@ -59,6 +64,8 @@ extern void Hydro_RiemannSolver_HLLD( const int XYZ, real Flux_Out[], const real
 //                2. Correct the fluxes across the coarse-fine boundaries at level "lv-1"
 //                3. Copy the data from the "h_Flu_Array_F_Out" and "h_DE_Array_F_Out" arrays to the "amr->patch" pointers
 //                4. Get the minimum time-step information of the fluid solver
+//                   --> Accumulate the maximum CFL speed of the updated data at lv in Flu_FusedMaxCFL_ThisRank[lv]
+//                       for OPT__DT_FLU_FUSED
 //
 // Parameter   :  lv                : Target refinement level
 //                SaveSg_Flu        : Sandglass to store the updated fluid data
@@ -123,11 +130,25 @@ void Flu_Close( const int lv, const int SaveSg_Flu, const int SaveSg_Mag,
 #     error : ERROR : FLU_NOUT != NCOMP_TOTAL (one must specify how to copy data from h_Flu_Array_F_Out to fluid) !!
 #  endif
 
+#  if ( MODEL == HYDRO )
+   real *MaxCFL_PG = ( OPT__DT_FLU_FUSED ) ? new real [NPG] : NULL;
+#  endif
+
 #  pragma omp parallel for schedule( static )
    for (int TID=0; TID<NPG; TID++)
    {
       const int PID0 = PID0_List[TID];
 
+//    get the maximum CFL speed while the updated data are still in cache
+#     if ( MODEL == HYDRO )
+      if ( OPT__DT_FLU_FUSED )
+#        ifdef MHD
+         MaxCFL_PG[TID] = GetMaxCFL( h_Flu_Array_F_Out[TID], h_Mag_Array_F_Out[TID] );
+#        else
+         MaxCFL_PG[TID] = GetMaxCFL( h_Flu_Array_F_Out[TID], NULL );
+#        endif
+#     endif
+
       for (int LocalID=0; LocalID<8; LocalID++)
       {
          const int PID     = PID0 + LocalID;
@@ -186,6 +207,19 @@ void Flu_Close( const int lv, const int SaveSg_Flu, const int SaveSg_Mag,
       } // for (int LocalID=0; LocalID<8; LocalID++)
    } // for (int TID=0; TID<NPG; TID++)
 
+
+// collect the maximum CFL speed of all patch groups
+// --> Flu_Close() is never invoked concurrently, so no lock is required
+#  if ( MODEL == HYDRO )
+   if ( OPT__DT_FLU_FUSED )
+   {
+      for (int TID=0; TID<NPG; TID++)
+         Flu_FusedMaxCFL_ThisRank[lv] = FMAX( Flu_FusedMaxCFL_ThisRank[lv], MaxCFL_PG[TID] );
+
+      delete [] MaxCFL_PG;
+   }
+#  endif
+
 } // FUNCTION : Flu_Close
 
 
@@ -1172,6 +1206,49 @@ void CorrectUnphysical( const int lv, const int NPG, const int *PID0_List,
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetMaxCFL
+// Description :  Get the maximum CFL speed of the updated fluid data in one patch group
+//
+// Note        :  1. Invoked by Flu_Close() for OPT__DT_FLU_FUSED
+//                2. Adopt the same per-cell estimate as the fluid dt solver (i.e., Hydro_GetMaxCFL())
+//
+// Parameter   :  h_Flu_Array_F_Out : Host array storing the updated fluid data of the target patch group
+//                h_Mag_Array_F_Out : Host array storing the updated B field of the target patch group (for MHD only)
+//
+// Return      :  Maximum CFL speed
+//-------------------------------------------------------------------------------------------------------
+real GetMaxCFL( const real h_Flu_Array_F_Out[][ CUBE(PS2) ],
+                const real h_Mag_Array_F_Out[][ PS2P1*SQR(PS2) ] )
+{
+
+   real Fluid[NCOMP_TOTAL], B[3], MaxCFL=(real)0.0;
+
+   for (int k=0; k<PS2; k++)
+   for (int j=0; j<PS2; j++)
+   for (int i=0; i<PS2; i++)
+   {
+      const int ijk = IDX321( i, j, k, PS2, PS2 );
+
+      for (int v=0; v<NCOMP_TOTAL; v++)   Fluid[v] = h_Flu_Array_F_Out[v][ijk];
+
+#     ifdef MHD
+      MHD_GetCellCenteredBField( B, h_Mag_Array_F_Out[MAGX], h_Mag_Array_F_Out[MAGY], h_Mag_Array_F_Out[MAGZ],
+                                 PS2, PS2, PS2, i, j, k );
+#     endif
+
+      const real CFL = Hydro_GetMaxCFL( Fluid, B, (real)MIN_PRES, EoS_DensEint2Pres_CPUPtr, EoS_DensPres2CSqr_CPUPtr,
+                                        EoS_AuxArray_Flt, EoS_AuxArray_Int, h_EoS_Table );
+
+      MaxCFL = FMAX( CFL, MaxCFL );
+   }
+
+   return MaxCFL;
+
+} // FUNCTION : GetMaxCFL
+
+
+
 #ifdef MHD
 //-------------------------------------------------------------------------------------------------------
 // Function    :  StoreElectric
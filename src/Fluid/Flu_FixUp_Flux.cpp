@@ -28,6 +28,9 @@ void Flu_FixUp_Flux( const int lv )
    const int  Offset[6]       = { 0, PS1-1, 0, (PS1-1)*PS1, 0, (PS1-1)*SQR(PS1) }; // x=0/PS1-1, y=0/PS1-1, z=0/PS1-1 faces
    const int  didx[3][2]      = { PS1, SQR(PS1), 1, SQR(PS1), 1, PS1 };
 
+// fluid data at lv will be corrected --> clear the data cached by Prepare_PatchData()
+   PrepCache_Invalidate( lv );
+
 //###EXPERIMENTAL: (does not work well and thus has been disabled for now)
 /*
 // when enabling cooling, we want to fix the specific internal energy so that it won't be corrected by the flux fix-up operation
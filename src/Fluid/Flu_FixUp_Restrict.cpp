@@ -37,6 +37,9 @@ void Flu_FixUp_Restrict( const int FaLv, const int SonFluSg, const int FaFluSg,
 
    const int SonLv = FaLv + 1;
 
+// the coarse-grid data will be overwritten --> clear the data cached by Prepare_PatchData() for OPT__PREP_CACHE
+   PrepCache_Invalidate( FaLv );
+
 // check
    if ( FaLv < 0  ||  FaLv >= NLEVEL )
       Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "FaLv", FaLv );
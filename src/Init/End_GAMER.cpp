@@ -19,6 +19,11 @@ void End_GAMER()
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "%s ...\n", __FUNCTION__ );
 
 
+// wait for the pending snapshot written by the background I/O thread
+#  ifdef SUPPORT_HDF5
+   Output_DumpData_Async_Wait();
+#  endif
+
 #  ifdef TIMING
    Aux_DeleteTimer();
 #  endif
@@ -94,6 +94,15 @@ void End_MemFree()
    delete [] UM_IC_RefineRegion;    UM_IC_RefineRegion = NULL;
 
 
+// 10. data cached by Prepare_PatchData() for OPT__PREP_CACHE
+   PrepCache_Free();
+
+
+// 11. slabs of patch data for OPT__SLAB_ALLOC
+//     --> must be freed after deleting all patches
+   Mis_SlabAlloc_Free();
+
+
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
 
 } // FUNCTION : End_MemFree
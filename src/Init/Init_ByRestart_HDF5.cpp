@@ -18,6 +18,19 @@ static void LoadOnePatch( const hid_t H5_FileID, const int lv, const int GID, co
                           const hid_t *H5_SetID_FCMag, const hid_t *H5_SpaceID_FCMag, const hid_t *H5_MemID_FCMag,
                           const int *NParList, real **ParBuf, long *NewParList, const hid_t *H5_SetID_ParData,
                           const hid_t H5_SpaceID_ParData, const long *GParID_Offset, const long NParThisRank );
+#ifdef LOAD_BALANCE
+static void LoadTree_Distributed( const hid_t H5_FileID, const hid_t H5_DataXferPropList, const int NLvInFile,
+                                  const int NLvRescale, const int GID_LvStart[], const bool ReenablePar,
+                                  int NLoad[], int *LoadGID[], int (*LoadCr[])[3], int *LoadNPar[], long *LoadGParID[] );
+static void LoadPatches_Distributed( const int lv, const int NLoad, const int *LoadGID, const int (*LoadCr)[3],
+                                     const int *LoadNPar, const long *LoadGParID, const hid_t H5_DataXferPropList,
+                                     const hid_t *H5_SetID_Field, const hid_t H5_SpaceID_Field,
+                                     const hid_t *H5_SetID_FCMag, const hid_t *H5_SpaceID_FCMag,
+                                     long *NewParList, const hid_t *H5_SetID_ParData, const hid_t H5_SpaceID_ParData,
+                                     const long NParThisRank );
+static void LoadTreeSlab( const hid_t H5_FileID, const char *SetName, const hid_t H5_TypeID, const int NComp,
+                          const long Start, const long Count, const hid_t H5_DataXferPropList, void *Buf );
+#endif
 static void Check_Makefile ( const char *FileName, const int FormatVersion );
 static void Check_SymConst ( const char *FileName, const int FormatVersion );
 static void Check_InputPara( const char *FileName, const int FormatVersion );
@@ -33,6 +46,10 @@ static void ResetParameter( const char *FileName, double *EndT, long *EndStep );
 // Note        :  1. This function will be invoked by "Init_ByRestart" automatically if the restart file
 //                   is in the HDF5 format
 //                2. Only work for format version >= 2100 (PARTICLE only works for version >= 2200)
+//                3. With LOAD_BALANCE, each rank only reads the tree information and data of the patches it owns
+//                   --> See LoadTree_Distributed() and LoadPatches_Distributed()
+//                   --> All ranks read data collectively with MPI-IO if OPT__OUTPUT_HDF5_MPIIO is on
+//                       (RESTART_LOAD_NRANK is ignored in this case)
 //
 // Parameter   :  FileName : Target file name
 //-------------------------------------------------------------------------------------------------------
@@ -94,11 +111,9 @@ void Init_ByRestart_HDF5( const char *FileName )
 
    KeyInfo_t KeyInfo;
 
-   hid_t  H5_FileID, H5_SetID_KeyInfo, H5_TypeID_KeyInfo, H5_SetID_Cr;
-#  ifdef LOAD_BALANCE
-   hid_t  H5_SetID_LBIdx;
-#  else
-   hid_t  H5_SetID_Son;
+   hid_t  H5_FileID, H5_SetID_KeyInfo, H5_TypeID_KeyInfo;
+#  ifndef LOAD_BALANCE
+   hid_t  H5_SetID_Cr, H5_SetID_Son;
 #  endif
    herr_t H5_Status;
    int    NLvRescale, NPatchAllLv, GID_LvStart[NLEVEL];
@@ -193,6 +208,10 @@ void Init_ByRestart_HDF5( const char *FileName )
 
    LoadField( "Step",                 &KeyInfo.Step,                 H5_SetID_KeyInfo, H5_TypeID_KeyInfo,    Fatal,  NullPtr,              -1, NonFatal );
    LoadField( "AdvanceCounter",        KeyInfo.AdvanceCounter,       H5_SetID_KeyInfo, H5_TypeID_KeyInfo,    Fatal,  NullPtr,              -1, NonFatal );
+   if ( KeyInfo.FormatVersion >= 2462 )
+   LoadField( "NPatchAlloc",           KeyInfo.NPatchAlloc,          H5_SetID_KeyInfo, H5_TypeID_KeyInfo, NonFatal,  NullPtr,              -1, NonFatal );
+   else
+   for (int lv=0; lv<NLEVEL; lv++)     KeyInfo.NPatchAlloc[lv] = 0;
 
 #  ifdef PARTICLE
    if ( ReenablePar ) {
@@ -318,6 +337,38 @@ void Init_ByRestart_HDF5( const char *FileName )
       GID_LvStart[lv] = ( lv == 0 ) ? 0 : GID_LvStart[lv-1] + NPatchTotal[lv-1];
    }
 
+
+// 1-12. set the file-access and data-transfer property lists for loading data collectively with MPI-IO
+//       --> only used with LOAD_BALANCE
+   hid_t H5_FileAccPropList  = H5P_DEFAULT;
+   hid_t H5_DataXferPropList = H5P_DEFAULT;
+
+#  if ( defined LOAD_BALANCE  &&  defined H5_HAVE_PARALLEL )
+   if ( OPT__OUTPUT_HDF5_MPIIO )
+   {
+      H5_FileAccPropList  = H5Pcreate( H5P_FILE_ACCESS );
+      H5_Status           = H5Pset_fapl_mpio( H5_FileAccPropList, MPI_COMM_WORLD, MPI_INFO_NULL );
+      if ( H5_Status < 0 )    Aux_Error( ERROR_INFO, "failed to set the MPI-IO file driver !!\n" );
+
+      H5_DataXferPropList = H5Pcreate( H5P_DATASET_XFER );
+      H5_Status           = H5Pset_dxpl_mpio( H5_DataXferPropList, H5FD_MPIO_COLLECTIVE );
+      if ( H5_Status < 0 )    Aux_Error( ERROR_INFO, "failed to set the collective data transfer mode !!\n" );
+   }
+#  endif
+
+
+// 1-13. preallocate the adaptive memory pool from the sizing hints stored in the restart file
+//       --> assuming patches are evenly distributed among all ranks
+   if ( OPT__MEMORY_POOL == MEMORY_POOL_ADAPTIVE )
+   {
+      int NPatchHint[NLEVEL];
+
+      for (int lv=0; lv<NLEVEL; lv++)
+         NPatchHint[lv] = ( lv < KeyInfo.NLevel ) ? ( KeyInfo.NPatchAlloc[lv] + MPI_NRank - 1 )/MPI_NRank : 0;
+
+      Aux_AdjustMemoryPool( NPatchHint );
+   }
+
    MPI_Barrier( MPI_COMM_WORLD );
 
 
@@ -325,7 +376,37 @@ void Init_ByRestart_HDF5( const char *FileName )
 
 
 
-// 2. load the tree information (load-balance indices, corner, son, ... etc) of all patches (by all ranks)
+// 2. load the tree information (load-balance indices, corner, son, ... etc)
+#  ifdef LOAD_BALANCE
+// 2-1. with LOAD_BALANCE, each rank only stores the tree information of the patches to be loaded by itself
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading and distributing the tree information ...\n" );
+
+   int   NLoad[NLEVEL];          // number of patches to be loaded by this rank
+   int  *LoadGID   [NLEVEL];     // GID of each patch to be loaded (sorted by LBIdx)
+   int (*LoadCr    [NLEVEL])[3]; // corner
+   int  *LoadNPar  [NLEVEL];     // number of particles
+   long *LoadGParID[NLEVEL];     // starting global particle index
+
+   H5_FileID = H5Fopen( FileName, H5F_ACC_RDONLY, H5_FileAccPropList );
+   if ( H5_FileID < 0 )
+      Aux_Error( ERROR_INFO, "failed to open the restart HDF5 file \"%s\" !!\n", FileName );
+
+#  if ( LOAD_BALANCE != HILBERT )
+   if ( NLvRescale != 1  &&  MPI_Rank == 0 )
+   Aux_Message( stderr, "WARNING : please make sure that the patch LBIdx doesn't change when NLvRescale != 1 !!\n" );
+#  endif
+
+   LoadTree_Distributed( H5_FileID, H5_DataXferPropList, KeyInfo.NLevel, NLvRescale, GID_LvStart, ReenablePar,
+                         NLoad, LoadGID, LoadCr, LoadNPar, LoadGParID );
+
+   H5_Status = H5Fclose( H5_FileID );
+
+   if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading and distributing the tree information ... done\n" );
+
+
+#  else // #ifdef LOAD_BALANCE
+
+// --> all ranks load the tree information of all patches
    H5_FileID = H5Fopen( FileName, H5F_ACC_RDONLY, H5P_DEFAULT );
    if ( H5_FileID < 0 )
       Aux_Error( ERROR_INFO, "failed to open the restart HDF5 file \"%s\" !!\n", FileName );
@@ -351,138 +432,7 @@ void Init_ByRestart_HDF5( const char *FileName )
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading corner table ... done\n" );
 
 
-// 2-2. LBIdx
-#  ifdef LOAD_BALANCE
-   if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading load-balance index table ...\n" );
-
-   long *LBIdxList_AllLv;
-   long *LBIdxList_EachLv         [NLEVEL];
-   int  *LBIdxList_EachLv_IdxTable[NLEVEL];
-   int   LoadIdx_Start[NLEVEL], LoadIdx_Stop[NLEVEL];
-
-// 2-2-1. allocate memory
-   LBIdxList_AllLv = new long [ NPatchAllLv ];
-
-   for (int lv=0; lv<NLEVEL; lv++)
-   {
-      if ( lv < KeyInfo.NLevel )
-      {
-         LBIdxList_EachLv         [lv] = LBIdxList_AllLv + GID_LvStart[lv];
-         LBIdxList_EachLv_IdxTable[lv] = new int [ NPatchTotal[lv] ];
-      }
-
-      else
-      {
-         LBIdxList_EachLv         [lv] = NULL;
-         LBIdxList_EachLv_IdxTable[lv] = NULL;
-      }
-   }
-
-
-// 2-2-2. load LBIdx list (sorted by GID)
-   H5_SetID_LBIdx = H5Dopen( H5_FileID, "Tree/LBIdx", H5P_DEFAULT );
-
-   if ( H5_SetID_LBIdx < 0 )  Aux_Error( ERROR_INFO, "failed to open the dataset \"%s\" !!\n", "Tree/LBIdx" );
-
-   H5_Status = H5Dread( H5_SetID_LBIdx, H5T_NATIVE_LONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, LBIdxList_AllLv );
-   H5_Status = H5Dclose( H5_SetID_LBIdx );
-
-
-   for (int lv=0; lv<KeyInfo.NLevel; lv++)
-   {
-//    2-2-3. sort the LBIdx list at each level and set the load-balance cut points
-#     if ( LOAD_BALANCE != HILBERT )
-      if ( NLvRescale != 1 )
-      Aux_Message( stderr, "WARNING : please make sure that the patch LBIdx doesn't change when NLvRescale != 1 !!\n" );
-#     endif
-
-//    Mis_Heapsort must be called before LB_SetCutPoint in order to get LBIdxList_EachLv_IdxTable
-//    (since LB_SetCutPoint will sort LBIdxList_EachLv as well)
-//    --> Actually it's not necessary anymore since we now send LBIdx0_AllRank instead of LBIdxList_EachLv into LB_SetCutPoint()
-      Mis_Heapsort( NPatchTotal[lv], LBIdxList_EachLv[lv], LBIdxList_EachLv_IdxTable[lv] );
-
-//    prepare LBIdx and load-balance weighting of each **patch group** for LB_SetCutPoint()
-      const bool InputLBIdx0AndLoad_Yes = true;
-      long   *LBIdx0_AllRank = NULL;
-      double *Load_AllRank   = NULL;
-
-      if ( MPI_Rank == 0 )
-      {
-         LBIdx0_AllRank = new long   [ NPatchTotal[lv] / 8 ];
-         Load_AllRank   = new double [ NPatchTotal[lv] / 8 ];
-
-         for (int t=0; t<NPatchTotal[lv]/8; t++)
-         {
-            LBIdx0_AllRank[t]  = LBIdxList_EachLv[lv][t*8];
-            LBIdx0_AllRank[t] -= LBIdx0_AllRank[t] % 8;     // assuming LBIdxList_EachLv is NOT sorted yet
-            Load_AllRank  [t]  = 8.0;                       // assuming all patches have the same weighting == 1.0
-         }
-      }
-
-//    do NOT consider load-balance weighting of particles since at this point we don't have that information
-      const double ParWeight_Zero = 0.0;
-      LB_SetCutPoint( lv, NPatchTotal[lv]/8, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_AllRank, Load_AllRank,
-                      ParWeight_Zero );
-
-//    free memory
-      if ( MPI_Rank == 0 )
-      {
-         delete [] LBIdx0_AllRank;
-         delete [] Load_AllRank;
-      }
-
-
-//    2-2-4. get the target LBIdx range of each rank
-      LoadIdx_Start[lv] = -1;    // -1 --> indicate that it has not been set
-      LoadIdx_Stop [lv] = -1;    // must be initialized as <= LoadIdx_Start[lv]
-
-//    skip levels with no patch (otherwise LoadIdx_Start and LoadIdx_Stop will be set incorrectly)
-      if ( NPatchTotal[lv] == 0 )   continue;
-
-      for (int t=0; t<NPatchTotal[lv]; t++)
-      {
-//       set LoadIdx_Start to "the first patch belonging to this rank"
-         if (  LoadIdx_Start[lv] == -1  &&  LB_Index2Rank( lv, LBIdxList_EachLv[lv][t], CHECK_ON ) == MPI_Rank  )
-            LoadIdx_Start[lv] = t;
-
-//       set LoadIdx_Stop to "the last patch belonging to this rank + 1"
-         if ( LoadIdx_Start[lv] != -1 )
-         {
-            if (  LB_Index2Rank( lv, LBIdxList_EachLv[lv][t], CHECK_ON ) > MPI_Rank  )
-            {
-               LoadIdx_Stop[lv] = t;
-               break;
-            }
-
-//          rank owning the last patch needs to be treated separately
-            else if ( t == NPatchTotal[lv] - 1 )
-            {
-               LoadIdx_Stop[lv] = NPatchTotal[lv];
-               break;
-            }
-         }
-      }
-
-#     ifdef DEBUG_HDF5
-      if ( LoadIdx_Start[lv]%8 != 0  &&  LoadIdx_Start[lv] != -1 )
-         Aux_Error( ERROR_INFO, "LoadIdx_Start[%d] = %d --> %%8 != 0 !!\n", lv, LoadIdx_Start[lv]%8 );
-
-      if ( LoadIdx_Stop [lv]%8 != 0  &&  LoadIdx_Stop[lv] != -1 )
-         Aux_Error( ERROR_INFO, "LoadIdx_Stop [%d] = %d --> %%8 != 0 !!\n", lv, LoadIdx_Stop [lv]%8 );
-
-      if (  ( LoadIdx_Start[lv] == -1 && LoadIdx_Stop[lv] != -1 )  ||
-            ( LoadIdx_Start[lv] != -1 && LoadIdx_Stop[lv] == -1 )   )
-         Aux_Error( ERROR_INFO, "LoadIdx_Start/Stop[%d] = %d/%d !!\n", lv, LoadIdx_Start[lv], LoadIdx_Stop[lv] );
-#     endif
-   } // for (int lv=0; lv<KeyInfo.NLevel; lv++)
-
-   if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading load-balance index table ... done\n" );
-
-
-#  else // #ifdef LOAD_BALANCE
-
-
-// 2-3. son
+// 2-2. son
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading son table ...\n" );
 
 // allocate memory
@@ -495,10 +445,9 @@ void Init_ByRestart_HDF5( const char *FileName )
    H5_Status = H5Dclose( H5_SetID_Son );
 
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading son table ... done\n" );
-#  endif // #ifdef LOAD_BALANCE ... else ...
 
 
-// 2-4. number of particles in each patch
+// 2-3. number of particles in each patch
 #  ifdef PARTICLE
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading particle counts ...\n" );
 
@@ -521,6 +470,7 @@ void Init_ByRestart_HDF5( const char *FileName )
 
 
    H5_Status = H5Fclose( H5_FileID );
+#  endif // #ifdef LOAD_BALANCE ... else ...
 
 
 // 2-5. initialize particle variables
@@ -534,15 +484,7 @@ void Init_ByRestart_HDF5( const char *FileName )
    NParThisRank = 0;
 
    for (int lv=0; lv<KeyInfo.NLevel; lv++)
-   for (int t=LoadIdx_Start[lv]; t<LoadIdx_Stop[lv]; t++)
-   {
-#     ifdef DEBUG_HDF5
-      if ( t < 0  ||  t >= NPatchTotal[lv] )
-         Aux_Error( ERROR_INFO, "incorrect load index (%d) !!\n", t );
-#     endif
-
-      NParThisRank += NParList_AllLv[ LBIdxList_EachLv_IdxTable[lv][t] + GID_LvStart[lv] ];
-   }
+   for (int t=0; t<NLoad[lv]; t++)     NParThisRank += LoadNPar[lv][t];
 
 #  ifdef DEBUG_HDF5
    long NParAllRank;
@@ -569,6 +511,10 @@ void Init_ByRestart_HDF5( const char *FileName )
 
 
 // 2-5-3. calculate the starting global particle indices (i.e., GParID_Offset) for all patches
+// --> already done by LoadTree_Distributed() with LOAD_BALANCE
+#  ifdef LOAD_BALANCE
+   long *GParID_Offset = NULL;
+#  else
    long *GParID_Offset = new long [ NPatchAllLv ];
 
    GParID_Offset[0] = 0;
@@ -579,6 +525,7 @@ void Init_ByRestart_HDF5( const char *FileName )
       Aux_Error( ERROR_INFO, "total number of particles (%ld) != expect (%ld) !!\n",
                  GParID_Offset[ NPatchAllLv-1 ] + NParList_AllLv[ NPatchAllLv-1 ], amr->Par->NPar_Active_AllRank );
 #  endif
+#  endif // #ifdef LOAD_BALANCE ... else ...
 
 
 // 2-5-4. get the maximum number of particles in one patch and allocate an I/O buffer accordingly
@@ -586,13 +533,21 @@ void Init_ByRestart_HDF5( const char *FileName )
    long *NewParList       = NULL;
    real **ParBuf          = NULL;
 
+#  ifdef LOAD_BALANCE
+   for (int lv=0; lv<KeyInfo.NLevel; lv++)
+   for (int t=0; t<NLoad[lv]; t++)     MaxNParInOnePatch = MAX( MaxNParInOnePatch, LoadNPar[lv][t] );
+#  else
    for (int t=0; t<NPatchAllLv; t++)   MaxNParInOnePatch = MAX( MaxNParInOnePatch, NParList_AllLv[t] );
+#  endif
 
    NewParList = new long [MaxNParInOnePatch];
 
 // be careful about using ParBuf returned from Aux_AllocateArray2D, which is set to NULL if MaxNParInOnePatch == 0
 // --> for example, accessing ParBuf[0...PAR_NATT_STORED-1] will be illegal when MaxNParInOnePatch == 0
+// --> not used with LOAD_BALANCE since LoadPatches_Distributed() reads particles of all patches on a level at once
+#  ifndef LOAD_BALANCE
    Aux_AllocateArray2D( ParBuf, PAR_NATT_STORED, MaxNParInOnePatch );
+#  endif
 
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Initializing particle repository ... done\n" );
 #  endif // #ifdef PARTICLE
@@ -602,9 +557,7 @@ void Init_ByRestart_HDF5( const char *FileName )
 // 3. load and allocate patches (load particles as well if PARTICLE is on)
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "   Loading patches and particles ...\n" );
 
-#  ifdef LOAD_BALANCE
-   const bool Recursive_No  = false;
-#  else
+#  ifndef LOAD_BALANCE
    const bool Recursive_Yes = true;
    int  TRange_Min[3], TRange_Max[3];
 #  endif
@@ -629,7 +582,9 @@ void Init_ByRestart_HDF5( const char *FileName )
    hid_t   H5_SetID_ParData[PAR_NATT_STORED], H5_SpaceID_ParData, H5_GroupID_Particle;
 #  else
 // define useless variables when PARTICLE is off
+#  ifndef LOAD_BALANCE
    int   *NParList_AllLv     = NULL;
+#  endif
    real **ParBuf             = NULL;
    long  *NewParList         = NULL;
    long  *GParID_Offset      = NULL;
@@ -700,12 +655,15 @@ void Init_ByRestart_HDF5( const char *FileName )
 
 
 // load data with RESTART_LOAD_NRANK ranks at a time
-   for (int TRanks=0; TRanks<MPI_NRank; TRanks+=RESTART_LOAD_NRANK)
+// --> all ranks must load data simultaneously when using MPI-IO since all HDF5 calls are collective
+   const int LoadNRank = ( H5_FileAccPropList == H5P_DEFAULT ) ? RESTART_LOAD_NRANK : MPI_NRank;
+
+   for (int TRanks=0; TRanks<MPI_NRank; TRanks+=LoadNRank)
    {
-      if ( MPI_Rank >= TRanks  &&  MPI_Rank < TRanks+RESTART_LOAD_NRANK )
+      if ( MPI_Rank >= TRanks  &&  MPI_Rank < TRanks+LoadNRank )
       {
 //       3-3. open the target datasets just once
-         H5_FileID = H5Fopen( FileName, H5F_ACC_RDONLY, H5P_DEFAULT );
+         H5_FileID = H5Fopen( FileName, H5F_ACC_RDONLY, H5_FileAccPropList );
          if ( H5_FileID < 0 )
             Aux_Error( ERROR_INFO, "failed to open the restart HDF5 file \"%s\" !!\n", FileName );
 
@@ -743,32 +701,17 @@ void Init_ByRestart_HDF5( const char *FileName )
 //       3-4. begin to load data
 //       3-4-1. load-balance data
 #        ifdef LOAD_BALANCE
-         int GID0;
-
          for (int lv=0; lv<KeyInfo.NLevel; lv++)
          {
             if ( MPI_Rank == TRanks )
             Aux_Message( stdout, "      Loading ranks %4d -- %4d, lv %2d ... ",
-                         TRanks, MIN(TRanks+RESTART_LOAD_NRANK-1, MPI_NRank-1), lv );
+                         TRanks, MIN(TRanks+LoadNRank-1, MPI_NRank-1), lv );
 
-//          loop over all target LBIdx
-            for (int t=LoadIdx_Start[lv]; t<LoadIdx_Stop[lv]; t+=8)
-            {
-#              ifdef DEBUG_HDF5
-               if ( t < 0  ||  t >= NPatchTotal[lv]  ||  t%8 != 0 )
-                 Aux_Error( ERROR_INFO, "incorrect load index (%d) !!\n", t );
-#              endif
-
-//             make sure that we load patch from LocalID == 0
-               GID0 = LBIdxList_EachLv_IdxTable[lv][t] - LBIdxList_EachLv_IdxTable[lv][t]%8 + GID_LvStart[lv];
-
-               for (int GID=GID0; GID<GID0+8; GID++)
-                  LoadOnePatch( H5_FileID, lv, GID, Recursive_No, NULL, CrList_AllLv,
-                                H5_SetID_Field, H5_SpaceID_Field, H5_MemID_Field,
-                                H5_SetID_FCMag, H5_SpaceID_FCMag, H5_MemID_FCMag,
-                                NParList_AllLv, ParBuf, NewParList, H5_SetID_ParData, H5_SpaceID_ParData,
-                                GParID_Offset, NParThisRank );
-            }
+//          load all target patches on this level at once
+            LoadPatches_Distributed( lv, NLoad[lv], LoadGID[lv], LoadCr[lv], LoadNPar[lv], LoadGParID[lv],
+                                     H5_DataXferPropList, H5_SetID_Field, H5_SpaceID_Field,
+                                     H5_SetID_FCMag, H5_SpaceID_FCMag, NewParList,
+                                     ( ReenablePar ) ? NULL : H5_SetID_ParData, H5_SpaceID_ParData, NParThisRank );
 
 //          check if LocalID matches corner
 #           ifdef DEBUG_HDF5
@@ -842,10 +785,10 @@ void Init_ByRestart_HDF5( const char *FileName )
 #        endif
 
          H5_Status = H5Fclose( H5_FileID );
-      } // if ( MPI_Rank >= TRanks  &&  MPI_Rank < TRanks+RESTART_LOAD_NRANK )
+      } // if ( MPI_Rank >= TRanks  &&  MPI_Rank < TRanks+LoadNRank )
 
       MPI_Barrier( MPI_COMM_WORLD );
-   } // for (int TRanks=0; TRanks<MPI_NRank; TRanks+=RESTART_LOAD_NRANK)
+   } // for (int TRanks=0; TRanks<MPI_NRank; TRanks+=LoadNRank)
 
 // free HDF5 objects
    H5_Status = H5Sclose( H5_SpaceID_Field );
@@ -877,7 +820,7 @@ void Init_ByRestart_HDF5( const char *FileName )
       for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
          amr->LB->IdxList_Real[lv][PID] = amr->patch[0][lv][PID]->LB_Idx;
 
-      Mis_Heapsort( amr->NPatchComma[lv][1], amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
+      Mis_RadixSort( amr->NPatchComma[lv][1], amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
 #     endif
 
 //    get the total number of real patches at all ranks
@@ -916,24 +859,36 @@ void Init_ByRestart_HDF5( const char *FileName )
    free( KeyInfo.GitCommit );
 
    delete [] FieldName;
-   delete [] CrList_AllLv;
 #  ifdef MHD
    delete [] FCMagName;
 #  endif
 #  ifdef LOAD_BALANCE
-   delete [] LBIdxList_AllLv;
-   for (int lv=0; lv<NLEVEL; lv++)  delete [] LBIdxList_EachLv_IdxTable[lv];
+   for (int lv=0; lv<KeyInfo.NLevel; lv++)
+   {
+      delete [] LoadGID[lv];
+      delete [] LoadCr [lv];
+#     ifdef PARTICLE
+      delete [] LoadNPar  [lv];
+      delete [] LoadGParID[lv];
+#     endif
+   }
 #  else
+   delete [] CrList_AllLv;
    delete [] SonList_AllLv;
 #  endif
 #  ifdef PARTICLE
    delete [] ParAttName;
+#  ifndef LOAD_BALANCE
    delete [] NParList_AllLv;
+#  endif
    delete [] GParID_Offset;
    delete [] NewParList;
    Aux_DeallocateArray2D( ParBuf );
 #  endif
 
+   if ( H5_FileAccPropList  != H5P_DEFAULT )    H5_Status = H5Pclose( H5_FileAccPropList );
+   if ( H5_DataXferPropList != H5P_DEFAULT )    H5_Status = H5Pclose( H5_DataXferPropList );
+
 
 
 // 5-1. improve load balance
@@ -958,14 +913,15 @@ void Init_ByRestart_HDF5( const char *FileName )
    const bool   SendGridData_No  = false;
    const bool   ResetLB_Yes      = true;
    const bool   ResetLB_No       = false;
+   const bool   Diffuse_No       = false;
    const int    AllLv            = -1;
 
-   LB_Init_LoadBalance( Redistribute_No, SendGridData_No, ParWeight_Zero, ResetLB_No, AllLv );
+   LB_Init_LoadBalance( Redistribute_No, SendGridData_No, ParWeight_Zero, ResetLB_No, Diffuse_No, AllLv );
 
 // redistribute patches again if we want to take into account the load-balance weighting of particles
 #  ifdef PARTICLE
    if ( amr->LB->Par_Weight > 0.0  &&  !ReenablePar )
-   LB_Init_LoadBalance( Redistribute_Yes, SendGridData_Yes, amr->LB->Par_Weight, ResetLB_Yes, AllLv );
+   LB_Init_LoadBalance( Redistribute_Yes, SendGridData_Yes, amr->LB->Par_Weight, ResetLB_Yes, Diffuse_No, AllLv );
 #  endif
 
 
@@ -1396,6 +1352,570 @@ void LoadOnePatch( const hid_t H5_FileID, const int lv, const int GID, const boo
 
 
 
+#ifdef LOAD_BALANCE
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LoadTree_Distributed
+// Description :  Load the tree information and determine the patches to be loaded by each rank
+//
+// Note        :  1. Work only with LOAD_BALANCE
+//                2. Each rank only reads a contiguous block of patch groups on each level from disk and then
+//                   sends them to the ranks owning these patch groups
+//                   --> No rank needs to store the tree information of all patches
+//                3. Load-balance cut points are set by LB_SetCutPoint() assuming all patches have the same weighting
+//                4. Starting global particle indices are computed here as well since they require the particle
+//                   counts of all patches preceding the target patch in the file
+//                5. Patches in the returned lists are sorted by their LBIdx
+//                   --> Patches within the same patch group are stored consecutively in the order of LocalID
+//                6. Returned lists must be freed by the caller
+//                   --> LoadNPar[] and LoadGParID[] are set to NULL when PARTICLE is off
+//
+// Parameter   :  H5_FileID           : HDF5 file ID of the restart file
+//                H5_DataXferPropList : HDF5 data transfer property list
+//                NLvInFile           : Number of levels in the restart file
+//                NLvRescale          : Factor to rescale the loaded corner (when NLvInFile != NLEVEL)
+//                GID_LvStart         : GID of the first patch on each level
+//                ReenablePar         : Particle data do not exist in the restart file
+//                NLoad               : Number of patches to be loaded by this rank on each level
+//                LoadGID             : GID of each patch to be loaded
+//                LoadCr              : Corner of each patch to be loaded
+//                LoadNPar            : Number of particles in each patch to be loaded
+//                LoadGParID          : Starting global particle index of each patch to be loaded
+//
+// Return      :  NLoad[], LoadGID[], LoadCr[], LoadNPar[], LoadGParID[]
+//-------------------------------------------------------------------------------------------------------
+void LoadTree_Distributed( const hid_t H5_FileID, const hid_t H5_DataXferPropList, const int NLvInFile,
+                           const int NLvRescale, const int GID_LvStart[], const bool ReenablePar,
+                           int NLoad[], int *LoadGID[], int (*LoadCr[])[3], int *LoadNPar[], long *LoadGParID[] )
+{
+
+// record of one patch group: GID0, LBIdx0, and corner[3] + NPar + GParID of each patch
+   const int NRec = 2 + 8*5;
+
+   int  *Send_NCount = new int [MPI_NRank];
+   int  *Recv_NCount = new int [MPI_NRank];
+   int  *Send_NDisp  = new int [MPI_NRank];
+   int  *Recv_NDisp  = new int [MPI_NRank];
+   long  GParID_LvStart = 0;     // total number of particles on all lower levels
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      NLoad     [lv] = 0;
+      LoadGID   [lv] = NULL;
+      LoadCr    [lv] = NULL;
+      LoadNPar  [lv] = NULL;
+      LoadGParID[lv] = NULL;
+
+      if ( lv >= NLvInFile )  continue;
+
+
+//    1. load a contiguous block of patch groups on this level
+      const int  NPG_AllRank = NPatchTotal[lv] / 8;
+      const int  PG_Start    = (long)NPG_AllRank*(MPI_Rank  )/MPI_NRank;
+      const int  PG_Stop     = (long)NPG_AllRank*(MPI_Rank+1)/MPI_NRank;
+      const int  NPG_Block   = PG_Stop - PG_Start;
+      const int  NP_Block    = 8*NPG_Block;
+      const long GID_Start   = GID_LvStart[lv] + 8*PG_Start;
+
+      long  *LBIdx_Block = new long [NP_Block];
+      int  (*Cr_Block)[3] = new int [NP_Block][3];
+      int   *NPar_Block  = new int  [NP_Block];
+
+      LoadTreeSlab( H5_FileID, "Tree/LBIdx",  H5T_NATIVE_LONG, 1, GID_Start, NP_Block, H5_DataXferPropList, LBIdx_Block );
+      LoadTreeSlab( H5_FileID, "Tree/Corner", H5T_NATIVE_INT,  3, GID_Start, NP_Block, H5_DataXferPropList, Cr_Block );
+
+#     ifdef PARTICLE
+      if ( ReenablePar )   for (int t=0; t<NP_Block; t++)   NPar_Block[t] = 0;
+      else                 LoadTreeSlab( H5_FileID, "Tree/NPar", H5T_NATIVE_INT, 1, GID_Start, NP_Block,
+                                         H5_DataXferPropList, NPar_Block );
+#     else
+      for (int t=0; t<NP_Block; t++)   NPar_Block[t] = 0;
+#     endif
+
+//    rescale the loaded corner (necessary when NLvInFile != NLEVEL)
+      if ( NLvRescale != 1 )
+      for (int t=0; t<NP_Block; t++)
+      for (int d=0; d<3; d++)
+         Cr_Block[t][d] *= NLvRescale;
+
+
+//    2. get the starting global particle index of this block
+//    --> GID are sorted by level first, and particles are stored in the order of GID
+      long GParID_Block = GParID_LvStart;
+
+#     ifdef PARTICLE
+      long  NPar_ThisBlock = 0;
+      long *NPar_EachBlock = new long [MPI_NRank];
+
+      for (int t=0; t<NP_Block; t++)   NPar_ThisBlock += NPar_Block[t];
+
+      MPI_Allgather( &NPar_ThisBlock, 1, MPI_LONG, NPar_EachBlock, 1, MPI_LONG, MPI_COMM_WORLD );
+
+      for (int r=0; r<MPI_NRank; r++)
+      {
+         if ( r < MPI_Rank )  GParID_Block += NPar_EachBlock[r];
+         GParID_LvStart += NPar_EachBlock[r];
+      }
+
+      delete [] NPar_EachBlock;
+#     endif
+
+
+//    3. set the load-balance cut points
+//    --> LB_SetCutPoint() accepts patch groups distributed arbitrarily among ranks
+      long   *LBIdx0_Block = new long   [NPG_Block];
+      double *Load_Block   = new double [NPG_Block];
+
+      for (int t=0; t<NPG_Block; t++)
+      {
+         LBIdx0_Block[t]  = LBIdx_Block[ t*8 ];
+         LBIdx0_Block[t] -= LBIdx0_Block[t] % 8;
+         Load_Block  [t]  = 8.0;    // assuming all patches have the same weighting == 1.0
+      }
+
+//    do NOT consider load-balance weighting of particles since at this point we don't have that information
+      const bool   InputLBIdx0AndLoad_Yes = true;
+      const double ParWeight_Zero         = 0.0;
+
+      LB_SetCutPoint( lv, NPG_Block, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_Block, Load_Block,
+                      ParWeight_Zero );
+
+      delete [] Load_Block;
+
+
+//    4. send the tree information of each patch group to the rank owning it
+//    4-1. get the target rank of each patch group
+      int *Owner = new int [NPG_Block];
+
+      for (int r=0; r<MPI_NRank; r++)  Send_NCount[r] = 0;
+
+      for (int t=0; t<NPG_Block; t++)
+      {
+         Owner[t] = LB_Index2Rank( lv, LBIdx0_Block[t], CHECK_ON );
+         Send_NCount[ Owner[t] ] += NRec;
+      }
+
+      MPI_Alltoall( Send_NCount, 1, MPI_INT, Recv_NCount, 1, MPI_INT, MPI_COMM_WORLD );
+
+      Send_NDisp[0] = 0;
+      Recv_NDisp[0] = 0;
+      for (int r=1; r<MPI_NRank; r++)
+      {
+         Send_NDisp[r] = Send_NDisp[r-1] + Send_NCount[r-1];
+         Recv_NDisp[r] = Recv_NDisp[r-1] + Recv_NCount[r-1];
+      }
+
+      const int NSend = Send_NDisp[MPI_NRank-1] + Send_NCount[MPI_NRank-1];
+      const int NRecv = Recv_NDisp[MPI_NRank-1] + Recv_NCount[MPI_NRank-1];
+
+//    4-2. prepare the send buffer
+      long *SendBuf = new long [NSend];
+      long *RecvBuf = new long [NRecv];
+      long  GParID  = GParID_Block;
+
+      for (int r=0; r<MPI_NRank; r++)  Send_NCount[r] = 0;
+
+      for (int t=0; t<NPG_Block; t++)
+      {
+         long *Rec = SendBuf + Send_NDisp[ Owner[t] ] + Send_NCount[ Owner[t] ];
+
+         Rec[0] = GID_Start + 8*t;
+         Rec[1] = LBIdx0_Block[t];
+
+         for (int LocalID=0; LocalID<8; LocalID++)
+         {
+            const int t_P = 8*t + LocalID;
+
+            for (int d=0; d<3; d++)
+            Rec[ 2 + 5*LocalID + d ] = Cr_Block[t_P][d];
+            Rec[ 2 + 5*LocalID + 3 ] = NPar_Block[t_P];
+            Rec[ 2 + 5*LocalID + 4 ] = GParID;
+
+            GParID += NPar_Block[t_P];
+         }
+
+         Send_NCount[ Owner[t] ] += NRec;
+      }
+
+//    4-3. exchange data
+      MPI_Alltoallv( SendBuf, Send_NCount, Send_NDisp, MPI_LONG, RecvBuf, Recv_NCount, Recv_NDisp, MPI_LONG,
+                     MPI_COMM_WORLD );
+
+
+//    5. store the received patches in the order of LBIdx
+      const int NPG_Recv = NRecv / NRec;
+
+      long *LBIdx0_Recv = new long [NPG_Recv];
+      int  *IdxTable    = new int  [NPG_Recv];
+
+      for (int t=0; t<NPG_Recv; t++)   LBIdx0_Recv[t] = RecvBuf[ t*NRec + 1 ];
+
+      Mis_RadixSort( NPG_Recv, LBIdx0_Recv, IdxTable );
+
+      NLoad  [lv] = 8*NPG_Recv;
+      LoadGID[lv] = new int [ NLoad[lv] ];
+      LoadCr [lv] = new int [ NLoad[lv] ][3];
+#     ifdef PARTICLE
+      LoadNPar  [lv] = new int  [ NLoad[lv] ];
+      LoadGParID[lv] = new long [ NLoad[lv] ];
+#     endif
+
+      for (int t=0; t<NPG_Recv; t++)
+      {
+         const long *Rec = RecvBuf + IdxTable[t]*NRec;
+
+         for (int LocalID=0; LocalID<8; LocalID++)
+         {
+            const int t_P = 8*t + LocalID;
+
+            LoadGID[lv][t_P] = Rec[0] + LocalID;
+            for (int d=0; d<3; d++)
+            LoadCr [lv][t_P][d] = Rec[ 2 + 5*LocalID + d ];
+#           ifdef PARTICLE
+            LoadNPar  [lv][t_P] = Rec[ 2 + 5*LocalID + 3 ];
+            LoadGParID[lv][t_P] = Rec[ 2 + 5*LocalID + 4 ];
+#           endif
+         }
+      }
+
+
+//    free memory
+      delete [] LBIdx_Block;
+      delete [] Cr_Block;
+      delete [] NPar_Block;
+      delete [] LBIdx0_Block;
+      delete [] Owner;
+      delete [] SendBuf;
+      delete [] RecvBuf;
+      delete [] LBIdx0_Recv;
+      delete [] IdxTable;
+   } // for (int lv=0; lv<NLEVEL; lv++)
+
+   delete [] Send_NCount;
+   delete [] Recv_NCount;
+   delete [] Send_NDisp;
+   delete [] Recv_NDisp;
+
+} // FUNCTION : LoadTree_Distributed
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LoadPatches_Distributed
+// Description :  Allocate and load all fields (and particles if PARTICLE is on) of the target patches on one level
+//
+// Note        :  1. Work only with LOAD_BALANCE
+//                2. Patches are allocated in the order of the input lists, which are set by LoadTree_Distributed()
+//                3. Data of all target patches are loaded by a single H5Dread() call for each field and particle
+//                   attribute, which is collective if the MPI-IO file driver is adopted
+//                   --> Must be called by all ranks in that case even if NLoad == 0
+//                4. Only leaf patches have particles, which is not checked here since the son information is not loaded
+//
+// Parameter   :  lv                  : Target level
+//                NLoad               : Number of patches to be loaded
+//                LoadGID             : GID of each patch to be loaded
+//                LoadCr              : Corner of each patch to be loaded
+//                LoadNPar            : Number of particles in each patch to be loaded
+//                LoadGParID          : Starting global particle index of each patch to be loaded
+//                H5_DataXferPropList : HDF5 data transfer property list
+//                H5_SetID_Field      : HDF5 dataset ID for cell-centered grid data
+//                H5_SpaceID_Field    : HDF5 dataset dataspace ID for cell-centered grid data
+//                H5_SetID_FCMag      : HDF5 dataset ID for face-centered magnetic field
+//                H5_SpaceID_FCMag    : HDF5 dataset dataspace ID for face-centered magnetic field
+//                NewParList          : Array to store the new particle indices
+//                                      --> It must be preallocated with a size equal to the maximum number of
+//                                          particles in one patch
+//                H5_SetID_ParData    : HDF5 dataset ID for particle data
+//                                      --> NULL if particle data do not exist in the restart file
+//                H5_SpaceID_ParData  : HDF5 dataset dataspace ID for particle data
+//                NParThisRank        : Total number of particles in this rank (for check only)
+//-------------------------------------------------------------------------------------------------------
+void LoadPatches_Distributed( const int lv, const int NLoad, const int *LoadGID, const int (*LoadCr)[3],
+                              const int *LoadNPar, const long *LoadGParID, const hid_t H5_DataXferPropList,
+                              const hid_t *H5_SetID_Field, const hid_t H5_SpaceID_Field,
+                              const hid_t *H5_SetID_FCMag, const hid_t *H5_SpaceID_FCMag,
+                              long *NewParList, const hid_t *H5_SetID_ParData, const hid_t H5_SpaceID_ParData,
+                              const long NParThisRank )
+{
+
+   const bool WithData_Yes = true;
+   const int  PID0         = amr->num[lv];
+#  ifdef MHD
+   const int  PatchSize    = PS1P1*SQR(PS1);
+#  else
+   const int  PatchSize    = CUBE(PS1);
+#  endif
+
+   hsize_t H5_Offset[4], H5_Count[4], H5_MemDims[1];
+   hid_t   H5_MemID;
+   herr_t  H5_Status;
+   real    Dummy;
+
+
+// 1. allocate patches
+   for (int t=0; t<NLoad; t++)
+      amr->pnew( lv, LoadCr[t][0], LoadCr[t][1], LoadCr[t][2], -1, WithData_Yes, WithData_Yes, WithData_Yes );
+
+
+// 2. sort patches by GID since HDF5 returns the selected elements in the order of the file
+   int *GID_Sorted = new int [NLoad];
+   int *IdxTable   = new int [NLoad];
+
+   memcpy( GID_Sorted, LoadGID, NLoad*sizeof(int) );
+
+   Mis_RadixSort( NLoad, GID_Sorted, IdxTable );
+
+
+// 3. load grid data
+   real *Buf = new real [ (long)NLoad*PatchSize ];
+
+   H5_MemDims[0] = (hsize_t)MAX( NLoad, 1 )*CUBE(PS1);
+   H5_MemID      = H5Screate_simple( 1, H5_MemDims, NULL );
+   if ( H5_MemID < 0 )  Aux_Error( ERROR_INFO, "failed to create the space \"%s\" !!\n", "H5_MemID" );
+   if ( NLoad == 0 )    H5Sselect_none( H5_MemID );
+
+// 3-1. select all target patches as a union of runs of consecutive GIDs
+   H5_Status = H5Sselect_none( H5_SpaceID_Field );
+
+   for (int s0=0, s1; s0<NLoad; s0=s1)
+   {
+      for (s1=s0+1; s1<NLoad && GID_Sorted[s1]==GID_Sorted[s1-1]+1; s1++) {}
+
+      H5_Offset[0] = GID_Sorted[s0];
+      H5_Count [0] = s1 - s0;
+      for (int t=1; t<4; t++)
+      {
+         H5_Offset[t] = 0;
+         H5_Count [t] = PS1;
+      }
+
+      H5_Status = H5Sselect_hyperslab( H5_SpaceID_Field, H5S_SELECT_OR, H5_Offset, NULL, H5_Count, NULL );
+      if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to create a hyperslab for the grid data !!\n" );
+   }
+
+// 3-2. load cell-centered intrinsic variables from disk
+// --> excluding all derived variables such as gravitational potential and cell-centered B field
+   for (int v=0; v<NCOMP_TOTAL; v++)
+   {
+      H5_Status = H5Dread( H5_SetID_Field[v], H5T_GAMER_REAL, H5_MemID, H5_SpaceID_Field, H5_DataXferPropList,
+                           ( NLoad > 0 ) ? Buf : &Dummy );
+      if ( H5_Status < 0 )
+         Aux_Error( ERROR_INFO, "failed to load a field variable (lv %d, v %d) !!\n", lv, v );
+
+      for (int s=0; s<NLoad; s++)
+         memcpy( amr->patch[ amr->FluSg[lv] ][lv][ PID0+IdxTable[s] ]->fluid[v], Buf+(long)s*CUBE(PS1),
+                 CUBE(PS1)*sizeof(real) );
+   }
+
+   H5_Status = H5Sclose( H5_MemID );
+
+
+// 3-3. load face-centered magnetic field from disk
+#  ifdef MHD
+   H5_MemDims[0] = (hsize_t)MAX( NLoad, 1 )*PS1P1*SQR(PS1);
+   H5_MemID      = H5Screate_simple( 1, H5_MemDims, NULL );
+   if ( H5_MemID < 0 )  Aux_Error( ERROR_INFO, "failed to create the space \"%s\" !!\n", "H5_MemID" );
+   if ( NLoad == 0 )    H5Sselect_none( H5_MemID );
+
+   for (int v=0; v<NCOMP_MAG; v++)
+   {
+      H5_Status = H5Sselect_none( H5_SpaceID_FCMag[v] );
+
+      for (int s0=0, s1; s0<NLoad; s0=s1)
+      {
+         for (s1=s0+1; s1<NLoad && GID_Sorted[s1]==GID_Sorted[s1-1]+1; s1++) {}
+
+         H5_Offset[0] = GID_Sorted[s0];
+         H5_Count [0] = s1 - s0;
+         for (int t=1; t<4; t++)
+         {
+            H5_Offset[t] = 0;
+            H5_Count [t] = ( 3-t == v ) ? PS1P1 : PS1;
+         }
+
+         H5_Status = H5Sselect_hyperslab( H5_SpaceID_FCMag[v], H5S_SELECT_OR, H5_Offset, NULL, H5_Count, NULL );
+         if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to create a hyperslab for the magnetic field %d !!\n", v );
+      }
+
+      H5_Status = H5Dread( H5_SetID_FCMag[v], H5T_GAMER_REAL, H5_MemID, H5_SpaceID_FCMag[v], H5_DataXferPropList,
+                           ( NLoad > 0 ) ? Buf : &Dummy );
+      if ( H5_Status < 0 )
+         Aux_Error( ERROR_INFO, "failed to load magnetic field (lv %d, v %d) !!\n", lv, v );
+
+      for (int s=0; s<NLoad; s++)
+         memcpy( amr->patch[ amr->MagSg[lv] ][lv][ PID0+IdxTable[s] ]->magnetic[v], Buf+(long)s*PS1P1*SQR(PS1),
+                 PS1P1*SQR(PS1)*sizeof(real) );
+   } // for (int v=0; v<NCOMP_MAG; v++)
+
+   H5_Status = H5Sclose( H5_MemID );
+#  endif // #ifdef MHD
+
+   delete [] Buf;
+
+
+// 4. load particle data
+#  ifdef PARTICLE
+   if ( H5_SetID_ParData != NULL )
+   {
+      long   NParThisLv = 0;
+      long  *ParBufIdx  = new long [NLoad];   // index of the first particle of each patch in ParBuf
+      real **ParBuf     = NULL;
+      real   NewParAtt[PAR_NATT_TOTAL];
+
+//    4-1. select particles of all target patches as a union of runs of consecutive global particle indices
+      H5_Status = H5Sselect_none( H5_SpaceID_ParData );
+
+      for (int s0=0, s1; s0<NLoad; s0=s1)
+      {
+         long NParRun = 0;
+
+         for (s1=s0; s1<NLoad; s1++)
+         {
+            const int t = IdxTable[s1];
+
+            if ( LoadGParID[t] != LoadGParID[ IdxTable[s0] ] + NParRun )  break;
+
+            ParBufIdx[t] = NParThisLv + NParRun;
+            NParRun     += LoadNPar[t];
+         }
+
+         if ( NParRun > 0 )
+         {
+            H5_Offset[0] = LoadGParID[ IdxTable[s0] ];
+            H5_Count [0] = NParRun;
+
+            H5_Status = H5Sselect_hyperslab( H5_SpaceID_ParData, H5S_SELECT_OR, H5_Offset, NULL, H5_Count, NULL );
+            if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to create a hyperslab for the particle data !!\n" );
+         }
+
+         NParThisLv += NParRun;
+      }
+
+      H5_MemDims[0] = MAX( NParThisLv, 1L );
+      H5_MemID      = H5Screate_simple( 1, H5_MemDims, NULL );
+      if ( H5_MemID < 0 )     Aux_Error( ERROR_INFO, "failed to create the space \"%s\" !!\n", "H5_MemID" );
+      if ( NParThisLv == 0 )  H5Sselect_none( H5_MemID );
+
+//    4-2. load particle data from disk
+//    be careful about using ParBuf returned from Aux_AllocateArray2D, which is set to NULL if NParThisLv == 0
+      Aux_AllocateArray2D( ParBuf, PAR_NATT_STORED, NParThisLv );
+
+      for (int v=0; v<PAR_NATT_STORED; v++)
+      {
+         H5_Status = H5Dread( H5_SetID_ParData[v], H5T_GAMER_REAL, H5_MemID, H5_SpaceID_ParData, H5_DataXferPropList,
+                              ( NParThisLv > 0 ) ? ParBuf[v] : &Dummy );
+         if ( H5_Status < 0 )
+            Aux_Error( ERROR_INFO, "failed to load a particle attribute (lv %d, v %d) !!\n", lv, v );
+      }
+
+      H5_Status = H5Sclose( H5_MemID );
+
+//    4-3. store particles to the particle repository and link them to their patches
+//    --> follow the order of patch allocation
+      NewParAtt[PAR_TIME] = Time[0];   // all particles are assumed to be synchronized with the base level
+
+      for (int t=0; t<NLoad; t++)
+      {
+         const int NParThisPatch = LoadNPar[t];
+         const int PID           = PID0 + t;
+
+         if ( NParThisPatch == 0 )  continue;
+
+         for (int p=0; p<NParThisPatch; p++)
+         {
+//          skip the last PAR_NATT_UNSTORED attributes since we do not store them on disk
+            for (int v=0; v<PAR_NATT_STORED; v++)  NewParAtt[v] = ParBuf[v][ ParBufIdx[t] + p ];
+
+            NewParList[p] = amr->Par->AddOneParticle( NewParAtt );
+
+//          check
+            if ( NewParList[p] >= NParThisRank )
+               Aux_Error( ERROR_INFO, "New particle ID (%ld) >= maximum allowed value (%ld) !!\n",
+                          NewParList[p], NParThisRank );
+         }
+
+         const real *PType = amr->Par->Type;
+#        ifdef DEBUG_PARTICLE
+         const real *ParPos[3] = { amr->Par->PosX, amr->Par->PosY, amr->Par->PosZ };
+         char Comment[MAX_STRING];
+         sprintf( Comment, "%s, lv %d, PID %d, GID %d, NPar %d", __FUNCTION__, lv, PID, LoadGID[t], NParThisPatch );
+         amr->patch[0][lv][PID]->AddParticle( NParThisPatch, NewParList, &amr->Par->NPar_Lv[lv],
+                                              PType, ParPos, amr->Par->NPar_AcPlusInac, Comment );
+#        else
+         amr->patch[0][lv][PID]->AddParticle( NParThisPatch, NewParList, &amr->Par->NPar_Lv[lv],
+                                              PType );
+#        endif
+      } // for (int t=0; t<NLoad; t++)
+
+      delete [] ParBufIdx;
+      Aux_DeallocateArray2D( ParBuf );
+   } // if ( H5_SetID_ParData != NULL )
+#  endif // #ifdef PARTICLE
+
+
+   delete [] GID_Sorted;
+   delete [] IdxTable;
+
+} // FUNCTION : LoadPatches_Distributed
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LoadTreeSlab
+// Description :  Load a contiguous range of patches from a dataset in the group "Tree"
+//
+// Note        :  1. Collective if H5_DataXferPropList adopts the MPI-IO collective mode
+//                   --> Must be called by all ranks in that case even if Count == 0
+//
+// Parameter   :  H5_FileID           : HDF5 file ID of the restart file
+//                SetName             : Target dataset name
+//                H5_TypeID           : HDF5 memory datatype
+//                NComp               : Number of components of each patch (e.g., 3 for corner)
+//                Start               : GID of the first target patch
+//                Count               : Number of target patches
+//                H5_DataXferPropList : HDF5 data transfer property list
+//                Buf                 : Array to store the loaded data
+//-------------------------------------------------------------------------------------------------------
+void LoadTreeSlab( const hid_t H5_FileID, const char *SetName, const hid_t H5_TypeID, const int NComp,
+                   const long Start, const long Count, const hid_t H5_DataXferPropList, void *Buf )
+{
+
+   const int Rank = ( NComp == 1 ) ? 1 : 2;
+
+   hsize_t H5_Offset[2] = { (hsize_t)Start, 0 };
+   hsize_t H5_Count [2] = { (hsize_t)Count, (hsize_t)NComp };
+   hsize_t H5_MemDims[2] = { (hsize_t)MAX( Count, 1L ), (hsize_t)NComp };
+   hid_t   H5_SetID, H5_SpaceID, H5_MemID;
+   herr_t  H5_Status;
+   long    Dummy[3];
+
+
+   H5_SetID = H5Dopen( H5_FileID, SetName, H5P_DEFAULT );
+   if ( H5_SetID < 0 )  Aux_Error( ERROR_INFO, "failed to open the dataset \"%s\" !!\n", SetName );
+
+   H5_SpaceID = H5Dget_space( H5_SetID );
+   H5_MemID   = H5Screate_simple( Rank, H5_MemDims, NULL );
+
+   if ( Count > 0 )
+      H5_Status = H5Sselect_hyperslab( H5_SpaceID, H5S_SELECT_SET, H5_Offset, NULL, H5_Count, NULL );
+   else
+   {
+      H5_Status = H5Sselect_none( H5_SpaceID );
+      H5_Status = H5Sselect_none( H5_MemID );
+   }
+   if ( H5_Status < 0 )    Aux_Error( ERROR_INFO, "failed to select the dataset \"%s\" !!\n", SetName );
+
+   H5_Status = H5Dread( H5_SetID, H5_TypeID, H5_MemID, H5_SpaceID, H5_DataXferPropList, ( Count > 0 ) ? Buf : Dummy );
+   if ( H5_Status < 0 )    Aux_Error( ERROR_INFO, "failed to load the dataset \"%s\" !!\n", SetName );
+
+   H5_Status = H5Sclose( H5_MemID );
+   H5_Status = H5Sclose( H5_SpaceID );
+   H5_Status = H5Dclose( H5_SetID );
+
+} // FUNCTION : LoadTreeSlab
+#endif // #ifdef LOAD_BALANCE
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Check_Makefile
 // Description :  Load and compare the Makefile_t structure (runtime vs. restart file)
@@ -1411,6 +1931,7 @@ void Check_Makefile( const char *FileName, const int FormatVersion )
 
    const bool    Fatal = true;
    const bool NonFatal = false;
+   const int *NullPtr  = NULL;
 
    herr_t Status;
 
@@ -1466,7 +1987,8 @@ void Check_Makefile( const char *FileName, const int FormatVersion )
    LoadField( "RandomNumber",           &RS.RandomNumber,           SID, TID, NonFatal, &RT.RandomNumber,           1, NonFatal );
 
    LoadField( "NLevel",                 &RS.NLevel,                 SID, TID, NonFatal, &RT.NLevel,                 1, NonFatal );
-   LoadField( "MaxPatch",               &RS.MaxPatch,               SID, TID, NonFatal, &RT.MaxPatch,               1, NonFatal );
+// MaxPatch is no longer a compile-time limit after FormatVersion 2460 --> skip the comparison
+   LoadField( "MaxPatch",               &RS.MaxPatch,               SID, TID, NonFatal,  NullPtr,                  -1, NonFatal );
 
 #  ifdef GRAVITY
    LoadField( "PotScheme",              &RS.PotScheme,              SID, TID, NonFatal, &RT.PotScheme,              1, NonFatal );
@@ -1793,6 +2315,8 @@ void Check_InputPara( const char *FileName, const int FormatVersion )
    LoadField( "Par_GhostSize",           &RS.Par_GhostSize,           SID, TID, NonFatal, &RT.Par_GhostSize,            1, NonFatal );
    LoadField( "Par_GhostSizeTracer",     &RS.Par_GhostSizeTracer,     SID, TID, NonFatal, &RT.Par_GhostSizeTracer,      1, NonFatal );
    LoadField( "Par_TracerVelCorr",       &RS.Par_TracerVelCorr,       SID, TID, NonFatal, &RT.Par_TracerVelCorr,        1, NonFatal );
+   LoadField( "Par_FixedPointDepo",      &RS.Par_FixedPointDepo,      SID, TID, NonFatal, &RT.Par_FixedPointDepo,       1, NonFatal );
+   LoadField( "Par_SortInterval",        &RS.Par_SortInterval,        SID, TID, NonFatal, &RT.Par_SortInterval,         1, NonFatal );
 #  endif
 
 // cosmology
@@ -1824,6 +2348,9 @@ void Check_InputPara( const char *FileName, const int FormatVersion )
    LoadField( "Dt__SyncChildrenLv",      &RS.Dt__SyncChildrenLv,      SID, TID, NonFatal, &RT.Dt__SyncChildrenLv,       1, NonFatal );
    LoadField( "Opt__DtUser",             &RS.Opt__DtUser,             SID, TID, NonFatal, &RT.Opt__DtUser,              1, NonFatal );
    LoadField( "Opt__DtLevel",            &RS.Opt__DtLevel,            SID, TID, NonFatal, &RT.Opt__DtLevel,             1, NonFatal );
+#  if ( MODEL == HYDRO )
+   LoadField( "Opt__DtFluFused",         &RS.Opt__DtFluFused,         SID, TID, NonFatal, &RT.Opt__DtFluFused,          1, NonFatal );
+#  endif
    LoadField( "Opt__RecordDt",           &RS.Opt__RecordDt,           SID, TID, NonFatal, &RT.Opt__RecordDt,            1, NonFatal );
    LoadField( "AutoReduceDt",            &RS.AutoReduceDt,            SID, TID, NonFatal, &RT.AutoReduceDt,             1, NonFatal );
    LoadField( "AutoReduceDtFactor",      &RS.AutoReduceDtFactor,      SID, TID, NonFatal, &RT.AutoReduceDtFactor,       1, NonFatal );
@@ -1872,6 +2399,9 @@ void Check_InputPara( const char *FileName, const int FormatVersion )
 #  endif
    LoadField( "Opt__ReuseMemory",        &RS.Opt__ReuseMemory,        SID, TID, NonFatal, &RT.Opt__ReuseMemory,         1, NonFatal );
    LoadField( "Opt__MemoryPool",         &RS.Opt__MemoryPool,         SID, TID, NonFatal, &RT.Opt__MemoryPool,          1, NonFatal );
+   LoadField( "MemoryPool_Headroom",     &RS.MemoryPool_Headroom,     SID, TID, NonFatal, &RT.MemoryPool_Headroom,      1, NonFatal );
+   LoadField( "MemoryPool_MaxMB",        &RS.MemoryPool_MaxMB,        SID, TID, NonFatal, &RT.MemoryPool_MaxMB,         1, NonFatal );
+   LoadField( "Opt__SlabAlloc",          &RS.Opt__SlabAlloc,          SID, TID, NonFatal, &RT.Opt__SlabAlloc,           1, NonFatal );
 
 // load balance
 #  ifdef LOAD_BALANCE
@@ -1880,6 +2410,10 @@ void Check_InputPara( const char *FileName, const int FormatVersion )
    LoadField( "LB_Par_Weight",           &RS.LB_Par_Weight,           SID, TID, NonFatal, &RT.LB_Par_Weight,            1, NonFatal );
 #  endif
    LoadField( "Opt__RecordLoadBalance",  &RS.Opt__RecordLoadBalance,  SID, TID, NonFatal, &RT.Opt__RecordLoadBalance,   1, NonFatal );
+   LoadField( "Opt__LB_Diffuse",         &RS.Opt__LB_Diffuse,         SID, TID, NonFatal, &RT.Opt__LB_Diffuse,          1, NonFatal );
+   LoadField( "Opt__LB_MeasureCost",     &RS.Opt__LB_MeasureCost,     SID, TID, NonFatal, &RT.Opt__LB_MeasureCost,      1, NonFatal );
+   LoadField( "LB_MeasureCostWeight",    &RS.LB_MeasureCostWeight,    SID, TID, NonFatal, &RT.LB_MeasureCostWeight,     1, NonFatal );
+   LoadField( "Opt__LB_NeighborMPI",     &RS.Opt__LB_NeighborMPI,     SID, TID, NonFatal, &RT.Opt__LB_NeighborMPI,      1, NonFatal );
 #  endif
    LoadField( "Opt__MinimizeMPIBarrier", &RS.Opt__MinimizeMPIBarrier, SID, TID, NonFatal, &RT.Opt__MinimizeMPIBarrier,  1, NonFatal );
 
@@ -1922,6 +2456,10 @@ void Check_InputPara( const char *FileName, const int FormatVersion )
    LoadField( "IntFracPassive_NVar",     &RS.IntFracPassive_NVar,     SID, TID, NonFatal, &RT.IntFracPassive_NVar,      1, NonFatal );
    LoadField( "IntFracPassive_VarIdx",    RS.IntFracPassive_VarIdx,   SID, TID, NonFatal,  RT.IntFracPassive_VarIdx,   NP, NonFatal );
    LoadField( "Opt__OverlapMPI",         &RS.Opt__OverlapMPI,         SID, TID, NonFatal, &RT.Opt__OverlapMPI,          1, NonFatal );
+   LoadField( "Opt__CPU_Pipeline",       &RS.Opt__CPU_Pipeline,       SID, TID, NonFatal, &RT.Opt__CPU_Pipeline,        1, NonFatal );
+   LoadField( "CPU_Pipeline_NThread",    &RS.CPU_Pipeline_NThread,    SID, TID, NonFatal, &RT.CPU_Pipeline_NThread,     1, NonFatal );
+   LoadField( "Opt__PrepCache",          &RS.Opt__PrepCache,          SID, TID, NonFatal, &RT.Opt__PrepCache,           1, NonFatal );
+   LoadField( "PrepCache_MaxMB",         &RS.PrepCache_MaxMB,         SID, TID, NonFatal, &RT.PrepCache_MaxMB,          1, NonFatal );
    LoadField( "Opt__ResetFluid",         &RS.Opt__ResetFluid,         SID, TID, NonFatal, &RT.Opt__ResetFluid,          1, NonFatal );
    LoadField( "Opt__FreezeFluid",        &RS.Opt__FreezeFluid,        SID, TID, NonFatal, &RT.Opt__FreezeFluid,         1, NonFatal );
 #  if ( MODEL == HYDRO  ||  MODEL == ELBDM )
@@ -1954,10 +2492,14 @@ void Check_InputPara( const char *FileName, const int FormatVersion )
    LoadField( "MG_NPreSmooth",           &RS.MG_NPreSmooth,           SID, TID, NonFatal, &RT.MG_NPreSmooth,            1, NonFatal );
    LoadField( "MG_NPostSmooth",          &RS.MG_NPostSmooth,          SID, TID, NonFatal, &RT.MG_NPostSmooth,           1, NonFatal );
    LoadField( "MG_ToleratedError",       &RS.MG_ToleratedError,       SID, TID, NonFatal, &RT.MG_ToleratedError,        1, NonFatal );
+   LoadField( "Opt__PoiLevelMG",         &RS.Opt__PoiLevelMG,         SID, TID, NonFatal, &RT.Opt__PoiLevelMG,          1, NonFatal );
 #  endif
    LoadField( "Pot_GPU_NPGroup",         &RS.Pot_GPU_NPGroup,         SID, TID, NonFatal, &RT.Pot_GPU_NPGroup,          1, NonFatal );
    LoadField( "Opt__GraP5Gradient",      &RS.Opt__GraP5Gradient,      SID, TID, NonFatal, &RT.Opt__GraP5Gradient,       1, NonFatal );
    LoadField( "Opt__SelfGravity",        &RS.Opt__SelfGravity,        SID, TID, NonFatal, &RT.Opt__SelfGravity,         1, NonFatal );
+   LoadField( "Opt__FFT_Pencil",         &RS.Opt__FFT_Pencil,         SID, TID, NonFatal, &RT.Opt__FFT_Pencil,          1, NonFatal );
+   LoadField( "Opt__FFTW_Startup",       &RS.Opt__FFTW_Startup,       SID, TID, NonFatal, &RT.Opt__FFTW_Startup,        1, NonFatal );
+   LoadField( "Opt__FFTW_Wisdom",        &RS.Opt__FFTW_Wisdom,        SID, TID, NonFatal, &RT.Opt__FFTW_Wisdom,         1, NonFatal );
    LoadField( "Opt__ExtAcc",             &RS.Opt__ExtAcc,             SID, TID, NonFatal, &RT.Opt__ExtAcc,              1, NonFatal );
    LoadField( "Opt__ExtPot",             &RS.Opt__ExtPot,             SID, TID, NonFatal, &RT.Opt__ExtPot,              1, NonFatal );
    LoadField( "ExtPotTable_Name",        &RS.ExtPotTable_Name,        SID, TID, NonFatal,  RT.ExtPotTable_Name,         1, NonFatal );
@@ -2081,6 +2623,9 @@ void Check_InputPara( const char *FileName, const int FormatVersion )
 #  endif
    LoadField( "Opt__Output_Mode",        &RS.Opt__Output_Mode,        SID, TID, NonFatal, &RT.Opt__Output_Mode,         1, NonFatal );
    LoadField( "Opt__Output_Restart",     &RS.Opt__Output_Restart,     SID, TID, NonFatal, &RT.Opt__Output_Restart,      1, NonFatal );
+   LoadField( "Opt__Output_HDF5_MPIIO",  &RS.Opt__Output_HDF5_MPIIO,  SID, TID, NonFatal, &RT.Opt__Output_HDF5_MPIIO,   1, NonFatal );
+   LoadField( "Opt__Output_Async",       &RS.Opt__Output_Async,       SID, TID, NonFatal, &RT.Opt__Output_Async,        1, NonFatal );
+   LoadField( "Output_Async_MaxMB",      &RS.Output_Async_MaxMB,      SID, TID, NonFatal, &RT.Output_Async_MaxMB,       1, NonFatal );
    LoadField( "Opt__Output_Step",        &RS.Opt__Output_Step,        SID, TID, NonFatal, &RT.Opt__Output_Step,         1, NonFatal );
    LoadField( "Opt__Output_Dt",          &RS.Opt__Output_Dt,          SID, TID, NonFatal, &RT.Opt__Output_Dt,           1, NonFatal );
    }
@@ -320,8 +320,8 @@ void Init_ByRestart_v1( const char FileName[] )
 //    d0-2. set the cut points
 //    --> do NOT consider load-balance weighting of particles since at this point we don't have that information
       const double ParWeight_Zero = 0.0;
-      LB_SetCutPoint( lv, NPatchTotal[lv]/8, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_AllRank, Load_AllRank,
-                      ParWeight_Zero );
+      LB_SetCutPoint( lv, (MPI_Rank==0)?NPatchTotal[lv]/8:0, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_AllRank,
+                      Load_AllRank, ParWeight_Zero );
 
       if ( MPI_Rank == 0 )
       {
@@ -434,7 +434,7 @@ void Init_ByRestart_v1( const char FileName[] )
             for (int RPID=0; RPID<amr->NPatchComma[lv][1]; RPID++)
                amr->LB->IdxList_Real[lv][RPID] = amr->patch[0][lv][RPID]->LB_Idx;
 
-            Mis_Heapsort( amr->NPatchComma[lv][1], amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
+            Mis_RadixSort( amr->NPatchComma[lv][1], amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
 #           endif // #ifdef LOAD_BALANCE
 
             Offset += DataSize[lv];
@@ -480,9 +480,10 @@ void Init_ByRestart_v1( const char FileName[] )
    const bool   SendGridData_No  = false;
    const bool   ResetLB_Yes      = true;
    const bool   ResetLB_No       = false;
+   const bool   Diffuse_No       = false;
    const int    AllLv            = -1;
 
-   LB_Init_LoadBalance( Redistribute_No, SendGridData_No, ParWeight_Zero, ResetLB_No, AllLv );
+   LB_Init_LoadBalance( Redistribute_No, SendGridData_No, ParWeight_Zero, ResetLB_No, Diffuse_No, AllLv );
 
 
 // fill up the data of non-leaf patches
@@ -728,10 +729,6 @@ void Load_Parameter_Before_1200( FILE *File, const int FormatVersion, int &NLv_R
          Aux_Message( stderr, "          --> Grid scale will be rescaled\n" );
       }
 
-      if ( max_patch != MAX_PATCH )
-         Aux_Message( stderr, "WARNING : %s : RESTART file (%d) != runtime (%d) !!\n",
-                      "MAX_PATCH", max_patch, MAX_PATCH );
-
       if ( flu_ghost_size != FLU_GHOST_SIZE )
          Aux_Message( stderr, "WARNING : %s : RESTART file (%d) != runtime (%d) !!\n",
                       "FLU_GHOST_SIZE", flu_ghost_size, FLU_GHOST_SIZE );
@@ -1198,8 +1195,6 @@ void Load_Parameter_After_1200( FILE *File, const int FormatVersion, int &NLv_Re
          Aux_Message( stderr, "          --> Grid scale will be rescaled\n" );
       }
 
-      CompareVar( "MAX_PATCH", max_patch, MAX_PATCH, NonFatal );
-
 
 
 //    d-2. check the symbolic constants defined in "Macro.h, CUPOT.h, and CUFLU.h"
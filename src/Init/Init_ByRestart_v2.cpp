@@ -416,7 +416,7 @@ void Init_ByRestart()
 //    d0-2. set the cut points
 //    --> do NOT consider load-balance weighting of particles since at this point we don't have that information
       const double ParWeight_Zero = 0.0;
-      LB_SetCutPoint( lv, NPatchTotal[lv]/8, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_AllRank,
+      LB_SetCutPoint( lv, (MPI_Rank==0)?NPatchTotal[lv]/8:0, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_AllRank,
                       Load_AllRank, ParWeight_Zero );
 
       if ( MPI_Rank == 0 )
@@ -550,7 +550,7 @@ void Init_ByRestart()
             for (int RPID=0; RPID<amr->NPatchComma[lv][1]; RPID++)
                amr->LB->IdxList_Real[lv][RPID] = amr->patch[0][lv][RPID]->LB_Idx;
 
-            Mis_Heapsort( amr->NPatchComma[lv][1], amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
+            Mis_RadixSort( amr->NPatchComma[lv][1], amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
 #           endif // #ifdef LOAD_BALANCE
 
             Offset += DataSize[lv];
@@ -708,14 +708,15 @@ void Init_ByRestart()
    const bool   SendGridData_No  = false;
    const bool   ResetLB_Yes      = true;
    const bool   ResetLB_No       = false;
+   const bool   Diffuse_No       = false;
    const int    AllLv            = -1;
 
-   LB_Init_LoadBalance( Redistribute_No, SendGridData_No, ParWeight_Zero, ResetLB_No, AllLv );
+   LB_Init_LoadBalance( Redistribute_No, SendGridData_No, ParWeight_Zero, ResetLB_No, Diffuse_No, AllLv );
 
 // redistribute patches again if we want to take into account the load-balance weighting of particles
 #  ifdef PARTICLE
    if ( amr->LB->Par_Weight > 0.0 )
-   LB_Init_LoadBalance( Redistribute_Yes, SendGridData_Yes, amr->LB->Par_Weight, ResetLB_Yes, AllLv );
+   LB_Init_LoadBalance( Redistribute_Yes, SendGridData_Yes, amr->LB->Par_Weight, ResetLB_Yes, Diffuse_No, AllLv );
 #  endif
 
 
@@ -1188,8 +1189,6 @@ void Load_Parameter_After_2000( FILE *File, const int FormatVersion, int &NLv_Re
          Aux_Message( stderr, "          --> Grid scale will be rescaled\n" );
       }
 
-      CompareVar( "MAX_PATCH", max_patch, MAX_PATCH, NonFatal );
-
       CompareVar( "EOS",       eos,       EOS,       NonFatal );
 
 
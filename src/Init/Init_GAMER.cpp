@@ -173,7 +173,7 @@ void Init_GAMER( int *argc, char ***argv )
 
 
 // initialize memory pool
-   if ( OPT__MEMORY_POOL )    Init_MemoryPool();
+   if ( OPT__MEMORY_POOL == MEMORY_POOL_TABLE )    Init_MemoryPool();
 
 
 // allocate memory for several global arrays
@@ -236,6 +236,13 @@ void Init_GAMER( int *argc, char ***argv )
    if ( Init_User_Ptr != NULL )  Init_User_Ptr();
 
 
+// sort particles by patches
+// --> after the user-defined initialization, which may add particles
+#  ifdef PARTICLE
+   if ( amr->Par->SortInterval > 0 )   Par_SortByPatch();
+#  endif
+
+
 // record the initial weighted load-imbalance factor
 #  ifdef LOAD_BALANCE
    if ( OPT__RECORD_LOAD_BALANCE )  LB_EstimateLoadImbalance();
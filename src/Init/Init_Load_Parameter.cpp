@@ -88,6 +88,8 @@ void Init_Load_Parameter()
    ReadPara->Add( "PAR_REMOVE_CELL",            &amr->Par->RemoveCell,           -1.0,              NoMin_double,  NoMax_double   );
    ReadPara->Add( "OPT__FREEZE_PAR",            &OPT__FREEZE_PAR,                 false,            Useless_bool,  Useless_bool   );
    ReadPara->Add( "PAR_TR_VEL_CORR",            &amr->Par->TracerVelCorr,         false,            Useless_bool,  Useless_bool   );
+   ReadPara->Add( "PAR_FIXED_POINT_DEPO",       &amr->Par->FixedPointDepo,        false,            Useless_bool,  Useless_bool   );
+   ReadPara->Add( "PAR_SORT_INTERVAL",          &amr->Par->SortInterval,          0,                0,             NoMax_int      );
 #  endif // #ifdef PARTICLE
 
 
@@ -122,6 +124,9 @@ void Init_Load_Parameter()
    ReadPara->Add( "DT__SYNC_CHILDREN_LV",       &DT__SYNC_CHILDREN_LV,            0.1,             0.0,           1.0            );
    ReadPara->Add( "OPT__DT_USER",               &OPT__DT_USER,                    false,           Useless_bool,  Useless_bool   );
    ReadPara->Add( "OPT__DT_LEVEL",              &OPT__DT_LEVEL,                   3,               1,             3              );
+#  if ( MODEL == HYDRO )
+   ReadPara->Add( "OPT__DT_FLU_FUSED",          &OPT__DT_FLU_FUSED,               false,           Useless_bool,  Useless_bool   );
+#  endif
    ReadPara->Add( "OPT__RECORD_DT",             &OPT__RECORD_DT,                  true,            Useless_bool,  Useless_bool   );
    ReadPara->Add( "AUTO_REDUCE_DT",             &AUTO_REDUCE_DT,                  true,            Useless_bool,  Useless_bool   );
    ReadPara->Add( "AUTO_REDUCE_DT_FACTOR",      &AUTO_REDUCE_DT_FACTOR,           0.8,             Eps_double,    1.0            );
@@ -167,7 +172,10 @@ void Init_Load_Parameter()
    ReadPara->Add( "OPT__PARTICLE_COUNT",        &OPT__PARTICLE_COUNT,             1,               0,             2              );
 #  endif
    ReadPara->Add( "OPT__REUSE_MEMORY",          &OPT__REUSE_MEMORY,               2,               0,             2              );
-   ReadPara->Add( "OPT__MEMORY_POOL",           &OPT__MEMORY_POOL,                false,           Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OPT__MEMORY_POOL",           &OPT__MEMORY_POOL,                0,               0,             2              );
+   ReadPara->Add( "MEMORY_POOL_HEADROOM",       &MEMORY_POOL_HEADROOM,            0.2,             0.0,           NoMax_double   );
+   ReadPara->Add( "MEMORY_POOL_MAX_MB",         &MEMORY_POOL_MAX_MB,             -1.0,             NoMin_double,  NoMax_double   );
+   ReadPara->Add( "OPT__SLAB_ALLOC",            &OPT__SLAB_ALLOC,                 false,           Useless_bool,  Useless_bool   );
 
 
 // load balance
@@ -177,6 +185,10 @@ void Init_Load_Parameter()
    ReadPara->Add( "LB_INPUT__PAR_WEIGHT",       &LB_INPUT__PAR_WEIGHT,            0.0,             0.0,           NoMax_double   );
 #  endif
    ReadPara->Add( "OPT__RECORD_LOAD_BALANCE",   &OPT__RECORD_LOAD_BALANCE,        true,            Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OPT__LB_DIFFUSE",            &OPT__LB_DIFFUSE,                 false,           Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OPT__LB_MEASURE_COST",       &OPT__LB_MEASURE_COST,            false,           Useless_bool,  Useless_bool   );
+   ReadPara->Add( "LB_MEASURE_COST_WEIGHT",     &LB_MEASURE_COST_WEIGHT,          0.5,             Eps_double,    1.0            );
+   ReadPara->Add( "OPT__LB_NEIGHBOR_MPI",       &OPT__LB_NEIGHBOR_MPI,            true,            Useless_bool,  Useless_bool   );
 #  endif
    ReadPara->Add( "OPT__MINIMIZE_MPI_BARRIER",  &OPT__MINIMIZE_MPI_BARRIER,       true,            Useless_bool,  Useless_bool   );
 
@@ -276,6 +288,11 @@ void Init_Load_Parameter()
    ReadPara->Add( "OPT__NORMALIZE_PASSIVE",     &OPT__NORMALIZE_PASSIVE,          true,            Useless_bool,  Useless_bool   );
    ReadPara->Add( "OPT__INT_FRAC_PASSIVE_LR",   &OPT__INT_FRAC_PASSIVE_LR,        true,            Useless_bool,  Useless_bool   );
    ReadPara->Add( "OPT__OVERLAP_MPI",           &OPT__OVERLAP_MPI,                false,           Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OPT__CPU_PIPELINE",          &OPT__CPU_PIPELINE,               false,           Useless_bool,  Useless_bool   );
+// do not check CPU_PIPELINE_NTHREAD since it may be reset by Init_ResetDefaultParameter()
+   ReadPara->Add( "CPU_PIPELINE_NTHREAD",       &CPU_PIPELINE_NTHREAD,           -1,               NoMin_int,     NoMax_int      );
+   ReadPara->Add( "OPT__PREP_CACHE",            &OPT__PREP_CACHE,                 false,           Useless_bool,  Useless_bool   );
+   ReadPara->Add( "PREP_CACHE_MAX_MB",          &PREP_CACHE_MAX_MB,               1024.0,          Eps_double,    NoMax_double   );
    ReadPara->Add( "OPT__RESET_FLUID",           &OPT__RESET_FLUID,                false,           Useless_bool,  Useless_bool   );
    ReadPara->Add( "OPT__FREEZE_FLUID",          &OPT__FREEZE_FLUID,               false,           Useless_bool,  Useless_bool   );
 #  if ( MODEL == HYDRO )
@@ -309,10 +326,14 @@ void Init_Load_Parameter()
    ReadPara->Add( "MG_NPRE_SMOOTH",             &MG_NPRE_SMOOTH,                 -1,               NoMin_int,     NoMax_int      );
    ReadPara->Add( "MG_NPOST_SMOOTH",            &MG_NPOST_SMOOTH,                -1,               NoMin_int,     NoMax_int      );
    ReadPara->Add( "MG_TOLERATED_ERROR",         &MG_TOLERATED_ERROR,             -1.0,             NoMin_double,  NoMax_double   );
+   ReadPara->Add( "OPT__POI_LEVEL_MG",          &OPT__POI_LEVEL_MG,               false,           Useless_bool,  Useless_bool   );
 // do not check POT_GPU_NPGROUP since it may be reset by either Init_ResetDefaultParameter() or CUAPI_Set_Default_GPU_Parameter()
    ReadPara->Add( "POT_GPU_NPGROUP",            &POT_GPU_NPGROUP,                -1,               NoMin_int,     NoMax_int      );
    ReadPara->Add( "OPT__GRA_P5_GRADIENT",       &OPT__GRA_P5_GRADIENT,            false,           Useless_bool,  Useless_bool   );
    ReadPara->Add( "OPT__SELF_GRAVITY",          &OPT__SELF_GRAVITY,               true,            Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OPT__FFT_PENCIL",            &OPT__FFT_PENCIL,                -1,              -1,             1              );
+   ReadPara->Add( "OPT__FFTW_STARTUP",          &OPT__FFTW_STARTUP,              -1,              -1,             1              );
+   ReadPara->Add( "OPT__FFTW_WISDOM",           &OPT__FFTW_WISDOM,                true,            Useless_bool,  Useless_bool   );
    ReadPara->Add( "OPT__EXT_ACC",               &OPT__EXT_ACC,                    0,               0,             1              );
    ReadPara->Add( "OPT__EXT_POT",               &OPT__EXT_POT,                    0,               0,             2              );
 // do not check the parameters of external potential table here --> do it in Init_LoadExtPotTable()
@@ -421,6 +442,9 @@ void Init_Load_Parameter()
    ReadPara->Add( "OPT__OUTPUT_USER_FIELD",     &OPT__OUTPUT_USER_FIELD,          false,           Useless_bool,  Useless_bool   );
    ReadPara->Add( "OPT__OUTPUT_MODE",           &OPT__OUTPUT_MODE,               -1,               1,             3              );
    ReadPara->Add( "OPT__OUTPUT_RESTART",        &OPT__OUTPUT_RESTART,             false,           Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OPT__OUTPUT_HDF5_MPIIO",     &OPT__OUTPUT_HDF5_MPIIO,          true,            Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OPT__OUTPUT_ASYNC",          &OPT__OUTPUT_ASYNC,               false,           Useless_bool,  Useless_bool   );
+   ReadPara->Add( "OUTPUT_ASYNC_MAX_MB",        &OUTPUT_ASYNC_MAX_MB,             4096.0,          NoMin_double,  NoMax_double   );
 // do not check OUTPUT_STEP and OUTPUT_DT since they depend on OPT__OUTPUT_MODE
    ReadPara->Add( "OUTPUT_STEP",                &OUTPUT_STEP,                    -1,               NoMin_int,     NoMax_int      );
    ReadPara->Add( "OUTPUT_DT",                  &OUTPUT_DT,                      -1.0,             NoMin_double,  NoMax_double   );
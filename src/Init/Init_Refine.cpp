@@ -16,6 +16,9 @@ void Init_Refine( const int lv )
 
    if ( lv == NLEVEL-1 )   Aux_Error( ERROR_INFO, "refine the maximum level !!\n" );
 
+// clear the data cached by Prepare_PatchData() since the patches at lv+1 will be reconstructed
+   PrepCache_Invalidate( lv );
+
 
    const int Width = PATCH_SIZE*amr->scale[lv+1];
    bool AllocData[8];         // allocate data or not
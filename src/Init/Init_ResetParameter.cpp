@@ -1,5 +1,9 @@
 #include "GAMER.h"
 
+#ifdef SUPPORT_HDF5
+#include "hdf5.h"
+#endif
+
 
 
 
@@ -415,6 +419,46 @@ void Init_ResetParameter()
 #  endif
 
 
+// pencil decomposition for the base-level FFT
+// --> adopt it automatically when the slab decomposition cannot utilize all MPI ranks or when there are
+//     multiple OpenMP threads since only the pencil FFT is multithreaded
+#  ifdef GRAVITY
+#  ifdef SERIAL
+   if ( OPT__FFT_PENCIL != 0 )
+   {
+      OPT__FFT_PENCIL = 0;
+
+      PRINT_WARNING( OPT__FFT_PENCIL, FORMAT_INT, "since SERIAL is enabled" );
+   }
+#  else
+   if ( OPT__FFT_PENCIL < 0 )
+   {
+      const int NSlab = ( OPT__BC_POT == BC_POT_ISOLATED ) ? 2*NX0_TOT[2] : NX0_TOT[2];
+
+      OPT__FFT_PENCIL = ( MPI_NRank > NSlab  ||  OMP_NTHREAD > 1 ) ? 1 : 0;
+
+      PRINT_WARNING( OPT__FFT_PENCIL, FORMAT_INT, "" );
+   }
+#  endif
+#  endif // #ifdef GRAVITY
+
+
+// FFTW planning strategy
+// --> FFTW_STARTUP_MEASURE may lead to different FFTW plans and thus round-off errors between runs
+#  ifdef GRAVITY
+   if ( OPT__FFTW_STARTUP == FFTW_STARTUP_DEFAULT )
+   {
+#     ifdef BITWISE_REPRODUCIBILITY
+      OPT__FFTW_STARTUP = FFTW_STARTUP_ESTIMATE;
+#     else
+      OPT__FFTW_STARTUP = FFTW_STARTUP_MEASURE;
+#     endif
+
+      PRINT_WARNING( OPT__FFTW_STARTUP, FORMAT_INT, "" );
+   }
+#  endif
+
+
 // 1st-order flux correction
 #  if ( MODEL == HYDRO )
    if ( OPT__1ST_FLUX_CORR < 0 )
@@ -511,8 +555,9 @@ void Init_ResetParameter()
    }
 
 
-// turn off "OPT__OVERLAP_MPI" if (1) OVERLAP_MPI=ff, (2) SERIAL=on, (3) LOAD_BALANCE=off,
-//                                (4) OPENMP=off, (5) MPI thread support=MPI_THREAD_SINGLE
+// turn off "OPT__OVERLAP_MPI" if (1) OVERLAP_MPI=off, (2) SERIAL=on, (3) LOAD_BALANCE=off,
+//                                (4) OPENMP=off, (5) MPI thread support < MPI_THREAD_SERIALIZED,
+//                                (6) MHD=on, (7) OPT__TIMING_BARRIER=on
 #  ifndef OVERLAP_MPI
    if ( OPT__OVERLAP_MPI )
    {
@@ -553,14 +598,31 @@ void Init_ResetParameter()
 // check the level of MPI thread support
    int MPI_Thread_Status;
    MPI_Query_thread( &MPI_Thread_Status );
-   if ( OPT__OVERLAP_MPI  &&  MPI_Thread_Status == MPI_THREAD_SINGLE )
+   if ( OPT__OVERLAP_MPI  &&  MPI_Thread_Status < MPI_THREAD_SERIALIZED )
    {
       OPT__OVERLAP_MPI = false;
 
-      PRINT_WARNING( OPT__OVERLAP_MPI, FORMAT_INT, "since the level of MPI thread support == MPI_THREAD_SINGLE" );
+      PRINT_WARNING( OPT__OVERLAP_MPI, FORMAT_INT, "since the level of MPI thread support < MPI_THREAD_SERIALIZED" );
    }
 #  endif
 
+#  ifdef MHD
+   if ( OPT__OVERLAP_MPI )
+   {
+      OPT__OVERLAP_MPI = false;
+
+      PRINT_WARNING( OPT__OVERLAP_MPI, FORMAT_INT, "since it does not support MHD yet" );
+   }
+#  endif
+
+// MPI_Barrier() called by the timers is not thread-safe
+   if ( OPT__OVERLAP_MPI  &&  OPT__TIMING_BARRIER )
+   {
+      OPT__OVERLAP_MPI = false;
+
+      PRINT_WARNING( OPT__OVERLAP_MPI, FORMAT_INT, "since OPT__TIMING_BARRIER is enabled" );
+   }
+
 
 // disable "OPT__CK_FLUX_ALLOCATE" if no flux arrays are going to be allocated
    if ( OPT__CK_FLUX_ALLOCATE  &&  !amr->WithFlux )
@@ -784,6 +846,57 @@ void Init_ResetParameter()
 #  endif
 
 
+// turn off "OPT__CPU_PIPELINE" if (1) GPU=on, (2) OPENMP=off, (3) OMP_NTHREAD < 2, (4) OPT__TIMING_BARRIER=on
+#  ifdef GPU
+   if ( OPT__CPU_PIPELINE )
+   {
+      OPT__CPU_PIPELINE = false;
+
+      PRINT_WARNING( OPT__CPU_PIPELINE, FORMAT_INT, "since GPU is enabled" );
+   }
+#  endif
+
+#  ifndef OPENMP
+   if ( OPT__CPU_PIPELINE )
+   {
+      OPT__CPU_PIPELINE = false;
+
+      PRINT_WARNING( OPT__CPU_PIPELINE, FORMAT_INT, "since OPENMP is disabled" );
+   }
+#  endif
+
+   if ( OPT__CPU_PIPELINE  &&  OMP_NTHREAD < 2 )
+   {
+      OPT__CPU_PIPELINE = false;
+
+      PRINT_WARNING( OPT__CPU_PIPELINE, FORMAT_INT, "since OMP_NTHREAD < 2" );
+   }
+
+// MPI_Barrier() called by the timers is not thread-safe
+   if ( OPT__CPU_PIPELINE  &&  OPT__TIMING_BARRIER )
+   {
+      OPT__CPU_PIPELINE = false;
+
+      PRINT_WARNING( OPT__CPU_PIPELINE, FORMAT_INT, "since OPT__TIMING_BARRIER is enabled" );
+   }
+
+// give one quarter of the threads to the preparation and closing steps by default
+// --> they must leave at least one thread to the solvers
+   if ( OPT__CPU_PIPELINE  &&  CPU_PIPELINE_NTHREAD <= 0 )
+   {
+      CPU_PIPELINE_NTHREAD = MAX( 1, OMP_NTHREAD/4 );
+
+      PRINT_WARNING( CPU_PIPELINE_NTHREAD, FORMAT_INT, "" );
+   }
+
+   if ( OPT__CPU_PIPELINE  &&  CPU_PIPELINE_NTHREAD >= OMP_NTHREAD )
+   {
+      CPU_PIPELINE_NTHREAD = OMP_NTHREAD - 1;
+
+      PRINT_WARNING( CPU_PIPELINE_NTHREAD, FORMAT_INT, "since it must be smaller than OMP_NTHREAD" );
+   }
+
+
 // OPT__UM_IC_NVAR
    if ( OPT__INIT == INIT_BY_FILE  &&  OPT__UM_IC_NVAR <= 0 )
    {
@@ -957,6 +1070,32 @@ void Init_ResetParameter()
 #  endif // #ifdef STAR_FORMATION
 
 
+// disable OPT__OUTPUT_HDF5_MPIIO if (1) SERIAL=on, (2) SUPPORT_HDF5=off, (3) the HDF5 library is not built with MPI support
+#  if ( defined SERIAL  ||  !defined SUPPORT_HDF5  ||  !defined H5_HAVE_PARALLEL )
+   if ( OPT__OUTPUT_HDF5_MPIIO )
+   {
+      OPT__OUTPUT_HDF5_MPIIO = false;
+
+#     if   ( defined SERIAL )
+      PRINT_WARNING( OPT__OUTPUT_HDF5_MPIIO, FORMAT_INT, "since SERIAL is enabled" );
+#     elif ( !defined SUPPORT_HDF5 )
+      PRINT_WARNING( OPT__OUTPUT_HDF5_MPIIO, FORMAT_INT, "since SUPPORT_HDF5 is disabled" );
+#     else
+      PRINT_WARNING( OPT__OUTPUT_HDF5_MPIIO, FORMAT_INT, "since the HDF5 library does not support MPI-IO" );
+#     endif
+   }
+#  endif
+
+
+// OPT__OUTPUT_ASYNC is only supported by the HDF5 snapshots
+   if ( OPT__OUTPUT_ASYNC  &&  OPT__OUTPUT_TOTAL != OUTPUT_FORMAT_HDF5 )
+   {
+      OPT__OUTPUT_ASYNC = false;
+
+      PRINT_WARNING( OPT__OUTPUT_ASYNC, FORMAT_INT, "since OPT__OUTPUT_TOTAL != 1" );
+   }
+
+
 // disable OPT__MINIMIZE_MPI_BARRIER in the serial mode
 #  ifdef SERIAL
    if ( OPT__MINIMIZE_MPI_BARRIER )
@@ -40,41 +40,36 @@ void Init_UniformGrid( const int lv, const bool FindHomePatchForPar )
    const double ParWeight_Zero         = 0.0;
    const long   NPG_Total              = (long)NPG_EachDim[0]*(long)NPG_EachDim[1]*(long)NPG_EachDim[2];
 
-   long   *LBIdx0_AllRank = NULL;
-   double *Load_AllRank   = NULL;
-   int     counter;
+   const long   PG_Start               = NPG_Total*(MPI_Rank  )/MPI_NRank;
+   const long   PG_Stop                = NPG_Total*(MPI_Rank+1)/MPI_NRank;
+   const int    NPG_ThisRank           = PG_Stop - PG_Start;
+
+   long   *LBIdx0_ThisRank = new long   [NPG_ThisRank];
+   double *Load_ThisRank   = new double [NPG_ThisRank];
 
 // 1.1 prepare LBIdx and load-balance weighting of each **patch group** for LB_SetCutPoint()
-   if ( MPI_Rank == 0 )
+//     --> each rank only prepares a contiguous subset of all patch groups
+   for (long PG=PG_Start; PG<PG_Stop; PG++)
    {
-      LBIdx0_AllRank = new long   [NPG_Total];
-      Load_AllRank   = new double [NPG_Total];
-
-      counter = 0;
-
-      for (int k=0; k<NPG_EachDim[2]; k++)   {  Cr[2] = k*PS2*scale;
-      for (int j=0; j<NPG_EachDim[1]; j++)   {  Cr[1] = j*PS2*scale;
-      for (int i=0; i<NPG_EachDim[0]; i++)   {  Cr[0] = i*PS2*scale;
+      const int t = PG - PG_Start;
 
-         LBIdx0_AllRank[counter]  = LB_Corner2Index( lv, Cr, CHECK_ON );
-         LBIdx0_AllRank[counter] -= LBIdx0_AllRank[counter] % 8;  // get the minimum LBIdx in each patch group
-         Load_AllRank  [counter]  = 8.0;                          // assuming all patches have the same weighting == 1.0
+      Cr[0] = (int)(   PG % NPG_EachDim[0]                                   )*PS2*scale;
+      Cr[1] = (int)( ( PG / NPG_EachDim[0] ) % NPG_EachDim[1]                )*PS2*scale;
+      Cr[2] = (int)(   PG / ( (long)NPG_EachDim[0]*(long)NPG_EachDim[1] )   )*PS2*scale;
 
-         counter ++;
-      }}}
+      LBIdx0_ThisRank[t]  = LB_Corner2Index( lv, Cr, CHECK_ON );
+      LBIdx0_ThisRank[t] -= LBIdx0_ThisRank[t] % 8;  // get the minimum LBIdx in each patch group
+      Load_ThisRank  [t]  = 8.0;                     // assuming all patches have the same weighting == 1.0
    }
 
 // 1.2 set CutPoint[]
 //     --> do NOT consider load-balance weighting of particles since we have not assoicated particles with patches yet
-   LB_SetCutPoint( lv, NPG_Total, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_AllRank, Load_AllRank,
+   LB_SetCutPoint( lv, NPG_ThisRank, amr->LB->CutPoint[lv], InputLBIdx0AndLoad_Yes, LBIdx0_ThisRank, Load_ThisRank,
                    ParWeight_Zero );
 
 // 1.3 free memory
-   if ( MPI_Rank == 0 )
-   {
-      delete [] LBIdx0_AllRank;
-      delete [] Load_AllRank;
-   }
+   delete [] LBIdx0_ThisRank;
+   delete [] Load_ThisRank;
 #  endif // #ifdef LOAD_BALANCE
 
 
@@ -18,7 +18,7 @@
 //                       --> But note that, in the current implementation, the father indices of all sibling/father-buffer
 //                           patches are always set to -1
 //                3. Father-buffer patches at SonLv-1 are NOT allocated for the "father-buffer" patches at SonLv
-//                4. This function will reconstruct the list LB_PaddedCr1DList[SonLv-1][]
+//                4. This function will reconstruct the hash table amr->LB->PaddedCr1DHash_Key/PID[SonLv-1]
 //                5. SearchAllSon == true  --> search over all real patches at SonLv
 //                                == false --> search over patches recorded in TargetSonPID0
 //                6. RecordFaPID  == ture  --> record the indices of all newly-allocated father-buffer patches
@@ -209,7 +209,7 @@ void LB_AllocateBufferPatch_Father( const int SonLv, const bool SearchAllSon, co
 
 
 // 2. sort the candidate list and remove duplicates (with the same FaCr1D)
-   Mis_Heapsort( NFaBuf_Dup, FaCr1D_List, NULL );
+   Mis_RadixSort( NFaBuf_Dup, FaCr1D_List, NULL );
 
    NFaBuf = ( NFaBuf_Dup > 0 ) ? 1 : 0;
 
@@ -219,7 +219,10 @@ void LB_AllocateBufferPatch_Father( const int SonLv, const bool SearchAllSon, co
 
 // 3. get the matching list
    char *Match = new char [NFaBuf];
-   Mis_Matching_char( amr->num[FaLv], amr->LB->PaddedCr1DList[FaLv], NFaBuf, FaCr1D_List, Match );
+
+#  pragma omp parallel for schedule( runtime )
+   for (int t=0; t<NFaBuf; t++)
+      Match[t] = ( LB_PaddedCr1DHash_Find( FaLv, FaCr1D_List[t] ) != -1 ) ? 1 : 0;
 
 #  ifdef GAMER_DEBUG
    if ( MPI_NRank == 1 )
@@ -282,33 +285,10 @@ void LB_AllocateBufferPatch_Father( const int SonLv, const bool SearchAllSon, co
                  FaLv, amr->NPatchComma[FaLv][3], FaLv, amr->num[FaLv] );
 
 
-// 5. reconstruct LB_PaddedCr1DList and LB_PaddedCr1DList_Index_Table at SonLv-1
+// 5. reconstruct the PaddedCr1D hash table at SonLv-1
    const int NP_New = amr->NPatchComma[FaLv][3];
 
-   if ( NP_New != NP_Old )
-   {
-      amr->LB->PaddedCr1DList         [FaLv] = (ulong*)realloc( amr->LB->PaddedCr1DList         [FaLv],
-                                                                NP_New*sizeof(ulong) );
-      amr->LB->PaddedCr1DList_IdxTable[FaLv] = (int*  )realloc( amr->LB->PaddedCr1DList_IdxTable[FaLv],
-                                                                NP_New*sizeof(int ) );
-
-//    must re-input all PaddedCr1D in order to get the correct LB_PaddedCr1DList_IdxTable[FaLv]
-      for (int PID=0; PID<NP_New; PID++)
-         amr->LB->PaddedCr1DList[FaLv][PID] = amr->patch[0][FaLv][PID]->PaddedCr1D;
-
-      Mis_Heapsort( NP_New, amr->LB->PaddedCr1DList[FaLv], amr->LB->PaddedCr1DList_IdxTable[FaLv] );
-
-//    check : no duplicate patches at FaLv
-#     ifdef GAMER_DEBUG
-      for (int t=1; t<amr->num[FaLv]; t++)
-      {
-         if ( amr->LB->PaddedCr1DList[FaLv][t] == amr->LB->PaddedCr1DList[FaLv][t-1] )
-            Aux_Error( ERROR_INFO, "duplicate patches at lv %d, PaddedCr1D %lu, PID = %d and %d !!\n",
-                       FaLv, amr->LB->PaddedCr1DList[FaLv][t], amr->LB->PaddedCr1DList_IdxTable[FaLv][t],
-                       amr->LB->PaddedCr1DList_IdxTable[FaLv][t-1] );
-      }
-#     endif
-   } // if ( NP_New != NP_Old )
+   if ( NP_New != NP_Old )    LB_PaddedCr1DHash_Build( FaLv, NP_New );
 
 
 // free memory
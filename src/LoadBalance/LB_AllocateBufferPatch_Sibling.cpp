@@ -172,7 +172,7 @@ void LB_AllocateBufferPatch_Sibling( const int lv )
 // 1.3 sort the query list and remove duplicates (with the same LB_Idx)
    for (int r=0; r<MPI_NRank; r++)
    {
-      Mis_Heapsort( NQuery_Temp[r], Query_Temp[r], NULL );
+      Mis_RadixSort( NQuery_Temp[r], Query_Temp[r], NULL );
 
       if ( NQuery_Temp[r] > 0 )  NQuery[r] = 1;
 
@@ -184,7 +184,7 @@ void LB_AllocateBufferPatch_Sibling( const int lv )
 // 1.4 sort the internal buffer patch list and remove duplicates (with the same LB_Idx)
    for (int r=0; r<MPI_NRank; r++)
    {
-      Mis_Heapsort( Int_NQuery_Temp[r], Int_LBIdx[r], NULL );
+      Mis_RadixSort( Int_NQuery_Temp[r], Int_LBIdx[r], NULL );
 
       if ( Int_NQuery_Temp[r] > 0 )  Int_NQuery[r] = 1;
 
@@ -199,7 +199,7 @@ void LB_AllocateBufferPatch_Sibling( const int lv )
    {
       Ext_IdxTable[r] = (int*)malloc( Ext_NQuery_Temp[r]*sizeof(int) );
 
-      Mis_Heapsort( Ext_NQuery_Temp[r], Ext_Coord1D[r], Ext_IdxTable[r] );
+      Mis_RadixSort( Ext_NQuery_Temp[r], Ext_Coord1D[r], Ext_IdxTable[r] );
 
       if ( Ext_NQuery_Temp[r] > 0 )  Ext_NQuery[r] = 1;
 
@@ -218,7 +218,7 @@ void LB_AllocateBufferPatch_Sibling( const int lv )
 
       for (int t=0; t<Ext_NQuery[r]; t++)    Ext_LBIdx[r][t] = Ext_LBIdx_Temp[r][ Ext_IdxTable[r][t] ];
 
-      Mis_Heapsort( Ext_NQuery[r], Ext_LBIdx[r], Ext_IdxTable[r] );
+      Mis_RadixSort( Ext_NQuery[r], Ext_LBIdx[r], Ext_IdxTable[r] );
    }
 
 
@@ -391,30 +391,9 @@ void LB_AllocateBufferPatch_Sibling( const int lv )
 
 
 
-// 4. record the padded 1D corner coordinates (which can be overwritten by "LB_AllocateBufferPatch_Father")
+// 4. construct the hash table of the padded 1D corner coordinates (which can be overwritten by "LB_AllocateBufferPatch_Father")
 // ==========================================================================================
-   const int NPatch = amr->NPatchComma[lv][2];
-
-   amr->LB->PaddedCr1DList         [lv] = (ulong*)realloc( amr->LB->PaddedCr1DList         [lv],
-                                                           NPatch*sizeof(ulong) );
-   amr->LB->PaddedCr1DList_IdxTable[lv] = (int*  )realloc( amr->LB->PaddedCr1DList_IdxTable[lv],
-                                                           NPatch*sizeof(int ) );
-
-   for (int PID=0; PID<NPatch; PID++)
-      amr->LB->PaddedCr1DList[lv][PID] = amr->patch[0][lv][PID]->PaddedCr1D;
-
-   Mis_Heapsort( NPatch, amr->LB->PaddedCr1DList[lv], amr->LB->PaddedCr1DList_IdxTable[lv] );
-
-// check : no duplicate patches at lv
-#  ifdef GAMER_DEBUG
-   for (int t=1; t<amr->num[lv]; t++)
-   {
-      if ( amr->LB->PaddedCr1DList[lv][t] == amr->LB->PaddedCr1DList[lv][t-1] )
-         Aux_Error( ERROR_INFO, "duplicate patches at lv %d, PaddedCr1D %lu, PID = %d and %d !!\n",
-                    lv, amr->LB->PaddedCr1DList[lv][t], amr->LB->PaddedCr1DList_IdxTable[lv][t],
-                    amr->LB->PaddedCr1DList_IdxTable[lv][t-1] );
-   }
-#  endif
+   LB_PaddedCr1DHash_Build( lv, amr->NPatchComma[lv][2] );
 
 
 // free memory
@@ -123,7 +123,7 @@ void LB_AllocateBufferPatch_Sibling_Base()
 // ==========================================================================================
    int NAlloc = ( NAlloc_Temp > 0 ) ? 1 : 0;
 
-   Mis_Heapsort( NAlloc_Temp, FaPaddedCr1D, NULL );
+   Mis_RadixSort( NAlloc_Temp, FaPaddedCr1D, NULL );
 
    for (int t=1; t<NAlloc_Temp; t++)
       if ( FaPaddedCr1D[t] != FaPaddedCr1D[t-1] )  FaPaddedCr1D[ NAlloc ++ ] = FaPaddedCr1D[t];
@@ -164,31 +164,10 @@ void LB_AllocateBufferPatch_Sibling_Base()
 
 
 
-// 5. record the padded 1D corner coordinates
+// 5. construct the hash table of the padded 1D corner coordinates
 //    --> can be overwritten by LB_AllocateBufferPatch_Father()
 // ==========================================================================================
-   const int NPatch = amr->NPatchComma[0][2];
-
-   amr->LB->PaddedCr1DList         [0] = (ulong*)realloc( amr->LB->PaddedCr1DList         [0],
-                                                          NPatch*sizeof(ulong) );
-   amr->LB->PaddedCr1DList_IdxTable[0] = (int*  )realloc( amr->LB->PaddedCr1DList_IdxTable[0],
-                                                          NPatch*sizeof(int ) );
-
-   for (int PID=0; PID<NPatch; PID++)
-      amr->LB->PaddedCr1DList[0][PID] = amr->patch[0][0][PID]->PaddedCr1D;
-
-   Mis_Heapsort( NPatch, amr->LB->PaddedCr1DList[0], amr->LB->PaddedCr1DList_IdxTable[0] );
-
-// check : no duplicate patches
-#  ifdef GAMER_DEBUG
-   for (int t=1; t<amr->num[0]; t++)
-   {
-      if ( amr->LB->PaddedCr1DList[0][t] == amr->LB->PaddedCr1DList[0][t-1] )
-         Aux_Error( ERROR_INFO, "duplicate patches at lv 0, PaddedCr1D %lu, PID = %d and %d !!\n",
-                    amr->LB->PaddedCr1DList[0][t], amr->LB->PaddedCr1DList_IdxTable[0][t],
-                    amr->LB->PaddedCr1DList_IdxTable[0][t-1] );
-   }
-#  endif
+   LB_PaddedCr1DHash_Build( 0, amr->NPatchComma[0][2] );
 
 
 // free memory
@@ -134,7 +134,7 @@ void LB_AllocateFluxArray( const int FaLv )
       LB_RecvF_IDList_IdxTable[r] = new int [ LB_RecvF_NList[r] ];
       LB_RecvF_SibList        [r] = new int [ LB_RecvF_NList[r] ];
 
-      Mis_Heapsort( LB_RecvF_NList[r], LB_RecvF_SibSonLBIdx[r], LB_RecvF_IDList_IdxTable[r] );
+      Mis_RadixSort( LB_RecvF_NList[r], LB_RecvF_SibSonLBIdx[r], LB_RecvF_IDList_IdxTable[r] );
 
       for (int t=0; t<LB_RecvF_NList[r]; t++)
          LB_RecvF_SibList[r][t] = Temp_SibList[r][ LB_RecvF_IDList_IdxTable[r][t] ];
@@ -145,7 +145,7 @@ void LB_AllocateFluxArray( const int FaLv )
       int *TempIdxTable = new int [ LB_RecvF_NList[r] ];
       memcpy( TempIDList, LB_RecvF_IDList[r], LB_RecvF_NList[r]*sizeof(int) );
 
-      Mis_Heapsort( LB_RecvF_NList[r], TempIDList, TempIdxTable );
+      Mis_RadixSort( LB_RecvF_NList[r], TempIDList, TempIdxTable );
 
       for (int t=1; t<LB_RecvF_NList[r]; t++)
          if ( TempIDList[t] == TempIDList[t-1]  &&
@@ -17,6 +17,13 @@
 //                   --> For non-leaf patches, this function will collect particles from the leaf patches
 //                3. This function assumes that "NPatchTotal[lv]" has already been set by invoking the
 //                   function "Mis_GetTotalPatchNumber( lv )"
+//                4. For OPT__LB_MEASURE_COST, workload of cells is replaced by the measured workload of each patch
+//                   (patch_t::LB_Cost), normalized so that the average over all measured patch groups at lv in all
+//                   ranks equals 8.0
+//                   --> Patch groups not measured yet (e.g., newly created ones) still adopt 8.0
+//                   --> Particle weighting is still added on top of it since the particle routines are not
+//                       measured by InvokeSolver()
+//                   --> Must be invoked by all ranks
 //
 // Parameter   :  lv        : Target refinement level
 //                ParWeight : Relative workload weighting of particles
@@ -38,6 +45,49 @@ void LB_EstimateWorkload_AllPatchGroup( const int lv, const double ParWeight, do
 
    for (int t=0; t<NPG_ThisRank; t++)  Load_PG[t] = 8.0; // 8 patches per patch group
 
+// 1.1 replace it by the measured workload
+   if ( OPT__LB_MEASURE_COST )
+   {
+      double *Cost_PG = new double [NPG_ThisRank];
+      double  Cost_Sum[2] = { 0.0, 0.0 };   // [0/1] = sum of the measured workload / number of measured patch groups
+
+      for (int t=0; t<NPG_ThisRank; t++)
+      {
+         Cost_PG[t] = 0.0;
+
+         for (int PID=t*8; PID<(t+1)*8; PID++)
+         {
+            const double Cost = amr->patch[0][lv][PID]->LB_Cost;
+
+            if ( Cost < 0.0 )
+            {
+               Cost_PG[t] = -1.0;
+               break;
+            }
+
+            Cost_PG[t] += Cost;
+         }
+
+         if ( Cost_PG[t] >= 0.0 )
+         {
+            Cost_Sum[0] += Cost_PG[t];
+            Cost_Sum[1] += 1.0;
+         }
+      }
+
+      MPI_Allreduce( MPI_IN_PLACE, Cost_Sum, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+
+      if ( Cost_Sum[0] > 0.0 )
+      {
+         const double Norm = 8.0*Cost_Sum[1]/Cost_Sum[0];
+
+         for (int t=0; t<NPG_ThisRank; t++)
+            if ( Cost_PG[t] >= 0.0 )   Load_PG[t] = Norm*Cost_PG[t];
+      }
+
+      delete [] Cost_PG;
+   } // if ( OPT__LB_MEASURE_COST )
+
 
 // 2. workload of particles
 #  ifdef PARTICLE
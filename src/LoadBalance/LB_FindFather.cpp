@@ -9,8 +9,7 @@
 // Function    :  LB_FindFather
 // Description :  Construct the patch relation : son <-> father
 //
-// Note        :  1. LB_PaddedCr1DList[] and LB_PaddedCr1DList_IdxTable[] must be properly prepared
-//                   at SonLv and FaLv
+// Note        :  1. The PaddedCr1D hash table (see LB_PaddedCr1DHash_Build()) must be properly prepared at FaLv
 //                2. Father-buffer patches should be allocated in advance by LB_AllocateBufferPatch_Father()
 //                3. One should find father patches only for the "real" patches at SonLv (applying to
 //                   sibling-buffer and father-buffer patches is not necessary)
@@ -52,11 +51,9 @@ void LB_FindFather( const int SonLv, const bool SearchAllSon, const int NInput,
    const int NTargetSon0 = ( SearchAllSon ) ? amr->NPatchComma[SonLv][1]/8 : NInput;
    const int FaLv        = SonLv - 1;
 
-   ulong *Cr1D_Son0          = new ulong [NTargetSon0];
-   int   *Cr1D_Son0_IdxTable = new int   [NTargetSon0];
-   int   *Match_Son0         = new int   [NTargetSon0];
-
-   int SonPID, SonPID0, FaID, FaPID;
+#  ifdef GAMER_DEBUG
+   int SonPID, SonPID0, FaPID;
+#  endif
 
 
 // 0. initialize son and father indices
@@ -68,14 +65,7 @@ void LB_FindFather( const int SonLv, const bool SearchAllSon, const int NInput,
 
 
 // 1. nothing to do if there is no target real patch at SonLv
-   if ( NTargetSon0 == 0 )
-   {
-      delete [] Cr1D_Son0;
-      delete [] Cr1D_Son0_IdxTable;
-      delete [] Match_Son0;
-
-      return;
-   }
+   if ( NTargetSon0 == 0 )    return;
 
 
 // 2. construct the target son patch list
@@ -101,43 +91,30 @@ void LB_FindFather( const int SonLv, const bool SearchAllSon, const int NInput,
 #  endif
 
 
-// 3. store and sort the 1D corner coordinates for all target son patches with LocalID == 0
+// 3. find the father patch with the same 1D corner coordinates as each target son patch with LocalID == 0
+//    and construct father <-> son relation
+//    --> different target son patches always have different father patches and thus can be processed in parallel
+#  pragma omp parallel for schedule( runtime )
    for (int t=0; t<NTargetSon0; t++)
    {
-      SonPID0      = TargetSonPID0[t];
-      Cr1D_Son0[t] = amr->patch[0][SonLv][SonPID0]->PaddedCr1D;
-   }
-
-   Mis_Heapsort( NTargetSon0, Cr1D_Son0, Cr1D_Son0_IdxTable );
+      const int TSonPID0 = TargetSonPID0[t];
+      const int TFaPID   = LB_PaddedCr1DHash_Find( FaLv, amr->patch[0][SonLv][TSonPID0]->PaddedCr1D );
 
-
-// 4. matching
-   Mis_Matching_int( amr->num[FaLv], amr->LB->PaddedCr1DList[FaLv], NTargetSon0, Cr1D_Son0, Match_Son0 );
-
-
-// 5. construct father <-> son relation
-   for (int t=0; t<NTargetSon0; t++)
-   {
-      SonPID0 = TargetSonPID0[ Cr1D_Son0_IdxTable[t] ];
-      FaID    = Match_Son0[t];
-
-      if ( FaID != -1 ) // father is found
+      if ( TFaPID != -1 ) // father is found
       {
-         FaPID = amr->LB->PaddedCr1DList_IdxTable[FaLv][FaID];
-
 //       son -> father
-         for (SonPID=SonPID0; SonPID<SonPID0+8; SonPID++)   amr->patch[0][SonLv][SonPID]->father = FaPID;
+         for (int TSonPID=TSonPID0; TSonPID<TSonPID0+8; TSonPID++)   amr->patch[0][SonLv][TSonPID]->father = TFaPID;
 
 //       father -> son
-         amr->patch[0][FaLv][FaPID]->son = SonPID0;
+         amr->patch[0][FaLv][TFaPID]->son = TSonPID0;
       }
 
       else // find no father (should NOT happen for any real patches)
-         Aux_Error( ERROR_INFO, "SonLv %d, SonPID0 %d found no father !!\n", SonLv, SonPID0 );
+         Aux_Error( ERROR_INFO, "SonLv %d, SonPID0 %d found no father !!\n", SonLv, TSonPID0 );
    }
 
 
-// 6. check results in debug mode
+// 4. check results in debug mode
 #  ifdef GAMER_DEBUG
    const int FaNNoFaBuf = amr->NPatchComma[FaLv][2];  // exclude father-buffer patches
 
@@ -239,9 +216,6 @@ void LB_FindFather( const int SonLv, const bool SearchAllSon, const int NInput,
 
 
 // free memory
-   delete [] Cr1D_Son0;
-   delete [] Cr1D_Son0_IdxTable;
-   delete [] Match_Son0;
    if ( SearchAllSon )  delete [] TargetSonPID0;
 
 } // FUNCTION : LB_FindFather
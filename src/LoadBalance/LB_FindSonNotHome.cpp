@@ -157,7 +157,7 @@ void LB_FindSonNotHome( const int FaLv, const bool SearchAllFa, const int NInput
    {
       FaPID_IdxTable[r] = new int [ NQuery[r] ];
 
-      Mis_Heapsort( NQuery[r], Query_Temp[r], FaPID_IdxTable[r] );
+      Mis_RadixSort( NQuery[r], Query_Temp[r], FaPID_IdxTable[r] );
    }
 
 
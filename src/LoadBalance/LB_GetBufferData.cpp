@@ -11,6 +11,23 @@ static real *MPI_RecvBuf_Shared = NULL;
 static int   SendBufSize        = -1;
 static int   RecvBufSize        = -1;
 
+// neighbor-only communicators for OPT__LB_NEIGHBOR_MPI
+// --> one communicator for each level and each group of send/recv lists (see GetNeighborListID())
+// --> constructed from the send/recv lists on demand and kept until LB_GetBufferData_ResetNeighbor()
+// --> Neighbor_Src/Dst store the source/destination ranks in the same order as the communicator
+const int NNeighborList = 6;
+
+static bool     Neighbor_Ready[NLEVEL][NNeighborList];
+static MPI_Comm Neighbor_Comm [NLEVEL][NNeighborList];
+static int      Neighbor_NSrc [NLEVEL][NNeighborList];
+static int      Neighbor_NDst [NLEVEL][NNeighborList];
+static int     *Neighbor_Src  [NLEVEL][NNeighborList];
+static int     *Neighbor_Dst  [NLEVEL][NNeighborList];
+
+static int  GetNeighborListID( const GetBufMode_t GetBufMode );
+static void ConstructNeighborComm( const int lv, const int ListID, const int *Send_NList, const int *Recv_NList,
+                                   const int *SendY_NList, const int *RecvY_NList );
+
 #ifdef TIMING
 extern Timer_t *Timer_MPI[3];
 #endif
@@ -28,6 +45,10 @@ extern Timer_t *Timer_MPI[3];
 //                3. The modes "POT_FOR_POISSON" and "POT_AFTER_REFINE" will exchange the potential data only.
 //                   The mode "COARSE_FINE_ELECTRIC" will exchange all electric field components.
 //                   For others modes, the variables to be exchanged depend on the input parameters "TVarCC" and "TVarFC".
+//                4. Data are transferred by MPI_Neighbor_alltoallv() among the ranks with non-empty send/recv lists
+//                   when OPT__LB_NEIGHBOR_MPI is on, and by MPI_Alltoallv() among all ranks otherwise
+//                   --> The neighbor communicators are constructed on demand and must be reset by
+//                       LB_GetBufferData_ResetNeighbor() whenever the send/recv lists are reconstructed
 //
 // Parameter   :  lv         : Target refinement level to exchage data
 //                FluSg      : Sandglass of the requested fluid data
@@ -68,6 +89,14 @@ void LB_GetBufferData( const int lv, const int FluSg, const int MagSg, const int
                        const long TVarCC, const long TVarFC, const int ParaBuf )
 {
 
+// the data of buffer patches at lv are about to change --> clear the data cached by Prepare_PatchData()
+// --> fluxes and electric field are not used by Prepare_PatchData()
+#  ifdef MHD
+   if ( GetBufMode != COARSE_FINE_FLUX  &&  GetBufMode != COARSE_FINE_ELECTRIC )    PrepCache_Invalidate( lv );
+#  else
+   if ( GetBufMode != COARSE_FINE_FLUX )                                            PrepCache_Invalidate( lv );
+#  endif
+
    bool ExchangeFlu = ( GetBufMode == COARSE_FINE_FLUX ) ?
                       TVarCC & _FLUX_TOTAL : TVarCC & _TOTAL;  // whether or not to exchage the fluid data
 #  ifdef GRAVITY
@@ -1099,8 +1128,20 @@ void LB_GetBufferData( const int lv, const int FluSg, const int MagSg, const int
 
 
 
-// 4. transfer data by MPI_Alltoallv
+// 4. transfer data by MPI_Neighbor_alltoallv (OPT__LB_NEIGHBOR_MPI) or MPI_Alltoallv
 // ============================================================================================================
+// construct the neighbor communicator of the target lists if it does not exist
+// --> all ranks invoke LB_GetBufferData() with the same lv and GetBufMode, so it is safe to construct the
+//     communicator collectively here
+   const int NeighborListID = GetNeighborListID( GetBufMode );
+
+   if ( OPT__LB_NEIGHBOR_MPI  &&  !Neighbor_Ready[lv][NeighborListID] )
+#     ifdef MHD
+      ConstructNeighborComm( lv, NeighborListID, Send_NList, Recv_NList, SendY_NList, RecvY_NList );
+#     else
+      ConstructNeighborComm( lv, NeighborListID, Send_NList, Recv_NList, NULL, NULL );
+#     endif
+
 #  ifdef TIMING
 // it's better to add barrier before timing transferring data through MPI
 // --> so that the timing results (i.e., the MPI bandwidth reported by OPT__TIMING_MPI ) does NOT include
@@ -1111,13 +1152,52 @@ void LB_GetBufferData( const int lv, const int FluSg, const int MagSg, const int
    if ( OPT__TIMING_MPI )  Timer_MPI[1]->Start();
 #  endif
 
-#  ifdef FLOAT8
-   MPI_Alltoallv( SendBuf, Send_NCount, Send_NDisp, MPI_DOUBLE,
-                  RecvBuf, Recv_NCount, Recv_NDisp, MPI_DOUBLE, MPI_COMM_WORLD );
-#  else
-   MPI_Alltoallv( SendBuf, Send_NCount, Send_NDisp, MPI_FLOAT,
-                  RecvBuf, Recv_NCount, Recv_NDisp, MPI_FLOAT,  MPI_COMM_WORLD );
-#  endif
+   if ( OPT__LB_NEIGHBOR_MPI )
+   {
+//    the send/recv buffers keep the same layout as MPI_Alltoallv
+//    --> just collect the counts and displacements of the neighboring ranks
+      const int  NSrc = Neighbor_NSrc[lv][NeighborListID];
+      const int  NDst = Neighbor_NDst[lv][NeighborListID];
+      const int *Src  = Neighbor_Src [lv][NeighborListID];
+      const int *Dst  = Neighbor_Dst [lv][NeighborListID];
+
+      int *Send_NCount_Nei = new int [ NDst + 1 ];
+      int *Send_NDisp_Nei  = new int [ NDst + 1 ];
+      int *Recv_NCount_Nei = new int [ NSrc + 1 ];
+      int *Recv_NDisp_Nei  = new int [ NSrc + 1 ];
+
+      for (int n=0; n<NDst; n++)
+      {
+         Send_NCount_Nei[n] = Send_NCount[ Dst[n] ];
+         Send_NDisp_Nei [n] = Send_NDisp [ Dst[n] ];
+      }
+
+      for (int n=0; n<NSrc; n++)
+      {
+         Recv_NCount_Nei[n] = Recv_NCount[ Src[n] ];
+         Recv_NDisp_Nei [n] = Recv_NDisp [ Src[n] ];
+      }
+
+      MPI_Neighbor_alltoallv( SendBuf, Send_NCount_Nei, Send_NDisp_Nei, MPI_GAMER_REAL,
+                              RecvBuf, Recv_NCount_Nei, Recv_NDisp_Nei, MPI_GAMER_REAL,
+                              Neighbor_Comm[lv][NeighborListID] );
+
+      delete [] Send_NCount_Nei;
+      delete [] Send_NDisp_Nei;
+      delete [] Recv_NCount_Nei;
+      delete [] Recv_NDisp_Nei;
+   } // if ( OPT__LB_NEIGHBOR_MPI )
+
+   else
+   {
+#     ifdef FLOAT8
+      MPI_Alltoallv( SendBuf, Send_NCount, Send_NDisp, MPI_DOUBLE,
+                     RecvBuf, Recv_NCount, Recv_NDisp, MPI_DOUBLE, MPI_COMM_WORLD );
+#     else
+      MPI_Alltoallv( SendBuf, Send_NCount, Send_NDisp, MPI_FLOAT,
+                     RecvBuf, Recv_NCount, Recv_NDisp, MPI_FLOAT,  MPI_COMM_WORLD );
+#     endif
+   } // if ( OPT__LB_NEIGHBOR_MPI ) ... else ...
 
 #  ifdef TIMING
    if ( OPT__TIMING_MPI )  Timer_MPI[1]->Stop();
@@ -1860,13 +1940,16 @@ real *LB_GetBufferData_MemAllocate_Recv( const int NRecv )
 // Function    :  LB_GetBufferData_MemFree
 // Description :  Free the MPI send and recv buffers
 //
-// Note        :  This function is invoked by "End_MemFree"
+// Note        :  1. This function is invoked by "End_MemFree"
+//                2. Also free all the neighbor communicators for OPT__LB_NEIGHBOR_MPI
 //
 // Parameter   :  None
 //-------------------------------------------------------------------------------------------------------
 void LB_GetBufferData_MemFree()
 {
 
+   for (int lv=0; lv<NLEVEL; lv++)  LB_GetBufferData_ResetNeighbor( lv );
+
    if ( MPI_SendBuf_Shared != NULL )
    {
       delete [] MPI_SendBuf_Shared;
@@ -1883,4 +1966,117 @@ void LB_GetBufferData_MemFree()
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LB_GetBufferData_ResetNeighbor
+// Description :  Free the neighbor communicators of OPT__LB_NEIGHBOR_MPI at the target level
+//
+// Note        :  1. Must be invoked whenever the send/recv lists at lv are reconstructed
+//                   --> Invoked by LB_Init_LoadBalance(), LB_Refine(), and LB_GetBufferData_MemFree()
+//                   --> The communicators will be reconstructed from the new lists by the next LB_GetBufferData()
+//                2. Must be invoked by all ranks since MPI_Comm_free() is collective
+//
+// Parameter   :  lv : Target refinement level
+//-------------------------------------------------------------------------------------------------------
+void LB_GetBufferData_ResetNeighbor( const int lv )
+{
+
+   for (int t=0; t<NNeighborList; t++)
+   {
+      if ( !Neighbor_Ready[lv][t] )    continue;
+
+      MPI_Comm_free( &Neighbor_Comm[lv][t] );
+
+      delete [] Neighbor_Src[lv][t];
+      delete [] Neighbor_Dst[lv][t];
+
+      Neighbor_Src  [lv][t] = NULL;
+      Neighbor_Dst  [lv][t] = NULL;
+      Neighbor_NSrc [lv][t] = 0;
+      Neighbor_NDst [lv][t] = 0;
+      Neighbor_Ready[lv][t] = false;
+   }
+
+} // FUNCTION : LB_GetBufferData_ResetNeighbor
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetNeighborListID
+// Description :  Return the index of the group of send/recv lists used by the target mode
+//
+// Note        :  1. Modes sharing the same send/recv lists (e.g., DATA_GENERAL and DATA_AFTER_REFINE) share
+//                   the same neighbor communicator
+//
+// Parameter   :  GetBufMode : Target mode of LB_GetBufferData()
+//
+// Return      :  0 ~ NNeighborList-1
+//-------------------------------------------------------------------------------------------------------
+int GetNeighborListID( const GetBufMode_t GetBufMode )
+{
+
+   switch ( GetBufMode )
+   {
+      case DATA_GENERAL : case DATA_AFTER_REFINE :    return 0;    // SendH/RecvH
+      case DATA_AFTER_FIXUP :                         return 1;    // SendX/RecvX (and SendY/RecvY)
+      case DATA_RESTRICT :                            return 2;    // SendR/RecvR
+#     ifdef GRAVITY
+      case POT_FOR_POISSON : case POT_AFTER_REFINE :  return 3;    // SendG/RecvG
+#     endif
+      case COARSE_FINE_FLUX :                         return 4;    // SendF/RecvF
+#     ifdef MHD
+      case COARSE_FINE_ELECTRIC :                     return 5;    // SendE/RecvE
+#     endif
+
+      default:
+         Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "GetBufMode", GetBufMode );
+         return -1;
+   }
+
+} // FUNCTION : GetNeighborListID
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  ConstructNeighborComm
+// Description :  Construct the distributed-graph communicator connecting this rank to the ranks with
+//                non-empty send/recv lists
+//
+// Note        :  1. Invoked by LB_GetBufferData() when OPT__LB_NEIGHBOR_MPI is on
+//                2. Collective --> must be invoked by all ranks with the same lv and ListID
+//                3. Ranks are not reordered so that the rank indices in the send/recv lists remain valid
+//
+// Parameter   :  lv          : Target refinement level
+//                ListID      : Index of the group of send/recv lists returned by GetNeighborListID()
+//                Send_NList  : Number of patches to be sent to each rank
+//                Recv_NList  : Number of patches to be received from each rank
+//                SendY_NList : Additional send list of DATA_AFTER_FIXUP in MHD (NULL --> none)
+//                RecvY_NList : Additional recv list of DATA_AFTER_FIXUP in MHD (NULL --> none)
+//-------------------------------------------------------------------------------------------------------
+void ConstructNeighborComm( const int lv, const int ListID, const int *Send_NList, const int *Recv_NList,
+                            const int *SendY_NList, const int *RecvY_NList )
+{
+
+   int *Src = new int [MPI_NRank];
+   int *Dst = new int [MPI_NRank];
+   int  NSrc = 0, NDst = 0;
+
+   for (int r=0; r<MPI_NRank; r++)
+   {
+      if (  Recv_NList[r] > 0  ||  ( RecvY_NList != NULL && RecvY_NList[r] > 0 )  )    Src[ NSrc ++ ] = r;
+      if (  Send_NList[r] > 0  ||  ( SendY_NList != NULL && SendY_NList[r] > 0 )  )    Dst[ NDst ++ ] = r;
+   }
+
+   MPI_Dist_graph_create_adjacent( MPI_COMM_WORLD, NSrc, Src, MPI_UNWEIGHTED, NDst, Dst, MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL, false, &Neighbor_Comm[lv][ListID] );
+
+   Neighbor_Src  [lv][ListID] = Src;
+   Neighbor_Dst  [lv][ListID] = Dst;
+   Neighbor_NSrc [lv][ListID] = NSrc;
+   Neighbor_NDst [lv][ListID] = NDst;
+   Neighbor_Ready[lv][ListID] = true;
+
+} // FUNCTION : ConstructNeighborComm
+
+
+
 #endif // #ifdef LOAD_BALANCE
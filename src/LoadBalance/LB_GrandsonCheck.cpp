@@ -110,7 +110,7 @@ void LB_GrandsonCheck( const int FaLv )
    {
       FaPID_IdxTable[r] = new int [ NQuery[r] ];
 
-      Mis_Heapsort( NQuery[r], Query_Temp[r], FaPID_IdxTable[r] );
+      Mis_RadixSort( NQuery[r], Query_Temp[r], FaPID_IdxTable[r] );
    }
 
 
@@ -45,13 +45,33 @@ static void LB_RedistributeParticle_End( real **ParAtt_Old );
 //                                                will be constructed only AFTER calling LB_Init_LoadBalance()
 //                Reset        : Call LB->reset() to reset the load-balance variables on the target level(s)
 //                               --> Note that CutPoint[] will NOT be reset even when "Reset == true"
+//                Diffuse      : true  --> Shift the current cut points between adjacent ranks by LB_ShiftCutPoint()
+//                                         instead of recomputing them by LB_SetCutPoint()
+//                                     --> Return immediately if no cut point is shifted
+//                                     --> Only applicable to a single level with "Redistribute == true"
+//                               false --> Recompute the cut points from scratch
 //                TLv          : Target refinement level(s)
 //                               --> 0~TOP_LEVEL : only apply to a specific level
 //                                   <0          : apply to all levels
 //-------------------------------------------------------------------------------------------------------
-void LB_Init_LoadBalance( const bool Redistribute, const bool SendGridData, const double ParWeight, const bool Reset, const int TLv )
+void LB_Init_LoadBalance( const bool Redistribute, const bool SendGridData, const double ParWeight, const bool Reset,
+                          const bool Diffuse, const int TLv )
 {
 
+// check
+   if ( Diffuse  &&  ( TLv < 0 || !Redistribute )  )
+      Aux_Error( ERROR_INFO, "Diffuse only works with a single level (TLv %d) and Redistribute == true !!\n", TLv );
+
+
+// shift the cut points first so that nothing will be done if the cut points remain unchanged
+   if ( Diffuse  &&  !LB_ShiftCutPoint( TLv, amr->LB->CutPoint[TLv], ParWeight ) )    return;
+
+
+// patches will be redistributed and reallocated --> clear the data cached by Prepare_PatchData() and the fluid solver
+   PrepCache_Invalidate( (TLv < 0) ? 0 : TLv );
+   Flu_FusedMaxCFL_Invalidate( (TLv < 0) ? 0 : TLv );
+
+
    if ( MPI_Rank == 0 )
    {
       char lv_str[MAX_STRING];
@@ -87,11 +107,12 @@ void LB_Init_LoadBalance( const bool Redistribute, const bool SendGridData, cons
 
 
 // 1. set up the load-balance cut points (must do this before calling LB_RedistributeParticle_Init())
+//    --> already done by LB_ShiftCutPoint() if Diffuse is on
    const bool InputLBIdxAndLoad_No = false;
 
-   if ( Redistribute )
+   if ( Redistribute  &&  !Diffuse )
    for (int lv=lv_min; lv<=lv_max; lv++)
-      LB_SetCutPoint( lv, NPatchTotal[lv]/8, amr->LB->CutPoint[lv], InputLBIdxAndLoad_No, NULL, NULL, ParWeight );
+      LB_SetCutPoint( lv, NULL_INT, amr->LB->CutPoint[lv], InputLBIdxAndLoad_No, NULL, NULL, ParWeight );
 
 
 // 2. reinitialize arrays used by the load-balance routines
@@ -242,10 +263,13 @@ void LB_Init_LoadBalance( const bool Redistribute, const bool SendGridData, cons
       Par_LB_RecordExchangeParticlePatchID( lv );
 #     endif
 
+//    5.8 reset the neighbor communicators for OPT__LB_NEIGHBOR_MPI since the send/recv lists have changed
+      LB_GetBufferData_ResetNeighbor( lv );
+
       if ( OPT__VERBOSE  &&  MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
    } // for (int lv=lv_min_mpi; lv<=lv_max_mpi; lv++)
 
-// 5.8 list for exchanging particles on TLv+1
+// 5.9 list for exchanging particles on TLv+1
 #  ifdef PARTICLE
    if ( TLv >= 0  &&  TLv < TOP_LEVEL )
    Par_LB_RecordExchangeParticlePatchID( TLv+1 );
@@ -462,7 +486,8 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
 #  endif
 
    real *SendPtr         = NULL;
-   long *SendBuf_LBIdx   = new long [ NSend_Total_Patch ];
+   long   *SendBuf_LBIdx = new long   [ NSend_Total_Patch ];
+   double *SendBuf_Cost  = ( OPT__LB_MEASURE_COST ) ? new double [ NSend_Total_Patch ] : NULL;
    real *SendBuf_Flu     = ( SendGridData ) ? new real [ SendDataSizeFlu1v*NCOMP_TOTAL ] : NULL;
 #  ifdef GRAVITY
    real *SendBuf_Pot     = ( SendGridData ) ? new real [ SendDataSizeFlu1v ]             : NULL;
@@ -494,6 +519,10 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
 //    2.1 LB_Idx
       SendBuf_LBIdx[ Send_NDisp_Patch[TRank] + NDone_Patch[TRank] ] = LB_Idx;
 
+//    measured workload for OPT__LB_MEASURE_COST
+      if ( OPT__LB_MEASURE_COST )
+      SendBuf_Cost [ Send_NDisp_Patch[TRank] + NDone_Patch[TRank] ] = amr->patch[0][lv][PID]->LB_Cost;
+
       if ( SendGridData )
       {
 //       2.2 fluid
@@ -574,7 +603,8 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
    amr->Lvdelete( lv, OPT__REUSE_MEMORY==2 );
 
 // allocate recv buffers AFTER deleting old patches
-   long *RecvBuf_LBIdx   = new long [ NRecv_Total_Patch ];
+   long   *RecvBuf_LBIdx = new long   [ NRecv_Total_Patch ];
+   double *RecvBuf_Cost  = ( OPT__LB_MEASURE_COST ) ? new double [ NRecv_Total_Patch ] : NULL;
    real *RecvBuf_Flu     = ( SendGridData ) ? new real [ RecvDataSizeFlu1v*NCOMP_TOTAL ] : NULL;
 #  ifdef GRAVITY
    real *RecvBuf_Pot     = ( SendGridData ) ? new real [ RecvDataSizeFlu1v ]             : NULL;
@@ -597,6 +627,10 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
    MPI_Alltoallv( SendBuf_LBIdx, Send_NCount_Patch, Send_NDisp_Patch, MPI_LONG,
                   RecvBuf_LBIdx, Recv_NCount_Patch, Recv_NDisp_Patch, MPI_LONG, MPI_COMM_WORLD );
 
+   if ( OPT__LB_MEASURE_COST )
+   MPI_Alltoallv( SendBuf_Cost,  Send_NCount_Patch, Send_NDisp_Patch, MPI_DOUBLE,
+                  RecvBuf_Cost,  Recv_NCount_Patch, Recv_NDisp_Patch, MPI_DOUBLE, MPI_COMM_WORLD );
+
    if ( SendGridData )
    {
 //    4.2 fluid (transfer one component at a time to avoid exceeding the maximum allowed transfer size in MPI)
@@ -675,6 +709,7 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
    delete [] Send_NDisp_Flu1v;
    delete [] NDone_Patch;
    delete [] SendBuf_LBIdx;
+   delete [] SendBuf_Cost;
    delete [] SendBuf_Flu;
 #  ifdef GRAVITY
    delete [] SendBuf_Pot;
@@ -752,6 +787,9 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
       {
          PID = PID0 + LocalID;
 
+//       measured workload
+         if ( OPT__LB_MEASURE_COST )   amr->patch[0][lv][PID]->LB_Cost = RecvBuf_Cost[PID];
+
          if ( SendGridData )
          {
 //          fluid
@@ -839,7 +877,7 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
 
    for (int PID=0; PID<NRecv_Total_Patch; PID++)   amr->LB->IdxList_Real[lv][PID] = amr->patch[0][lv][PID]->LB_Idx;
 
-   Mis_Heapsort( NRecv_Total_Patch, amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
+   Mis_RadixSort( NRecv_Total_Patch, amr->LB->IdxList_Real[lv], amr->LB->IdxList_Real_IdxTable[lv] );
 
 
 // 8. deallocate the MPI recv buffers
@@ -849,6 +887,7 @@ void LB_RedistributeRealPatch( const int lv, real **ParAtt_Old, const bool Remov
    delete [] Recv_NCount_Flu1v;
    delete [] Recv_NDisp_Flu1v;
    delete [] RecvBuf_LBIdx;
+   delete [] RecvBuf_Cost;
    delete [] RecvBuf_Flu;
 #  ifdef GRAVITY
    delete [] RecvBuf_Pot;
@@ -0,0 +1,80 @@
+#include "GAMER.h"
+
+#ifdef LOAD_BALANCE
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LB_AddMeasuredCost
+// Description :  Add the wall-clock time spent on a set of patch groups to their workload record
+//
+// Note        :  1. Invoked by InvokeSolver() for OPT__LB_MEASURE_COST after the closing step of each
+//                   batch of patch groups
+//                2. The solvers process patch groups in batches (FLU_GPU_NPGROUP, POT_GPU_NPGROUP, ...)
+//                   --> Time spent on a batch is shared equally by all patch groups in that batch
+//                3. Time is accumulated in patch_t::LB_CostNow and will be folded into patch_t::LB_Cost by
+//                   LB_UpdateMeasuredCost()
+//
+// Parameter   :  lv        : Target refinement level
+//                NPG       : Number of patch groups in the batch
+//                PID0_List : List recording the patch indices with LocalID==0 in the batch
+//                Time      : Wall-clock time spent on the batch
+//-------------------------------------------------------------------------------------------------------
+void LB_AddMeasuredCost( const int lv, const int NPG, const int *PID0_List, const double Time )
+{
+
+   if ( NPG <= 0 )   return;
+
+   const double TimePerPatch = Time / (double)( 8*NPG );
+
+   for (int t=0; t<NPG; t++)
+   for (int PID=PID0_List[t]; PID<PID0_List[t]+8; PID++)
+      amr->patch[0][lv][PID]->LB_CostNow += TimePerPatch;
+
+} // FUNCTION : LB_AddMeasuredCost
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LB_UpdateMeasuredCost
+// Description :  Update the measured workload of all real patches at all levels
+//
+// Note        :  1. Invoked by main() once per root-level step before estimating the load imbalance
+//                2. Workload per update is estimated as "LB_CostNow/amr->NUpdateLv[lv]", which is then averaged
+//                   over steps by an exponential moving average with the weighting LB_MEASURE_COST_WEIGHT
+//                   of the latest step
+//                   --> Patches measured for the first time adopt the latest measurement directly
+//                   --> Patches not updated during the last step keep their previous workload
+//                3. Reset LB_CostNow to zero afterwards
+//
+// Parameter   :  None
+//-------------------------------------------------------------------------------------------------------
+void LB_UpdateMeasuredCost()
+{
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      if ( amr->NUpdateLv[lv] <= 0 )   continue;
+
+      for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
+      {
+         patch_t *TP = amr->patch[0][lv][PID];
+
+         if ( TP->LB_CostNow > 0.0 )
+         {
+            const double Cost = TP->LB_CostNow / (double)amr->NUpdateLv[lv];
+
+            if ( TP->LB_Cost < 0.0 )   TP->LB_Cost  = Cost;
+            else                       TP->LB_Cost += LB_MEASURE_COST_WEIGHT*( Cost - TP->LB_Cost );
+         }
+
+         TP->LB_CostNow = 0.0;
+      }
+   }
+
+} // FUNCTION : LB_UpdateMeasuredCost
+
+
+
+#endif // #ifdef LOAD_BALANCE
@@ -0,0 +1,140 @@
+#include "GAMER.h"
+
+#ifdef LOAD_BALANCE
+
+
+static ulong HashPaddedCr1D( const ulong PaddedCr1D, const int NBit );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LB_PaddedCr1DHash_Build
+// Description :  Construct the hash table mapping the padded 1D corner coordinates (PaddedCr1D) of patches
+//                to their patch indices at the target level
+//
+// Note        :  1. Must be invoked whenever patches are allocated or deallocated at lv before calling
+//                   LB_PaddedCr1DHash_Find() at the same level
+//                   --> Invoked by LB_AllocateBufferPatch_Sibling_Base(), LB_AllocateBufferPatch_Sibling(),
+//                       LB_AllocateBufferPatch_Father(), LB_Refine_AllocateBufferPatch_Sibling(),
+//                       and LB_Refine_AllocateNewPatch()
+//                2. Open addressing with linear probing is adopted and the table is at most half full
+//                   --> Constructing the table costs O(NPatch) and each search costs O(1) on average
+//                3. Memory of the table is reused if the number of slots does not change
+//                4. Patches with the same PaddedCr1D are not allowed
+//
+// Parameter   :  lv     : Target refinement level
+//                NPatch : Number of patches to be stored (i.e., PID = [0 ... NPatch-1])
+//-------------------------------------------------------------------------------------------------------
+void LB_PaddedCr1DHash_Build( const int lv, const int NPatch )
+{
+
+// determine the number of slots
+   int NBit = 4;
+   while (  ( 1L<<NBit ) < 2L*NPatch  )   NBit ++;
+
+   const long NSlot = 1L << NBit;
+
+
+// allocate memory
+   ulong *&Key = amr->LB->PaddedCr1DHash_Key[lv];
+   int   *&PID = amr->LB->PaddedCr1DHash_PID[lv];
+
+   if ( Key == NULL  ||  NBit != amr->LB->PaddedCr1DHash_NBit[lv] )
+   {
+      if ( Key != NULL )   delete [] Key;
+      if ( PID != NULL )   delete [] PID;
+
+      Key = new ulong [NSlot];
+      PID = new int   [NSlot];
+
+      amr->LB->PaddedCr1DHash_NBit[lv] = NBit;
+   }
+
+   for (long s=0; s<NSlot; s++)  PID[s] = -1;
+
+
+// insert all patches
+   const long Mask = NSlot - 1;
+
+   for (int p=0; p<NPatch; p++)
+   {
+      const ulong Cr1D = amr->patch[0][lv][p]->PaddedCr1D;
+      long        Slot = HashPaddedCr1D( Cr1D, NBit );
+
+      while ( PID[Slot] != -1 )
+      {
+         if ( Key[Slot] == Cr1D )
+            Aux_Error( ERROR_INFO, "duplicate patches at lv %d, PaddedCr1D %lu, PID = %d and %d !!\n",
+                       lv, Cr1D, PID[Slot], p );
+
+         Slot = ( Slot + 1 ) & Mask;
+      }
+
+      Key[Slot] = Cr1D;
+      PID[Slot] = p;
+   }
+
+} // FUNCTION : LB_PaddedCr1DHash_Build
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LB_PaddedCr1DHash_Find
+// Description :  Return the index of the patch with the target padded 1D corner coordinates at the target level
+//
+// Note        :  1. The hash table must be constructed by LB_PaddedCr1DHash_Build() in advance
+//                2. Thread-safe
+//
+// Parameter   :  lv         : Target refinement level
+//                PaddedCr1D : Target padded 1D corner coordinates
+//
+// Return      :  Patch index if found, -1 otherwise
+//-------------------------------------------------------------------------------------------------------
+int LB_PaddedCr1DHash_Find( const int lv, const ulong PaddedCr1D )
+{
+
+   const ulong *Key  = amr->LB->PaddedCr1DHash_Key [lv];
+   const int   *PID  = amr->LB->PaddedCr1DHash_PID [lv];
+   const int    NBit = amr->LB->PaddedCr1DHash_NBit[lv];
+
+   if ( PID == NULL )   return -1;
+
+   const long Mask = ( 1L << NBit ) - 1;
+   long       Slot = HashPaddedCr1D( PaddedCr1D, NBit );
+
+   while ( PID[Slot] != -1 )
+   {
+      if ( Key[Slot] == PaddedCr1D )   return PID[Slot];
+
+      Slot = ( Slot + 1 ) & Mask;
+   }
+
+   return -1;
+
+} // FUNCTION : LB_PaddedCr1DHash_Find
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  HashPaddedCr1D
+// Description :  Hash function of the padded 1D corner coordinates
+//
+// Note        :  1. Fibonacci hashing, which spreads the regularly spaced PaddedCr1D of adjacent patches
+//                   evenly over the table
+//
+// Parameter   :  PaddedCr1D : Padded 1D corner coordinates
+//                NBit       : log2 of the number of slots
+//
+// Return      :  Slot index in the range [0 ... 2^NBit-1]
+//-------------------------------------------------------------------------------------------------------
+ulong HashPaddedCr1D( const ulong PaddedCr1D, const int NBit )
+{
+
+   return ( PaddedCr1D*0x9E3779B97F4A7C15UL ) >> ( 64 - NBit );
+
+} // FUNCTION : HashPaddedCr1D
+
+
+
+#endif // #ifdef LOAD_BALANCE
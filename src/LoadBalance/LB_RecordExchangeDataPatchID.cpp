@@ -500,7 +500,7 @@ void LB_RecordExchangeDataPatchID( const int Lv, const bool AfterRefine )
       for (int t=0; t<LB_RecvH_NList[r]; t++)
          LB_RecvH_LBIdxList[r][t] = amr->patch[0][Lv][ LB_RecvH_IDList[r][t] ]->LB_Idx;
 
-      Mis_Heapsort( LB_RecvH_NList[r], LB_RecvH_LBIdxList[r], LB_RecvH_IDList_IdxTable[r] );
+      Mis_RadixSort( LB_RecvH_NList[r], LB_RecvH_LBIdxList[r], LB_RecvH_IDList_IdxTable[r] );
 
 //    5.1.4 get the sorted SibList and PaddedCr1D
       for (int t=0; t<LB_RecvH_NList[r]; t++)
@@ -512,7 +512,7 @@ void LB_RecordExchangeDataPatchID( const int Lv, const bool AfterRefine )
       }
 
 //    5.1.5 sort PaddedCr1D again and record the index table (for constructing the SibDiff lists later)
-      Mis_Heapsort( LB_RecvH_NList[r], LB_RecvH_PCr1D[r], LB_RecvH_PCr1D_IdxTable[r] );
+      Mis_RadixSort( LB_RecvH_NList[r], LB_RecvH_PCr1D[r], LB_RecvH_PCr1D_IdxTable[r] );
 
 //    5.1.6 get the recv SibDiff lists
       if ( AfterRefine )
@@ -553,7 +553,7 @@ void LB_RecordExchangeDataPatchID( const int Lv, const bool AfterRefine )
       int *TempIDList = new int [ LB_RecvH_NList[r] ];
       memcpy( TempIDList, LB_RecvH_IDList[r], LB_RecvH_NList[r]*sizeof(int) );
 
-      Mis_Heapsort( LB_RecvH_NList[r], TempIDList, NULL );
+      Mis_RadixSort( LB_RecvH_NList[r], TempIDList, NULL );
 
       for (int t=1; t<LB_RecvH_NList[r]; t++)
          if ( TempIDList[t] == TempIDList[t-1] )
@@ -605,7 +605,7 @@ void LB_RecordExchangeDataPatchID( const int Lv, const bool AfterRefine )
       for (int t=0; t<LB_RecvG_NList[r]; t++)
          LB_RecvG_LBIdxList[r][t] = amr->patch[0][Lv][ LB_RecvG_IDList[r][t] ]->LB_Idx;
 
-      Mis_Heapsort( LB_RecvG_NList[r], LB_RecvG_LBIdxList[r], LB_RecvG_IDList_IdxTable[r] );
+      Mis_RadixSort( LB_RecvG_NList[r], LB_RecvG_LBIdxList[r], LB_RecvG_IDList_IdxTable[r] );
 
 //    5.2.4 get the sorted SibList and PaddedCr1D
       for (int t=0; t<LB_RecvG_NList[r]; t++)
@@ -617,7 +617,7 @@ void LB_RecordExchangeDataPatchID( const int Lv, const bool AfterRefine )
       }
 
 //    5.2.5 sort PaddedCr1D again and record the index table (for constructing the SibDiff lists later)
-      Mis_Heapsort( LB_RecvG_NList[r], LB_RecvG_PCr1D[r], LB_RecvG_PCr1D_IdxTable[r] );
+      Mis_RadixSort( LB_RecvG_NList[r], LB_RecvG_PCr1D[r], LB_RecvG_PCr1D_IdxTable[r] );
 
 //    5.2.6 get the recv SibDiff lists
       if ( AfterRefine )
@@ -658,7 +658,7 @@ void LB_RecordExchangeDataPatchID( const int Lv, const bool AfterRefine )
       int *TempIDList = new int [ LB_RecvG_NList[r] ];
       memcpy( TempIDList, LB_RecvG_IDList[r], LB_RecvG_NList[r]*sizeof(int) );
 
-      Mis_Heapsort( LB_RecvG_NList[r], TempIDList, NULL );
+      Mis_RadixSort( LB_RecvG_NList[r], TempIDList, NULL );
 
       for (int t=1; t<LB_RecvG_NList[r]; t++)
          if ( TempIDList[t] == TempIDList[t-1] )
@@ -116,14 +116,14 @@ void LB_RecordExchangeRestrictDataPatchID( const int FaLv )
 
       LB_SendR_IDList_IdxTable[r] = new int [ LB_SendR_NList[r] ];
 
-      Mis_Heapsort( LB_SendR_NList[r], LB_SendR_LBIdx[r], LB_SendR_IDList_IdxTable[r] );
+      Mis_RadixSort( LB_SendR_NList[r], LB_SendR_LBIdx[r], LB_SendR_IDList_IdxTable[r] );
 
 //    send PID should not repeat
 #     ifdef GAMER_DEBUG
       int *TempIDList = new int [ LB_SendR_NList[r] ];
       memcpy( TempIDList, LB_SendR_IDList[r], LB_SendR_NList[r]*sizeof(int) );
 
-      Mis_Heapsort( LB_SendR_NList[r], TempIDList, NULL );
+      Mis_RadixSort( LB_SendR_NList[r], TempIDList, NULL );
 
       for (int t=1; t<LB_SendR_NList[r]; t++)
          if ( TempIDList[t] == TempIDList[t-1] )
@@ -233,7 +233,7 @@ void LB_RecordExchangeRestrictDataPatchID( const int FaLv )
          }
       }
 
-      Mis_Heapsort( Counter, TempList_LBIdx, TempList_LBIdx_IdxTable );
+      Mis_RadixSort( Counter, TempList_LBIdx, TempList_LBIdx_IdxTable );
 
       if ( Counter != LB_RecvR_NList[r] )
          Aux_Error( ERROR_INFO, "TRank %d, FaLv %d, Counter (%d) != NList (%d) !!\n",
@@ -167,6 +167,10 @@ void LB_Refine( const int FaLv )
    Par_LB_RecordExchangeParticlePatchID( FaLv );
 #  endif
 
+// 5.8 reset the neighbor communicators for OPT__LB_NEIGHBOR_MPI since the send/recv lists have changed
+   LB_GetBufferData_ResetNeighbor(  FaLv );
+   LB_GetBufferData_ResetNeighbor( SonLv );
+
 
 // 6. send particles to leaf real patches
 // ==========================================================================================
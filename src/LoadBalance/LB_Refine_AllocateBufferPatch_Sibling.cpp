@@ -109,30 +109,9 @@ void LB_Refine_AllocateBufferPatch_Sibling( const int SonLv )
 
 
 
-// 3. record the padded 1D corner coordinates (which can be overwritten by "LB_AllocateBufferPatch_Father")
+// 3. construct the hash table of the padded 1D corner coordinates (which can be overwritten by "LB_AllocateBufferPatch_Father")
 // ==========================================================================================
-   const int NPatch = amr->num[SonLv];
-
-   amr->LB->PaddedCr1DList         [SonLv] = (ulong*)realloc( amr->LB->PaddedCr1DList         [SonLv],
-                                                              NPatch*sizeof(ulong) );
-   amr->LB->PaddedCr1DList_IdxTable[SonLv] = (int*  )realloc( amr->LB->PaddedCr1DList_IdxTable[SonLv],
-                                                              NPatch*sizeof(int ) );
-
-   for (int SonPID=0; SonPID<NPatch; SonPID++)
-      amr->LB->PaddedCr1DList[SonLv][SonPID] = amr->patch[0][SonLv][SonPID]->PaddedCr1D;
-
-   Mis_Heapsort( NPatch, amr->LB->PaddedCr1DList[SonLv], amr->LB->PaddedCr1DList_IdxTable[SonLv] );
-
-// check : no duplicate patches at SonLv
-#  ifdef GAMER_DEBUG
-   for (int t=1; t<NPatch; t++)
-   {
-      if ( amr->LB->PaddedCr1DList[SonLv][t] == amr->LB->PaddedCr1DList[SonLv][t-1] )
-         Aux_Error( ERROR_INFO, "duplicate patches at SonLv %d, PaddedCr1D %lu, PID = %d and %d !!\n",
-                    SonLv, amr->LB->PaddedCr1DList[SonLv][t], amr->LB->PaddedCr1DList_IdxTable[SonLv][t],
-                    amr->LB->PaddedCr1DList_IdxTable[SonLv][t-1] );
-   }
-#  endif
+   LB_PaddedCr1DHash_Build( SonLv, amr->num[SonLv] );
 
 
 // free memory
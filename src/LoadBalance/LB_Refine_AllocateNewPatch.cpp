@@ -72,26 +72,26 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
    const int GraLv    = FaLv + 2;
    const int SonNReal = amr->NPatchComma[SonLv][1];
    const int SonNBuff = amr->NPatchComma[SonLv][3] - SonNReal;
-   const int FaNPatch = amr->num[FaLv];
 
 // 1. get the matching lists for the away patches
+//    --> Match_New[] and DelPID_Away[] store the indices of the matched patches at FaLv (-1 if not found)
 // ==========================================================================================
    int *Match_New   = new int [NNew_Away];
-   int *Match_Del   = new int [NDel_Away];
    int *DelPID_Away = new int [NDel_Away];
 
-   Mis_Matching_int( FaNPatch, amr->LB->PaddedCr1DList[FaLv], NNew_Away, NewCr1D_Away, Match_New );
-   Mis_Matching_int( FaNPatch, amr->LB->PaddedCr1DList[FaLv], NDel_Away, DelCr1D_Away, Match_Del );
+#  pragma omp parallel for schedule( runtime )
+   for (int t=0; t<NNew_Away; t++)  Match_New[t] = LB_PaddedCr1DHash_Find( FaLv, NewCr1D_Away[t] );
 
+#  pragma omp parallel for schedule( runtime )
    for (int t=0; t<NDel_Away; t++)
    {
+      DelPID_Away[t] = LB_PaddedCr1DHash_Find( FaLv, DelCr1D_Away[t] );
+
 #     ifdef GAMER_DEBUG
-      if ( Match_Del[t] == -1 )
+      if ( DelPID_Away[t] == -1 )
          Aux_Error( ERROR_INFO, "FaLv %d, away patch with Cr1D %lu found no matching !!\n",
                     FaLv, DelCr1D_Away[t] );
 #     endif
-
-      DelPID_Away[t] = amr->LB->PaddedCr1DList_IdxTable[FaLv][ Match_Del[t] ];
    }
 
 
@@ -116,7 +116,6 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
    int NBufBk=0, NBufBk_Dup;  // BufBk : backup the data of buffer patches
                               // must set NBufBk=0 here --> otherwise it may not be initialized if SonNBuff == 0
    ulong *PCr1D_BufBk          = new ulong [SonNBuff];
-   int   *PCr1D_BufBk_IdxTable = new int   [SonNBuff];
    int   *PID_BufBk            = NULL;
 
 // to avoid GNU warnings "non-constant array new length must be specified without parentheses around the type-id [-Wvla]"
@@ -167,7 +166,7 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
       }
 
 //    2-1-3. sort the PID list and remove duplicates
-      Mis_Heapsort( NBufBk_Dup, PID_BufBk, NULL );
+      Mis_RadixSort( NBufBk_Dup, PID_BufBk, NULL );
 
       NBufBk = ( NBufBk_Dup > 0 ) ? 1 : 0;
 
@@ -226,9 +225,6 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
          PCr1D_BufBk[t] = amr->patch[0][SonLv][SonPID]->PaddedCr1D;
       } // for (int t=0; t<NBufBk; t++)
 
-//    2-2-4. sort PCr1D_BufBk
-      Mis_Heapsort( NBufBk, PCr1D_BufBk, PCr1D_BufBk_IdxTable );
-
 
 //    2-3. deallocate all buffer patches
       for (int SonPID=SonNReal; SonPID<amr->NPatchComma[SonLv][3]; SonPID++)
@@ -249,16 +245,8 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
 //    2-3-3. reset NPatchComma
       for (int m=2; m<28; m++)   amr->NPatchComma[SonLv][m] = SonNReal;
 
-//    2-3-4. recalculate PaddedCr1DList
-      amr->LB->PaddedCr1DList         [SonLv] = (ulong*)realloc( amr->LB->PaddedCr1DList         [SonLv],
-                                                                 SonNReal*sizeof(ulong) );
-      amr->LB->PaddedCr1DList_IdxTable[SonLv] = (int*  )realloc( amr->LB->PaddedCr1DList_IdxTable[SonLv],
-                                                                 SonNReal*sizeof(int ) );
-
-      for (int SonPID=0; SonPID<SonNReal; SonPID++)
-         amr->LB->PaddedCr1DList[SonLv][SonPID] = amr->patch[0][SonLv][SonPID]->PaddedCr1D;
-
-      Mis_Heapsort( SonNReal, amr->LB->PaddedCr1DList[SonLv], amr->LB->PaddedCr1DList_IdxTable[SonLv] );
+//    2-3-4. reconstruct the PaddedCr1D hash table
+      LB_PaddedCr1DHash_Build( SonLv, SonNReal );
 
    } // if ( SonNBuff != 0 )
 
@@ -394,7 +382,7 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
 //    3.2.2 away patches with father patch
       else
       {
-         FaPID    = amr->LB->PaddedCr1DList_IdxTable[FaLv][ Match_New[t] ];
+         FaPID    = Match_New[t];
          Cr3D_Ptr = amr->patch[0][FaLv][FaPID]->corner;
 
          NewSonPID0_Away[t] = AllocateSonPatch( FaLv, Cr3D_Ptr, PScale, FaPID,
@@ -468,7 +456,7 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
    for (int SonPID=0; SonPID<SonNReal_New; SonPID++)
       amr->LB->IdxList_Real[SonLv][SonPID] = amr->patch[0][SonLv][SonPID]->LB_Idx;
 
-   Mis_Heapsort( SonNReal_New, amr->LB->IdxList_Real[SonLv], amr->LB->IdxList_Real_IdxTable[SonLv] );
+   Mis_RadixSort( SonNReal_New, amr->LB->IdxList_Real[SonLv], amr->LB->IdxList_Real_IdxTable[SonLv] );
 
 
 // 6.4 check : no duplicate patches at FaLv and SonLv
@@ -481,7 +469,7 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
       for (int PID=0; PID<amr->num[lv]; PID++)
          TempPaddedCr1D[PID] = amr->patch[0][lv][PID]->PaddedCr1D;
 
-      Mis_Heapsort( amr->num[lv], TempPaddedCr1D, TempPaddedCr1D_IdxTable );
+      Mis_RadixSort( amr->num[lv], TempPaddedCr1D, TempPaddedCr1D_IdxTable );
 
       for (int t=1; t<amr->num[lv]; t++)
       {
@@ -569,25 +557,26 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
    int *Match_BufBk = new int [NBufBk];
    int  MPID;
 
-// 10.1 get the match lists
-   Mis_Matching_int( amr->num[SonLv], amr->LB->PaddedCr1DList[SonLv], NBufBk, PCr1D_BufBk, Match_BufBk );
+// 10.1 get the match lists (i.e., the indices of the new buffer patches at SonLv)
+#  pragma omp parallel for schedule( runtime )
+   for (int t=0; t<NBufBk; t++)  Match_BufBk[t] = LB_PaddedCr1DHash_Find( SonLv, PCr1D_BufBk[t] );
 
 // 10.2 reset array pointers
    for (int t=0; t<NBufBk; t++)
    {
       if ( Match_BufBk[t] != -1 )
       {
-         MPID = amr->LB->PaddedCr1DList_IdxTable[SonLv][ Match_BufBk[t] ];
+         MPID = Match_BufBk[t];
 
 #        ifdef GAMER_DEBUG
          if ( MPID < amr->NPatchComma[SonLv][1] )
-            Aux_Error( ERROR_INFO, "Match_PID = %d matches to a real patch (Match[%d] = %d, SonNReal = %d) !!\n",
-                       MPID, t, Match_BufBk[t], amr->NPatchComma[SonLv][1] );
+            Aux_Error( ERROR_INFO, "Match_PID = %d matches to a real patch (t = %d, SonNReal = %d) !!\n",
+                       MPID, t, amr->NPatchComma[SonLv][1] );
 #        endif
 
          if ( OPT__REUSE_MEMORY )
          {
-            const int OldBufPID = PID_BufBk[ PCr1D_BufBk_IdxTable[t] ];
+            const int OldBufPID = PID_BufBk[t];
 
 //          note that (1) we must swap poniters even if MPID == OldBufPID (because they have different Sg)
 //                    (2) we store the previous buffer data in FSg_Flu2, FSg_Pot2 and FSg_Mag2 instead of FSg_Flu, FSg_Pot, and FSg_Mag
@@ -624,20 +613,20 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
          {
 //          note that it's OK to leave FSg_Flu2, FSg_Pot2, FSg_Mag2 unmodified (which can thus be NULL) since
 //          it will be allocated in LB_RecordExchangeDataPatchID if necessary
-            real (*flu_ptr)[PS1][PS1][PS1] = flu_BufBk[ PCr1D_BufBk_IdxTable[t] ];
+            real (*flu_ptr)[PS1][PS1][PS1] = flu_BufBk[t];
             if ( flu_ptr != NULL )
                amr->patch[FSg_Flu][SonLv][MPID]->fluid = flu_ptr;
 
 #           ifdef GRAVITY
 //          don't worry about pot_ext since it's actually useless for buffer patches
 //          --> after the following operation, some buffer patches may have pot != NULL but pot_ext == NULL (for FSg_Pot)
-            real (*pot_ptr)[PS1][PS1] = pot_BufBk[ PCr1D_BufBk_IdxTable[t] ];
+            real (*pot_ptr)[PS1][PS1] = pot_BufBk[t];
             if ( pot_ptr != NULL )
                amr->patch[FSg_Pot][SonLv][MPID]->pot = pot_ptr;
 #           endif
 
 #           ifdef MHD
-            real (*mag_ptr)[ PS1P1*SQR(PS1) ] = mag_BufBk[ PCr1D_BufBk_IdxTable[t] ];
+            real (*mag_ptr)[ PS1P1*SQR(PS1) ] = mag_BufBk[t];
             if ( mag_ptr != NULL )
                amr->patch[FSg_Mag][SonLv][MPID]->magnetic = mag_ptr;
 #           endif
@@ -646,12 +635,12 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
 
       else if ( ! OPT__REUSE_MEMORY )
       {
-         delete [] flu_BufBk[ PCr1D_BufBk_IdxTable[t] ];
+         Mis_SlabAlloc_Delete( SLAB_FLUID,    flu_BufBk[t] );
 #        ifdef GRAVITY
-         delete [] pot_BufBk[ PCr1D_BufBk_IdxTable[t] ];
+         Mis_SlabAlloc_Delete( SLAB_POT,      pot_BufBk[t] );
 #        endif
 #        ifdef MHD
-         delete [] mag_BufBk[ PCr1D_BufBk_IdxTable[t] ];
+         Mis_SlabAlloc_Delete( SLAB_MAGNETIC, mag_BufBk[t] );
 #        endif
       } // if ( Match_BufBk[t] != -1 ) ... else if ...
    } // for (int t=0; t<NBufBk; t++)
@@ -661,14 +650,12 @@ void LB_Refine_AllocateNewPatch( const int FaLv, int NNew_Home, int *NewPID_Home
 // free memory
    free( NewSonPID0_All );
    delete [] Match_New;
-   delete [] Match_Del;
    delete [] Match_BufBk;
    delete [] DelPID_Away;
    delete [] NewSonPID0_NoFa;
    delete [] NewSonPID_All;
    if ( NewFaBufPID0 != NULL )   delete [] NewFaBufPID0;
    delete [] PCr1D_BufBk;
-   delete [] PCr1D_BufBk_IdxTable;
    delete [] PID_BufBk;
    delete [] flu_BufBk;
 #  ifdef GRAVITY
@@ -4,6 +4,11 @@
 
 
 
+static void SortLBIdx0_Distributed( int &NPG, long *&LBIdx0, double *&Load );
+static int  LowerBound( const int N, const long Array[], const long Key );
+
+
+
 
 //-------------------------------------------------------------------------------------------------------
 // Function    :  LB_SetCutPoint
@@ -15,33 +20,39 @@
 //                3. Option "InputLBIdx0AndLoad" is useful during RESTART where we have very limited information
 //                   (e.g., we don't know the number of patches in each rank, amr->NPatchComma, and any
 //                   particle information yet ...)
-//                   --> See the description of "InputLBIdx0AndLoad, LBIdx0_AllRank_Input, and
-//                       Load_AllRank_Input" below
+//                   --> See the description of "InputLBIdx0AndLoad, LBIdx0_Input, and Load_Input" below
+//                4. Cut points are computed in parallel without collecting all patch groups to a single rank
+//                   --> Patch groups are first sorted by LBIdx across all ranks by SortLBIdx0_Distributed(),
+//                       which is trivial if the patch groups are already distributed by the current cut points
+//                   --> Each rank then determines the cut points falling within its own segment of the sorted list
+//                       from the accumulated workload of all preceding ranks
+//                   --> Memory consumption per rank is O(number of patch groups per rank + MPI_NRank)
 //
-// Parameter   :  lv                   : Target refinement level
-//                NPG_Total            : Total number of patch groups on level "lv"
-//                CutPoint             : Cut point array to be set
-//                InputLBIdx0AndLoad   : Provide both LBIdx0_AllRank_Input[] and Load_AllRank_Input[] directly
-//                                       so that they don't have to be collected from all ranks again
-//                                       --> Useful during RESTART
-//                LBIdx0_AllRank_Input : LBIdx of all patch groups in all ranks
-//                                       --> Useful only when InputLBIdx0AndLoad == true
-//                                       --> Only need the **minimum** LBIdx in each patch group
-//                                       --> Only rank 0 needs to provide this list
-//                                       --> Can be unsorted
-//                Load_AllRank_Input   : Load-balance weighting of all patch groups in all ranks
-//                                       --> Useful only when InputLBIdx0AndLoad == true
-//                                       --> Please provide the **sum** of all patches within each patch group
-//                                       --> Only rank 0 needs to provide this list
-//                                       --> Must be in the same order as LBIdx0_AllRank_Input
-//                ParWeight            : Relative load-balance weighting of particles
-//                                       --> Weighting of each patch is estimated as "PATCH_SIZE^3 + NParThisPatch*ParWeight"
-//                                       --> <= 0.0 : do not consider particle weighting
+// Parameter   :  lv                 : Target refinement level
+//                NPG_Input          : Number of patch groups in LBIdx0_Input[] and Load_Input[] on this rank
+//                                     --> Useful only when InputLBIdx0AndLoad == true
+//                CutPoint           : Cut point array to be set
+//                InputLBIdx0AndLoad : Provide both LBIdx0_Input[] and Load_Input[] directly
+//                                     so that they don't have to be collected from the real patches
+//                                     --> Useful during RESTART
+//                LBIdx0_Input       : LBIdx of patch groups provided by this rank
+//                                     --> Useful only when InputLBIdx0AndLoad == true
+//                                     --> Only need the **minimum** LBIdx in each patch group
+//                                     --> Patch groups can be distributed arbitrarily among ranks
+//                                         (e.g., all patch groups can be provided by rank 0)
+//                                     --> Can be unsorted
+//                Load_Input         : Load-balance weighting of patch groups provided by this rank
+//                                     --> Useful only when InputLBIdx0AndLoad == true
+//                                     --> Please provide the **sum** of all patches within each patch group
+//                                     --> Must be in the same order as LBIdx0_Input
+//                ParWeight          : Relative load-balance weighting of particles
+//                                     --> Weighting of each patch is estimated as "PATCH_SIZE^3 + NParThisPatch*ParWeight"
+//                                     --> <= 0.0 : do not consider particle weighting
 //
 // Return      :  CutPoint[]
 //-------------------------------------------------------------------------------------------------------
-void LB_SetCutPoint( const int lv, const int NPG_Total, long *CutPoint, const bool InputLBIdx0AndLoad,
-                     long *LBIdx0_AllRank_Input, double *Load_AllRank_Input, const double ParWeight )
+void LB_SetCutPoint( const int lv, const int NPG_Input, long *CutPoint, const bool InputLBIdx0AndLoad,
+                     long *LBIdx0_Input, double *Load_Input, const double ParWeight )
 {
 
    if ( OPT__VERBOSE  &&  MPI_Rank == 0 )
@@ -49,58 +60,37 @@ void LB_SetCutPoint( const int lv, const int NPG_Total, long *CutPoint, const bo
 
 
 // check
-   if ( MPI_Rank == 0  &&  InputLBIdx0AndLoad  &&  ( LBIdx0_AllRank_Input == NULL || Load_AllRank_Input == NULL )  )
-      Aux_Error( ERROR_INFO, "LBIdx0_AllRank_Input/Load_AllRank_Input == NULL when InputLBIdx0AndLoad is on !!\n" );
+   if ( InputLBIdx0AndLoad  &&  NPG_Input < 0 )
+      Aux_Error( ERROR_INFO, "NPG_Input (%d) < 0 !!\n", NPG_Input );
 
-   if ( NPG_Total < 0 )
-      Aux_Error( ERROR_INFO, "NPG_Total (%d) < 0 !!\n", NPG_Total );
+   if ( InputLBIdx0AndLoad  &&  NPG_Input > 0  &&  ( LBIdx0_Input == NULL || Load_Input == NULL )  )
+      Aux_Error( ERROR_INFO, "LBIdx0_Input/Load_Input == NULL when InputLBIdx0AndLoad is on !!\n" );
 
 
-// 1. collect the load-balance weighting and LB_Idx of all patch groups from all ranks
-   long   *LBIdx0_AllRank = NULL;
-   double *Load_AllRank   = NULL;
-   int    *IdxTable       = ( MPI_Rank == 0 ) ? new int [NPG_Total] : NULL;
+// 1. collect the load-balance weighting and LB_Idx of all patch groups in this rank
+   int     NPG_ThisRank;
+   long   *LBIdx0_ThisRank = NULL;
+   double *Load_ThisRank   = NULL;
 
 // use the input tables directly
 // --> useful during RESTART, where we have very limited information
 //     (e.g., we don't know the number of patches in each rank, amr->NPatchComma, and any particle information yet ...)
+// --> copy them since they will be sorted and redistributed
    if ( InputLBIdx0AndLoad )
    {
-      if ( MPI_Rank == 0 )
-      {
-         LBIdx0_AllRank = LBIdx0_AllRank_Input;
-         Load_AllRank   = Load_AllRank_Input;
-      }
+      NPG_ThisRank    = NPG_Input;
+      LBIdx0_ThisRank = new long   [ NPG_ThisRank ];
+      Load_ThisRank   = new double [ NPG_ThisRank ];
+
+      memcpy( LBIdx0_ThisRank, LBIdx0_Input, NPG_ThisRank*sizeof(long)   );
+      memcpy( Load_ThisRank,   Load_Input,   NPG_ThisRank*sizeof(double) );
    }
 
    else
    {
-//    allocate memory
-      int NPG_ThisRank = amr->NPatchComma[lv][1] / 8;
-
-      long   *LBIdx0_ThisRank = new long   [ NPG_ThisRank ];
-      double *Load_ThisRank   = new double [ NPG_ThisRank ];
-      int    *NPG_EachRank    = NULL;
-      int    *Recv_Disp       = NULL;
-
-      if ( MPI_Rank == 0 )
-      {
-         NPG_EachRank   = new int    [ MPI_NRank ];
-         Recv_Disp      = new int    [ MPI_NRank ];
-         LBIdx0_AllRank = new long   [ NPG_Total ];
-         Load_AllRank   = new double [ NPG_Total ];
-      }
-
-
-//    collect the number of patch groups in each rank
-      MPI_Gather( &NPG_ThisRank, 1, MPI_INT, NPG_EachRank, 1, MPI_INT, 0, MPI_COMM_WORLD );
-
-      if ( MPI_Rank == 0 )
-      {
-         Recv_Disp[0] = 0;
-         for (int r=0; r<MPI_NRank-1; r++)   Recv_Disp[r+1] = Recv_Disp[r] + NPG_EachRank[r];
-      }
-
+      NPG_ThisRank    = amr->NPatchComma[lv][1] / 8;
+      LBIdx0_ThisRank = new long   [ NPG_ThisRank ];
+      Load_ThisRank   = new double [ NPG_ThisRank ];
 
 //    collect the minimum LBIdx in each patch group
 //    --> assuming patches within the same patch group have consecutive LBIdx
@@ -112,148 +102,170 @@ void LB_SetCutPoint( const int lv, const int NPG_Total, long *CutPoint, const bo
          LBIdx0_ThisRank[t] -= LBIdx0_ThisRank[t] % 8;         // get the **minimum** LBIdx in this patch group
       }
 
-      MPI_Gatherv( LBIdx0_ThisRank, NPG_ThisRank, MPI_LONG, LBIdx0_AllRank, NPG_EachRank, Recv_Disp,
-                   MPI_LONG, 0, MPI_COMM_WORLD );
-
-
 //    collect the load-balance weighting in each patch group
       LB_EstimateWorkload_AllPatchGroup( lv, ParWeight, Load_ThisRank );
+   } // if ( InputLBIdx0AndLoad ) ... else ...
 
-      MPI_Gatherv( Load_ThisRank, NPG_ThisRank, MPI_DOUBLE, Load_AllRank, NPG_EachRank, Recv_Disp,
-                   MPI_DOUBLE, 0, MPI_COMM_WORLD );
 
+// 2. sort patch groups by LBIdx across all ranks
+// --> afterwards, each rank holds a contiguous segment of the globally sorted list and
+//     the segments are arranged in the order of MPI ranks
+   SortLBIdx0_Distributed( NPG_ThisRank, LBIdx0_ThisRank, Load_ThisRank );
 
-//    free memory
-      delete [] LBIdx0_ThisRank;
-      delete [] Load_ThisRank;
 
-      if ( MPI_Rank == 0 )
-      {
-         delete [] NPG_EachRank;
-         delete [] Recv_Disp;
-      }
-   } // if ( InputLBIdx0AndLoad ) ... else ...
+// 3. get the global information required for setting the cut points
+// 3-1. total number of patch groups and the range of LBIdx
+   long NPG_Total, LBIdx0_Min, LBIdx0_Max, LBIdx0_Next;
+   long NPG_ThisRank_long = NPG_ThisRank;
+   long LBIdx0_First      = ( NPG_ThisRank > 0 ) ? LBIdx0_ThisRank[0]              : __LONG_MAX__;
+   long LBIdx0_Last       = ( NPG_ThisRank > 0 ) ? LBIdx0_ThisRank[NPG_ThisRank-1] : -1L;
+
+   MPI_Allreduce( &NPG_ThisRank_long, &NPG_Total,  1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD );
+   MPI_Allreduce( &LBIdx0_First,      &LBIdx0_Min, 1, MPI_LONG, MPI_MIN, MPI_COMM_WORLD );
+   MPI_Allreduce( &LBIdx0_Last,       &LBIdx0_Max, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD );
 
+// 3-2. minimum LBIdx of the next patch group after this rank
+// --> the maximum LBIdx in all patches is LBIdx0_Max + 7
+   long *LBIdx0_First_AllRank = new long [MPI_NRank];
 
-   if ( MPI_Rank == 0 )
+   MPI_Allgather( &LBIdx0_First, 1, MPI_LONG, LBIdx0_First_AllRank, 1, MPI_LONG, MPI_COMM_WORLD );
+
+   LBIdx0_Next = LBIdx0_Max + 8;
+   for (int r=MPI_NRank-1; r>MPI_Rank; r--)
+      if ( LBIdx0_First_AllRank[r] != __LONG_MAX__ )  LBIdx0_Next = LBIdx0_First_AllRank[r];
+
+   delete [] LBIdx0_First_AllRank;
+
+// 3-3. total workload and the accumulated workload of all preceding ranks
+// --> accumulate the workload of all ranks in the same order on all ranks so that the results are bitwise identical
+//     (otherwise a cut point may be claimed by no rank due to round-off errors)
+   double  Load_ThisRank_Sum = 0.0, Load_Before, Load_After, Load_Total, Load_Ave;
+   double *Load_Sum_AllRank  = new double [MPI_NRank];
+
+   for (int t=0; t<NPG_ThisRank; t++)  Load_ThisRank_Sum += Load_ThisRank[t];
+
+   MPI_Allgather( &Load_ThisRank_Sum, 1, MPI_DOUBLE, Load_Sum_AllRank, 1, MPI_DOUBLE, MPI_COMM_WORLD );
+
+   Load_Total = 0.0;
+   for (int r=0; r<MPI_NRank; r++)
    {
-      double *Load_Record = ( OPT__VERBOSE ) ? new double [MPI_NRank] : NULL;
-      double  Load_Ave;
+      if ( r == MPI_Rank )    Load_Before = Load_Total;
 
-//    3. sort LB_Idx
-//    --> after sorting, we must use IdxTable to access the Load_AllRank[] array
-      Mis_Heapsort( NPG_Total, LBIdx0_AllRank, IdxTable );
+      Load_Total += Load_Sum_AllRank[r];
 
+      if ( r == MPI_Rank )    Load_After  = Load_Total;
+   }
 
-//    4. set the cut points
-      for (int t=0; t<MPI_NRank+1; t++)   CutPoint[t] = -1;
+   delete [] Load_Sum_AllRank;
 
-//    4-1. take care of the case with no patches at all
-      if ( NPG_Total == 0 )
-      {
-         Load_Ave = 0.0;
+   Load_Ave = Load_Total / (double)MPI_NRank;
 
-         if ( OPT__VERBOSE )
-            for (int r=0; r<MPI_NRank; r++)  Load_Record[r] = 0.0;
-      }
 
-      else
-      {
-//       4-2. get the average workload for each rank
-         Load_Ave = 0.0;
-         for (int t=0; t<NPG_Total; t++)  Load_Ave += Load_AllRank[t];
-         Load_Ave /= (double)MPI_NRank;
-
-//       4-3. set the min and max cut points
-         const long LBIdx0_Min = LBIdx0_AllRank[             0 ];
-         const long LBIdx0_Max = LBIdx0_AllRank[ NPG_Total - 1 ];
-         CutPoint[        0] = LBIdx0_Min;
-         CutPoint[MPI_NRank] = LBIdx0_Max + 8;  // +8 since the maximum LBIdx in all patches is LBIdx0_Max + 7
-
-//       4-4. find the LBIdx with an accumulated workload (LoadAcc) closest to the average workload of each rank (LoadTarget)
-         int    CutIdx     = 1;                 // target array index for CutPoint[]
-                                                // --> note that CutPoint[CutIdx] is the **exclusive** upper bound of rank "CutIdx-1"
-         double LoadAcc    = 0.0;               // accumulated workload
-         double LoadTarget = CutIdx*Load_Ave;   // target accumulated workload for the rank "CutIdx-1"
-         double LoadThisPG;                     // workload of the target patch group
-
-         for (int PG=0; PG<NPG_Total; PG++)
-         {
-//          nothing to do if all cut points have been set already
-            if ( CutIdx == MPI_NRank )    break;
-
-//          remember to use IdxTable to access Load_AllRank
-            LoadThisPG = Load_AllRank[ IdxTable[PG] ];
-
-//          check if adding a new patch group will exceed the target accumulated workload
-            if ( LoadAcc+LoadThisPG >= LoadTarget )
-            {
-//             determine the cut point with an accumulated workload **closest** to the target accumulated workload
-//             (a) if adding a new patch group will exceed the target accumulated workload too much
-//                 --> exclude this patch group from the rank "CutIdx-1"
-//             note that both "LoadAcc > LoadTarget" and "LoadAcc <= LoadTaget" can happen
-               if ( fabs(LoadAcc-LoadTarget) < LoadAcc+LoadThisPG-LoadTarget )
-               {
-                  CutPoint[CutIdx] = LBIdx0_AllRank[PG];
-
-                  PG --;   // because this patch group has been **excluded** from this cut point
-               }
-
-//             (b) if adding a new patch group will NOT exceed the target accumulated workload too much
-//                 --> include this patch group in the rank "CutIdx-1"
-               else
-               {
-//                be careful about the special case "PG == NPG_Total-1"
-                  CutPoint[CutIdx] = ( PG == NPG_Total-1 ) ? CutPoint[MPI_NRank] : LBIdx0_AllRank[PG+1];
-
-                  LoadAcc += LoadThisPG;
-               }
-
-//             record the **accumulated** workload of each rank
-               if ( OPT__VERBOSE )  Load_Record[ CutIdx - 1 ] = LoadAcc;
-
-               CutIdx ++;
-               LoadTarget = CutIdx*Load_Ave;
-            } // if ( LoadAcc+LoadThisPG >= LoadTarget )
+// 4. set the cut points
+   for (int t=0; t<MPI_NRank+1; t++)   CutPoint[t] = -1;
 
-            else
-            {
-               LoadAcc += LoadThisPG;
-            } // if ( LoadAcc+LoadThisPG >= LoadTarget ) ... else ...
+// 4-1. take care of the case with no patches at all
+   if ( NPG_Total > 0 )
+   {
+//    4-2. find the LBIdx with an accumulated workload (LoadAcc) closest to the average workload of each rank (LoadTarget)
+//         --> each rank only sets the cut points with Load_Before < LoadTarget <= Load_After
+//    skip the cut points already reached by the preceding ranks
+      int    CutIdx = 1;                     // target array index for CutPoint[]
+                                             // --> note that CutPoint[CutIdx] is the **exclusive** upper bound of rank "CutIdx-1"
+      double LoadAcc = Load_Before;          // accumulated workload
+      double LoadThisPG;                     // workload of the target patch group
 
-         } // for (int PG=0; PG<NPG_Total; PG++)
+      while ( CutIdx < MPI_NRank  &&  CutIdx*Load_Ave <= Load_Before )  CutIdx ++;
 
-//       4.5 take care of the special case where the last several ranks have no patches at all
-         for (int t=CutIdx; t<MPI_NRank; t++)
+      for (int PG=0; PG<NPG_ThisRank; PG++)
+      {
+//       nothing to do if all cut points have been set already
+         if ( CutIdx == MPI_NRank )    break;
+
+         LoadThisPG = Load_ThisRank[PG];
+
+//       check if adding a new patch group will exceed the target accumulated workload
+//       --> a single patch group can exceed the target accumulated workload of several ranks
+//       --> the last patch group must take all remaining cut points belonging to this rank since the running sum
+//           LoadAcc may be slightly smaller than Load_After due to round-off errors
+         while (  CutIdx < MPI_NRank  &&  CutIdx*Load_Ave <= Load_After  &&
+                  ( LoadAcc+LoadThisPG >= CutIdx*Load_Ave || PG == NPG_ThisRank-1 )  )
          {
-            CutPoint[t] = CutPoint[MPI_NRank];
+            const double LoadTarget = CutIdx*Load_Ave;
+
+//          determine the cut point with an accumulated workload **closest** to the target accumulated workload
+//          (a) if adding a new patch group will exceed the target accumulated workload too much
+//              --> exclude this patch group from the rank "CutIdx-1"
+//          note that both "LoadAcc > LoadTarget" and "LoadAcc <= LoadTaget" can happen
+            if ( fabs(LoadAcc-LoadTarget) < LoadAcc+LoadThisPG-LoadTarget )
+               CutPoint[CutIdx] = LBIdx0_ThisRank[PG];
+
+//          (b) if adding a new patch group will NOT exceed the target accumulated workload too much
+//              --> include this patch group in the rank "CutIdx-1"
+//          be careful about the last patch group in this rank
+            else
+               CutPoint[CutIdx] = ( PG == NPG_ThisRank-1 ) ? LBIdx0_Next : LBIdx0_ThisRank[PG+1];
 
-            if ( OPT__VERBOSE )  Load_Record[ t - 1 ] = Load_Ave*MPI_NRank;
+            CutIdx ++;
          }
 
-//       4.6 check
-#        ifdef GAMER_DEBUG
-//       all cut points must be set properly
-         for (int t=0; t<MPI_NRank+1; t++)
-            if ( CutPoint[t] == -1 )
-               Aux_Error( ERROR_INFO, "lv %d, CutPoint[%d] == -1 !!\n", lv, t );
+         LoadAcc += LoadThisPG;
+      } // for (int PG=0; PG<NPG_ThisRank; PG++)
+
+
+//    4-3. collect the cut points set by all ranks
+//    --> each cut point is set by at most one rank and all unset cut points are -1
+      MPI_Allreduce( MPI_IN_PLACE, CutPoint, MPI_NRank+1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD );
+
+//    4-4. set the min and max cut points
+      CutPoint[        0] = LBIdx0_Min;
+      CutPoint[MPI_NRank] = LBIdx0_Max + 8;  // +8 since the maximum LBIdx in all patches is LBIdx0_Max + 7
+
+//    4-5. take care of the special case where the last several ranks have no patches at all
+//    --> also enforce monotonicity, which is necessary when several cut points are set by the same patch group
+//        (i.e., "a patch group included in the rank CutIdx-1 must not be assigned to the rank CutIdx")
+      for (int t=1; t<MPI_NRank; t++)
+      {
+         if ( CutPoint[t] == -1 )   CutPoint[t] = CutPoint[MPI_NRank];
+
+         CutPoint[t] = MAX( CutPoint[t], CutPoint[t-1] );
+      }
+
+//    4-6. check
+#     ifdef GAMER_DEBUG
+//    all cut points must be set properly
+      for (int t=0; t<MPI_NRank+1; t++)
+         if ( CutPoint[t] == -1 )
+            Aux_Error( ERROR_INFO, "lv %d, CutPoint[%d] == -1 !!\n", lv, t );
 
-//       monotonicity
-         for (int t=0; t<MPI_NRank; t++)
-            if ( CutPoint[t+1] < CutPoint[t] )
-               Aux_Error( ERROR_INFO, "lv %d, CutPoint[%d] (%ld) < CutPoint[%d] (%ld) !!\n",
-                          lv, t+1, CutPoint[t+1], t, CutPoint[t] );
-#        endif
-      } // if ( NPG_Total == 0 ) ... else ...
+//    monotonicity
+      for (int t=0; t<MPI_NRank; t++)
+         if ( CutPoint[t+1] < CutPoint[t] )
+            Aux_Error( ERROR_INFO, "lv %d, CutPoint[%d] (%ld) < CutPoint[%d] (%ld) !!\n",
+                       lv, t+1, CutPoint[t+1], t, CutPoint[t] );
+#     endif
+   } // if ( NPG_Total > 0 )
 
 
-//    5. output the cut points and workload of each MPI rank
-      if ( OPT__VERBOSE )
+// 5. output the cut points and workload of each MPI rank
+   if ( OPT__VERBOSE )
+   {
+      double *Load_Record = new double [MPI_NRank];
+
+      for (int r=0; r<MPI_NRank; r++)  Load_Record[r] = 0.0;
+
+//    patch groups are sorted and so are the cut points
+      for (int PG=0, r=0; PG<NPG_ThisRank; PG++)
       {
-//       convert the accumulated workload to the actual workload of each rank
-         Load_Record[ MPI_NRank - 1 ] = Load_Ave*MPI_NRank;
-         for (int r=MPI_NRank-1; r>=1; r--)  Load_Record[r] -= Load_Record[r-1];
+         while ( r < MPI_NRank-1  &&  LBIdx0_ThisRank[PG] >= CutPoint[r+1] )   r ++;
+
+         Load_Record[r] += Load_ThisRank[PG];
+      }
 
+      MPI_Reduce( (MPI_Rank==0)?MPI_IN_PLACE:Load_Record, Load_Record, MPI_NRank, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+
+      if ( MPI_Rank == 0 )
+      {
          double Load_Max = -1.0;
 
          for (int r=0; r<MPI_NRank; r++)
@@ -267,33 +279,213 @@ void LB_SetCutPoint( const int lv, const int NPG_Total, long *CutPoint, const bo
          Aux_Message( stdout, "         Load_Ave %9.3e, Load_Max %9.3e --> Load_Imbalance = %6.2f%%\n",
                       Load_Ave, Load_Max, (NPG_Total == 0) ? 0.0 : 100.0*(Load_Max-Load_Ave)/Load_Ave );
          Aux_Message( stdout, "         =============================================================================\n" );
-
-         delete [] Load_Record;
       }
-   } // if ( MPI_Rank == 0 )
 
-
-// 6. broadcast the cut points
-   MPI_Bcast( CutPoint, MPI_NRank+1, MPI_LONG, 0, MPI_COMM_WORLD );
+      delete [] Load_Record;
+   } // if ( OPT__VERBOSE )
 
 
 // free memory
-   if ( MPI_Rank == 0 )
+   delete [] LBIdx0_ThisRank;
+   delete [] Load_ThisRank;
+
+
+   if ( OPT__VERBOSE  &&  MPI_Rank == 0 )
+      Aux_Message( stdout, "      %s at Lv %2d ... done\n", __FUNCTION__, lv );
+
+} // FUNCTION : LB_SetCutPoint
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SortLBIdx0_Distributed
+// Description :  Sort patch groups by LBIdx across all ranks
+//
+// Note        :  1. On return, each rank holds a sorted and contiguous segment of the globally sorted list,
+//                   and the segments are arranged in the order of MPI ranks
+//                2. Patch groups are not exchanged if they are already globally sorted after the local sorting
+//                   (e.g., when patches are distributed according to the current cut points)
+//                3. Otherwise, the splitters between ranks are determined by bisection on LBIdx so that
+//                   each rank receives nearly the same number of patch groups
+//                   --> Each iteration only requires an MPI_Allreduce() of MPI_NRank-1 counts, and the
+//                       number of iterations is bounded by log2 of the range of LBIdx
+//                4. Input arrays are reallocated if necessary
+//                5. LBIdx of different patch groups must be distinct and non-negative
+//
+// Parameter   :  NPG    : Number of patch groups in this rank
+//                LBIdx0 : Minimum LBIdx in each patch group
+//                Load   : Load-balance weighting of each patch group
+//
+// Return      :  NPG, LBIdx0[], Load[]
+//-------------------------------------------------------------------------------------------------------
+void SortLBIdx0_Distributed( int &NPG, long *&LBIdx0, double *&Load )
+{
+
+// 1. sort locally
+   int    *IdxTable    = new int    [NPG];
+   double *Load_Sorted = new double [NPG];
+
+   Mis_RadixSort( NPG, LBIdx0, IdxTable );
+
+   for (int t=0; t<NPG; t++)  Load_Sorted[t] = Load[ IdxTable[t] ];
+
+   delete [] Load;
+   delete [] IdxTable;
+   Load = Load_Sorted;
+
+
+// 2. return if patch groups are already globally sorted
+   long  Info_ThisRank[3] = { NPG, ( NPG > 0 ) ? LBIdx0[0] : -1L, ( NPG > 0 ) ? LBIdx0[NPG-1] : -1L };
+   long (*Info_AllRank)[3] = new long [MPI_NRank][3];
+
+   MPI_Allgather( Info_ThisRank, 3, MPI_LONG, Info_AllRank, 3, MPI_LONG, MPI_COMM_WORLD );
+
+   bool Sorted    = true;
+   long NPG_Total = 0, LBIdx0_Min = __LONG_MAX__, LBIdx0_Max = -1L, LBIdx0_Prev = -1L;
+
+   for (int r=0; r<MPI_NRank; r++)
    {
-      delete [] IdxTable;
+      if ( Info_AllRank[r][0] == 0 )   continue;
 
-      if ( !InputLBIdx0AndLoad )
+      if ( Info_AllRank[r][1] <= LBIdx0_Prev )  Sorted = false;
+
+      NPG_Total  += Info_AllRank[r][0];
+      LBIdx0_Min  = MIN( LBIdx0_Min, Info_AllRank[r][1] );
+      LBIdx0_Max  = MAX( LBIdx0_Max, Info_AllRank[r][2] );
+      LBIdx0_Prev = Info_AllRank[r][2];
+   }
+
+   delete [] Info_AllRank;
+
+   if ( Sorted )  return;
+
+
+// 3. determine the splitters by bisection
+// --> rank r will receive the patch groups with Splitter[r] <= LBIdx0 < Splitter[r+1]
+// --> Splitter[r] is the smallest LBIdx with "NPG_Total*r/MPI_NRank" patch groups below it
+   long *Splitter = new long [MPI_NRank+1];
+   long *Lo       = new long [MPI_NRank];
+   long *Hi       = new long [MPI_NRank];
+   long *NBelow   = new long [MPI_NRank];
+   bool  Converged;
+
+   for (int r=1; r<MPI_NRank; r++)
+   {
+      Lo[r] = LBIdx0_Min;
+      Hi[r] = LBIdx0_Max + 1;
+   }
+
+   do
+   {
+      for (int r=1; r<MPI_NRank; r++)  NBelow[r] = LowerBound( NPG, LBIdx0, Lo[r]+(Hi[r]-Lo[r])/2 );
+
+      MPI_Allreduce( MPI_IN_PLACE, NBelow+1, MPI_NRank-1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD );
+
+      Converged = true;
+
+      for (int r=1; r<MPI_NRank; r++)
       {
-         delete [] LBIdx0_AllRank;
-         delete [] Load_AllRank;
+         if ( Lo[r] >= Hi[r] )   continue;
+
+         const long Mid = Lo[r] + (Hi[r]-Lo[r])/2;
+
+         if ( NBelow[r] >= NPG_Total*r/MPI_NRank )  Hi[r] = Mid;
+         else                                       Lo[r] = Mid + 1;
+
+         if ( Lo[r] < Hi[r] )    Converged = false;
       }
+   } while ( !Converged );
+
+   Splitter[        0] = LBIdx0_Min;
+   Splitter[MPI_NRank] = LBIdx0_Max + 1;
+   for (int r=1; r<MPI_NRank; r++)  Splitter[r] = Lo[r];
+
+
+// 4. exchange patch groups
+   int *Send_NCount = new int [MPI_NRank];
+   int *Recv_NCount = new int [MPI_NRank];
+   int *Send_NDisp  = new int [MPI_NRank];
+   int *Recv_NDisp  = new int [MPI_NRank];
+
+   for (int r=0; r<MPI_NRank; r++)
+   {
+      Send_NDisp [r] = LowerBound( NPG, LBIdx0, Splitter[r] );
+      Send_NCount[r] = LowerBound( NPG, LBIdx0, Splitter[r+1] ) - Send_NDisp[r];
    }
 
+   MPI_Alltoall( Send_NCount, 1, MPI_INT, Recv_NCount, 1, MPI_INT, MPI_COMM_WORLD );
 
-   if ( OPT__VERBOSE  &&  MPI_Rank == 0 )
-      Aux_Message( stdout, "      %s at Lv %2d ... done\n", __FUNCTION__, lv );
+   Recv_NDisp[0] = 0;
+   for (int r=1; r<MPI_NRank; r++)  Recv_NDisp[r] = Recv_NDisp[r-1] + Recv_NCount[r-1];
 
-} // FUNCTION : LB_SetCutPoint
+   const int NPG_New = Recv_NDisp[MPI_NRank-1] + Recv_NCount[MPI_NRank-1];
+
+   long   *LBIdx0_New = new long   [NPG_New];
+   double *Load_New   = new double [NPG_New];
+
+   MPI_Alltoallv( LBIdx0, Send_NCount, Send_NDisp, MPI_LONG,   LBIdx0_New, Recv_NCount, Recv_NDisp, MPI_LONG,
+                  MPI_COMM_WORLD );
+   MPI_Alltoallv( Load,   Send_NCount, Send_NDisp, MPI_DOUBLE, Load_New,   Recv_NCount, Recv_NDisp, MPI_DOUBLE,
+                  MPI_COMM_WORLD );
+
+   delete [] LBIdx0;
+   delete [] Load;
+   NPG    = NPG_New;
+   LBIdx0 = LBIdx0_New;
+   Load   = Load_New;
+
+
+// 5. sort the received patch groups, which consist of sorted segments from all ranks
+   IdxTable    = new int    [NPG];
+   Load_Sorted = new double [NPG];
+
+   Mis_RadixSort( NPG, LBIdx0, IdxTable );
+
+   for (int t=0; t<NPG; t++)  Load_Sorted[t] = Load[ IdxTable[t] ];
+
+   delete [] Load;
+   Load = Load_Sorted;
+
+
+// free memory
+   delete [] IdxTable;
+   delete [] Splitter;
+   delete [] Lo;
+   delete [] Hi;
+   delete [] NBelow;
+   delete [] Send_NCount;
+   delete [] Recv_NCount;
+   delete [] Send_NDisp;
+   delete [] Recv_NDisp;
+
+} // FUNCTION : SortLBIdx0_Distributed
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LowerBound
+// Description :  Return the number of elements smaller than the target key in a sorted array
+//
+// Parameter   :  N     : Number of elements
+//                Array : Sorted array
+//                Key   : Target key
+//-------------------------------------------------------------------------------------------------------
+int LowerBound( const int N, const long Array[], const long Key )
+{
+
+   int Lo = 0, Hi = N;
+
+   while ( Lo < Hi )
+   {
+      const int Mid = Lo + (Hi-Lo)/2;
+
+      if ( Array[Mid] < Key )    Lo = Mid + 1;
+      else                       Hi = Mid;
+   }
+
+   return Lo;
+
+} // FUNCTION : LowerBound
 
 
 
@@ -0,0 +1,199 @@
+#include "GAMER.h"
+
+#ifdef LOAD_BALANCE
+
+
+
+// fall back to LB_SetCutPoint() if the load imbalance at the target level exceeds this threshold
+// --> diffusion only transfers workload between adjacent ranks and would take many steps to converge
+//     if most of the workload is concentrated on a few ranks (e.g., when a new level is created)
+#define LB_DIFFUSE_MAX_IMBALANCE    1.0
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LB_ShiftCutPoint
+// Description :  Improve the load balance by shifting the current cut points between adjacent ranks
+//                along the space-filling curve
+//
+// Note        :  1. Diffusive load balancing: the cut point between rank r and r+1 is shifted so that roughly
+//                   half of the workload difference of these two ranks is transferred from the heavier rank
+//                   to the lighter one
+//                   --> Only the patch groups adjacent to the cut points are reassigned
+//                   --> Each rank only needs the workload of its two neighboring ranks
+//                2. Real patches must be distributed according to the input cut points
+//                   (i.e., "CutPoint[MPI_Rank] <= LB_Idx < CutPoint[MPI_Rank+1]")
+//                   --> This is always the case during the evolution
+//                3. Invoke LB_SetCutPoint() instead if the load imbalance at lv exceeds LB_DIFFUSE_MAX_IMBALANCE
+//                4. Invoked by LB_Init_LoadBalance() when "Diffuse == true"
+//
+// Parameter   :  lv        : Target refinement level
+//                CutPoint  : Cut point array to be updated
+//                ParWeight : Relative load-balance weighting of particles
+//                            --> Weighting of each patch is estimated as "PATCH_SIZE^3 + NParThisPatch*ParWeight"
+//                            --> <= 0.0 : do not consider particle weighting
+//
+// Return      :  1. CutPoint[]
+//                2. true/false --> at least one/no cut point has been changed (identical on all ranks)
+//-------------------------------------------------------------------------------------------------------
+bool LB_ShiftCutPoint( const int lv, long *CutPoint, const double ParWeight )
+{
+
+   if ( OPT__VERBOSE  &&  MPI_Rank == 0 )
+      Aux_Message( stdout, "      %s at Lv %2d ...\n", __FUNCTION__, lv );
+
+
+// 1. collect the load-balance weighting and LB_Idx of all patch groups in this rank
+   const int NPG = amr->NPatchComma[lv][1] / 8;
+
+   long   *LBIdx0   = new long   [NPG];
+   double *Load_PG  = new double [NPG];
+   double *Load     = new double [NPG];
+   int    *IdxTable = new int    [NPG];
+
+   for (int t=0; t<NPG; t++)
+   {
+      LBIdx0[t]  = amr->patch[0][lv][t*8]->LB_Idx;
+      LBIdx0[t] -= LBIdx0[t] % 8;   // get the **minimum** LBIdx in this patch group
+   }
+
+   LB_EstimateWorkload_AllPatchGroup( lv, ParWeight, Load_PG );
+
+// sort patch groups by LBIdx
+   Mis_RadixSort( NPG, LBIdx0, IdxTable );
+
+   for (int t=0; t<NPG; t++)  Load[t] = Load_PG[ IdxTable[t] ];
+
+   delete [] Load_PG;
+   delete [] IdxTable;
+
+
+// 2. check the overall load imbalance at lv
+   double Load_ThisRank = 0.0, Load_Sum, Load_Max, Load_Ave;
+
+   for (int t=0; t<NPG; t++)  Load_ThisRank += Load[t];
+
+   MPI_Allreduce( &Load_ThisRank, &Load_Sum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+   MPI_Allreduce( &Load_ThisRank, &Load_Max, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+
+   Load_Ave = Load_Sum / (double)MPI_NRank;
+
+// 2-1. nothing to do if there are no patches at all
+   if ( Load_Sum == 0.0 )
+   {
+      delete [] LBIdx0;
+      delete [] Load;
+
+      return false;
+   }
+
+// 2-2. recompute all cut points if the load imbalance is too large
+   if ( (Load_Max-Load_Ave)/Load_Ave > LB_DIFFUSE_MAX_IMBALANCE )
+   {
+      delete [] LBIdx0;
+      delete [] Load;
+
+      const bool InputLBIdx0AndLoad_No = false;
+
+      LB_SetCutPoint( lv, NULL_INT, CutPoint, InputLBIdx0AndLoad_No, NULL, NULL, ParWeight );
+
+      return true;
+   }
+
+
+// 3. get the workload of the neighboring ranks
+   const int Rank_L = ( MPI_Rank > 0           ) ? MPI_Rank-1 : MPI_PROC_NULL;
+   const int Rank_R = ( MPI_Rank < MPI_NRank-1 ) ? MPI_Rank+1 : MPI_PROC_NULL;
+
+   double Load_L = Load_ThisRank, Load_R = Load_ThisRank;
+
+   MPI_Sendrecv( &Load_ThisRank, 1, MPI_DOUBLE, Rank_R, 0, &Load_L, 1, MPI_DOUBLE, Rank_L, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+   MPI_Sendrecv( &Load_ThisRank, 1, MPI_DOUBLE, Rank_L, 1, &Load_R, 1, MPI_DOUBLE, Rank_R, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+
+
+// 4. shift the cut points adjacent to this rank if this rank is heavier than its neighbors
+// --> only the heavier rank of each pair sets the shared cut point, and all unset cut points are -1
+// --> transfer the patch groups one by one as long as the transferred workload gets closer to the target flow
+   long  *CutPoint_New = new long [MPI_NRank+1];
+   int    NSend_L = 0, NSend_R = 0;
+   double Flow, Load_Send;
+
+   for (int t=0; t<MPI_NRank+1; t++)   CutPoint_New[t] = -1;
+
+// 4-1. lower cut point: send the leading patch groups to the left rank
+   if ( Rank_L != MPI_PROC_NULL  &&  Load_ThisRank > Load_L )
+   {
+      Flow      = 0.5*( Load_ThisRank - Load_L );
+      Load_Send = 0.0;
+
+      while ( NSend_L < NPG  &&  fabs(Load_Send+Load[NSend_L]-Flow) < fabs(Load_Send-Flow) )
+         Load_Send += Load[ NSend_L ++ ];
+
+      if ( NSend_L > 0 )   CutPoint_New[MPI_Rank] = ( NSend_L < NPG ) ? LBIdx0[NSend_L] : CutPoint[MPI_Rank+1];
+   }
+
+// 4-2. upper cut point: send the trailing patch groups to the right rank
+// --> never send the patch groups already sent to the left rank
+   if ( Rank_R != MPI_PROC_NULL  &&  Load_ThisRank > Load_R )
+   {
+      Flow      = 0.5*( Load_ThisRank - Load_R );
+      Load_Send = 0.0;
+
+      while ( NSend_L+NSend_R < NPG  &&  fabs(Load_Send+Load[NPG-1-NSend_R]-Flow) < fabs(Load_Send-Flow) )
+         Load_Send += Load[ NPG-1-(NSend_R++) ];
+
+      if ( NSend_R > 0 )   CutPoint_New[MPI_Rank+1] = LBIdx0[ NPG-NSend_R ];
+   }
+
+
+// 5. collect the cut points shifted by all ranks
+   bool Shifted = false;
+
+   MPI_Allreduce( MPI_IN_PLACE, CutPoint_New, MPI_NRank+1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD );
+
+   for (int t=1; t<MPI_NRank; t++)
+   {
+      if ( CutPoint_New[t] != -1  &&  CutPoint_New[t] != CutPoint[t] )
+      {
+         CutPoint[t] = CutPoint_New[t];
+         Shifted     = true;
+      }
+   }
+
+#  ifdef GAMER_DEBUG
+   for (int t=0; t<MPI_NRank; t++)
+      if ( CutPoint[t+1] < CutPoint[t] )
+         Aux_Error( ERROR_INFO, "lv %d, CutPoint[%d] (%ld) < CutPoint[%d] (%ld) !!\n",
+                    lv, t+1, CutPoint[t+1], t, CutPoint[t] );
+#  endif
+
+
+// 6. output the cut points
+   if ( OPT__VERBOSE  &&  MPI_Rank == 0 )
+   {
+      for (int r=0; r<MPI_NRank; r++)
+         Aux_Message( stdout, "         Lv %2d: Rank %4d, Cut %15ld -> %15ld\n", lv, r, CutPoint[r], CutPoint[r+1] );
+
+      Aux_Message( stdout, "         Load_Ave %9.3e, Load_Max %9.3e --> Load_Imbalance (before shifting) = %6.2f%%\n",
+                   Load_Ave, Load_Max, 100.0*(Load_Max-Load_Ave)/Load_Ave );
+      Aux_Message( stdout, "         =============================================================================\n" );
+   }
+
+
+// free memory
+   delete [] LBIdx0;
+   delete [] Load;
+   delete [] CutPoint_New;
+
+
+   if ( OPT__VERBOSE  &&  MPI_Rank == 0 )
+      Aux_Message( stdout, "      %s at Lv %2d ... done\n", __FUNCTION__, lv );
+
+   return Shifted;
+
+} // FUNCTION : LB_ShiftCutPoint
+
+
+
+#endif // #ifdef LOAD_BALANCE
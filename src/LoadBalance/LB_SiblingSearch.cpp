@@ -17,7 +17,7 @@ static void SetSiblingExternal_CheckPeriodicity( int *Sibling, const int Boundar
 // Function    :  LB_SiblingSearch
 // Description :  Construct the sibling patch relation
 //
-// Note        :  1. LB_PaddedCr1DList[] and LB_PaddedCr1DList_IdxTable[] at SonLv and FaLv must be properly prepared
+// Note        :  1. The PaddedCr1D hash table (see LB_PaddedCr1DHash_Build()) at lv must be properly prepared
 //                2. SearchAllPID == true  --> Works on all patches at lv (including real, sibling-buffer
 //                                             and father-buffer patches)
 //                                == false --> Only works on PID0 recorded in TargetPID0
@@ -43,7 +43,6 @@ void LB_SiblingSearch( const int lv, const bool SearchAllPID, const int NInput,
    const bool BothSide            = ( SearchAllPID ) ? false : true;             // construct relations in both side
    const int  NTarget0            = ( SearchAllPID ) ? NPatch/8 : NInput;
    const int  NSib                = 26;
-   const int  NSearch_Max         = NSib*NTarget0;
    const int  Padded              = 1<<NLEVEL;
    const int  BoxNScale_Padded[3] = { amr->BoxScale[0]/PATCH_SIZE + 2*Padded,
                                       amr->BoxScale[1]/PATCH_SIZE + 2*Padded,
@@ -53,23 +52,12 @@ void LB_SiblingSearch( const int lv, const bool SearchAllPID, const int NInput,
                                       (long)Scale2*BoxNScale_Padded[0],
                                       (long)Scale2*BoxNScale_Padded[0]*BoxNScale_Padded[1] };
 
-   int   NSearch, Count, *Match, PID0;
+   int   Count;
    long  Cr1D_Disp[26];
 
-   ulong *SibCr1D_Search   = new ulong [ NSearch_Max ];
-   ulong *SibCr1D          = new ulong [ NSearch_Max ];
-   int   *SibCr1D_IdxTable = new  int  [ NSearch_Max ];
-
 
 // nothing to do if there is no target patches
-   if ( NTarget0 == 0 )
-   {
-      delete [] SibCr1D_Search;
-      delete [] SibCr1D;
-      delete [] SibCr1D_IdxTable;
-
-      return;
-   }
+   if ( NTarget0 == 0 )    return;
 
 
 // 0. initialize all siblings as -1 and construct the target patch list with LocalID==0 (for SearchAllPID)
@@ -94,12 +82,13 @@ void LB_SiblingSearch( const int lv, const bool SearchAllPID, const int NInput,
       if ( i != 0  ||  j != 0  ||  k != 0 )  Cr1D_Disp[ Count++ ] = (long)i*dr[0] + (long)j*dr[1] + (long)k*dr[2];
 
 
-// 2. construct the sorted sibling list (with duplicates)
-   Count = 0;
+// 2. find the sibling patch groups (i.e., the patches with LocalID==0) of all target patches
+   int (*SibPID0_List)[NSib] = new int [NTarget0][NSib];
 
+#  pragma omp parallel for schedule( runtime )
    for (int t=0; t<NTarget0; t++)
    {
-      PID0 = TargetPID0[t];
+      const int PID0 = TargetPID0[t];
 
 #     ifdef GAMER_DEBUG
       if ( PID0%8 != 0 )
@@ -113,98 +102,59 @@ void LB_SiblingSearch( const int lv, const bool SearchAllPID, const int NInput,
 //                                      = PaddedCr1D + Disp
 //             (because PaddedCr1D + Disp >= 0; ==> reduced modulo again)
       for (int s=0; s<NSib; s++)
-         SibCr1D[ Count++ ] = amr->patch[0][lv][PID0]->PaddedCr1D + (ulong)Cr1D_Disp[s];
+         SibPID0_List[t][s] = LB_PaddedCr1DHash_Find( lv, amr->patch[0][lv][PID0]->PaddedCr1D + (ulong)Cr1D_Disp[s] );
    }
 
-   Mis_Heapsort( NSearch_Max, SibCr1D, SibCr1D_IdxTable );
-
-
-// 3. prepare the searching list and remove the duplicates
-   memcpy( SibCr1D_Search, SibCr1D, NSearch_Max*sizeof(ulong) );
-
-   NSearch = ( NTarget0 > 0 ) ? 1 : 0;
-
-   for (int t=1; t<NSearch_Max; t++)
-      if ( SibCr1D_Search[t] != SibCr1D_Search[t-1] )   SibCr1D_Search[ NSearch ++ ] = SibCr1D_Search[t];
-
-
-// 4. matching
-   Match = new int [NSearch];
-   Mis_Matching_int( NPatch, amr->LB->PaddedCr1DList[lv], NSearch, SibCr1D_Search, Match );
-
 
-// 5. construct the sibling relation
+// 3. construct the sibling relation
    const int PGScale = PATCH_SIZE*Scale2;
    const int SibID[3][3][3] = {  { {18, 10, 19}, {14,  4, 16}, {20, 11, 21} },
                                  { { 6,  2,  7}, { 0, -1,  1}, { 8,  3,  9} },
                                  { {22, 12, 23}, {15,  5, 17}, {24, 13, 25} }  };
-   ulong Cr1D;
-   int   SibPID0, dID[3], Start = 0;
-   int  *Cr1, *Cr2;
 
-// 5.1 construct the sibling relation for patches within the same patch group
+// 3.1 construct the sibling relation for patches within the same patch group
    for (int t=0; t<NTarget0; t++)   SetSiblingInSamePatchGroup( lv, TargetPID0[t] );
 
 
-// 5.2 construct the sibling relation for patches in different patch groups
-   for (int t=0; t<NSearch; t++)
+// 3.2 construct the sibling relation for patches in different patch groups
+//     --> different target patches only modify their own sibling indices when BothSide == false
+//         and thus can be processed in parallel
+#  pragma omp parallel for schedule( runtime ) if ( !BothSide )
+   for (int t=0; t<NTarget0; t++)
    {
-      if ( Match[t] != -1 )
+      const int  PID0 = TargetPID0[t];
+      const int *Cr1  = amr->patch[0][lv][PID0]->corner;
+
+      for (int s=0; s<NSib; s++)
       {
-         Cr1D    = amr->LB->PaddedCr1DList         [lv][ Match[t] ];
-         SibPID0 = amr->LB->PaddedCr1DList_IdxTable[lv][ Match[t] ];
-         Cr2     = amr->patch[0][lv][SibPID0]->corner;
+         const int SibPID0 = SibPID0_List[t][s];
 
-         for (int m=Start; m<NSearch_Max; m++)
-         {
-            if ( SibCr1D[m] == Cr1D )
-            {
-               do
-               {
-                  PID0 = TargetPID0[ SibCr1D_IdxTable[m] / NSib ];
-                  Cr1  = amr->patch[0][lv][PID0]->corner;
-
-                  for (int d=0; d<3; d++)    dID[d] = 1 + ( Cr2[d] - Cr1[d] ) / PGScale;
-
-//                for NLEVEL == 1, buffer patch groups can have sibling PaddedCr1D map to wrong buffer
-//                patch groups in the opposite direction (check the note for a more detailed explanation)
-#                 if ( NLEVEL == 1 )
-                  if (  dID[0]<0 || dID[0]>2 || dID[1]<0 || dID[1]>2  )
-                  {
-                     m++;
-                     continue;
-                  }
-#                 endif
-
-#                 ifdef GAMER_DEBUG
-                  if (  ( NLEVEL != 1 && (dID[0]<0 || dID[0]>2 || dID[1]<0 || dID[1]>2) )
-                        || dID[2]<0 || dID[2]>2 || ( dID[0]==1 && dID[1]==1 && dID[2]==1 )  )
-                     Aux_Error( ERROR_INFO, "lv %d, PID0 %d, SibPID0 %d, incorrect dID[3]=(%d,%d,%d) !!\n",
-                                lv, PID0, SibPID0, dID[0], dID[1], dID[2] );
-#                 endif
-
-                  SetSiblingInDiffPatchGroup( lv, PID0, SibPID0, SibID[ dID[2] ][ dID[1] ][ dID[0] ], BothSide );
-
-                  m++;
-               }
-               while( m < NSearch_Max  &&  SibCr1D[m] == Cr1D );
-
-               Start = m;
-               break;
-            } // if ( SibCr1D[m] == Cr1D )
-
-#           ifdef GAMER_DEBUG
-            if ( m == NSearch_Max - 1 )
-               Aux_Error( ERROR_INFO, "lv %d, SibPID0 %d, Cr1D %lu has no matching patch !!\n",
-                          lv, SibPID0, Cr1D );
-#           endif
-
-         } // for (int m=Start; m<NSearch_Max; m++)
-      } // if ( Match[t] != -1 )
-   } // for (int t=0; t<NSearch; t++)
-
-
-// 5.3 set the sibling indices for the patches adjacent to the simulation domain (for non-periodic B.C. only)
+         if ( SibPID0 == -1 )    continue;
+
+         const int *Cr2 = amr->patch[0][lv][SibPID0]->corner;
+         int dID[3];
+
+         for (int d=0; d<3; d++)    dID[d] = 1 + ( Cr2[d] - Cr1[d] ) / PGScale;
+
+//       for NLEVEL == 1, buffer patch groups can have sibling PaddedCr1D map to wrong buffer
+//       patch groups in the opposite direction (check the note for a more detailed explanation)
+#        if ( NLEVEL == 1 )
+         if (  dID[0]<0 || dID[0]>2 || dID[1]<0 || dID[1]>2  )   continue;
+#        endif
+
+#        ifdef GAMER_DEBUG
+         if (  ( NLEVEL != 1 && (dID[0]<0 || dID[0]>2 || dID[1]<0 || dID[1]>2) )
+               || dID[2]<0 || dID[2]>2 || ( dID[0]==1 && dID[1]==1 && dID[2]==1 )  )
+            Aux_Error( ERROR_INFO, "lv %d, PID0 %d, SibPID0 %d, incorrect dID[3]=(%d,%d,%d) !!\n",
+                       lv, PID0, SibPID0, dID[0], dID[1], dID[2] );
+#        endif
+
+         SetSiblingInDiffPatchGroup( lv, PID0, SibPID0, SibID[ dID[2] ][ dID[1] ][ dID[0] ], BothSide );
+      } // for (int s=0; s<NSib; s++)
+   } // for (int t=0; t<NTarget0; t++)
+
+
+// 3.3 set the sibling indices for the patches adjacent to the simulation domain (for non-periodic B.C. only)
    if ( OPT__BC_FLU[0] != BC_FLU_PERIODIC  ||
         OPT__BC_FLU[2] != BC_FLU_PERIODIC  ||
         OPT__BC_FLU[4] != BC_FLU_PERIODIC   )   SetSiblingExternal( lv, NTarget0, TargetPID0 );
@@ -243,10 +193,7 @@ void LB_SiblingSearch( const int lv, const bool SearchAllPID, const int NInput,
 
 
 // free memory
-   delete [] SibCr1D_Search;
-   delete [] SibCr1D;
-   delete [] SibCr1D_IdxTable;
-   delete [] Match;
+   delete [] SibPID0_List;
    if ( SearchAllPID )  delete [] TargetPID0;
 
 } // FUNCTION : LB_SiblingSearch
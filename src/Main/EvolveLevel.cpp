@@ -15,6 +15,7 @@ extern Timer_t *Timer_GetBuf     [NLEVEL][9];
 extern Timer_t *Timer_Par_Update [NLEVEL][3];
 extern Timer_t *Timer_Par_2Sib   [NLEVEL];
 extern Timer_t *Timer_Par_2Son   [NLEVEL];
+extern Timer_t *Timer_OverlapMPI [NLEVEL][3];
 #endif
 
 bool AutoReduceDt_Continue;
@@ -47,6 +48,16 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
 #  ifdef GRAVITY
    const bool UsePot            = ( OPT__SELF_GRAVITY  ||  OPT__EXT_POT );
 #  endif
+
+// overlap MPI communication with computation
+// --> fluid   solver : exchange the updated fluid data (or density for the Poisson solver at lv>0)
+//     gravity solver : exchange the updated potential and fluid data (lv>0 only)
+#  ifdef GRAVITY
+   const bool OverlapMPI_Flu    = ( OPT__OVERLAP_MPI  &&  lv > 0  &&  OPT__SELF_GRAVITY );
+   const bool OverlapMPI_Gra    = ( OPT__OVERLAP_MPI  &&  lv > 0  &&  !OPT__POI_LEVEL_MG );
+#  else
+   const bool OverlapMPI_Flu    = OPT__OVERLAP_MPI;
+#  endif
 #  ifdef PARTICLE
    const bool StoreAcc_Yes      = true;
    const bool StoreAcc_No       = false;
@@ -149,105 +160,137 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
       if ( OPT__VERBOSE  &&  MPI_Rank == 0 )
          Aux_Message( stdout, "   Lv %2d: Flu_AdvanceDt, counter = %8ld ... ", lv, AdvanceCounter[lv] );
 
-      if ( false ) {}
-      /*
-      if ( OPT__OVERLAP_MPI )
+//    whether the fluid data in the buffer patches have been updated by the overlapped MPI communication
+      bool FluBuf_Updated = false;
+      int  FluStatus_AllRank;
+
+      if ( OverlapMPI_Flu )
       {
+//       advance patches needed to be sent
+         TIMING_FUNC(   Flu_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Flu, SaveSg_Mag, true, true ),
+                        Timer_Flu_Advance[lv],   TIMER_ON   );
+
 //       enable OpenMP nested parallelism
 #        ifdef OPENMP
          omp_set_nested( true );
 #        endif
 
-//       advance patches needed to be sent
-         TIMING_FUNC(   Flu_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Flu, SaveSg_Mag, true, true ),
-                        Timer_Flu_Advance[lv],   TIMER_ON   );
+#        ifdef TIMING
+         Timer_OverlapMPI[lv][0]->Start();
+#        endif
 
 #        pragma omp parallel sections num_threads(2)
          {
 #           pragma omp section
             {
+#              ifdef TIMING
+               Timer_OverlapMPI[lv][1]->Start();
+#              endif
+
 //             transfer data simultaneously
 #              ifdef GRAVITY
-               if ( OPT__SELF_GRAVITY )
                TIMING_FUNC(   Buf_GetBufferData( lv, SaveSg_Flu, NULL_INT,   NULL_INT, DATA_GENERAL, _DENS,  _NONE, Rho_ParaBuf, USELB_YES ),
                               Timer_GetBuf[lv][0],   TIMER_ON   );
 #              else
                TIMING_FUNC(   Buf_GetBufferData( lv, SaveSg_Flu, SaveSg_Mag, NULL_INT, DATA_GENERAL, _TOTAL, _MAG,  Flu_ParaBuf, USELB_YES ),
                               Timer_GetBuf[lv][2],   TIMER_ON   );
+
+               FluBuf_Updated = true;
+#              endif
+
+#              ifdef TIMING
+               Timer_OverlapMPI[lv][1]->Stop();
 #              endif
             }
 
 #           pragma omp section
             {
+#              ifdef TIMING
+               Timer_OverlapMPI[lv][2]->Start();
+#              endif
+
+//             leave one thread for MPI communication
+#              ifdef OPENMP
+               omp_set_num_threads( MAX( OMP_NTHREAD-1, 1 ) );
+#              endif
+
 //             advance patches not needed to be sent
                TIMING_FUNC(   Flu_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Flu, SaveSg_Mag, true, false ),
                               Timer_Flu_Advance[lv],   TIMER_ON   );
+
+#              ifdef TIMING
+               Timer_OverlapMPI[lv][2]->Stop();
+#              endif
             }
          } // OpenMP parallel sections
 
+#        ifdef TIMING
+         Timer_OverlapMPI[lv][0]->Stop();
+#        endif
+
 //       disable OpenMP nested parallelism
 #        ifdef OPENMP
          omp_set_nested( false );
 #        endif
-      } // if ( OPT__OVERLAP_MPI )
-      */
+
+//       collect the fluid solver status from all ranks
+         TIMING_FUNC(   FluStatus_AllRank = Flu_AdvanceDt_Finalize( lv ),
+                        Timer_Flu_Advance[lv],   TIMER_ON   );
+      } // if ( OverlapMPI_Flu )
 
       else
       {
-         int FluStatus_AllRank;
-
          TIMING_FUNC(   FluStatus_AllRank = Flu_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Flu, SaveSg_Mag, false, false ),
                         Timer_Flu_Advance[lv],   TIMER_ON   );
+      } // if ( OverlapMPI_Flu ) ... else ...
+
+//    do nothing if AUTO_REDUCE_DT is disabled
+      if ( AUTO_REDUCE_DT )
+      {
+         if ( FluStatus_AllRank == GAMER_SUCCESS )
+         {
+//          restore the original parameters
+            AutoReduceDtCoeff     = 1.0;
+            AutoReduceDt_Continue = true;
+         }
 
-//       do nothing if AUTO_REDUCE_DT is disabled
-         if ( AUTO_REDUCE_DT )
+         else
          {
-            if ( FluStatus_AllRank == GAMER_SUCCESS )
+//          reduce the time-step coefficient if allowed
+            if ( AutoReduceDtCoeff >= AUTO_REDUCE_DT_FACTOR_MIN )
             {
-//             restore the original parameters
-               AutoReduceDtCoeff     = 1.0;
+               AutoReduceDtCoeff    *= AUTO_REDUCE_DT_FACTOR;
                AutoReduceDt_Continue = true;
-            }
 
-            else
-            {
-//             reduce the time-step coefficient if allowed
-               if ( AutoReduceDtCoeff >= AUTO_REDUCE_DT_FACTOR_MIN )
+               if ( MPI_Rank == 0 )
                {
-                  AutoReduceDtCoeff    *= AUTO_REDUCE_DT_FACTOR;
-                  AutoReduceDt_Continue = true;
-
-                  if ( MPI_Rank == 0 )
-                  {
-                     Aux_Message( stderr, "WARNING : fluid solver failed (Lv %2d, counter %8ld) --> ", lv, AdvanceCounter[lv] );
-                     Aux_Message( stderr, "reduce dt by %13.7e\n", AutoReduceDtCoeff );
-                  }
+                  Aux_Message( stderr, "WARNING : fluid solver failed (Lv %2d, counter %8ld) --> ", lv, AdvanceCounter[lv] );
+                  Aux_Message( stderr, "reduce dt by %13.7e\n", AutoReduceDtCoeff );
                }
+            }
 
-//             if the time-step coefficient becomes smaller than the given threshold, restore the original time-step
-//             and apply floor values in Flu_Close()
-               else
-               {
-                  const double AutoReduceDtCoeff_Failed = AutoReduceDtCoeff;
-
-                  AutoReduceDtCoeff     = 1.0;     // restore the original dt
-                  AutoReduceDt_Continue = false;   // trigger density/energy floors in Flu_Close()
+//          if the time-step coefficient becomes smaller than the given threshold, restore the original time-step
+//          and apply floor values in Flu_Close()
+            else
+            {
+               const double AutoReduceDtCoeff_Failed = AutoReduceDtCoeff;
 
-                  if ( MPI_Rank == 0 )
-                  {
-                     Aux_Message( stderr, "WARNING : AUTO_REDUCE_DT failed (Lv %2d, counter %8ld, dt-coeff=%13.7e < min=%13.7e) !!\n",
-                                  lv, AdvanceCounter[lv], AutoReduceDtCoeff_Failed, AUTO_REDUCE_DT_FACTOR_MIN );
-                     Aux_Message( stderr, "          --> Apply floor values with the original dt as the last resort ...\n" );
-                  }
-               } // if ( AutoReduceDtCoeff >= AUTO_REDUCE_DT_FACTOR_MIN ) ... else ...
+               AutoReduceDtCoeff     = 1.0;     // restore the original dt
+               AutoReduceDt_Continue = false;   // trigger density/energy floors in Flu_Close()
 
-//             restart the sub-step while loop
-               continue;
+               if ( MPI_Rank == 0 )
+               {
+                  Aux_Message( stderr, "WARNING : AUTO_REDUCE_DT failed (Lv %2d, counter %8ld, dt-coeff=%13.7e < min=%13.7e) !!\n",
+                               lv, AdvanceCounter[lv], AutoReduceDtCoeff_Failed, AUTO_REDUCE_DT_FACTOR_MIN );
+                  Aux_Message( stderr, "          --> Apply floor values with the original dt as the last resort ...\n" );
+               }
+            } // if ( AutoReduceDtCoeff >= AUTO_REDUCE_DT_FACTOR_MIN ) ... else ...
 
-            } // if ( FluStatus_AllRank == GAMER_SUCCESS ) ... else ...
-         } // if ( AUTO_REDUCE_DT )
+//          restart the sub-step while loop
+            continue;
 
-      } // if ( OPT__OVERLAP_MPI ) ... else ...
+         } // if ( FluStatus_AllRank == GAMER_SUCCESS ) ... else ...
+      } // if ( AUTO_REDUCE_DT )
 
       amr->FluSg    [lv]             = SaveSg_Flu;
       amr->FluSgTime[lv][SaveSg_Flu] = TimeNew;
@@ -303,26 +346,32 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
 
       else // lv > 0
       {
-         if ( false ) {}
-         /*
-         if ( OPT__OVERLAP_MPI )
+         if ( OverlapMPI_Gra )
          {
+//          advance patches needed to be sent
+            TIMING_FUNC(   Gra_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Flu, SaveSg_Pot,
+                                          UsePot, true, true, true, true ),
+                           Timer_Gra_Advance[lv],   TIMER_ON   );
+
 //          enable OpenMP nested parallelism
 #           ifdef OPENMP
             omp_set_nested( true );
 #           endif
 
-//          advance patches needed to be sent
-            TIMING_FUNC(   Gra_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Flu, SaveSg_Pot,
-                           UsePot, true, true, true, true ),
-                           Timer_Gra_Advance[lv],   TIMER_ON   );
+#           ifdef TIMING
+            Timer_OverlapMPI[lv][0]->Start();
+#           endif
 
 #           pragma omp parallel sections num_threads(2)
             {
 #              pragma omp section
                {
+#                 ifdef TIMING
+                  Timer_OverlapMPI[lv][1]->Start();
+#                 endif
+
 //                transfer data simultaneously
-                  if ( UsePot )
+                  if ( UsePot  &&  !OPT__MINIMIZE_MPI_BARRIER )
                   TIMING_FUNC(   Buf_GetBufferData( lv, NULL_INT, NULL_INT, SaveSg_Pot, POT_FOR_POISSON,
                                                     _POTE, _NONE, Pot_ParaBuf, USELB_YES ),
                                  Timer_GetBuf[lv][1],   TIMER_ON   );
@@ -330,23 +379,45 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
                   TIMING_FUNC(   Buf_GetBufferData( lv, SaveSg_Flu, SaveSg_Mag, NULL_INT, DATA_GENERAL,
                                                     _TOTAL, _MAG,  Flu_ParaBuf, USELB_YES ),
                                  Timer_GetBuf[lv][2],   TIMER_ON   );
+
+                  FluBuf_Updated = true;
+
+#                 ifdef TIMING
+                  Timer_OverlapMPI[lv][1]->Stop();
+#                 endif
                }
 
 #              pragma omp section
                {
+#                 ifdef TIMING
+                  Timer_OverlapMPI[lv][2]->Start();
+#                 endif
+
+//                leave one thread for MPI communication
+#                 ifdef OPENMP
+                  omp_set_num_threads( MAX( OMP_NTHREAD-1, 1 ) );
+#                 endif
+
 //                advance patches not needed to be sent
                   TIMING_FUNC(   Gra_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Flu, SaveSg_Pot,
                                                 UsePot, true, true, false, true ),
                                  Timer_Gra_Advance[lv],   TIMER_ON   );
+
+#                 ifdef TIMING
+                  Timer_OverlapMPI[lv][2]->Stop();
+#                 endif
                }
             } // OpenMP parallel sections
 
+#           ifdef TIMING
+            Timer_OverlapMPI[lv][0]->Stop();
+#           endif
+
 //          disable OpenMP nested parallelism
 #           ifdef OPENMP
             omp_set_nested( false );
 #           endif
-         } // if ( OPT__OVERLAP_MPI )
-         */
+         } // if ( OverlapMPI_Gra )
 
          else
          {
@@ -364,11 +435,12 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
 //          --> we will do this after all other operations (e.g., star formation) if OPT__MINIMIZE_MPI_BARRIER is adopted
 //              --> assuming that all remaining operations do not need to access the potential in the buffer patches
 //              --> one must enable both STORE_POT_GHOST and PAR_IMPROVE_ACC for this purpose
-            if ( UsePot  &&  !OPT__MINIMIZE_MPI_BARRIER )
+//          --> already done by Gra_AdvanceDt() for OPT__POI_LEVEL_MG
+            if ( UsePot  &&  !OPT__MINIMIZE_MPI_BARRIER  &&  !OPT__POI_LEVEL_MG )
             TIMING_FUNC(   Buf_GetBufferData( lv, NULL_INT, NULL_INT, SaveSg_Pot, POT_FOR_POISSON,
                                               _POTE, _NONE, Pot_ParaBuf, USELB_YES ),
                            Timer_GetBuf[lv][1],   TIMER_ON   );
-         } // if ( OPT__OVERLAP_MPI ) ... else ...
+         } // if ( OverlapMPI_Gra ) ... else ...
 
          if ( UsePot )
          {
@@ -453,6 +525,8 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
          TIMING_FUNC(   Src_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_SrcFlu, SaveSg_SrcMag, false, false ),
                         Timer_Src_Advance[lv],   TIMER_ON   );
 
+         FluBuf_Updated = false;
+
          if ( OPT__VERBOSE  &&  MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
       }
 
@@ -472,6 +546,8 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
          TIMING_FUNC(   Grackle_AdvanceDt( lv, TimeNew, TimeOld, dt_SubStep, SaveSg_Che, false, false ),
                         Timer_Che_Advance[lv],   TIMER_ON   );
 
+         FluBuf_Updated = false;
+
          if ( OPT__VERBOSE  &&  MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
       } // if ( GRACKLE_ACTIVATE )
 #     endif // #ifdef SUPPORT_GRACKLE
@@ -506,6 +582,8 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
          TIMING_FUNC(   SF_CreateStar( lv, TimeNew, dt_SubStep ),
                         Timer_SF[lv],   TIMER_ON   );
 
+         FluBuf_Updated = false;
+
          if ( OPT__VERBOSE  &&  MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
       } // if ( SF_CREATE_STAR_SCHEME != SF_CREATE_STAR_SCHEME_NONE )
 #     endif // #ifdef STAR_FORMATION
@@ -522,6 +600,8 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
          {
             TIMING_FUNC(   Flu_ResetByUser_API_Ptr( lv, SaveSg_Flu, TimeNew, dt_SubStep ),
                            Timer_Flu_Advance[lv],   TIMER_ON   );
+
+            FluBuf_Updated = false;
          }
 
          else
@@ -532,14 +612,21 @@ void EvolveLevel( const int lv, const double dTime_FaLv )
 
 //    8. update MPI buffers
 // ===============================================================================================
+//    fluid data at lv may have been modified in place (e.g., by SF_CreateStar() and OPT__RESET_FLUID)
+//    --> clear the data cached by Prepare_PatchData() even if the buffer data are not exchanged below
+      PrepCache_Invalidate( lv );
+
 //    exchange the updated fluid field in the buffer patches
+//    --> skip it if it has been done by the overlapped MPI communication and no fluid data have been modified since then
+      if ( !FluBuf_Updated )
       TIMING_FUNC(   Buf_GetBufferData( lv, SaveSg_Flu, SaveSg_Mag, NULL_INT, DATA_GENERAL,
                                         _TOTAL, _MAG, Flu_ParaBuf, USELB_YES ),
                      Timer_GetBuf[lv][2],   TIMER_ON   );
 
 //    exchange the updated potential in the buffer patches here if OPT__MINIMIZE_MPI_BARRIER is adopted
+//    --> already done by Gra_AdvanceDt() for OPT__POI_LEVEL_MG
 #     ifdef GRAVITY
-      if ( lv > 0  &&  UsePot  &&  OPT__MINIMIZE_MPI_BARRIER )
+      if ( lv > 0  &&  UsePot  &&  OPT__MINIMIZE_MPI_BARRIER  &&  !OPT__POI_LEVEL_MG )
       TIMING_FUNC(   Buf_GetBufferData( lv, NULL_INT, NULL_INT, SaveSg_Pot, POT_FOR_POISSON,
                                         _POTE, _NONE, Pot_ParaBuf, USELB_YES ),
                      Timer_GetBuf[lv][1],   TIMER_ON   );
@@ -6,6 +6,12 @@ static void Solver( const Solver_t TSolver, const int lv, const double TimeNew,
                     const int NPG, const int ArrayID, const double dt, const double Poi_Coeff );
 static void Closing_Step( const Solver_t TSolver, const int lv, const int SaveSg_Flu, const int SaveSg_Mag, const int SaveSg_Pot,
                           const int NPG, const int *PID0_List, const int ArrayID, const double dt );
+#ifdef OPENMP
+static void Pipeline_CPU( const Solver_t TSolver, const int lv, const double TimeNew, const double TimeOld, const double dt,
+                          const double Poi_Coeff, const int SaveSg_Flu, const int SaveSg_Mag, const int SaveSg_Pot,
+                          const int NPG_Max, const int NTotal, const int *PID0_List );
+#endif
+static void InvalidatePrepCache( const Solver_t TSolver, const int lv );
 
 extern Timer_t *Timer_Pre         [NLEVEL][NSOLVER];
 extern Timer_t *Timer_Sol         [NLEVEL][NSOLVER];
@@ -16,6 +22,22 @@ extern Timer_t *Timer_Poi_PreFlu  [NLEVEL];
 extern Timer_t *Timer_Poi_PrePot_C[NLEVEL];
 extern Timer_t *Timer_Poi_PrePot_F[NLEVEL];
 #endif
+#ifdef TIMING
+extern Timer_t *Timer_Pipeline    [NLEVEL][3];
+#endif
+
+
+// measure the wall-clock time spent on "call" and add it to "cost" for OPT__LB_MEASURE_COST
+#ifdef LOAD_BALANCE
+#  define MEASURE_COST( call, cost )                                        \
+   {                                                                        \
+      const double Time0 = ( OPT__LB_MEASURE_COST ) ? MPI_Wtime() : 0.0;   \
+      call;                                                                 \
+      if ( OPT__LB_MEASURE_COST )   cost += MPI_Wtime() - Time0;            \
+   }
+#else
+#  define MEASURE_COST( call, cost )   call
+#endif
 
 
 
@@ -33,6 +55,16 @@ extern Timer_t *Timer_Poi_PrePot_F[NLEVEL];
 //                   the input data
 //                4. For LOAD_BALANCE, one can turn on the option "OPT__OVERLAP_MPI" to enable the
 //                   overlapping between MPI communication and CPU/GPU computation
+//                5. For OPT__LB_MEASURE_COST, the wall-clock time spent on each batch of patch groups is recorded
+//                   by LB_AddMeasuredCost() for estimating the load-balance weighting
+//                   --> Time spent on a batch is shared equally by all patch groups in that batch
+//                   --> For GPU, it only measures the time spent on the host side
+//                6. For CPU-only runs with OpenMP, one can turn on the option "OPT__CPU_PIPELINE" to overlap the
+//                   preparation and closing steps with the solvers
+//                   --> See Pipeline_CPU() for details
+//                   --> Not applied to the Grackle solver since the Grackle library manages its own threads
+//                7. For OPT__PREP_CACHE, the data cached by Prepare_PatchData() are cleared after the solvers
+//                   updating the AMR data --> See InvalidatePrepCache() for details
 //
 // Parameter   :  TSolver      : Target solver
 //                               --> FLUID_SOLVER               : Fluid / ELBDM solver
@@ -141,6 +173,7 @@ void InvokeSolver( const Solver_t TSolver, const int lv, const double TimeNew, c
    int  NPG[2];               // number of patch groups to be updated at a time
    int  NTotal;               // total number of patch groups to be updated
    int  Disp;                 // index displacement in PID0_List
+   double Cost[2];            // wall-clock time spent on the patch groups being updated (for OPT__LB_MEASURE_COST)
 
    if ( OverlapMPI )
    {
@@ -193,17 +226,42 @@ void InvokeSolver( const Solver_t TSolver, const int lv, const double TimeNew, c
       for (int t=0; t<NTotal; t++)  PID0_List[t] = 8*t;
    } // if ( OverlapMPI ) ... else ...
 
-   NPG[ArrayID] = ( NPG_Max < NTotal ) ? NPG_Max : NTotal;
+// pipeline the three steps on the CPU
+// --> no need to pipeline if there is only one batch of patch groups
+#  ifdef OPENMP
+   bool Pipeline = ( OPT__CPU_PIPELINE  &&  !OverlapMPI  &&  NTotal > NPG_Max );
+#  ifdef SUPPORT_GRACKLE
+   if ( TSolver == GRACKLE_SOLVER )    Pipeline = false;
+#  endif
+
+   if ( Pipeline )
+   {
+      Pipeline_CPU( TSolver, lv, TimeNew, TimeOld, dt, Poi_Coeff, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot,
+                    NPG_Max, NTotal, PID0_List );
+
+      if ( AllocateList )  delete [] PID0_List;
+
+      InvalidatePrepCache( TSolver, lv );
+
+      return;
+   }
+#  endif
+
+
+   NPG [ArrayID] = ( NPG_Max < NTotal ) ? NPG_Max : NTotal;
+   Cost[ArrayID] = 0.0;
 
 
 //-------------------------------------------------------------------------------------------------------------
-   TIMING_SYNC(   Preparation_Step( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], PID0_List, ArrayID ),
+   TIMING_SYNC(   MEASURE_COST( Preparation_Step( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], PID0_List, ArrayID ),
+                                Cost[ArrayID] ),
                   Timer_Pre[lv][TSolver]  );
 //-------------------------------------------------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------------------------------------------------
-   TIMING_SYNC(   Solver( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], ArrayID, dt, Poi_Coeff ),
+   TIMING_SYNC(   MEASURE_COST( Solver( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], ArrayID, dt, Poi_Coeff ),
+                                Cost[ArrayID] ),
                   Timer_Sol[lv][TSolver]  );
 //-------------------------------------------------------------------------------------------------------------
 
@@ -211,12 +269,14 @@ void InvokeSolver( const Solver_t TSolver, const int lv, const double TimeNew, c
    for (Disp=NPG_Max; Disp<NTotal; Disp+=NPG_Max)
    {
 
-      ArrayID      = 1 - ArrayID;
-      NPG[ArrayID] = ( NPG_Max < NTotal-Disp ) ? NPG_Max : NTotal-Disp;
+      ArrayID       = 1 - ArrayID;
+      NPG [ArrayID] = ( NPG_Max < NTotal-Disp ) ? NPG_Max : NTotal-Disp;
+      Cost[ArrayID] = 0.0;
 
 
 //-------------------------------------------------------------------------------------------------------------
-      TIMING_SYNC(   Preparation_Step( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], PID0_List+Disp, ArrayID ),
+      TIMING_SYNC(   MEASURE_COST( Preparation_Step( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], PID0_List+Disp, ArrayID ),
+                                   Cost[ArrayID] ),
                      Timer_Pre[lv][TSolver]  );
 //-------------------------------------------------------------------------------------------------------------
 
@@ -229,17 +289,24 @@ void InvokeSolver( const Solver_t TSolver, const int lv, const double TimeNew, c
 
 
 //-------------------------------------------------------------------------------------------------------------
-      TIMING_SYNC(   Solver( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], ArrayID, dt, Poi_Coeff ),
+      TIMING_SYNC(   MEASURE_COST( Solver( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], ArrayID, dt, Poi_Coeff ),
+                                   Cost[ArrayID] ),
                      Timer_Sol[lv][TSolver]  );
 //-------------------------------------------------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------------------------------------------------
-      TIMING_SYNC(   Closing_Step( TSolver, lv, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot,
-                     NPG[1-ArrayID], PID0_List+Disp-NPG_Max, 1-ArrayID, dt ),
+      TIMING_SYNC(   MEASURE_COST( Closing_Step( TSolver, lv, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot,
+                                                 NPG[1-ArrayID], PID0_List+Disp-NPG_Max, 1-ArrayID, dt ),
+                                   Cost[1-ArrayID] ),
                      Timer_Clo[lv][TSolver]  );
 //-------------------------------------------------------------------------------------------------------------
 
+#     ifdef LOAD_BALANCE
+      if ( OPT__LB_MEASURE_COST )
+         LB_AddMeasuredCost( lv, NPG[1-ArrayID], PID0_List+Disp-NPG_Max, Cost[1-ArrayID] );
+#     endif
+
    } // for (int Disp=NPG_Max; Disp<NTotal; Disp+=NPG_Max)
 
 
@@ -251,18 +318,187 @@ void InvokeSolver( const Solver_t TSolver, const int lv, const double TimeNew, c
 
 
 //-------------------------------------------------------------------------------------------------------------
-   TIMING_SYNC(   Closing_Step( TSolver, lv, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot,
-                  NPG[ArrayID], PID0_List+Disp-NPG_Max, ArrayID, dt ),
+   TIMING_SYNC(   MEASURE_COST( Closing_Step( TSolver, lv, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot,
+                                              NPG[ArrayID], PID0_List+Disp-NPG_Max, ArrayID, dt ),
+                                Cost[ArrayID] ),
                   Timer_Clo[lv][TSolver]  );
 //-------------------------------------------------------------------------------------------------------------
 
+#  ifdef LOAD_BALANCE
+   if ( OPT__LB_MEASURE_COST )
+      LB_AddMeasuredCost( lv, NPG[ArrayID], PID0_List+Disp-NPG_Max, Cost[ArrayID] );
+#  endif
+
 
    if ( AllocateList )  delete [] PID0_List;
 
+   InvalidatePrepCache( TSolver, lv );
+
 } // FUNCTION : InvokeSolver
 
 
 
+#ifdef OPENMP
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Pipeline_CPU
+// Description :  Pipelined version of the preparation, execution, and closing steps for OPT__CPU_PIPELINE
+//
+// Note        :  1. Invoked by InvokeSolver()
+//                2. While the solver team advances batch n in one array, the preparation/closing team first
+//                   stores batch n-1 and then prepares batch n+1 in the other array
+//                   --> The closing step of batch n-1 must finish before the preparation step of batch n+1
+//                       since they share the same array and some closing steps read the input array
+//                   --> The solver team and the preparation/closing team use (OMP_NTHREAD-CPU_PIPELINE_NTHREAD)
+//                       and CPU_PIPELINE_NTHREAD threads, respectively, by OpenMP nested parallelism
+//                3. The two teams never run the same step concurrently. Therefore, it only requires that
+//                   the solvers do not share any data with the preparation and closing steps except
+//                   the input/output arrays.
+//                4. The wall-clock time of the entire pipeline and the busy time of the two teams are recorded
+//                   in Timer_Pipeline[lv][0/1/2] for the stage utilisation in Record__Timing
+//
+// Parameter   :  TSolver, lv, TimeNew, TimeOld, dt, Poi_Coeff, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot
+//                           : See InvokeSolver()
+//                NPG_Max    : Maximum number of patch groups to be updated at a time
+//                NTotal     : Total number of patch groups to be updated
+//                PID0_List  : List recording the patch indices with LocalID==0 to be udpated
+//-------------------------------------------------------------------------------------------------------
+void Pipeline_CPU( const Solver_t TSolver, const int lv, const double TimeNew, const double TimeOld, const double dt,
+                   const double Poi_Coeff, const int SaveSg_Flu, const int SaveSg_Mag, const int SaveSg_Pot,
+                   const int NPG_Max, const int NTotal, const int *PID0_List )
+{
+
+   const int NBatch      = ( NTotal + NPG_Max - 1 ) / NPG_Max;
+   const int NThread_Sol = OMP_NTHREAD - CPU_PIPELINE_NTHREAD;
+   const int NThread_PC  = CPU_PIPELINE_NTHREAD;
+
+   int    NPG [2];   // number of patch groups in the batch stored in each array
+   double Cost[2];   // wall-clock time spent on the batch stored in each array (for OPT__LB_MEASURE_COST)
+
+
+#  ifdef TIMING
+   Timer_Pipeline[lv][0]->Start();
+#  endif
+
+
+// 1. prepare the first batch
+#  ifdef TIMING
+   Timer_Pipeline[lv][2]->Start();
+#  endif
+
+   NPG [0] = MIN( NPG_Max, NTotal );
+   Cost[0] = 0.0;
+
+   TIMING_SYNC(   MEASURE_COST( Preparation_Step( TSolver, lv, TimeNew, TimeOld, NPG[0], PID0_List, 0 ),
+                                Cost[0] ),
+                  Timer_Pre[lv][TSolver]  );
+
+#  ifdef TIMING
+   Timer_Pipeline[lv][2]->Stop();
+#  endif
+
+
+// 2. advance batch n while storing batch n-1 and preparing batch n+1
+   omp_set_nested( true );
+
+   for (int n=0; n<NBatch; n++)
+   {
+      const int ArrayID = n%2;
+
+#     pragma omp parallel sections num_threads( 2 )
+      {
+//       2-1. solver team
+#        pragma omp section
+         {
+#           ifdef TIMING
+            Timer_Pipeline[lv][1]->Start();
+#           endif
+
+            omp_set_num_threads( NThread_Sol );
+
+            TIMING_SYNC(   MEASURE_COST( Solver( TSolver, lv, TimeNew, TimeOld, NPG[ArrayID], ArrayID, dt, Poi_Coeff ),
+                                         Cost[ArrayID] ),
+                           Timer_Sol[lv][TSolver]  );
+
+#           ifdef TIMING
+            Timer_Pipeline[lv][1]->Stop();
+#           endif
+         }
+
+//       2-2. preparation/closing team
+#        pragma omp section
+         {
+#           ifdef TIMING
+            Timer_Pipeline[lv][2]->Start();
+#           endif
+
+            omp_set_num_threads( NThread_PC );
+
+            if ( n > 0 )
+            {
+               const int Disp = (n-1)*NPG_Max;
+
+               TIMING_SYNC(   MEASURE_COST( Closing_Step( TSolver, lv, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot,
+                                                          NPG[1-ArrayID], PID0_List+Disp, 1-ArrayID, dt ),
+                                            Cost[1-ArrayID] ),
+                              Timer_Clo[lv][TSolver]  );
+
+#              ifdef LOAD_BALANCE
+               if ( OPT__LB_MEASURE_COST )
+                  LB_AddMeasuredCost( lv, NPG[1-ArrayID], PID0_List+Disp, Cost[1-ArrayID] );
+#              endif
+            }
+
+            if ( n+1 < NBatch )
+            {
+               const int Disp = (n+1)*NPG_Max;
+
+               NPG [1-ArrayID] = MIN( NPG_Max, NTotal-Disp );
+               Cost[1-ArrayID] = 0.0;
+
+               TIMING_SYNC(   MEASURE_COST( Preparation_Step( TSolver, lv, TimeNew, TimeOld, NPG[1-ArrayID], PID0_List+Disp,
+                                                              1-ArrayID ),
+                                            Cost[1-ArrayID] ),
+                              Timer_Pre[lv][TSolver]  );
+            }
+
+#           ifdef TIMING
+            Timer_Pipeline[lv][2]->Stop();
+#           endif
+         }
+      } // OpenMP parallel sections
+   } // for (int n=0; n<NBatch; n++)
+
+   omp_set_nested( false );
+
+
+// 3. store the last batch
+#  ifdef TIMING
+   Timer_Pipeline[lv][2]->Start();
+#  endif
+
+   const int ArrayID = (NBatch-1)%2;
+   const int Disp    = (NBatch-1)*NPG_Max;
+
+   TIMING_SYNC(   MEASURE_COST( Closing_Step( TSolver, lv, SaveSg_Flu, SaveSg_Mag, SaveSg_Pot,
+                                              NPG[ArrayID], PID0_List+Disp, ArrayID, dt ),
+                                Cost[ArrayID] ),
+                  Timer_Clo[lv][TSolver]  );
+
+#  ifdef LOAD_BALANCE
+   if ( OPT__LB_MEASURE_COST )
+      LB_AddMeasuredCost( lv, NPG[ArrayID], PID0_List+Disp, Cost[ArrayID] );
+#  endif
+
+#  ifdef TIMING
+   Timer_Pipeline[lv][2]->Stop();
+   Timer_Pipeline[lv][0]->Stop();
+#  endif
+
+} // FUNCTION : Pipeline_CPU
+#endif // #ifdef OPENMP
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Preparation_Step
 // Description :  Prepare the input data for the CPU/GPU solvers
@@ -826,3 +1062,36 @@ void Closing_Step( const Solver_t TSolver, const int lv, const int SaveSg_Flu, c
 } // FUNCTION : Closing_Step
 
 
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  InvalidatePrepCache
+// Description :  Clear the data cached by Prepare_PatchData() for OPT__PREP_CACHE after invoking the target solver
+//
+// Note        :  1. Invoked by InvokeSolver()
+//                2. The dt solvers do not modify any AMR data
+//                3. The fluid solver stores the updated data in the sandglass different from the input data
+//                   --> Data prepared at lv are not affected since PrepTime < TimeNew
+//                   --> Only clear the data at levels > lv, which may be interpolated in time from the updated
+//                       sandglass at lv
+//                   --> Allow reusing the prepared data when the fluid solver is invoked again with a smaller
+//                       time-step by AUTO_REDUCE_DT
+//                4. The other solvers may update the data in place --> clear the data at levels >= lv
+//
+// Parameter   :  TSolver : Target solver
+//                lv      : Target refinement level
+//-------------------------------------------------------------------------------------------------------
+void InvalidatePrepCache( const Solver_t TSolver, const int lv )
+{
+
+#  ifdef GRAVITY
+   if ( TSolver == DT_FLU_SOLVER  ||  TSolver == DT_GRA_SOLVER )  return;
+#  else
+   if ( TSolver == DT_FLU_SOLVER )                                return;
+#  endif
+
+   if ( TSolver == FLUID_SOLVER )   PrepCache_Invalidate( lv+1 );
+   else                             PrepCache_Invalidate( lv   );
+
+} // FUNCTION : InvalidatePrepCache
+
+
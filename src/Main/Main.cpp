@@ -22,6 +22,8 @@ double               Time[NLEVEL]           = { 0.0 };
 double               dTime_AllLv[NLEVEL]    = { 0.0 };
 long                 AdvanceCounter[NLEVEL] = { 0 };
 long                 NCorrUnphy[NLEVEL]     = { 0 };
+long                 PrepCache_NHit [NLEVEL] = { 0 };
+long                 PrepCache_NMiss[NLEVEL] = { 0 };
 long                 Step                   = 0;
 int                  DumpID                 = 0;
 double               DumpTime               = 0.0;
@@ -44,27 +46,29 @@ int                  Flu_ParaBuf;
 
 double               BOX_SIZE, DT__MAX, DT__FLUID, DT__FLUID_INIT, END_T, OUTPUT_DT, DT__SYNC_PARENT_LV, DT__SYNC_CHILDREN_LV;
 long                 END_STEP;
-int                  NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, SRC_GPU_NPGROUP, OMP_NTHREAD;
+int                  NX0_TOT[3], OUTPUT_STEP, REGRID_COUNT, FLU_GPU_NPGROUP, SRC_GPU_NPGROUP, OMP_NTHREAD, CPU_PIPELINE_NTHREAD;
 int                  MPI_NRank, MPI_NRank_X[3];
 int                  GPU_NSTREAM, FLAG_BUFFER_SIZE, FLAG_BUFFER_SIZE_MAXM1_LV, FLAG_BUFFER_SIZE_MAXM2_LV, MAX_LEVEL;
 
 IntScheme_t          OPT__FLU_INT_SCHEME, OPT__REF_FLU_INT_SCHEME;
-double               OUTPUT_PART_X, OUTPUT_PART_Y, OUTPUT_PART_Z, AUTO_REDUCE_DT_FACTOR, AUTO_REDUCE_DT_FACTOR_MIN;
+double               OUTPUT_PART_X, OUTPUT_PART_Y, OUTPUT_PART_Z, AUTO_REDUCE_DT_FACTOR, AUTO_REDUCE_DT_FACTOR_MIN, OUTPUT_ASYNC_MAX_MB, PREP_CACHE_MAX_MB;
 double               OPT__CK_MEMFREE, INT_MONO_COEFF, UNIT_L, UNIT_M, UNIT_T, UNIT_V, UNIT_D, UNIT_E, UNIT_P;
+double               MEMORY_POOL_HEADROOM, MEMORY_POOL_MAX_MB;
 int                  OPT__UM_IC_LEVEL, OPT__UM_IC_NLEVEL, OPT__UM_IC_NVAR, OPT__UM_IC_LOAD_NRANK, OPT__GPUID_SELECT, OPT__PATCH_COUNT;
 int                  INIT_DUMPID, INIT_SUBSAMPLING_NCELL, OPT__TIMING_BARRIER, OPT__REUSE_MEMORY, RESTART_LOAD_NRANK;
 bool                 OPT__FLAG_RHO, OPT__FLAG_RHO_GRADIENT, OPT__FLAG_USER, OPT__FLAG_LOHNER_DENS, OPT__FLAG_REGION;
 int                  OPT__FLAG_USER_NUM, MONO_MAX_ITER;
-bool                 OPT__DT_USER, OPT__RECORD_DT, OPT__RECORD_MEMORY, OPT__MEMORY_POOL, OPT__RESTART_RESET;
+bool                 OPT__DT_USER, OPT__DT_FLU_FUSED, OPT__RECORD_DT, OPT__RECORD_MEMORY, OPT__RESTART_RESET, OPT__SLAB_ALLOC;
 bool                 OPT__FIXUP_RESTRICT, OPT__INIT_RESTRICT, OPT__VERBOSE, OPT__MANUAL_CONTROL, OPT__UNIT;
-bool                 OPT__INT_TIME, OPT__OUTPUT_USER, OPT__OUTPUT_BASE, OPT__OUTPUT_RESTART, OPT__OVERLAP_MPI, OPT__TIMING_BALANCE;
+bool                 OPT__INT_TIME, OPT__OUTPUT_USER, OPT__OUTPUT_BASE, OPT__OUTPUT_RESTART, OPT__OVERLAP_MPI, OPT__TIMING_BALANCE, OPT__CPU_PIPELINE;
+bool                 OPT__PREP_CACHE;
 bool                 OPT__OUTPUT_BASEPS, OPT__CK_REFINE, OPT__CK_PROPER_NESTING, OPT__CK_FINITE, OPT__RECORD_PERFORMANCE;
 bool                 OPT__CK_RESTRICT, OPT__CK_PATCH_ALLOCATE, OPT__FIXUP_FLUX, OPT__CK_FLUX_ALLOCATE, OPT__CK_NORMALIZE_PASSIVE;
 bool                 OPT__UM_IC_DOWNGRADE, OPT__UM_IC_REFINE, OPT__TIMING_MPI;
 bool                 OPT__CK_CONSERVATION, OPT__RESET_FLUID, OPT__FREEZE_FLUID, OPT__RECORD_USER, OPT__NORMALIZE_PASSIVE, AUTO_REDUCE_DT;
 bool                 OPT__OPTIMIZE_AGGRESSIVE, OPT__INIT_GRID_WITH_OMP, OPT__NO_FLAG_NEAR_BOUNDARY;
 bool                 OPT__RECORD_NOTE, OPT__RECORD_UNPHY, INT_OPP_SIGN_0TH_ORDER;
-bool                 OPT__INT_FRAC_PASSIVE_LR;
+bool                 OPT__INT_FRAC_PASSIVE_LR, OPT__OUTPUT_HDF5_MPIIO, OPT__OUTPUT_ASYNC;
 
 UM_IC_Format_t       OPT__UM_IC_FORMAT;
 TestProbID_t         TESTPROB_ID;
@@ -75,6 +79,7 @@ OptOutputMode_t      OPT__OUTPUT_MODE;
 OptFluBC_t           OPT__BC_FLU[6];
 OptLohnerForm_t      OPT__FLAG_LOHNER_FORM;
 OptCorrAfterSync_t   OPT__CORR_AFTER_ALL_SYNC;
+OptMemoryPool_t      OPT__MEMORY_POOL;
 OptTimeStepLevel_t   OPT__DT_LEVEL;
 
 
@@ -130,17 +135,20 @@ real                *GreenFuncK = NULL;
 double               GFUNC_COEFF0;
 double               DT__GRAVITY;
 double               NEWTON_G;
-int                  POT_GPU_NPGROUP;
+int                  POT_GPU_NPGROUP, OPT__FFT_PENCIL;
 bool                 OPT__OUTPUT_POT, OPT__GRA_P5_GRADIENT, OPT__SELF_GRAVITY, OPT__GRAVITY_EXTRA_MASS;
 double               SOR_OMEGA;
 int                  SOR_MAX_ITER, SOR_MIN_ITER;
 double               MG_TOLERATED_ERROR;
 int                  MG_MAX_ITER, MG_NPRE_SMOOTH, MG_NPOST_SMOOTH;
+bool                 OPT__POI_LEVEL_MG;
 char                 EXT_POT_TABLE_NAME[MAX_STRING];
 double               EXT_POT_TABLE_DH[3], EXT_POT_TABLE_EDGEL[3];
 int                  EXT_POT_TABLE_NPOINT[3], EXT_POT_TABLE_FLOAT8;
 IntScheme_t          OPT__POT_INT_SCHEME, OPT__RHO_INT_SCHEME, OPT__GRA_INT_SCHEME, OPT__REF_POT_INT_SCHEME;
 OptPotBC_t           OPT__BC_POT;
+OptFFTWStartup_t     OPT__FFTW_STARTUP;
+bool                 OPT__FFTW_WISDOM;
 OptExtAcc_t          OPT__EXT_ACC;
 OptExtPot_t          OPT__EXT_POT;
 
@@ -170,7 +178,8 @@ double               LB_INPUT__WLI_MAX;
 #ifdef PARTICLE
 double               LB_INPUT__PAR_WEIGHT;
 #endif
-bool                 OPT__RECORD_LOAD_BALANCE;
+bool                 OPT__RECORD_LOAD_BALANCE, OPT__LB_DIFFUSE, OPT__LB_MEASURE_COST, OPT__LB_NEIGHBOR_MPI;
+double               LB_MEASURE_COST_WEIGHT;
 #endif
 bool                 OPT__MINIMIZE_MPI_BARRIER;
 
@@ -454,6 +463,8 @@ Timer_t *Timer_Par_2Sib   [NLEVEL];
 Timer_t *Timer_Par_2Son   [NLEVEL];
 Timer_t *Timer_Par_Collect[NLEVEL];
 Timer_t *Timer_Par_MPI    [NLEVEL][6];
+Timer_t *Timer_OverlapMPI [NLEVEL][3];
+Timer_t *Timer_Pipeline   [NLEVEL][3];
 #endif
 
 #ifdef TIMING_SOLVER
@@ -505,6 +516,8 @@ int main( int argc, char *argv[] )
    Output_DumpData( 0 );
 
    if ( OPT__PATCH_COUNT > 0 )            Aux_Record_PatchCount();
+   if ( OPT__MEMORY_POOL == MEMORY_POOL_ADAPTIVE )
+                                          Aux_AdjustMemoryPool( NULL );
    if ( OPT__RECORD_MEMORY )              Aux_GetMemInfo();
    if ( OPT__RECORD_USER ) {
       if ( Aux_Record_User_Ptr != NULL )  Aux_Record_User_Ptr();
@@ -570,6 +583,9 @@ int main( int argc, char *argv[] )
       if ( OPT__PATCH_COUNT == 1 )
       TIMING_FUNC(   Aux_Record_PatchCount(),         Timer_Main[4],   TIMER_ON   );
 
+      if ( OPT__MEMORY_POOL == MEMORY_POOL_ADAPTIVE )
+      TIMING_FUNC(   Aux_AdjustMemoryPool( NULL ),    Timer_Main[4],   TIMER_ON   );
+
       if ( OPT__RECORD_MEMORY )
       TIMING_FUNC(   Aux_GetMemInfo(),                Timer_Main[4],   TIMER_ON   );
 
@@ -579,6 +595,9 @@ int main( int argc, char *argv[] )
       if ( OPT__RECORD_UNPHY )
       TIMING_FUNC(   Aux_Record_CorrUnphy(),          Timer_Main[4],   TIMER_ON   );
 
+      if ( OPT__PREP_CACHE )
+      TIMING_FUNC(   Aux_Record_PrepCache(),          Timer_Main[4],   TIMER_ON   );
+
 #     ifdef PARTICLE
       if ( OPT__PARTICLE_COUNT == 1 )
       TIMING_FUNC(   Par_Aux_Record_ParticleCount(),  Timer_Main[4],   TIMER_ON   );
@@ -608,24 +627,34 @@ int main( int argc, char *argv[] )
 
 //    6. check whether to redistribute all patches for LOAD_BALANCE
 //    ---------------------------------------------------------------------------------------------------
+#     ifdef PARTICLE
+//    sort particles periodically and after redistributing patches (see step 7)
+      bool SortPar = ( amr->Par->SortInterval > 0  &&  Step % amr->Par->SortInterval == 0 );
+#     endif
+
 #     ifdef LOAD_BALANCE
       if ( OPT__TIMING_BARRIER ) MPI_Barrier( MPI_COMM_WORLD );
 #     ifdef TIMING
       Timer_Main[5]->Start();    // timer for load balance
 #     endif
 
+      if ( OPT__LB_MEASURE_COST )   LB_UpdateMeasuredCost();
+
       if ( LB_EstimateLoadImbalance() > amr->LB->WLI_Max )
       {
          if ( MPI_Rank == 0 )
          {
             Aux_Message( stdout, "Weighted load-imbalance factor (%13.7e) > threshold (%13.7e) ",
                          amr->LB->WLI, amr->LB->WLI_Max );
-            Aux_Message( stdout, "--> redistributing all patches ...\n" );
+            Aux_Message( stdout, "--> %s ...\n", (OPT__LB_DIFFUSE)?"shifting cut points between adjacent ranks"
+                                                                  :"redistributing all patches" );
          }
 
          const bool   Redistribute_Yes = true;
          const bool   SendGridData_Yes = true;
          const bool   ResetLB_Yes      = true;
+         const bool   Diffuse_Yes      = true;
+         const bool   Diffuse_No       = false;
 #        ifdef PARTICLE
          const double ParWeight        = amr->LB->Par_Weight;
 #        else
@@ -633,12 +662,22 @@ int main( int argc, char *argv[] )
 #        endif
          const int    AllLv            = -1;
 
-         LB_Init_LoadBalance( Redistribute_Yes, SendGridData_Yes, ParWeight, ResetLB_Yes, AllLv );
+//       diffusive load balancing: only redistribute the levels with shifted cut points
+//       --> must proceed from lower to higher levels since LB_Init_LoadBalance() applied to a single level
+//           also reconstructs the patch relation and MPI lists on the adjacent levels
+         if ( OPT__LB_DIFFUSE )
+            for (int lv=0; lv<NLEVEL; lv++)
+               LB_Init_LoadBalance( Redistribute_Yes, SendGridData_Yes, ParWeight, ResetLB_Yes, Diffuse_Yes, lv );
+
+         else
+            LB_Init_LoadBalance( Redistribute_Yes, SendGridData_Yes, ParWeight, ResetLB_Yes, Diffuse_No, AllLv );
 
          if ( OPT__PATCH_COUNT > 0 )         Aux_Record_PatchCount();
 
 #        ifdef PARTICLE
          if ( OPT__PARTICLE_COUNT > 0 )      Par_Aux_Record_ParticleCount();
+
+         if ( amr->Par->SortInterval > 0 )   SortPar = true;
 #        endif
       } // if ( LB_EstimateLoadImbalance() > amr->LB->WLI_Max )
 
@@ -649,7 +688,16 @@ int main( int argc, char *argv[] )
 //    ---------------------------------------------------------------------------------------------------
 
 
-//    7. record timing
+//    7. sort particles by patches
+//    ---------------------------------------------------------------------------------------------------
+#     ifdef PARTICLE
+      if ( SortPar )
+      TIMING_FUNC(   Par_SortByPatch(),               Timer_Main[4],   TIMER_ON   );
+#     endif
+//    ---------------------------------------------------------------------------------------------------
+
+
+//    8. record timing
 //    ---------------------------------------------------------------------------------------------------
 #     ifdef TIMING
       MPI_Barrier( MPI_COMM_WORLD );
@@ -0,0 +1,266 @@
+#include "GAMER.h"
+
+
+
+// structure storing the prepared data of one patch group
+struct PrepCacheEntry_t
+{
+   PrepCacheKey_t    Key;
+   long              SizeCC;
+   long              SizeFC;
+   real             *DataCC;
+   real             *DataFC;
+   PrepCacheEntry_t *Next;
+};
+
+// Table     : linked lists of cached entries indexed by PID0/8 at each level (allocated on demand)
+// NBucket   : size of Table[] at each level (grown on demand)
+// NEntry    : number of cached entries at each level
+// MaxBucket : maximum bucket index ever used at each level since the last invalidation
+// MemByte   : total memory occupied by the cached data
+static PrepCacheEntry_t **Table    [NLEVEL] = { NULL };
+static int                NBucket  [NLEVEL] = { 0 };
+static long               NEntry   [NLEVEL] = { 0 };
+static int                MaxBucket[NLEVEL] = { 0 };
+static long               MemByte           = 0;
+
+static void FreeLevel( const int lv );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  PrepCache_Get
+// Description :  Retrieve the data of one patch group previously prepared by Prepare_PatchData()
+//
+// Note        :  1. Invoked by Prepare_PatchData() when OPT__PREP_CACHE is on
+//                2. Cached data are exact copies of the output of Prepare_PatchData() for the same key
+//                   --> Both the cell-centered and face-centered data must have the same sizes as the cached ones
+//                3. Hits and misses are accumulated in PrepCache_NHit[] and PrepCache_NMiss[]
+//                4. Thread-safe
+//
+// Parameter   :  lv       : Target refinement level
+//                PID0     : Patch index with LocalID==0 of the target patch group
+//                Key      : Input parameters of Prepare_PatchData()
+//                OutputCC : Array to store the cell-centered data
+//                OutputFC : Array to store the face-centered data
+//                SizeCC   : Number of cell-centered elements of one patch group
+//                SizeFC   : Number of face-centered elements of one patch group
+//
+// Return      :  true  --> data are found and copied to OutputCC/FC
+//                false --> data are not found
+//-------------------------------------------------------------------------------------------------------
+bool PrepCache_Get( const int lv, const int PID0, const PrepCacheKey_t &Key, real *OutputCC, real *OutputFC,
+                    const long SizeCC, const long SizeFC )
+{
+
+   bool Found = false;
+
+#  pragma omp critical( PrepCache )
+   {
+      if ( NEntry[lv] > 0  &&  PID0/8 < NBucket[lv] )
+      {
+         for (PrepCacheEntry_t *Entry=Table[lv][PID0/8]; Entry!=NULL; Entry=Entry->Next)
+         {
+            if ( Entry->SizeCC == SizeCC  &&  Entry->SizeFC == SizeFC  &&  Entry->Key.Match(Key) )
+            {
+               if ( SizeCC > 0 )    memcpy( OutputCC, Entry->DataCC, SizeCC*sizeof(real) );
+               if ( SizeFC > 0 )    memcpy( OutputFC, Entry->DataFC, SizeFC*sizeof(real) );
+
+               Found = true;
+               break;
+            }
+         }
+      }
+
+      if ( Found )   PrepCache_NHit [lv] ++;
+      else           PrepCache_NMiss[lv] ++;
+   } // omp critical
+
+   return Found;
+
+} // FUNCTION : PrepCache_Get
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  PrepCache_Put
+// Description :  Store the data of one patch group prepared by Prepare_PatchData()
+//
+// Note        :  1. Invoked by Prepare_PatchData() when OPT__PREP_CACHE is on
+//                2. Do nothing if the same key has been stored or the total memory would exceed PREP_CACHE_MAX_MB
+//                   --> No entry is evicted until the next PrepCache_Invalidate()
+//                3. Thread-safe
+//
+// Parameter   :  lv       : Target refinement level
+//                PID0     : Patch index with LocalID==0 of the target patch group
+//                Key      : Input parameters of Prepare_PatchData()
+//                InputCC  : Cell-centered data to be stored
+//                InputFC  : Face-centered data to be stored
+//                SizeCC   : Number of cell-centered elements of one patch group
+//                SizeFC   : Number of face-centered elements of one patch group
+//-------------------------------------------------------------------------------------------------------
+void PrepCache_Put( const int lv, const int PID0, const PrepCacheKey_t &Key, const real *InputCC, const real *InputFC,
+                    const long SizeCC, const long SizeFC )
+{
+
+   const long   NewByte = ( SizeCC + SizeFC )*sizeof(real);
+   const double MaxByte = PREP_CACHE_MAX_MB*1024.0*1024.0;
+   const int    Bucket  = PID0/8;
+
+#  pragma omp critical( PrepCache )
+   {
+      bool Skip = ( (double)( MemByte + NewByte ) > MaxByte );
+
+//    allocate or grow the table at this level
+      if ( !Skip  &&  Bucket >= NBucket[lv] )
+      {
+         const int NBucketNew = MAX( Bucket+1, 2*NBucket[lv] );
+         PrepCacheEntry_t **TableNew = new PrepCacheEntry_t* [NBucketNew];
+
+         for (int b=0;           b<NBucket[lv]; b++)   TableNew[b] = Table[lv][b];
+         for (int b=NBucket[lv]; b<NBucketNew;  b++)   TableNew[b] = NULL;
+
+         delete [] Table[lv];
+         Table  [lv] = TableNew;
+         NBucket[lv] = NBucketNew;
+      }
+
+//    check whether the same key has been stored
+      if ( !Skip )
+      {
+         for (PrepCacheEntry_t *Entry=Table[lv][Bucket]; Entry!=NULL; Entry=Entry->Next)
+         {
+            if ( Entry->SizeCC == SizeCC  &&  Entry->SizeFC == SizeFC  &&  Entry->Key.Match(Key) )
+            {
+               Skip = true;
+               break;
+            }
+         }
+      }
+
+      if ( !Skip )
+      {
+         PrepCacheEntry_t *Entry = new PrepCacheEntry_t;
+
+         Entry->Key    = Key;
+         Entry->SizeCC = SizeCC;
+         Entry->SizeFC = SizeFC;
+         Entry->DataCC = ( SizeCC > 0 ) ? new real [SizeCC] : NULL;
+         Entry->DataFC = ( SizeFC > 0 ) ? new real [SizeFC] : NULL;
+
+         if ( SizeCC > 0 )    memcpy( Entry->DataCC, InputCC, SizeCC*sizeof(real) );
+         if ( SizeFC > 0 )    memcpy( Entry->DataFC, InputFC, SizeFC*sizeof(real) );
+
+//       insert it at the head of the list
+         Entry->Next       = Table[lv][Bucket];
+         Table[lv][Bucket] = Entry;
+
+         NEntry[lv] ++;
+         MaxBucket[lv] = MAX( MaxBucket[lv], Bucket );
+         MemByte      += NewByte;
+      }
+   } // omp critical
+
+} // FUNCTION : PrepCache_Put
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  PrepCache_Invalidate
+// Description :  Remove all cached data at levels >= lv
+//
+// Note        :  1. Must be invoked whenever the data at level lv used by Prepare_PatchData() may change
+//                   (e.g., the solvers, fix-up, refinement, load balancing, and buffer-data exchange)
+//                   --> Finer levels are also invalidated since their ghost zones may be interpolated from lv
+//                2. Memory of the table itself is kept for reuse
+//                3. Thread-safe
+//
+// Parameter   :  lv : Minimum target refinement level
+//                     --> Do nothing if lv > TOP_LEVEL
+//-------------------------------------------------------------------------------------------------------
+void PrepCache_Invalidate( const int lv )
+{
+
+   if ( !OPT__PREP_CACHE )    return;
+
+#  pragma omp critical( PrepCache )
+   {
+      for (int TLv=lv; TLv<NLEVEL; TLv++)
+         if ( NEntry[TLv] > 0 )  FreeLevel( TLv );
+   }
+
+} // FUNCTION : PrepCache_Invalidate
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  PrepCache_Free
+// Description :  Free all memory allocated for the cache
+//
+// Note        :  1. Invoked by End_MemFree()
+//-------------------------------------------------------------------------------------------------------
+void PrepCache_Free()
+{
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   {
+      if ( NEntry[lv] > 0 )   FreeLevel( lv );
+
+      delete [] Table[lv];
+      Table  [lv] = NULL;
+      NBucket[lv] = 0;
+   }
+
+} // FUNCTION : PrepCache_Free
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  PrepCache_GetMemoryMB
+// Description :  Return the memory in MB currently occupied by the cached data on this rank
+//-------------------------------------------------------------------------------------------------------
+double PrepCache_GetMemoryMB()
+{
+
+   return (double)MemByte/( 1024.0*1024.0 );
+
+} // FUNCTION : PrepCache_GetMemoryMB
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  FreeLevel
+// Description :  Remove all cached entries at the target level
+//
+// Note        :  1. Not thread-safe --> callers must lock the "PrepCache" critical section if necessary
+//
+// Parameter   :  lv : Target refinement level
+//-------------------------------------------------------------------------------------------------------
+void FreeLevel( const int lv )
+{
+
+   for (int b=0; b<=MaxBucket[lv]; b++)
+   {
+      PrepCacheEntry_t *Entry = Table[lv][b];
+
+      while ( Entry != NULL )
+      {
+         PrepCacheEntry_t *Next = Entry->Next;
+
+         MemByte -= ( Entry->SizeCC + Entry->SizeFC )*sizeof(real);
+
+         delete [] Entry->DataCC;
+         delete [] Entry->DataFC;
+         delete Entry;
+
+         Entry = Next;
+      }
+
+      Table[lv][b] = NULL;
+   }
+
+   NEntry   [lv] = 0;
+   MaxBucket[lv] = 0;
+
+} // FUNCTION : FreeLevel
@@ -20,6 +20,10 @@ static void MHD_SetFInterface( real *FInt_Data, real *FInt_Ptr[6], const real *D
                                const int Side, const int GhostSize, const int MagSg, const int MagSg_IntT,
                                const bool MagIntTime, const real MagWeighting, const real MagWeighting_IntT );
 #endif
+#ifdef MASSIVE_PARTICLES
+static void ParMass_GetParList( const int lv, const int PID, int &NPar, long *&ParList, bool &UseInputMassPos,
+                                real **&InputMassPos );
+#endif
 
 // flags for checking whether (1) Prepare_PatchData_InitParticleDensityArray() and (2) Par_CollectParticle2OneLevel()
 // are properly called before preparing either _PAR_DENS or _TOTAL_DENS
@@ -46,6 +50,14 @@ static void MHD_CheckDivB( const real *Data1PG_FC, const int GhostSize, const re
 #endif // MHD
 
 
+// minimum number of particles in a patch for depositing its particle mass with all OpenMP threads
+// --> a patch is split across threads only if it also holds more particles than the average number of
+//     particles per thread, so that it would otherwise keep one thread busy while the others idle
+#ifdef MASSIVE_PARTICLES
+#  define PAR_DEPO_SPLIT_NPAR_MIN   10000
+#endif
+
+
 
 
 //-------------------------------------------------------------------------------------------------------
@@ -93,6 +105,11 @@ static void MHD_CheckDivB( const real *Data1PG_FC, const int GhostSize, const re
 //                           field on the coarse-fine interfaces of the central patch group
 //                       --> It's OK for the MHD solver since it will still guarantee that the updated B field within the patch group
 //                           is divergence free
+//               10. For OPT__PREP_CACHE, the prepared data of each patch group are stored by PrepCache_Put() and reused
+//                   by the subsequent calls with exactly the same input parameters
+//                   --> The cache is cleared by PrepCache_Invalidate() whenever the AMR data may change
+//                   --> Not applied to GhostSize == 0 (for which the preparation is just a copy) and
+//                       _PAR_DENS/_TOTAL_DENS (for which rho_ext[] is rebuilt by the caller every time)
 //
 // Parameter   :  lv             : Target refinement level
 //                PrepTime       : Target physical time to prepare data
@@ -470,6 +487,41 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
 #  endif
 
 
+// set up the cache key for OPT__PREP_CACHE
+// --> PrepSizeCC/FC: number of cell-centered/face-centered elements of one patch group in OutputCC/FC
+#  ifdef PARTICLE
+   const bool UsePrepCache = ( OPT__PREP_CACHE  &&  GhostSize > 0  &&  !PrepParOnlyDens  &&  !PrepTotalDens );
+#  else
+   const bool UsePrepCache = ( OPT__PREP_CACHE  &&  GhostSize > 0 );
+#  endif
+   const long PrepSizeCC   = ( PrepUnit == UNIT_PATCHGROUP ) ? (long)NVarCC_Tot*PGSize3D_CC
+                                                             : 8L*NVarCC_Tot*CUBE( PS1+2*GhostSize );
+   const long PrepSizeFC   = ( PrepUnit == UNIT_PATCHGROUP ) ? (long)NVarFC_Tot*PGSize3D_FC
+                                                             : 8L*NVarFC_Tot*( PS1+2*GhostSize+1 )*SQR( PS1+2*GhostSize );
+   PrepCacheKey_t PrepKey;
+
+   if ( UsePrepCache )
+   {
+      PrepKey.PrepTime       = PrepTime;
+      PrepKey.TVarCC         = TVarCC;
+      PrepKey.TVarFC         = TVarFC;
+      PrepKey.GhostSize      = GhostSize;
+      PrepKey.IntScheme_CC   = IntScheme_CC;
+      PrepKey.IntScheme_FC   = IntScheme_FC;
+      PrepKey.PrepUnit       = PrepUnit;
+      PrepKey.NSide          = NSide;
+      PrepKey.IntPhase       = IntPhase;
+      PrepKey.PotBC          = PotBC;
+      PrepKey.MinDens        = MinDens;
+      PrepKey.MinPres        = MinPres;
+      PrepKey.MinTemp        = MinTemp;
+      PrepKey.MinEntr        = MinEntr;
+      PrepKey.DE_Consistency = DE_Consistency;
+
+      for (int f=0; f<6; f++)    PrepKey.FluBC[f] = FluBC[f];
+   }
+
+
 // temporal interpolation parameters
    bool FluIntTime;
    int  FluSg, FluSg_IntT;
@@ -564,6 +616,9 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
    int *ParMass_PID_List   = NULL;
    int  ParMass_NPatch_Dup = 0;        // number of patches (including duplicates) for the particle mass assignment
    int  ParMass_NPatch;
+   int  ParMass_NLight     = 0;        // number of patches deposited by one thread each (the rest are split across threads)
+
+   real (*ParMass_Tile)[ CUBE(RHOEXT_NXT) ] = NULL;   // per-thread rho_ext[] tiles for splitting heavy patches
 
 // constant settings related to particle mass assignment
    const bool InitZero_Yes     = true;
@@ -647,7 +702,7 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
 
 
 //    sort PID list and remove duplicate patches
-      Mis_Heapsort( ParMass_NPatch_Dup, ParMass_PID_List, NULL );
+      Mis_RadixSort( ParMass_NPatch_Dup, ParMass_PID_List, NULL );
 
       ParMass_NPatch = ( ParMass_NPatch_Dup > 0 ) ? 1 : 0;
 
@@ -665,6 +720,52 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
          if ( amr->patch[0][lv][TPID]->rho_ext == NULL )    amr->patch[0][lv][TPID]->dnew();
       }
 
+
+//    move heavy patches to the end of the PID list so that their particles can be deposited by all threads
+//    --> a patch is heavy if NPar >= MAX( PAR_DEPO_SPLIT_NPAR_MIN, average number of particles per thread )
+//    --> keep the order of the remaining patches
+//    --> disabled for BITWISE_REPRODUCIBILITY since the deposited mass would depend on the number of threads
+      ParMass_NLight = ParMass_NPatch;
+
+#     if ( defined OPENMP  &&  !defined BITWISE_REPRODUCIBILITY )
+      const int NT = omp_get_max_threads();
+
+      if ( NT > 1  &&  ParMass_NPatch > 0 )
+      {
+         int  *NPar_List  = new int [ParMass_NPatch];
+         int  *Heavy_List = new int [ParMass_NPatch];
+         int   NHeavy     = 0;
+         long  NPar_Sum   = 0;
+         long *ParList_Dummy;
+         bool  UseInputMassPos_Dummy;
+         real **InputMassPos_Dummy;
+
+         for (int t=0; t<ParMass_NPatch; t++)
+         {
+            ParMass_GetParList( lv, ParMass_PID_List[t], NPar_List[t], ParList_Dummy, UseInputMassPos_Dummy,
+                                InputMassPos_Dummy );
+            NPar_Sum += NPar_List[t];
+         }
+
+         const long NPar_Heavy = MAX( (long)PAR_DEPO_SPLIT_NPAR_MIN, NPar_Sum/NT );
+
+         ParMass_NLight = 0;
+
+         for (int t=0; t<ParMass_NPatch; t++)
+         {
+            if ( NPar_List[t] >= NPar_Heavy )   Heavy_List[ NHeavy ++ ]                 = ParMass_PID_List[t];
+            else                                ParMass_PID_List[ ParMass_NLight ++ ] = ParMass_PID_List[t];
+         }
+
+         for (int t=0; t<NHeavy; t++)  ParMass_PID_List[ ParMass_NLight + t ] = Heavy_List[t];
+
+         if ( NHeavy > 0 )    ParMass_Tile = new real [NT][ CUBE(RHOEXT_NXT) ];
+
+         delete [] NPar_List;
+         delete [] Heavy_List;
+      }
+#     endif // #if ( defined OPENMP  &&  !defined BITWISE_REPRODUCIBILITY )
+
    } //if ( PrepParOnlyDens || PrepTotalDens )
 #  endif // #ifdef MASSIVE_PARTICLES
 
@@ -733,7 +834,7 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
          real **InputMassPos = NULL;
 
 #        pragma omp for schedule( runtime )
-         for (int t=0; t<ParMass_NPatch; t++)
+         for (int t=0; t<ParMass_NLight; t++)
          {
             PID = ParMass_PID_List[t];
 
@@ -744,55 +845,7 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
 #           endif
 
 //          determine the number of particles and the particle list
-            if ( amr->patch[0][lv][PID]->son == -1  &&  PID < amr->NPatchComma[lv][1] )
-            {
-               NPar            = amr->patch[0][lv][PID]->NPar;
-               ParList         = amr->patch[0][lv][PID]->ParList;
-               UseInputMassPos = false;
-               InputMassPos    = NULL;
-
-#              ifdef DEBUG_PARTICLE
-               if ( amr->patch[0][lv][PID]->NPar_Copy != -1 )
-                  Aux_Error( ERROR_INFO, "lv %d, PID %d, NPar_Copy = %d != -1 !!\n",
-                             lv, PID, amr->patch[0][lv][PID]->NPar_Copy );
-#              endif
-            }
-
-            else
-            {
-//             note that amr->patch[0][lv][PID]->NPar>0 is still possible
-               NPar            = amr->patch[0][lv][PID]->NPar_Copy;
-#              ifdef LOAD_BALANCE
-               ParList         = NULL;
-               UseInputMassPos = true;
-               InputMassPos    = amr->patch[0][lv][PID]->ParAtt_Copy;
-#              else
-               ParList         = amr->patch[0][lv][PID]->ParList_Copy;
-               UseInputMassPos = false;
-               InputMassPos    = NULL;
-#              endif
-            }
-
-#           ifdef DEBUG_PARTICLE
-            if ( NPar <= 0 )
-               Aux_Error( ERROR_INFO, "NPar (%d) <= 0 (lv %d, PID %d) !!\n", NPar, lv, PID );
-
-            else
-            {
-               if ( UseInputMassPos )
-               {
-                  if ( InputMassPos[PAR_MASS] == NULL  ||  InputMassPos[PAR_POSX] == NULL  ||
-                       InputMassPos[PAR_POSY] == NULL  ||  InputMassPos[PAR_POSZ] == NULL  ||
-                       InputMassPos[PAR_TYPE] == NULL )
-                     Aux_Error( ERROR_INFO, "InputMassPos[0/1/2/3/4] == NULL for NPar (%d) > 0 (lv %d, PID %d) !!\n",
-                                NPar, lv, PID );
-               }
-
-               else if ( ParList == NULL )
-                  Aux_Error( ERROR_INFO, "ParList == NULL for NPar (%d) > 0 (lv %d, PID %d) !!\n",
-                             NPar, lv, PID );
-            }
-#           endif // #ifdef DEBUG_PARTICLE
+            ParMass_GetParList( lv, PID, NPar, ParList, UseInputMassPos, InputMassPos );
 
 //          set the left edge of rho_ext[]
             const double RhoExtGhostPhySize = RHOEXT_GHOST_SIZE*dh;
@@ -808,7 +861,60 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
             Par_MassAssignment( ParList, NPar, amr->Par->Interp, amr->patch[0][lv][PID]->rho_ext[0][0], RHOEXT_NXT,
                                 EdgeL, dh, (amr->Par->PredictPos && !UseInputMassPos), PrepTime, InitZero_Yes,
                                 Periodic_No, NULL, UnitDens_No, CheckFarAway_No, UseInputMassPos, InputMassPos );
-         } // for (int t=0; t<ParMass_NPatch; t++)
+         } // for (int t=0; t<ParMass_NLight; t++)
+
+
+//       deposit particle mass of heavy patches with all threads
+//       --> each thread deposits a contiguous chunk of the particle list onto its own tile, and the tiles are then
+//           summed up in a fixed thread order
+//       --> all threads must reach here, which is guaranteed by the implicit barrier of the above **for** construct
+#        if ( defined OPENMP  &&  !defined BITWISE_REPRODUCIBILITY )
+         const int TID = omp_get_thread_num();
+         const int NT  = omp_get_num_threads();
+         real *InputMassPos_Sub[PAR_NATT_TOTAL];
+
+         for (int t=ParMass_NLight; t<ParMass_NPatch; t++)
+         {
+            PID = ParMass_PID_List[t];
+
+#           ifdef DEBUG_PARTICLE
+            if ( amr->patch[0][lv][PID]->rho_ext == NULL  ||
+                 amr->patch[0][lv][PID]->rho_ext[0][0][0] != RHO_EXT_NEED_INIT )
+               Aux_Error( ERROR_INFO, "lv %d, PID %d, rho_ext == NULL (or has been calculated already) !!\n", lv, PID );
+#           endif
+
+            ParMass_GetParList( lv, PID, NPar, ParList, UseInputMassPos, InputMassPos );
+
+            const int p0 = (int)( (long)NPar*TID/NT );
+            const int p1 = (int)( (long)NPar*(TID+1)/NT );
+
+            if ( UseInputMassPos )
+               for (int v=0; v<PAR_NATT_TOTAL; v++)
+                  InputMassPos_Sub[v] = ( InputMassPos[v] == NULL ) ? NULL : InputMassPos[v] + p0;
+
+            const double RhoExtGhostPhySize = RHOEXT_GHOST_SIZE*dh;
+            for (int d=0; d<3; d++)    EdgeL[d] = amr->patch[0][lv][PID]->EdgeL[d] - RhoExtGhostPhySize;
+
+//          same as the deposition of light patches except for depositing onto the thread-private tile
+            Par_MassAssignment( (UseInputMassPos) ? NULL : ParList+p0, p1-p0, amr->Par->Interp, ParMass_Tile[TID],
+                                RHOEXT_NXT, EdgeL, dh, (amr->Par->PredictPos && !UseInputMassPos), PrepTime, InitZero_Yes,
+                                Periodic_No, NULL, UnitDens_No, CheckFarAway_No, UseInputMassPos,
+                                (UseInputMassPos) ? InputMassPos_Sub : NULL );
+
+#           pragma omp barrier
+
+//          sum up the tiles (the implicit barrier also protects the tiles from being overwritten by the next patch)
+            real *RhoExt = amr->patch[0][lv][PID]->rho_ext[0][0];
+
+#           pragma omp for schedule( static )
+            for (int c=0; c<CUBE(RHOEXT_NXT); c++)
+            {
+               real Sum = ParMass_Tile[0][c];
+               for (int s=1; s<NT; s++)   Sum += ParMass_Tile[s][c];
+               RhoExt[c] = Sum;
+            }
+         } // for (int t=ParMass_NLight; t<ParMass_NPatch; t++)
+#        endif // #if ( defined OPENMP  &&  !defined BITWISE_REPRODUCIBILITY )
       } // if ( PrepParOnlyDens || PrepTotalDens )
 #     endif // #ifdef MASSIVE_PARTICLES
 
@@ -832,6 +938,11 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
             Aux_Error( ERROR_INFO, "PID0 (%d) does not have LocalID == 0 !!\n", PID0 );
 #        endif
 
+//       reuse the cached data if available
+         if (  UsePrepCache  &&  PrepCache_Get( lv, PID0, PrepKey, OutputCC+TID*PrepSizeCC, OutputFC+TID*PrepSizeFC,
+                                                PrepSizeCC, PrepSizeFC )  )
+            continue;
+
          for (int d=0; d<3; d++)    xyz0[d] = amr->patch[0][lv][PID0]->EdgeL[d] + (0.5-GhostSize)*dh;
 
 //       Data1PG_CC/FC point to OutputCC/FC directly for PrepUnit == UNIT_PATCHGROUP
@@ -2231,6 +2342,12 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
             } // for (int LocalID=0; LocalID<8; LocalID++)
          } // if ( PrepUnit == UNIT_PATCH )
 
+
+//       f. store the prepared data in the cache
+// ------------------------------------------------------------------------------------------------------------
+         if ( UsePrepCache )
+            PrepCache_Put( lv, PID0, PrepKey, OutputCC+TID*PrepSizeCC, OutputFC+TID*PrepSizeFC, PrepSizeCC, PrepSizeFC );
+
       } // for (int TID=0; TID<NPG; TID++)
 
       if ( PrepUnit == UNIT_PATCH )
@@ -2253,7 +2370,11 @@ void Prepare_PatchData( const int lv, const double PrepTime, real *OutputCC, rea
    for (int s=0; s<26; s++)   delete [] TSib[s];
 
 #  ifdef MASSIVE_PARTICLES
-   if ( PrepParOnlyDens || PrepTotalDens )   delete [] ParMass_PID_List;
+   if ( PrepParOnlyDens || PrepTotalDens )
+   {
+      delete [] ParMass_PID_List;
+      delete [] ParMass_Tile;
+   }
 #  endif
 
 } // FUNCTION : Prepare_PatchData
@@ -3089,6 +3210,82 @@ void Prepare_PatchData_FreeParticleDensityArray( const int lv )
    ParDensArray_Initialized = false;
 
 } // FUNCTION : Prepare_PatchData_FreeParticleDensityArray
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  ParMass_GetParList
+// Description :  Get the particles to be deposited onto rho_ext[] of the target patch
+//
+// Note        :  1. Work for Prepare_PatchData()
+//                2. Real leaf patches use their own particle list, while other patches use the particle copies
+//                   collected by Par_CollectParticle2OneLevel()
+//                   --> Particle attributes are returned via InputMassPos[] instead of ParList[] for buffer
+//                       patches with LOAD_BALANCE
+//
+// Parameter   :  lv              : Target refinement level
+//                PID             : Target patch ID
+//                NPar            : Number of particles
+//                ParList         : Particle list (NULL if UseInputMassPos is on)
+//                UseInputMassPos : Use InputMassPos[] instead of ParList[]
+//                InputMassPos    : Particle attribute arrays (NULL if UseInputMassPos is off)
+//
+// Return      :  NPar, ParList, UseInputMassPos, InputMassPos
+//-------------------------------------------------------------------------------------------------------
+void ParMass_GetParList( const int lv, const int PID, int &NPar, long *&ParList, bool &UseInputMassPos,
+                         real **&InputMassPos )
+{
+
+   if ( amr->patch[0][lv][PID]->son == -1  &&  PID < amr->NPatchComma[lv][1] )
+   {
+      NPar            = amr->patch[0][lv][PID]->NPar;
+      ParList         = amr->patch[0][lv][PID]->ParList;
+      UseInputMassPos = false;
+      InputMassPos    = NULL;
+
+#     ifdef DEBUG_PARTICLE
+      if ( amr->patch[0][lv][PID]->NPar_Copy != -1 )
+         Aux_Error( ERROR_INFO, "lv %d, PID %d, NPar_Copy = %d != -1 !!\n",
+                    lv, PID, amr->patch[0][lv][PID]->NPar_Copy );
+#     endif
+   }
+
+   else
+   {
+//    note that amr->patch[0][lv][PID]->NPar>0 is still possible
+      NPar            = amr->patch[0][lv][PID]->NPar_Copy;
+#     ifdef LOAD_BALANCE
+      ParList         = NULL;
+      UseInputMassPos = true;
+      InputMassPos    = amr->patch[0][lv][PID]->ParAtt_Copy;
+#     else
+      ParList         = amr->patch[0][lv][PID]->ParList_Copy;
+      UseInputMassPos = false;
+      InputMassPos    = NULL;
+#     endif
+   }
+
+#  ifdef DEBUG_PARTICLE
+   if ( NPar <= 0 )
+      Aux_Error( ERROR_INFO, "NPar (%d) <= 0 (lv %d, PID %d) !!\n", NPar, lv, PID );
+
+   else
+   {
+      if ( UseInputMassPos )
+      {
+         if ( InputMassPos[PAR_MASS] == NULL  ||  InputMassPos[PAR_POSX] == NULL  ||
+              InputMassPos[PAR_POSY] == NULL  ||  InputMassPos[PAR_POSZ] == NULL  ||
+              InputMassPos[PAR_TYPE] == NULL )
+            Aux_Error( ERROR_INFO, "InputMassPos[0/1/2/3/4] == NULL for NPar (%d) > 0 (lv %d, PID %d) !!\n",
+                       NPar, lv, PID );
+      }
+
+      else if ( ParList == NULL )
+         Aux_Error( ERROR_INFO, "ParList == NULL for NPar (%d) > 0 (lv %d, PID %d) !!\n",
+                    NPar, lv, PID );
+   }
+#  endif // #ifdef DEBUG_PARTICLE
+
+} // FUNCTION : ParMass_GetParList
 #endif // #ifdef MASSIVE_PARTICLES
 
 
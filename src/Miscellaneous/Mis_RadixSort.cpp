@@ -0,0 +1,244 @@
+#include "GAMER.h"
+
+// threshold of the number of elements for using the insertion sort and for multithreading
+#define RADIX_NINSERT      64
+#define RADIX_NPARALLEL    ( 1 << 16 )
+
+// number of bits in each radix digit
+#define RADIX_NBIT         8
+#define RADIX_NBUCKET      ( 1 << RADIX_NBIT )
+
+
+// order-preserving map between the sorted type and an unsigned integer type of the same size
+template <typename T> struct RadixKey;
+
+template <> struct RadixKey <int>
+{
+   typedef uint Key_t;
+   static inline Key_t Encode( const int   x )  { return (Key_t)x ^ 0x80000000U; }
+   static inline int   Decode( const Key_t k )  { return (int)( k ^ 0x80000000U ); }
+};
+
+template <> struct RadixKey <long>
+{
+   typedef ulong Key_t;
+   static inline Key_t Encode( const long  x )  { return (Key_t)x ^ 0x8000000000000000UL; }
+   static inline long  Decode( const Key_t k )  { return (long)( k ^ 0x8000000000000000UL ); }
+};
+
+template <> struct RadixKey <ulong>
+{
+   typedef ulong Key_t;
+   static inline Key_t Encode( const ulong x )  { return x; }
+   static inline ulong Decode( const Key_t k )  { return k; }
+};
+
+// floating-point numbers: flip all bits of negative numbers and only the sign bit of positive numbers
+template <> struct RadixKey <float>
+{
+   typedef uint Key_t;
+   static inline Key_t Encode( const float x )
+   {
+      Key_t k;
+      memcpy( &k, &x, sizeof(Key_t) );
+      return ( k & 0x80000000U ) ? ~k : k | 0x80000000U;
+   }
+   static inline float Decode( const Key_t k )
+   {
+      const Key_t b = ( k & 0x80000000U ) ? k & 0x7FFFFFFFU : ~k;
+      float x;
+      memcpy( &x, &b, sizeof(Key_t) );
+      return x;
+   }
+};
+
+template <> struct RadixKey <double>
+{
+   typedef ulong Key_t;
+   static inline Key_t  Encode( const double x )
+   {
+      Key_t k;
+      memcpy( &k, &x, sizeof(Key_t) );
+      return ( k & 0x8000000000000000UL ) ? ~k : k | 0x8000000000000000UL;
+   }
+   static inline double Decode( const Key_t k )
+   {
+      const Key_t b = ( k & 0x8000000000000000UL ) ? k & 0x7FFFFFFFFFFFFFFFUL : ~k;
+      double x;
+      memcpy( &x, &b, sizeof(Key_t) );
+      return x;
+   }
+};
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Mis_RadixSort
+// Description :  Use the least-significant-digit radix sort to sort the input array into ascending numerical order
+//                --> An index table will also be constructed if "IdxTable != NULL"
+//
+// Note        :  1. Drop-in replacement of Mis_Heapsort()
+//                   --> But the sort is stable (i.e., equal elements keep their original order), so IdxTable[]
+//                       may differ from that of Mis_Heapsort() for equal elements
+//                2. Floating-point numbers are mapped to unsigned integers by an order-preserving bit transform
+//                   --> NaN is not supported, and -0.0 is placed before +0.0
+//                3. Digits shared by all elements are skipped, which is common for the LB indices
+//                4. Multithreaded when N >= RADIX_NPARALLEL and not invoked inside an OpenMP parallel region
+//                   --> The result does not depend on the number of threads
+//                5. Use the insertion sort when N < RADIX_NINSERT
+//                6. Overloaded with different types
+//                   --> Explicit template instantiation is put in the end of this file
+//
+// Parameter   :  N        :  Size of Array
+//                Array    :  Array to be sorted into ascending numerical order
+//                IdxTable :  Index table
+//-------------------------------------------------------------------------------------------------------
+template <typename T>
+void Mis_RadixSort( const int N, T Array[], int IdxTable[] )
+{
+
+   typedef typename RadixKey<T>::Key_t Key_t;
+
+   const bool RecordIdx = ( IdxTable != NULL );
+
+
+// 1. insertion sort for small arrays
+   if ( N < RADIX_NINSERT )
+   {
+      if ( RecordIdx )
+         for (int t=0; t<N; t++)    IdxTable[t] = t;
+
+      for (int i=1; i<N; i++)
+      {
+         const T   Val = Array[i];
+         const int Idx = ( RecordIdx ) ? IdxTable[i] : -1;
+         int j = i - 1;
+
+         for ( ; j>=0  &&  Array[j] > Val; j--)
+         {
+            Array[j+1] = Array[j];
+            if ( RecordIdx )  IdxTable[j+1] = IdxTable[j];
+         }
+
+         Array[j+1] = Val;
+         if ( RecordIdx )  IdxTable[j+1] = Idx;
+      }
+
+      return;
+   } // if ( N < RADIX_NINSERT )
+
+
+// 2. allocate the double buffers and encode the input array
+#  ifdef OPENMP
+   const int NT = ( N >= RADIX_NPARALLEL  &&  !omp_in_parallel() ) ? omp_get_max_threads() : 1;
+#  else
+   const int NT = 1;
+#  endif
+
+   Key_t *Key_In   = new Key_t [N];
+   Key_t *Key_Out  = new Key_t [N];
+   int   *Idx_In   = ( RecordIdx ) ? new int [N] : NULL;
+   int   *Idx_Out  = ( RecordIdx ) ? new int [N] : NULL;
+   long (*Hist)[RADIX_NBUCKET] = new long [NT][RADIX_NBUCKET];
+
+#  pragma omp parallel for schedule( static ) num_threads( NT )
+   for (int t=0; t<N; t++)
+   {
+      Key_In[t] = RadixKey<T>::Encode( Array[t] );
+      if ( RecordIdx )  Idx_In[t] = t;
+   }
+
+
+// 3. sort one digit at a time from the least significant one
+   const int NPass = ( 8*sizeof(Key_t) + RADIX_NBIT - 1 ) / RADIX_NBIT;
+
+   for (int Pass=0; Pass<NPass; Pass++)
+   {
+      const int Shift = Pass*RADIX_NBIT;
+      bool      Skip  = false;
+
+#     pragma omp parallel num_threads( NT )
+      {
+#        ifdef OPENMP
+         const int TID = omp_get_thread_num();
+#        else
+         const int TID = 0;
+#        endif
+         const int t0  = (int)( (long)N*TID/NT );
+         const int t1  = (int)( (long)N*(TID+1)/NT );
+
+//       3-1. histogram of the contiguous chunk handled by each thread
+         for (int b=0; b<RADIX_NBUCKET; b++)    Hist[TID][b] = 0;
+         for (int t=t0; t<t1; t++)  Hist[TID][ ( Key_In[t] >> Shift ) & ( RADIX_NBUCKET - 1 ) ] ++;
+
+#        pragma omp barrier
+
+//       3-2. convert the histograms to the starting offsets of each bucket in each thread
+//            --> buckets are filled by thread 0, 1, ... in order to keep the sort stable
+#        pragma omp single
+         {
+            long Offset = 0;
+
+            for (int b=0; b<RADIX_NBUCKET; b++)
+            {
+               long Total = 0;
+               for (int s=0; s<NT; s++)   Total += Hist[s][b];
+
+               if ( Total == N )    Skip = true;
+
+               for (int s=0; s<NT; s++)
+               {
+                  const long Count = Hist[s][b];
+                  Hist[s][b] = Offset;
+                  Offset    += Count;
+               }
+            }
+         } // implicit barrier
+
+//       3-3. scatter
+         if ( !Skip )
+         {
+            for (int t=t0; t<t1; t++)
+            {
+               const long Target = Hist[TID][ ( Key_In[t] >> Shift ) & ( RADIX_NBUCKET - 1 ) ] ++;
+
+               Key_Out[Target] = Key_In[t];
+               if ( RecordIdx )  Idx_Out[Target] = Idx_In[t];
+            }
+         }
+      } // OpenMP parallel region
+
+//    skip the passes where all elements have the same digit
+      if ( Skip )    continue;
+
+      Key_t *KeyTmp = Key_In;  Key_In = Key_Out;  Key_Out = KeyTmp;
+      int   *IdxTmp = Idx_In;  Idx_In = Idx_Out;  Idx_Out = IdxTmp;
+   } // for (int Pass=0; Pass<NPass; Pass++)
+
+
+// 4. decode the sorted array
+#  pragma omp parallel for schedule( static ) num_threads( NT )
+   for (int t=0; t<N; t++)
+   {
+      Array[t] = RadixKey<T>::Decode( Key_In[t] );
+      if ( RecordIdx )  IdxTable[t] = Idx_In[t];
+   }
+
+
+   delete [] Key_In;
+   delete [] Key_Out;
+   delete [] Idx_In;
+   delete [] Idx_Out;
+   delete [] Hist;
+
+} // FUNCTION : Mis_RadixSort
+
+
+
+// explicit template instantiation
+template void Mis_RadixSort <int>    ( const int N, int    Array[], int IdxTable[] );
+template void Mis_RadixSort <long>   ( const int N, long   Array[], int IdxTable[] );
+template void Mis_RadixSort <ulong>  ( const int N, ulong  Array[], int IdxTable[] );
+template void Mis_RadixSort <float>  ( const int N, float  Array[], int IdxTable[] );
+template void Mis_RadixSort <double> ( const int N, double Array[], int IdxTable[] );
@@ -0,0 +1,238 @@
+#include "GAMER.h"
+
+
+
+// structure storing the memory blocks of one patch data type
+struct SlabArena_t
+{
+   char **Slab;         // list of slabs
+   int    NSlab;        // number of slabs
+   int    NSlabMax;     // size of Slab[]
+   void **FreeBlock;    // stack of free blocks
+   long   NFree;        // number of free blocks
+   long   NFreeMax;     // size of FreeBlock[]
+};
+
+static SlabArena_t Arena[SLAB_NTYPE] = { { NULL, 0, 0, NULL, 0, 0 } };
+
+static long GetBlockByte( const SlabType_t Type );
+static void AddSlab( const SlabType_t Type );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Mis_SlabAlloc_New
+// Description :  Allocate a memory block for one type of patch data (e.g., fluid[], flux[])
+//
+// Note        :  1. Invoked by the allocation methods of patch_t (e.g., patch_t::hnew())
+//                2. OPT__SLAB_ALLOC == false --> allocate memory by new real [...] directly
+//                                      true  --> take a block from the slabs of the target type
+//                   --> Blocks are cut from contiguous slabs of SLAB_BYTE bytes, which reduces the
+//                       overhead and contention of the system allocator and keeps the data of patches
+//                       allocated consecutively (e.g., patches in the same patch group) close in memory
+//                   --> New slabs are first touched by all OpenMP threads with a static schedule when this
+//                       function is invoked outside a parallel region
+//                       --> Pages are distributed across the NUMA domains of the threads instead of being
+//                           placed entirely on the domain of the master thread
+//                   --> Blocks released by Mis_SlabAlloc_Delete() are recycled in a LIFO order
+//                3. Memory of the slabs is not returned to the system until Mis_SlabAlloc_Free()
+//                4. Thread-safe
+//
+// Parameter   :  Type : Type of the patch data (see SlabType_t)
+//
+// Return      :  Pointer to the allocated memory block
+//-------------------------------------------------------------------------------------------------------
+void *Mis_SlabAlloc_New( const SlabType_t Type )
+{
+
+#  ifdef GAMER_DEBUG
+   if ( Type < 0  ||  Type >= SLAB_NTYPE )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "Type", Type );
+#  endif
+
+   if ( !OPT__SLAB_ALLOC )    return new real [ GetBlockByte(Type)/sizeof(real) ];
+
+
+   void *Block = NULL;
+
+#  pragma omp critical( SlabAlloc )
+   {
+      if ( Arena[Type].NFree == 0 )    AddSlab( Type );
+
+      Block = Arena[Type].FreeBlock[ -- Arena[Type].NFree ];
+   }
+
+   return Block;
+
+} // FUNCTION : Mis_SlabAlloc_New
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Mis_SlabAlloc_Delete
+// Description :  Release a memory block allocated by Mis_SlabAlloc_New()
+//
+// Note        :  1. Do nothing if Ptr == NULL
+//                2. Type must be the same as the one used to allocate Ptr
+//                3. Thread-safe
+//
+// Parameter   :  Type : Type of the patch data (see SlabType_t)
+//                Ptr  : Memory block to be released
+//-------------------------------------------------------------------------------------------------------
+void Mis_SlabAlloc_Delete( const SlabType_t Type, void *Ptr )
+{
+
+   if ( Ptr == NULL )   return;
+
+#  ifdef GAMER_DEBUG
+   if ( Type < 0  ||  Type >= SLAB_NTYPE )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "Type", Type );
+#  endif
+
+   if ( !OPT__SLAB_ALLOC )
+   {
+      delete [] (real*)Ptr;
+      return;
+   }
+
+#  pragma omp critical( SlabAlloc )
+   {
+      SlabArena_t &A = Arena[Type];
+
+//    the free-block stack never overflows since it is sized by the total number of blocks
+#     ifdef GAMER_DEBUG
+      if ( A.NFree >= A.NFreeMax )
+         Aux_Error( ERROR_INFO, "releasing more blocks than allocated (Type %d, NFree %ld) !!\n", Type, A.NFree );
+#     endif
+
+      A.FreeBlock[ A.NFree ++ ] = Ptr;
+   }
+
+} // FUNCTION : Mis_SlabAlloc_Delete
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Mis_SlabAlloc_Free
+// Description :  Free all slabs
+//
+// Note        :  1. Invoked by End_MemFree()
+//                2. All patches must be deallocated in advance
+//-------------------------------------------------------------------------------------------------------
+void Mis_SlabAlloc_Free()
+{
+
+   for (int t=0; t<SLAB_NTYPE; t++)
+   {
+      for (int s=0; s<Arena[t].NSlab; s++)   free( Arena[t].Slab[s] );
+
+      free( Arena[t].Slab );
+      free( Arena[t].FreeBlock );
+
+      Arena[t].Slab      = NULL;
+      Arena[t].NSlab     = 0;
+      Arena[t].NSlabMax  = 0;
+      Arena[t].FreeBlock = NULL;
+      Arena[t].NFree     = 0;
+      Arena[t].NFreeMax  = 0;
+   }
+
+} // FUNCTION : Mis_SlabAlloc_Free
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetBlockByte
+// Description :  Return the size in bytes of one memory block of the target patch data type
+//
+// Note        :  1. Rounded up to a multiple of 64 bytes for slabs so that all blocks are aligned
+//                   to cache lines
+//
+// Parameter   :  Type : Type of the patch data (see SlabType_t)
+//-------------------------------------------------------------------------------------------------------
+long GetBlockByte( const SlabType_t Type )
+{
+
+   long NReal = 0;
+
+   switch ( Type )
+   {
+      case SLAB_FLUID         :  NReal = (long)NCOMP_TOTAL*CUBE(PS1);                  break;
+#     ifdef MHD
+      case SLAB_MAGNETIC      :  NReal = (long)NCOMP_MAG*PS1P1*SQR(PS1);               break;
+      case SLAB_ELECTRIC_FACE :  NReal = (long)NCOMP_ELE*PS1M1*PS1;                    break;
+      case SLAB_ELECTRIC_EDGE :  NReal = (long)PS1;                                    break;
+#     endif
+#     ifdef GRAVITY
+      case SLAB_POT           :  NReal = (long)CUBE(PS1);                              break;
+      case SLAB_POT_EXT       :  NReal = (long)CUBE(GRA_NXT);                          break;
+#     endif
+      case SLAB_FLUX          :  NReal = (long)NFLUX_TOTAL*SQR(PS1);                   break;
+
+      default :
+         Aux_Error( ERROR_INFO, "unsupported slab type %d !!\n", Type );
+   }
+
+   if ( !OPT__SLAB_ALLOC )    return NReal*sizeof(real);
+   else                       return ( NReal*sizeof(real) + 63L )/64L*64L;
+
+} // FUNCTION : GetBlockByte
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  AddSlab
+// Description :  Allocate a new slab for the target patch data type and push all its blocks to the
+//                free-block stack
+//
+// Note        :  1. Not thread-safe --> callers must lock the "SlabAlloc" critical section
+//                2. Blocks are pushed in a reverse order so that they are handed out in the order of
+//                   increasing addresses
+//
+// Parameter   :  Type : Type of the patch data (see SlabType_t)
+//-------------------------------------------------------------------------------------------------------
+void AddSlab( const SlabType_t Type )
+{
+
+   SlabArena_t &A = Arena[Type];
+
+   const long BlockByte = GetBlockByte( Type );
+   const long NBlock    = MAX( 1L, SLAB_BYTE/BlockByte );
+
+
+// 1. allocate the slab
+   void *Ptr = NULL;
+
+   if (  posix_memalign( &Ptr, 64, NBlock*BlockByte ) != 0  )
+      Aux_Error( ERROR_INFO, "failed to allocate a slab of %ld bytes (Type %d) !!\n", NBlock*BlockByte, Type );
+
+   char *Slab = (char*)Ptr;
+
+
+// 2. first touch
+//    --> distribute the pages across the NUMA domains of all OpenMP threads if possible
+#  pragma omp parallel for schedule( static ) if ( !omp_in_parallel() )
+   for (long b=0; b<NBlock; b++)    memset( Slab + b*BlockByte, 0, BlockByte );
+
+
+// 3. record the slab
+   if ( A.NSlab == A.NSlabMax )
+   {
+      A.NSlabMax = MAX( 1, 2*A.NSlabMax );
+      A.Slab     = (char**)realloc( A.Slab, A.NSlabMax*sizeof(char*) );
+   }
+
+   A.Slab[ A.NSlab ++ ] = Slab;
+
+
+// 4. push all blocks to the free-block stack
+   if ( A.NFreeMax < A.NSlab*NBlock )
+   {
+      A.NFreeMax  = A.NSlab*NBlock;
+      A.FreeBlock = (void**)realloc( A.FreeBlock, A.NFreeMax*sizeof(void*) );
+   }
+
+   for (long b=NBlock-1; b>=0; b--)    A.FreeBlock[ A.NFree ++ ] = Slab + b*BlockByte;
+
+} // FUNCTION : AddSlab
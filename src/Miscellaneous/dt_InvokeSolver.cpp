@@ -2,6 +2,10 @@
 
 double dt_min_for_solver;
 
+// maximum CFL speed accumulated by the fluid solver (declared in Flu_AdvanceDt.cpp)
+extern real Flu_FusedMaxCFL_ThisRank[NLEVEL];
+extern bool Flu_FusedMaxCFL_Valid   [NLEVEL];
+
 
 
 
@@ -11,6 +15,12 @@ double dt_min_for_solver;
 //
 // Note        :  1. Invoked by Mis_GetTimeStep()
 //                2. The global variable "dt_min_for_solver" will be set by dt_Close()
+//                3. For OPT__DT_FLU_FUSED, the fluid dt solver is skipped if the maximum CFL speed of lv has
+//                   been accumulated by Flu_Close() during the last fluid update
+//                   --> Corrections applied after Flu_Close() (e.g., flux fix-up, restriction, gravity, and
+//                       source terms) are not taken into account
+//                   --> Fall back to the dt solver if the accumulated value has been invalidated by
+//                       Flu_FusedMaxCFL_Invalidate() (e.g., after grid refinement and load balancing)
 //
 // Parameter   :  TSolver : Target dt solver
 //                          --> DT_FLU_SOLVER, DT_GRA_SOLVER
@@ -26,6 +36,18 @@ double dt_InvokeSolver( const Solver_t TSolver, const int lv )
 
 
 // invoke the target dt solver
+// --> reuse the maximum CFL speed accumulated by the fluid solver if possible
+#  if ( MODEL == HYDRO )
+   if ( TSolver == DT_FLU_SOLVER  &&  OPT__DT_FLU_FUSED  &&  Flu_FusedMaxCFL_Valid[lv] )
+   {
+      const real dhSafety = (real)( (Step==0)?DT__FLUID_INIT:DT__FLUID )*(real)amr->dh[lv];
+      const real MaxCFL   = Flu_FusedMaxCFL_ThisRank[lv];
+
+      if ( MaxCFL > (real)0.0 )  dt_min_for_solver = (double)( dhSafety/MaxCFL );
+   }
+
+   else
+#  endif
    InvokeSolver( TSolver, lv, Time[lv], NULL_REAL, NULL_REAL, NULL_REAL, NULL_INT, NULL_INT, NULL_INT, false, false );
 
 
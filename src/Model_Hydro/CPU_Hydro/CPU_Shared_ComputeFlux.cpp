@@ -56,6 +56,15 @@ void Hydro_RiemannSolver_HLLD( const int XYZ, real Flux_Out[], const real L_In[]
 #endif // #ifdef __CUDACC__ ... else ...
 
 
+// internal functions (GPU_DEVICE is defined in CUFLU.h)
+GPU_DEVICE
+static void Hydro_InvokeRiemannSolver( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[],
+                                       const real MinDens, const real MinPres, const EoS_t *EoS );
+GPU_DEVICE
+static void Hydro_StoreIntFlux( const int XYZ, const int i_flux, const int j_flux, const int k_flux,
+                                const real Flux[], real g_IntFlux[][NCOMP_TOTAL][ SQR(PS2) ] );
+
+
 
 
 //-------------------------------------------------------------------------------------------------------
@@ -78,6 +87,13 @@ void Hydro_RiemannSolver_HLLD( const int XYZ, real Flux_Out[], const real L_In[]
 //                   --> Option "DumpIntFlux"
 //                6. For the unsplitting scheme in gravity (i.e., UNSPLIT_GRAVITY), this function also corrects the half-step
 //                   velocity by gravity when CorrHalfVel==true
+//                7. The CPU version walks the faces row by row along x and loads/stores the variables directly
+//                   in the frame rotated to the target direction
+//                   --> Avoid the integer division and modulo operations in CGPU_LOOP and the calls to Hydro_Rotate3D()
+//                       in the Riemann solvers
+//                   --> Produce the same fluxes as the GPU version up to round-off errors, which only arise from
+//                       the kinetic energy summed in a different order in the exact solver and in the half-step
+//                       velocity correction of UNSPLIT_GRAVITY
 //
 // Parameter   :  g_FC_Var        : Array storing the input face-centered conserved variables
 //                g_FC_Flux       : Array to store the output face-centered fluxes
@@ -136,8 +152,6 @@ void Hydro_ComputeFlux( const real g_FC_Var [][NCOMP_TOTAL_PLUS_MAG][ CUBE(N_FC_
 
    const int didx_fc[3] = { 1, N_FC_VAR, N_FC_VAR*N_FC_VAR };
 
-   real ConVar_L[NCOMP_TOTAL_PLUS_MAG], ConVar_R[NCOMP_TOTAL_PLUS_MAG], Flux_1Face[NCOMP_TOTAL_PLUS_MAG];
-
 #  ifdef UNSPLIT_GRAVITY
    const real   GraConst    = -(real)0.5*dt/dh;
    const int    didx_usg[3] = { 1, USG_NXT_F, SQR(USG_NXT_F) };
@@ -203,6 +217,7 @@ void Hydro_ComputeFlux( const real g_FC_Var [][NCOMP_TOTAL_PLUS_MAG][ CUBE(N_FC_
                   break;
       }
 
+#     ifdef __CUDACC__
       const int size_ij = idx_flux_e[0]*idx_flux_e[1];
       CGPU_LOOP( idx, idx_flux_e[0]*idx_flux_e[1]*idx_flux_e[2] )
       {
@@ -216,6 +231,8 @@ void Hydro_ComputeFlux( const real g_FC_Var [][NCOMP_TOTAL_PLUS_MAG][ CUBE(N_FC_
          const int k_fc     = k_flux + idx_fc_s[2];
          const int idx_fc   = IDX321( i_fc, j_fc, k_fc, N_FC_VAR, N_FC_VAR );
 
+         real ConVar_L[NCOMP_TOTAL_PLUS_MAG], ConVar_R[NCOMP_TOTAL_PLUS_MAG], Flux_1Face[NCOMP_TOTAL_PLUS_MAG];
+
          for (int v=0; v<NCOMP_TOTAL_PLUS_MAG; v++)
          {
             ConVar_L[v] = g_FC_Var[faceR][v][ idx_fc            ];
@@ -276,29 +293,7 @@ void Hydro_ComputeFlux( const real g_FC_Var [][NCOMP_TOTAL_PLUS_MAG][ CUBE(N_FC_
 
 
 //       2. invoke Riemann solver
-#        if   ( RSOLVER == EXACT  &&  !defined MHD )
-         Hydro_RiemannSolver_Exact( d, Flux_1Face, ConVar_L, ConVar_R, MinDens, MinPres,
-                                    EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
-                                    EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
-#        elif ( RSOLVER == ROE )
-         Hydro_RiemannSolver_Roe  ( d, Flux_1Face, ConVar_L, ConVar_R, MinDens, MinPres,
-                                    EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
-                                    EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
-#        elif ( RSOLVER == HLLE )
-         Hydro_RiemannSolver_HLLE ( d, Flux_1Face, ConVar_L, ConVar_R, MinDens, MinPres,
-                                    EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
-                                    EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
-#        elif ( RSOLVER == HLLC  &&  !defined MHD )
-         Hydro_RiemannSolver_HLLC ( d, Flux_1Face, ConVar_L, ConVar_R, MinDens, MinPres,
-                                    EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
-                                    EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
-#        elif ( RSOLVER == HLLD  &&  defined MHD )
-         Hydro_RiemannSolver_HLLD ( d, Flux_1Face, ConVar_L, ConVar_R, MinDens, MinPres,
-                                    EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
-                                    EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
-#        else
-#        error : ERROR : unsupported Riemann solver (EXACT/ROE/HLLE/HLLC/HLLD) !!
-#        endif
+         Hydro_InvokeRiemannSolver( d, Flux_1Face, ConVar_L, ConVar_R, MinDens, MinPres, EoS );
 
 
 //       3. store the fluxes of all cells in g_FC_Flux[]
@@ -307,63 +302,126 @@ void Hydro_ComputeFlux( const real g_FC_Var [][NCOMP_TOTAL_PLUS_MAG][ CUBE(N_FC_
 
 
 //       4. store the inter-patch fluxes in g_IntFlux[]
-//       --> no need to store the magnetic components since this array is only for the flux fix-up operation
          if ( DumpIntFlux )
+            Hydro_StoreIntFlux( d, i_flux, j_flux, k_flux, Flux_1Face, g_IntFlux );
+      } // i,j,k
+
+
+#     else // #ifdef __CUDACC__
+
+
+//    rotate the input and output variables by permuting the loaded and stored components directly
+//    --> the Riemann solver can be invoked with XYZ=0 and skip Hydro_Rotate3D()
+//    --> idx_rot[v]: component in g_FC_Var[] and g_FC_Flux[] corresponding to the v-th component in the rotated frame
+      int idx_rot[NCOMP_TOTAL_PLUS_MAG];
+
+      for (int v=0; v<NCOMP_TOTAL_PLUS_MAG; v++)   idx_rot[v] = v;
+      for (int t=0; t<3; t++)
+      {
+         idx_rot[ 1 + t ] = 1 + (t+d)%3;
+#        ifdef MHD
+         idx_rot[ MAG_OFFSET + t ] = MAG_OFFSET + (t+d)%3;
+#        endif
+      }
+
+//    walk the faces row by row along x to avoid the integer division and modulo operations in CGPU_LOOP
+      for (int k_flux=0; k_flux<idx_flux_e[2]; k_flux++)
+      for (int j_flux=0; j_flux<idx_flux_e[1]; j_flux++)
+      {
+         const int j_fc         = j_flux + idx_fc_s[1];
+         const int k_fc         = k_flux + idx_fc_s[2];
+         const int idx_flux_row = IDX321( 0,           j_flux, k_flux, NFlux,    NFlux    );
+         const int idx_fc_row   = IDX321( idx_fc_s[0], j_fc,   k_fc,   N_FC_VAR, N_FC_VAR );
+
+         for (int i_flux=0; i_flux<idx_flux_e[0]; i_flux++)
          {
-            int int_face, int_idx;
+            const int idx_flux = idx_flux_row + i_flux;
+            const int idx_fc   = idx_fc_row   + i_flux;
+
+            real ConVar_L[NCOMP_TOTAL_PLUS_MAG], ConVar_R[NCOMP_TOTAL_PLUS_MAG];
+            real Flux_Rot[NCOMP_TOTAL_PLUS_MAG], Flux_1Face[NCOMP_TOTAL_PLUS_MAG];
 
-//          we have assumed N_FC_VAR=PS2+2 for pure hydro
-//          --> for MHD, one additional flux is evaluated along each transverse direction for computing the CT electric field
-//          --> must exclude it when storing the inter-patch fluxes
-            if (  d == 0  &&  ( i_flux == 0 || i_flux == PS1 || i_flux == PS2 )  )
+            for (int v=0; v<NCOMP_TOTAL_PLUS_MAG; v++)
             {
-#              ifdef MHD
-               if ( j_flux > 0  &&  j_flux < PS2+1  &&  k_flux > 0  &&  k_flux < PS2+1 )
-#              endif
-               {
-                  int_face = i_flux/PS1;
-#                 ifdef MHD
-                  int_idx  = (k_flux-1)*PS2 + j_flux-1;
-#                 else
-                  int_idx  = (k_flux  )*PS2 + j_flux;
-#                 endif
-                  for (int v=0; v<NCOMP_TOTAL; v++)   g_IntFlux[int_face][v][int_idx] = Flux_1Face[v];
-               }
+               ConVar_L[v] = g_FC_Var[faceR][ idx_rot[v] ][ idx_fc            ];
+               ConVar_R[v] = g_FC_Var[faceL][ idx_rot[v] ][ idx_fc+didx_fc[d] ];
             }
 
-            else if (  d == 1  &&  ( j_flux == 0 || j_flux == PS1 || j_flux == PS2 )  )
+
+//          1. correct the half-step velocity by gravity
+//          --> velocity is stored in the rotated frame here
+#           ifdef UNSPLIT_GRAVITY
+            if ( CorrHalfVel )
             {
-#              ifdef MHD
-               if ( i_flux > 0  &&  i_flux < PS2+1  &&  k_flux > 0  &&  k_flux < PS2+1 )
-#              endif
+               const int i_fc = i_flux + idx_fc_s[0];
+               real Acc[3] = { (real)0.0, (real)0.0, (real)0.0 };
+               real Enki_L, Enki_R;
+
+//             external acceleration
+               if ( ExtAcc )
                {
-                  int_face = j_flux/PS1 + 3;
-#                 ifdef MHD
-                  int_idx  = (k_flux-1)*PS2 + i_flux-1;
-#                 else
-                  int_idx  = (k_flux  )*PS2 + i_flux;
-#                 endif
-                  for (int v=0; v<NCOMP_TOTAL; v++)   g_IntFlux[int_face][v][int_idx] = Flux_1Face[v];
+                  double xyz[3]; // face-centered coordinates
+
+                  xyz[0]  = CrShift[0] + (double)(i_fc*dh);
+                  xyz[1]  = CrShift[1] + (double)(j_fc*dh);
+                  xyz[2]  = CrShift[2] + (double)(k_fc*dh);
+                  xyz[d] += dh_half;
+
+                  ExtAcc_Func( Acc, xyz[0], xyz[1], xyz[2], Time, ExtAcc_AuxArray );
+
+                  for (int t=0; t<3; t++)    Acc[t] *= dt_half;
                }
-            }
 
-            else if (  d == 2  &&  ( k_flux == 0 || k_flux == PS1 || k_flux == PS2 )  )
-            {
-#              ifdef MHD
-               if ( i_flux > 0  &&  i_flux < PS2+1  &&  j_flux > 0  &&  j_flux < PS2+1 )
-#              endif
+//             self-gravity and external potential
+               if ( UsePot )
                {
-                  int_face = k_flux/PS1 + 6;
-#                 ifdef MHD
-                  int_idx  = (j_flux-1)*PS2 + i_flux-1;
-#                 else
-                  int_idx  = (j_flux  )*PS2 + i_flux;
-#                 endif
-                  for (int v=0; v<NCOMP_TOTAL; v++)   g_IntFlux[int_face][v][int_idx] = Flux_1Face[v];
+                  const int idx_usg = IDX321( i_fc+idx_fc2usg, j_fc+idx_fc2usg, k_fc+idx_fc2usg, USG_NXT_F, USG_NXT_F );
+
+                  Acc[d1] +=            GraConst*( g_Pot_USG[ idx_usg+didx_usg[d1] ] - g_Pot_USG[ idx_usg                           ] );
+                  Acc[d2] += (real)0.25*GraConst*( g_Pot_USG[ idx_usg+didx_usg[d2] ] + g_Pot_USG[ idx_usg+didx_usg[d2]+didx_usg[d1] ]
+                                                  -g_Pot_USG[ idx_usg-didx_usg[d2] ] - g_Pot_USG[ idx_usg-didx_usg[d2]+didx_usg[d1] ] );
+                  Acc[d3] += (real)0.25*GraConst*( g_Pot_USG[ idx_usg+didx_usg[d3] ] + g_Pot_USG[ idx_usg+didx_usg[d3]+didx_usg[d1] ]
+                                                  -g_Pot_USG[ idx_usg-didx_usg[d3] ] - g_Pot_USG[ idx_usg-didx_usg[d3]+didx_usg[d1] ] );
+               }
+
+//             store the "non"-kinetic energy (i.e. total energy - kinetic energy)
+               Enki_L = ConVar_L[4] - (real)0.5*( SQR(ConVar_L[1]) + SQR(ConVar_L[2]) + SQR(ConVar_L[3]) )/ConVar_L[0];
+               Enki_R = ConVar_R[4] - (real)0.5*( SQR(ConVar_R[1]) + SQR(ConVar_R[2]) + SQR(ConVar_R[3]) )/ConVar_R[0];
+
+//             advance velocity by gravity
+               for (int t=0; t<3; t++)
+               {
+                  ConVar_L[t+1] += ConVar_L[0]*Acc[ idx_rot[t+1]-1 ];
+                  ConVar_R[t+1] += ConVar_R[0]*Acc[ idx_rot[t+1]-1 ];
                }
+
+//             update total energy density with the non-kinetic energy fixed
+               ConVar_L[4] = Enki_L + (real)0.5*( SQR(ConVar_L[1]) + SQR(ConVar_L[2]) + SQR(ConVar_L[3]) )/ConVar_L[0];
+               ConVar_R[4] = Enki_R + (real)0.5*( SQR(ConVar_R[1]) + SQR(ConVar_R[2]) + SQR(ConVar_R[3]) )/ConVar_R[0];
+            } // if ( CorrHalfVel )
+#           endif // #ifdef UNSPLIT_GRAVITY
+
+
+//          2. invoke Riemann solver in the rotated frame
+            Hydro_InvokeRiemannSolver( 0, Flux_Rot, ConVar_L, ConVar_R, MinDens, MinPres, EoS );
+
+
+//          3. store the fluxes of all cells in g_FC_Flux[]
+//          --> including the magnetic components since they are required for CT
+            for (int v=0; v<NCOMP_TOTAL_PLUS_MAG; v++)
+            {
+               Flux_1Face[ idx_rot[v] ] = Flux_Rot[v];
+               g_FC_Flux[d][ idx_rot[v] ][idx_flux] = Flux_Rot[v];
             }
-         } // if ( DumpIntFlux )
-      } // i,j,k
+
+
+//          4. store the inter-patch fluxes in g_IntFlux[]
+            if ( DumpIntFlux )
+               Hydro_StoreIntFlux( d, i_flux, j_flux, k_flux, Flux_1Face, g_IntFlux );
+         } // for (int i_flux=0; i_flux<idx_flux_e[0]; i_flux++)
+      } // j,k
+
+#     endif // #ifdef __CUDACC__ ... else ...
    } // for (int d=0; d<3; d++)
 
 
@@ -375,6 +433,126 @@ void Hydro_ComputeFlux( const real g_FC_Var [][NCOMP_TOTAL_PLUS_MAG][ CUBE(N_FC_
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Hydro_InvokeRiemannSolver
+// Description :  Invoke the Riemann solver selected by RSOLVER for a single face
+//
+// Note        :  1. Invoked by Hydro_ComputeFlux()
+//
+// Parameter   :  XYZ          : Target spatial direction : (0/1/2) --> (x/y/z)
+//                Flux_Out     : Array to store the output flux
+//                L/R_In       : Input left/right states (conserved variables)
+//                MinDens/Pres : Density and pressure floors
+//                EoS          : EoS object
+//-------------------------------------------------------------------------------------------------------
+GPU_DEVICE
+void Hydro_InvokeRiemannSolver( const int XYZ, real Flux_Out[], const real L_In[], const real R_In[],
+                                const real MinDens, const real MinPres, const EoS_t *EoS )
+{
+
+#  if   ( RSOLVER == EXACT  &&  !defined MHD )
+   Hydro_RiemannSolver_Exact( XYZ, Flux_Out, L_In, R_In, MinDens, MinPres,
+                              EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
+                              EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
+#  elif ( RSOLVER == ROE )
+   Hydro_RiemannSolver_Roe  ( XYZ, Flux_Out, L_In, R_In, MinDens, MinPres,
+                              EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
+                              EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
+#  elif ( RSOLVER == HLLE )
+   Hydro_RiemannSolver_HLLE ( XYZ, Flux_Out, L_In, R_In, MinDens, MinPres,
+                              EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
+                              EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
+#  elif ( RSOLVER == HLLC  &&  !defined MHD )
+   Hydro_RiemannSolver_HLLC ( XYZ, Flux_Out, L_In, R_In, MinDens, MinPres,
+                              EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
+                              EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
+#  elif ( RSOLVER == HLLD  &&  defined MHD )
+   Hydro_RiemannSolver_HLLD ( XYZ, Flux_Out, L_In, R_In, MinDens, MinPres,
+                              EoS->DensEint2Pres_FuncPtr, EoS->DensPres2CSqr_FuncPtr,
+                              EoS->AuxArrayDevPtr_Flt, EoS->AuxArrayDevPtr_Int, EoS->Table );
+#  else
+#  error : ERROR : unsupported Riemann solver (EXACT/ROE/HLLE/HLLC/HLLD) !!
+#  endif
+
+} // FUNCTION : Hydro_InvokeRiemannSolver
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Hydro_StoreIntFlux
+// Description :  Store the inter-patch fluxes of a single face in g_IntFlux[]
+//
+// Note        :  1. Invoked by Hydro_ComputeFlux()
+//                2. Do nothing if the target face is not on a patch boundary
+//                3. No need to store the magnetic components since g_IntFlux[] is only for the flux fix-up operation
+//
+// Parameter   :  XYZ       : Target spatial direction : (0/1/2) --> (x/y/z)
+//                i/j/k_flux: Flux indices of the target face (see Hydro_ComputeFlux())
+//                Flux      : Array storing the flux of the target face
+//                g_IntFlux : Array to store the inter-patch fluxes
+//-------------------------------------------------------------------------------------------------------
+GPU_DEVICE
+void Hydro_StoreIntFlux( const int XYZ, const int i_flux, const int j_flux, const int k_flux,
+                         const real Flux[], real g_IntFlux[][NCOMP_TOTAL][ SQR(PS2) ] )
+{
+
+   int int_face, int_idx;
+
+// we have assumed N_FC_VAR=PS2+2 for pure hydro
+// --> for MHD, one additional flux is evaluated along each transverse direction for computing the CT electric field
+// --> must exclude it when storing the inter-patch fluxes
+   if (  XYZ == 0  &&  ( i_flux == 0 || i_flux == PS1 || i_flux == PS2 )  )
+   {
+#     ifdef MHD
+      if ( j_flux > 0  &&  j_flux < PS2+1  &&  k_flux > 0  &&  k_flux < PS2+1 )
+#     endif
+      {
+         int_face = i_flux/PS1;
+#        ifdef MHD
+         int_idx  = (k_flux-1)*PS2 + j_flux-1;
+#        else
+         int_idx  = (k_flux  )*PS2 + j_flux;
+#        endif
+         for (int v=0; v<NCOMP_TOTAL; v++)   g_IntFlux[int_face][v][int_idx] = Flux[v];
+      }
+   }
+
+   else if (  XYZ == 1  &&  ( j_flux == 0 || j_flux == PS1 || j_flux == PS2 )  )
+   {
+#     ifdef MHD
+      if ( i_flux > 0  &&  i_flux < PS2+1  &&  k_flux > 0  &&  k_flux < PS2+1 )
+#     endif
+      {
+         int_face = j_flux/PS1 + 3;
+#        ifdef MHD
+         int_idx  = (k_flux-1)*PS2 + i_flux-1;
+#        else
+         int_idx  = (k_flux  )*PS2 + i_flux;
+#        endif
+         for (int v=0; v<NCOMP_TOTAL; v++)   g_IntFlux[int_face][v][int_idx] = Flux[v];
+      }
+   }
+
+   else if (  XYZ == 2  &&  ( k_flux == 0 || k_flux == PS1 || k_flux == PS2 )  )
+   {
+#     ifdef MHD
+      if ( i_flux > 0  &&  i_flux < PS2+1  &&  j_flux > 0  &&  j_flux < PS2+1 )
+#     endif
+      {
+         int_face = k_flux/PS1 + 6;
+#        ifdef MHD
+         int_idx  = (j_flux-1)*PS2 + i_flux-1;
+#        else
+         int_idx  = (j_flux  )*PS2 + i_flux;
+#        endif
+         for (int v=0; v<NCOMP_TOTAL; v++)   g_IntFlux[int_face][v][int_idx] = Flux[v];
+      }
+   }
+
+} // FUNCTION : Hydro_StoreIntFlux
+
+
+
 #endif // #if ( MODEL == HYDRO  &&  (FLU_SCHEME == MHM || FLU_SCHEME == MHM_RP || FLU_SCHEME == CTU) )
 
 
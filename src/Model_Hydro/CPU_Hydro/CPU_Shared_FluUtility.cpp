@@ -199,7 +199,7 @@ void Hydro_Con2Pri( const real In[], real Out[], const real MinPres,
 
 //    recompute internal energy to be consistent with the updated pressure
       if ( EintOut != NULL  &&  Out[4] != Pres0 )
-         *EintOut = EoS_DensPres2Eint( Out[0], Out[4], In+NCOMP_FLUID, EoS_AuxArray_Flt, EoS_AuxArray_Int, EoS_Table );
+         *EintOut = EOS_FUNC( EoS_DensPres2Eint )( Out[0], Out[4], In+NCOMP_FLUID, EoS_AuxArray_Flt, EoS_AuxArray_Int, EoS_Table );
    }
 
 
@@ -284,8 +284,8 @@ void Hydro_Pri2Con( const real In[], real Out[], const bool FracPassive, const i
    const real Bz = In[ MAG_OFFSET + 2 ];
    Emag   = (real)0.5*( SQR(Bx) + SQR(By) + SQR(Bz) );
 #  endif
-   Eint   = ( EintIn == NULL ) ? EoS_DensPres2Eint( In[0], In[4], Out+NCOMP_FLUID, EoS_AuxArray_Flt,
-                                                    EoS_AuxArray_Int, EoS_Table )
+   Eint   = ( EintIn == NULL ) ? EOS_FUNC( EoS_DensPres2Eint )( In[0], In[4], Out+NCOMP_FLUID, EoS_AuxArray_Flt,
+                                                                  EoS_AuxArray_Int, EoS_Table )
                                : *EintIn;
    Out[4] = Hydro_ConEint2Etot( Out[0], Out[1], Out[2], Out[3], Eint, Emag );
 
@@ -795,7 +795,7 @@ real Hydro_Con2Pres( const real Dens, const real MomX, const real MomY, const re
    real Eint, Pres;
 
    Eint = Hydro_Con2Eint( Dens, MomX, MomY, MomZ, Engy, CheckMinEint_No, NULL_REAL, Emag );
-   Pres = EoS_DensEint2Pres( Dens, Eint, Passive, EoS_AuxArray_Flt, EoS_AuxArray_Int, EoS_Table );
+   Pres = EOS_FUNC( EoS_DensEint2Pres )( Dens, Eint, Passive, EoS_AuxArray_Flt, EoS_AuxArray_Int, EoS_Table );
 
    if ( CheckMinPres )   Pres = Hydro_CheckMinPres( Pres, MinPres );
 
@@ -999,6 +999,93 @@ real Hydro_Con2Entr( const real Dens, const real MomX, const real MomY, const re
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Hydro_GetMaxCFL
+// Description :  Evaluate the maximum information propagating speed among all three directions in one cell
+//
+// Note        :  1. Hydro: bulk velocity + sound wave
+//                   MHD  : bulk velocity +  fast wave
+//                2. Invoked by CPU/CUFLU_dtSolver_HydroCFL() and Flu_Close()
+//
+// Parameter   :  Fluid             : Input conserved variables (including passive scalars)
+//                B                 : Input cell-centered magnetic field (for MHD only)
+//                MinPres           : Minimum allowed pressure
+//                EoS_DensEint2Pres : EoS routine to compute the gas pressure
+//                EoS_DensPres2CSqr : EoS routine to compute the sound speed squared
+//                EoS_AuxArray_*    : Auxiliary arrays for the EoS routines
+//                EoS_Table         : EoS tables
+//
+// Return      :  Maximum CFL speed
+//-------------------------------------------------------------------------------------------------------
+GPU_DEVICE
+real Hydro_GetMaxCFL( const real Fluid[], const real B[], const real MinPres,
+                      const EoS_DE2P_t EoS_DensEint2Pres, const EoS_DP2C_t EoS_DensPres2CSqr,
+                      const double EoS_AuxArray_Flt[], const int EoS_AuxArray_Int[],
+                      const real *const EoS_Table[EOS_NTABLE_MAX] )
+{
+
+   const bool CheckMinPres_Yes = true;
+
+   real _Rho, Vx, Vy, Vz, Pres, Emag, a2, CFLx, CFLy, CFLz, MaxCFL;
+#  ifdef MHD
+   real Bx2, By2, Bz2, B2, Ca2_plus_a2, Ca2_min_a2, Ca2_min_a2_sqr, four_a2_over_Rho;
+#  endif
+
+#  ifdef MHD
+   Bx2  = SQR( B[MAGX] );
+   By2  = SQR( B[MAGY] );
+   Bz2  = SQR( B[MAGZ] );
+   B2   = Bx2 + By2 + Bz2;
+   Emag = (real)0.5*B2;
+#  else
+   Emag = NULL_REAL;
+#  endif
+
+  _Rho  = (real)1.0 / Fluid[DENS];
+   Vx   = FABS( Fluid[MOMX] )*_Rho;
+   Vy   = FABS( Fluid[MOMY] )*_Rho;
+   Vz   = FABS( Fluid[MOMZ] )*_Rho;
+   Pres = Hydro_Con2Pres( Fluid[DENS], Fluid[MOMX], Fluid[MOMY], Fluid[MOMZ], Fluid[ENGY], Fluid+NCOMP_FLUID,
+                          CheckMinPres_Yes, MinPres, Emag,
+                          EoS_DensEint2Pres, EoS_AuxArray_Flt, EoS_AuxArray_Int, EoS_Table, NULL );
+   a2   = EOS_FUNC( EoS_DensPres2CSqr )( Fluid[DENS], Pres, Fluid+NCOMP_FLUID, EoS_AuxArray_Flt, EoS_AuxArray_Int,
+                                           EoS_Table ); // sound speed squared
+
+// compute the maximum information propagating speed
+#  ifdef MHD
+   Ca2_plus_a2      = B2*_Rho + a2;
+   Ca2_min_a2       = B2*_Rho - a2;
+   Ca2_min_a2_sqr   = SQR( Ca2_min_a2 );
+   four_a2_over_Rho = (real)4.0*a2*_Rho;
+   CFLx             = (real)0.5*(  Ca2_plus_a2 + SQRT( Ca2_min_a2_sqr + four_a2_over_Rho*(By2+Bz2) )  );
+   CFLy             = (real)0.5*(  Ca2_plus_a2 + SQRT( Ca2_min_a2_sqr + four_a2_over_Rho*(Bx2+Bz2) )  );
+   CFLz             = (real)0.5*(  Ca2_plus_a2 + SQRT( Ca2_min_a2_sqr + four_a2_over_Rho*(Bx2+By2) )  );
+   CFLx             = SQRT( CFLx );
+   CFLy             = SQRT( CFLy );
+   CFLz             = SQRT( CFLz );
+#  else
+   CFLx             = SQRT( a2 );
+   CFLy             = CFLx;
+   CFLz             = CFLx;
+#  endif // #ifdef MHD ... else ...
+
+   CFLx += Vx;
+   CFLy += Vy;
+   CFLz += Vz;
+
+#  if   ( FLU_SCHEME == RTVD  ||  FLU_SCHEME == MHM  ||  FLU_SCHEME == MHM_RP  ||  FLU_SCHEME == CTU )
+   MaxCFL = FMAX( CFLx, CFLy );
+   MaxCFL = FMAX( CFLz, MaxCFL );
+#  else
+#  error : ERROR : unsupported FLU_SCHEME !!
+#  endif
+
+   return MaxCFL;
+
+} // FUNCTION : Hydro_GetMaxCFL
+
+
+
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Hydro_NormalizePassive
 // Description :  Normalize the target passive scalars so that the sum of their mass density is equal to
@@ -62,8 +62,7 @@ void CPU_dtSolver_HydroCFL  ( real g_dt_Array[], const real g_Flu_Array[][FLU_NI
 #endif
 {
 
-   const bool CheckMinPres_Yes = true;
-   const real dhSafety         = Safety*dh;
+   const real dhSafety = Safety*dh;
 
 // loop over all patches
 // --> CPU/GPU solver: use different (OpenMP threads) / (CUDA thread blocks)
@@ -79,75 +78,23 @@ void CPU_dtSolver_HydroCFL  ( real g_dt_Array[], const real g_Flu_Array[][FLU_NI
 
       CGPU_LOOP( t, CUBE(PS1) )
       {
-         real fluid[FLU_NIN_T], _Rho, Vx, Vy, Vz, Pres, Emag, a2, CFLx, CFLy, CFLz;
-#        ifdef MHD
-         int  i, j, k;
-         real B[3], Bx2, By2, Bz2, B2, Ca2_plus_a2, Ca2_min_a2, Ca2_min_a2_sqr, four_a2_over_Rho;
-#        endif
+         real fluid[FLU_NIN_T], B[3];
 
          for (int v=0; v<FLU_NIN_T; v++)  fluid[v] = g_Flu_Array[p][v][t];
 
 #        ifdef MHD
-         i    = t % PS1;
-         j    = t % SQR(PS1) / PS1;
-         k    = t / SQR(PS1);
+         const int i = t % PS1;
+         const int j = t % SQR(PS1) / PS1;
+         const int k = t / SQR(PS1);
 
          MHD_GetCellCenteredBField( B, g_Mag_Array[p][MAGX], g_Mag_Array[p][MAGY], g_Mag_Array[p][MAGZ], PS1, PS1, PS1, i, j, k );
-
-         Bx2  = SQR( B[MAGX] );
-         By2  = SQR( B[MAGY] );
-         Bz2  = SQR( B[MAGZ] );
-         B2   = Bx2 + By2 + Bz2;
-         Emag = (real)0.5*B2;
-#        else
-         Emag = NULL_REAL;
 #        endif
 
-        _Rho   = (real)1.0 / fluid[DENS];
-         Vx    = FABS( fluid[MOMX] )*_Rho;
-         Vy    = FABS( fluid[MOMY] )*_Rho;
-         Vz    = FABS( fluid[MOMZ] )*_Rho;
-         Pres  = Hydro_Con2Pres( fluid[DENS], fluid[MOMX], fluid[MOMY], fluid[MOMZ], fluid[ENGY], fluid+NCOMP_FLUID,
-                                 CheckMinPres_Yes, MinPres, Emag,
-                                 EoS.DensEint2Pres_FuncPtr, EoS.AuxArrayDevPtr_Flt, EoS.AuxArrayDevPtr_Int, EoS.Table, NULL );
-         a2    = EoS.DensPres2CSqr_FuncPtr( fluid[DENS], Pres, fluid+NCOMP_FLUID, EoS.AuxArrayDevPtr_Flt, EoS.AuxArrayDevPtr_Int,
-                                            EoS.Table ); // sound speed squared
-
 //       compute the maximum information propagating speed
-//       --> hydro: bulk velocity + sound wave
-//           MHD  : bulk velocity +  fast wave
-#        ifdef MHD
-         Ca2_plus_a2      = B2*_Rho + a2;
-         Ca2_min_a2       = B2*_Rho - a2;
-         Ca2_min_a2_sqr   = SQR( Ca2_min_a2 );
-         four_a2_over_Rho = (real)4.0*a2*_Rho;
-         CFLx             = (real)0.5*(  Ca2_plus_a2 + SQRT( Ca2_min_a2_sqr + four_a2_over_Rho*(By2+Bz2) )  );
-         CFLy             = (real)0.5*(  Ca2_plus_a2 + SQRT( Ca2_min_a2_sqr + four_a2_over_Rho*(Bx2+Bz2) )  );
-         CFLz             = (real)0.5*(  Ca2_plus_a2 + SQRT( Ca2_min_a2_sqr + four_a2_over_Rho*(Bx2+By2) )  );
-         CFLx             = SQRT( CFLx );
-         CFLy             = SQRT( CFLy );
-         CFLz             = SQRT( CFLz );
-#        else
-         CFLx             = SQRT( a2 );
-         CFLy             = CFLx;
-         CFLz             = CFLx;
-#        endif // #ifdef MHD ... else ...
-
-         CFLx += Vx;
-         CFLy += Vy;
-         CFLz += Vz;
-
-#        if   ( FLU_SCHEME == RTVD  ||  FLU_SCHEME == MHM  ||  FLU_SCHEME == MHM_RP  ||  FLU_SCHEME == CTU )
-         MaxCFL = FMAX( CFLx, MaxCFL );
-         MaxCFL = FMAX( CFLy, MaxCFL );
-         MaxCFL = FMAX( CFLz, MaxCFL );
-#        else
-#        error : ERROR : unsupported FLU_SCHEME !!
-         /*
-//       no longer used
-         MaxCFL = FMAX( CFLx+CFLy+CFLz, MaxCFL );
-         */
-#        endif
+         const real CFL = Hydro_GetMaxCFL( fluid, B, MinPres, EoS.DensEint2Pres_FuncPtr, EoS.DensPres2CSqr_FuncPtr,
+                                           EoS.AuxArrayDevPtr_Flt, EoS.AuxArrayDevPtr_Int, EoS.Table );
+
+         MaxCFL = FMAX( CFL, MaxCFL );
       } // CGPU_LOOP( t, CUBE(PS1) )
 
 //    perform parallel reduction to get the maximum CFL speed in each thread block
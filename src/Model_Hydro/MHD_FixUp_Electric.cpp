@@ -28,6 +28,9 @@ void MHD_FixUp_Electric( const int lv )
    const int  PS1P1_PS1       = PS1P1*PS1;
    const int  PS1_PS1         = SQR( PS1 );
    const int  PS1_PS1_PS1     = CUBE( PS1 );
+
+// B field at lv will be corrected --> clear the data cached by Prepare_PatchData()
+   PrepCache_Invalidate( lv );
    const int  PS1M1_PS1P1     = PS1M1*PS1P1;
    const int  PS1_PS1M1_PS1P1 = PS1*PS1M1_PS1P1;
 
@@ -222,7 +222,7 @@ void MHD_LB_AllocateElectricArray( const int FaLv )
       LB_RecvE_IDList_IdxTable[r] = new int [ LB_RecvE_NList[r] ];
       LB_RecvE_SibList        [r] = new int [ LB_RecvE_NList[r] ];
 
-      Mis_Heapsort( LB_RecvE_NList[r], Recv_SibSonLBIdx[r], LB_RecvE_IDList_IdxTable[r] );
+      Mis_RadixSort( LB_RecvE_NList[r], Recv_SibSonLBIdx[r], LB_RecvE_IDList_IdxTable[r] );
 
       for (int t=0; t<LB_RecvE_NList[r]; t++)
       {
@@ -236,7 +236,7 @@ void MHD_LB_AllocateElectricArray( const int FaLv )
       int *TempIdxTable = new int [ LB_RecvE_NList[r] ];
       memcpy( TempIDList, LB_RecvE_IDList[r], LB_RecvE_NList[r]*sizeof(int) );
 
-      Mis_Heapsort( LB_RecvE_NList[r], TempIDList, TempIdxTable );
+      Mis_RadixSort( LB_RecvE_NList[r], TempIDList, TempIdxTable );
 
       for (int t=1; t<LB_RecvE_NList[r]; t++)
          if ( TempIDList[t] == TempIDList[t-1]  &&
@@ -151,7 +151,7 @@ void MHD_LB_Refine_GetCoarseFineInterfaceBField(
 //    be aware that there may be duplicate LBIdx in RecvPtr_LBIdx[]
 //    --> RecvPtr_LBIdx_IdxTable[] is indeterministic in that case
 //    --> but it's not a real issue since the mapped PID is deterministic
-      Mis_Heapsort( SendEachRank_N[r], RecvPtr_LBIdx, RecvPtr_LBIdx_IdxTable );
+      Mis_RadixSort( SendEachRank_N[r], RecvPtr_LBIdx, RecvPtr_LBIdx_IdxTable );
 
       Mis_Matching_int( amr->NPatchComma[SonLv][1], amr->LB->IdxList_Real[SonLv], SendEachRank_N[r], RecvPtr_LBIdx, Match );
 
@@ -12,6 +12,7 @@ static void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, d
 extern rfftwnd_plan     FFTW_Plan_PS;
 #else
 extern rfftwnd_mpi_plan FFTW_Plan_PS;
+extern FFT_Pencil_t    *FFT_Pencil_PS;
 #endif
 
 
@@ -43,33 +44,64 @@ void Output_BasePowerSpectrum( const char *FileName )
    local_y_start_after_transpose = NULL_INT;
    total_local_size              = 2*Nx_Padded*FFT_Size[1]*FFT_Size[2];
 #  else
+   if ( OPT__FFT_PENCIL )
+   {
+      const int Coord1 = FFT_Pencil_PS->Coord[1];
+
+      local_nz                      = FFT_Pencil_PS->R_Start[1][Coord1+1] - FFT_Pencil_PS->R_Start[1][Coord1];
+      local_z_start                 = FFT_Pencil_PS->R_Start[1][Coord1];
+      local_ny_after_transpose      = FFT_Pencil_PS->K_Start[1][Coord1+1] - FFT_Pencil_PS->K_Start[1][Coord1];
+      local_y_start_after_transpose = FFT_Pencil_PS->K_Start[1][Coord1];
+      total_local_size              = (int)FFT_Pencil_PS->LocalSize;
+   }
+
+   else
    rfftwnd_mpi_local_sizes( FFTW_Plan_PS, &local_nz, &local_z_start, &local_ny_after_transpose,
                             &local_y_start_after_transpose, &total_local_size );
 #  endif
 
-// collect "local_nz" from all ranks and set the corresponding list "List_z_start"
-   int List_nz     [MPI_NRank  ];   // slab thickness of each rank in the FFTW slab decomposition
-   int List_z_start[MPI_NRank+1];   // starting z coordinate of each rank in the FFTW slab decomposition
+// set the lists "List_y_start" and "List_z_start" recording the starting y/z coordinates of all ranks
+// --> for the slab decomposition, collect "local_nz" from all ranks
+   int  NRank_y = 1;
+   int  List_y_start_Slab[2] = { 0, FFT_Size[1] };
+   int  List_nz     [MPI_NRank  ];  // slab thickness of each rank in the FFTW slab decomposition
+   int  List_z_start[MPI_NRank+1];  // starting z coordinate of each rank in the FFTW slab decomposition
+   int *List_y_start = List_y_start_Slab;
+
+#  ifndef SERIAL
+   if ( OPT__FFT_PENCIL )
+   {
+      NRank_y      = FFT_Pencil_PS->NRank[0];
+      List_y_start = FFT_Pencil_PS->R_Start[0];
+
+      for (int r=0; r<=FFT_Pencil_PS->NRank[1]; r++)  List_z_start[r] = FFT_Pencil_PS->R_Start[1][r];
+   }
 
-   MPI_Allgather( &local_nz, 1, MPI_INT, List_nz, 1, MPI_INT, MPI_COMM_WORLD );
+   else
+#  endif
+   {
+      MPI_Allgather( &local_nz, 1, MPI_INT, List_nz, 1, MPI_INT, MPI_COMM_WORLD );
 
-   List_z_start[0] = 0;
-   for (int r=0; r<MPI_NRank; r++)  List_z_start[r+1] = List_z_start[r] + List_nz[r];
+      List_z_start[0] = 0;
+      for (int r=0; r<MPI_NRank; r++)  List_z_start[r+1] = List_z_start[r] + List_nz[r];
 
-   if ( List_z_start[MPI_NRank] != FFT_Size[2] )
-      Aux_Error( ERROR_INFO, "List_z_start[%d] (%d) != expectation (%d) !!\n",
-                 MPI_NRank, List_z_start[MPI_NRank], FFT_Size[2] );
+      if ( List_z_start[MPI_NRank] != FFT_Size[2] )
+         Aux_Error( ERROR_INFO, "List_z_start[%d] (%d) != expectation (%d) !!\n",
+                    MPI_NRank, List_z_start[MPI_NRank], FFT_Size[2] );
+   }
 
 
 // 2. allocate memory
-   const int NRecvSlice = MIN( List_z_start[MPI_Rank]+local_nz, NX0_TOT[2] ) - MIN( List_z_start[MPI_Rank], NX0_TOT[2] );
+   const int  YRank     = MPI_Rank % NRank_y;
+   const int  NRecvY    = List_y_start[YRank+1] - List_y_start[YRank];
+   const long NRecvCell = (long)NX0_TOT[0]*NRecvY*local_nz;
 
    double *PS_total     = NULL;
    real   *RhoK         = new real [ total_local_size ];                         // array storing both density and potential
    real   *SendBuf      = new real [ amr->NPatchComma[0][1]*CUBE(PS1) ];         // MPI send buffer for density and potential
-   real   *RecvBuf      = new real [ NX0_TOT[0]*NX0_TOT[1]*NRecvSlice ];         // MPI recv buffer for density and potentia
+   real   *RecvBuf      = new real [ NRecvCell ];                                // MPI recv buffer for density and potentia
    long   *SendBuf_SIdx = new long [ amr->NPatchComma[0][1]*PS1 ];               // MPI send buffer for 1D coordinate in slab
-   long   *RecvBuf_SIdx = new long [ NX0_TOT[0]*NX0_TOT[1]*NRecvSlice/SQR(PS1) ];// MPI recv buffer for 1D coordinate in slab
+   long   *RecvBuf_SIdx = new long [ NRecvCell/SQR(PS1) ];                       // MPI recv buffer for 1D coordinate in slab
 
    int  *List_PID    [MPI_NRank];   // PID of each patch slice sent to each rank
    int  *List_k      [MPI_NRank];   // local z coordinate of each patch slice sent to each rank
@@ -101,8 +133,8 @@ void Output_BasePowerSpectrum( const char *FileName )
 
 
 // 4. rearrange data from patch to slab
-   Patch2Slab( RhoK, SendBuf, RecvBuf, SendBuf_SIdx, RecvBuf_SIdx, List_PID, List_k, List_NSend, List_NRecv, List_z_start,
-               local_nz, FFT_Size, NRecvSlice, Time[0] );
+   Patch2Slab( RhoK, SendBuf, RecvBuf, SendBuf_SIdx, RecvBuf_SIdx, List_PID, List_k, List_NSend, List_NRecv,
+               List_y_start, List_z_start, NRank_y, FFT_Size, Time[0] );
 
 
 // 5. evaluate the base-level power spectrum by FFT
@@ -155,7 +187,9 @@ void Output_BasePowerSpectrum( const char *FileName )
 // Function    :  GetBasePowerSpectrum
 // Description :  Evaluate and base-level power spectrum by FFT
 //
-// Note        :  Invoked by the function "Output_BasePowerSpectrum"
+// Note        :  1. Invoked by the function "Output_BasePowerSpectrum"
+//                2. For OPT__FFT_PENCIL, the k-space data are stored in the z pencils with the layout [x][y][z]
+//                   --> j_start and dj are the y range of this rank in the z pencils
 //
 // Parameter   :  RhoK        : Array storing the input density and output potential
 //                j_start     : Starting j index
@@ -186,7 +220,8 @@ void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, double *
 #  ifdef SERIAL
    rfftwnd_one_real_to_complex( FFTW_Plan_PS, RhoK, NULL );
 #  else
-   rfftwnd_mpi( FFTW_Plan_PS, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
+   if ( OPT__FFT_PENCIL )  FFT_Pencil_Forward( FFT_Pencil_PS, RhoK );
+   else                    rfftwnd_mpi( FFTW_Plan_PS, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
 #  endif
 
 
@@ -209,6 +244,37 @@ void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, double *
       Count_local[b] = 0;
    }
 
+#  ifndef SERIAL
+// pencil mode: [i][j][k] in the z pencils
+   if ( OPT__FFT_PENCIL )
+   {
+      const int i_start = FFT_Pencil_PS->K_Start[0][ FFT_Pencil_PS->Coord[0]   ];
+      const int di      = FFT_Pencil_PS->K_Start[0][ FFT_Pencil_PS->Coord[0]+1 ] - i_start;
+      int i, j;
+
+      for (int ii=0; ii<di; ii++)   {  i = i_start + ii;
+      for (int jj=0; jj<dj; jj++)   {  j = j_start + jj;
+      for (int k=0;  k<Nz;  k++)    {
+
+         Idx = ( (long)ii*dj + jj )*Nz + k;
+
+#        ifdef FLOAT8
+         bin = lround (   SQRT(   real( SQR(bin_i[i]) + SQR(bin_j[j]) + SQR(bin_k[k]) )  )   );
+#        else
+         bin = lroundf(   SQRT(   real( SQR(bin_i[i]) + SQR(bin_j[j]) + SQR(bin_k[k]) )  )   );
+#        endif
+
+         if ( bin < Nx_Padded )
+         {
+            PS_local   [bin] += double(  SQR( cdata[Idx].re ) + SQR( cdata[Idx].im )  );
+            Count_local[bin] ++;
+         }
+      }}} // i,j,k
+   } // if ( OPT__FFT_PENCIL )
+
+   else
+#  endif // #ifndef SERIAL
+   {
 #  ifdef SERIAL // serial mode
 
    for (int k=0; k<Nz; k++)
@@ -247,6 +313,7 @@ void GetBasePowerSpectrum( real *RhoK, const int j_start, const int dj, double *
          }
       } // i,j,k
    } // i,j,k
+   } // if ( OPT__FFT_PENCIL ) ... else ...
 
 
 // sum over all ranks
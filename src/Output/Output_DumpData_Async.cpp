@@ -0,0 +1,250 @@
+#ifdef SUPPORT_HDF5
+
+#include "GAMER.h"
+#include <pthread.h>
+#include <fcntl.h>
+#include <cerrno>
+
+
+// a contiguous block of data to be written to the target file at a given byte offset
+struct AsyncChunk_t
+{
+   long  Offset;  // file offset in bytes
+   long  NByte;   // number of bytes
+   real *Data;    // staging buffer owned by the writer (allocated by new [])
+};
+
+// all data of one snapshot
+struct AsyncDump_t
+{
+   char          FileName[MAX_STRING];
+   AsyncChunk_t *Chunk;
+   int           NChunk, NChunkAlloc;
+   long          NByte;
+   int           ErrNo;
+};
+
+// two dumps are kept: one being staged by the main thread and one being written by the I/O thread
+static AsyncDump_t Async_Dump[2];
+static int         Async_StageIdx = 0;
+static bool        Async_Writing  = false;
+static pthread_t   Async_Thread;
+
+static void *Async_Writer( void *Arg );
+static void  Async_FreeDump( AsyncDump_t &Dump );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Output_DumpData_Async_Reserve
+// Description :  Check whether a snapshot of the given size can be staged for the asynchronous output
+//
+// Note        :  1. Invoked by Output_DumpData_Total_HDF5() before staging any data
+//                2. Staging memory per MPI rank is bounded by OUTPUT_ASYNC_MAX_MB (<=0 --> no limit), which
+//                   includes the snapshot still being written by the I/O thread
+//                   --> Block until the previous snapshot is written if both snapshots do not fit
+//                   --> Return false if the new snapshot alone exceeds the limit, in which case the caller should
+//                       fall back to the synchronous output
+//                3. This function is purely local and the caller is responsible for making the decision collective
+//
+// Parameter   :  NByte : Total number of bytes to be staged by this rank
+//
+// Return      :  true/false --> stage/do not stage the snapshot
+//-------------------------------------------------------------------------------------------------------
+bool Output_DumpData_Async_Reserve( const long NByte )
+{
+
+   const long MaxNByte = ( OUTPUT_ASYNC_MAX_MB > 0.0 ) ? (long)( OUTPUT_ASYNC_MAX_MB*1024.0*1024.0 ) : -1L;
+
+   if ( MaxNByte >= 0L  &&  NByte > MaxNByte )  return false;
+
+   if ( Async_Writing  &&  MaxNByte >= 0L  &&  NByte + Async_Dump[1-Async_StageIdx].NByte > MaxNByte )
+      Output_DumpData_Async_Wait();
+
+   return true;
+
+} // FUNCTION : Output_DumpData_Async_Reserve
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Output_DumpData_Async_Stage
+// Description :  Add a data block to the snapshot being staged
+//
+// Note        :  1. The ownership of "Data" is transferred to the I/O thread, which will free it by delete []
+//                   --> The caller must NOT access or free "Data" afterwards
+//                2. Bytes are written verbatim to the file
+//                   --> "Offset" must point to a contiguous and allocated dataset storing the native datatype
+//
+// Parameter   :  Offset : File offset in bytes
+//                NReal  : Number of elements in "Data"
+//                Data   : Data to be written
+//-------------------------------------------------------------------------------------------------------
+void Output_DumpData_Async_Stage( const long Offset, const long NReal, real *Data )
+{
+
+   AsyncDump_t &Dump = Async_Dump[Async_StageIdx];
+
+   if ( NReal <= 0L )
+   {
+      delete [] Data;
+      return;
+   }
+
+   if ( Dump.NChunk >= Dump.NChunkAlloc )
+   {
+      Dump.NChunkAlloc = ( Dump.NChunkAlloc == 0 ) ? 64 : 2*Dump.NChunkAlloc;
+      Dump.Chunk       = (AsyncChunk_t*)realloc( Dump.Chunk, Dump.NChunkAlloc*sizeof(AsyncChunk_t) );
+
+      if ( Dump.Chunk == NULL )  Aux_Error( ERROR_INFO, "failed to allocate memory for the asynchronous output !!\n" );
+   }
+
+   Dump.Chunk[ Dump.NChunk ].Offset = Offset;
+   Dump.Chunk[ Dump.NChunk ].NByte  = NReal*sizeof(real);
+   Dump.Chunk[ Dump.NChunk ].Data   = Data;
+   Dump.NChunk ++;
+   Dump.NByte += NReal*sizeof(real);
+
+} // FUNCTION : Output_DumpData_Async_Stage
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Output_DumpData_Async_Launch
+// Description :  Hand over the staged snapshot to a background I/O thread and return immediately
+//
+// Note        :  1. The target file must already exist with all datasets allocated
+//                2. Wait for the previous snapshot to be written first (if it has not finished yet)
+//                3. The I/O thread does not invoke any MPI or HDF5 routine and only uses POSIX pwrite()
+//                   --> Does not require a thread-safe MPI or HDF5 library
+//
+// Parameter   :  FileName : Name of the target file
+//-------------------------------------------------------------------------------------------------------
+void Output_DumpData_Async_Launch( const char *FileName )
+{
+
+   Output_DumpData_Async_Wait();
+
+   AsyncDump_t &Dump = Async_Dump[Async_StageIdx];
+
+   strncpy( Dump.FileName, FileName, MAX_STRING-1 );
+   Dump.FileName[MAX_STRING-1] = '\0';
+   Dump.ErrNo = 0;
+
+   if ( pthread_create( &Async_Thread, NULL, Async_Writer, &Dump ) != 0 )
+      Aux_Error( ERROR_INFO, "failed to create the I/O thread for \"%s\" !!\n", FileName );
+
+   Async_Writing  = true;
+   Async_StageIdx = 1 - Async_StageIdx;
+
+} // FUNCTION : Output_DumpData_Async_Launch
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Output_DumpData_Async_Wait
+// Description :  Wait until the snapshot being written by the I/O thread is complete
+//
+// Note        :  1. Must be called before reading any snapshot written asynchronously and before MPI_Finalize()
+//                2. Do nothing if there is no pending snapshot
+//
+// Parameter   :  None
+//-------------------------------------------------------------------------------------------------------
+void Output_DumpData_Async_Wait()
+{
+
+   if ( !Async_Writing )   return;
+
+   AsyncDump_t &Dump = Async_Dump[1-Async_StageIdx];
+
+   if ( pthread_join( Async_Thread, NULL ) != 0 )
+      Aux_Error( ERROR_INFO, "failed to join the I/O thread for \"%s\" !!\n", Dump.FileName );
+
+   Async_Writing = false;
+
+   if ( Dump.ErrNo != 0 )
+      Aux_Error( ERROR_INFO, "failed to write the file \"%s\" asynchronously (%s) !!\n",
+                 Dump.FileName, strerror(Dump.ErrNo) );
+
+   Async_FreeDump( Dump );
+
+} // FUNCTION : Output_DumpData_Async_Wait
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Async_Writer
+// Description :  Write all chunks of a staged snapshot to disk
+//
+// Note        :  1. Running on the I/O thread
+//                2. Errors are recorded in AsyncDump_t::ErrNo and reported by Output_DumpData_Async_Wait()
+//                3. Staging buffers are freed as soon as they are written to release memory early
+//
+// Parameter   :  Arg : Pointer to the target AsyncDump_t
+//-------------------------------------------------------------------------------------------------------
+void *Async_Writer( void *Arg )
+{
+
+   AsyncDump_t *Dump = (AsyncDump_t*)Arg;
+
+   const int FileDes = open( Dump->FileName, O_WRONLY );
+
+   if ( FileDes < 0 )
+   {
+      Dump->ErrNo = errno;
+      return NULL;
+   }
+
+   for (int c=0; c<Dump->NChunk; c++)
+   {
+      AsyncChunk_t &Chunk = Dump->Chunk[c];
+      const char   *Ptr   = (const char*)Chunk.Data;
+      long          NLeft = Chunk.NByte;
+      long          Off   = Chunk.Offset;
+
+//    pwrite() may write fewer bytes than requested
+      while ( NLeft > 0L  &&  Dump->ErrNo == 0 )
+      {
+         const ssize_t NDone = pwrite( FileDes, Ptr, NLeft, Off );
+
+         if      ( NDone > 0 )                        { Ptr += NDone;  Off += NDone;  NLeft -= NDone; }
+         else if ( NDone < 0  &&  errno == EINTR )    continue;
+         else                                         Dump->ErrNo = ( NDone < 0 ) ? errno : EIO;
+      }
+
+      delete [] Chunk.Data;
+      Chunk.Data = NULL;
+   }
+
+   if ( close( FileDes ) != 0  &&  Dump->ErrNo == 0 )    Dump->ErrNo = errno;
+
+   return NULL;
+
+} // FUNCTION : Async_Writer
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Async_FreeDump
+// Description :  Free all staging buffers of a snapshot and reset it for reuse
+//
+// Parameter   :  Dump : Target AsyncDump_t
+//-------------------------------------------------------------------------------------------------------
+void Async_FreeDump( AsyncDump_t &Dump )
+{
+
+   for (int c=0; c<Dump.NChunk; c++)   delete [] Dump.Chunk[c].Data;
+
+   free( Dump.Chunk );
+
+   Dump.Chunk       = NULL;
+   Dump.NChunk      = 0;
+   Dump.NChunkAlloc = 0;
+   Dump.NByte       = 0L;
+
+} // FUNCTION : Async_FreeDump
+
+
+
+#endif // #ifdef SUPPORT_HDF5
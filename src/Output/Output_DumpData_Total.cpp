@@ -382,7 +382,7 @@ void Output_DumpData_Total( const char *FileName )
 #     endif
 
       const int nlevel               = NLEVEL;
-      const int max_patch            = MAX_PATCH;
+      const int max_patch            = -1;   // no compile-time limit on the number of patches
 
       fwrite( &model,                     sizeof(int),                     1,             File );
       fwrite( &gravity,                   sizeof(bool),                    1,             File );
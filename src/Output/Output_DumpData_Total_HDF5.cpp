@@ -4,7 +4,7 @@
 #include "HDF5_Typedef.h"
 #include <ctime>
 
-void FillIn_KeyInfo  (   KeyInfo_t &KeyInfo, const int NFieldStored );
+void FillIn_KeyInfo  (   KeyInfo_t &KeyInfo, const int NFieldStored, const int NPatchAlloc[] );
 void FillIn_Makefile (  Makefile_t &Makefile  );
 void FillIn_SymConst (  SymConst_t &SymConst  );
 void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char FieldLabelOut[][MAX_STRING] );
@@ -13,6 +13,7 @@ static void GetCompound_KeyInfo  ( hid_t &H5_TypeID );
 static void GetCompound_Makefile ( hid_t &H5_TypeID );
 static void GetCompound_SymConst ( hid_t &H5_TypeID );
 static void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored );
+static long GetDatasetOffset( const hid_t H5_SetID, const char *SetName );
 
 
 
@@ -69,7 +70,7 @@ Procedure for outputting new variables:
 
 
 //-------------------------------------------------------------------------------------------------------
-// Function    :  Output_DumpData_Total_HDF5 (FormatVersion = 2450)
+// Function    :  Output_DumpData_Total_HDF5 (FormatVersion = 2466)
 // Description :  Output all simulation data in the HDF5 format, which can be used as a restart file
 //                or loaded by YT
 //
@@ -106,6 +107,19 @@ Procedure for outputting new variables:
 //                        --> Currently we store different attributes in separate datasets
 //                        --> Particles are stored in the order of their associated GIDs as well, but the order of
 //                            particles in the same patch is not specified
+//                11. Grid and particle data are written by all ranks simultaneously using collective MPI-IO if
+//                    OPT__OUTPUT_HDF5_MPIIO is on (which requires an HDF5 library built with MPI support)
+//                    --> Otherwise ranks write data one after another by reopening the file in turn
+//                    --> Both approaches produce the same file layout
+//                12. Grid and particle data are staged in memory and written by a background I/O thread if
+//                    OPT__OUTPUT_ASYNC is on
+//                    --> This function returns once the data are staged, and rank 0 has created the file
+//                        with all datasets allocated
+//                    --> The I/O thread writes raw bytes to the dataset offsets using pwrite() and does not
+//                        invoke any MPI or HDF5 routine
+//                    --> The file is incomplete until Output_DumpData_Async_Wait() returns
+//                    --> Fall back to the synchronous output if the staging size exceeds OUTPUT_ASYNC_MAX_MB
+//                        on any rank
 //
 // Parameter   :  FileName : Name of the output file
 //
@@ -221,6 +235,23 @@ Procedure for outputting new variables:
 //                2448 : 2022/05/18 --> output PAR_IC_TYPE
 //                2449 : 2022/07/08 --> output OPT__OUTPUT_RESTART
 //                2450 : 2022/07/13 --> output OPT__INT_PRIM
+//                2451 : 2022/07/20 --> output OPT__OUTPUT_HDF5_MPIIO
+//                2452 : 2022/07/22 --> output OPT__OUTPUT_ASYNC and OUTPUT_ASYNC_MAX_MB
+//                2453 : 2022/07/26 --> output OPT__LB_DIFFUSE
+//                2454 : 2022/07/28 --> output OPT__LB_MEASURE_COST and LB_MEASURE_COST_WEIGHT
+//                2455 : 2022/07/30 --> output OPT__FFT_PENCIL
+//                2456 : 2022/08/01 --> output OPT__FFTW_STARTUP and OPT__FFTW_WISDOM
+//                2457 : 2022/08/08 --> output OPT__CPU_PIPELINE and CPU_PIPELINE_NTHREAD
+//                2458 : 2022/08/10 --> output OPT__PREP_CACHE and PREP_CACHE_MAX_MB
+//                2459 : 2022/08/12 --> output OPT__LB_NEIGHBOR_MPI
+//                2460 : 2022/08/14 --> MaxPatch = -1 since there is no compile-time limit on the number of patches
+//                2461 : 2022/08/16 --> output OPT__SLAB_ALLOC
+//                2462 : 2022/08/18 --> output MEMORY_POOL_HEADROOM, MEMORY_POOL_MAX_MB, and NPatchAlloc for the
+//                                      adaptive memory pool (OPT__MEMORY_POOL=2)
+//                2463 : 2022/08/20 --> output OPT__DT_FLU_FUSED
+//                2464 : 2022/08/22 --> output OPT__POI_LEVEL_MG
+//                2465 : 2022/08/24 --> output PAR_SORT_INTERVAL
+//                2466 : 2022/08/26 --> output PAR_FIXED_POINT_DEPO
 //-------------------------------------------------------------------------------------------------------
 void Output_DumpData_Total_HDF5( const char *FileName )
 {
@@ -349,6 +380,47 @@ void Output_DumpData_Total_HDF5( const char *FileName )
       GID_LvStart[lv] = ( lv == 0 ) ? 0 : GID_LvStart[lv-1] + NPatchTotal[lv-1];
    }
 
+// sum the numbers of allocated (active+inactive) patches over all ranks as the sizing hints of the
+// adaptive memory pool (OPT__MEMORY_POOL == MEMORY_POOL_ADAPTIVE) for restart
+   int NPatchAllocLocal[NLEVEL], NPatchAlloc[NLEVEL];
+
+   for (int lv=0; lv<NLEVEL; lv++)  NPatchAllocLocal[lv] = amr->num[lv] + amr->CountInactive( lv );
+
+   MPI_Reduce( NPatchAllocLocal, NPatchAlloc, NLEVEL, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD );
+
+
+// 1-1. determine whether to stage the grid and particle data for the asynchronous output
+//      --> all ranks must agree since the synchronous output involves collective operations
+   bool UseAsync = false;
+
+   if ( OPT__OUTPUT_ASYNC )
+   {
+      long NByteStage = 0L;
+
+      for (int lv=0; lv<NLEVEL; lv++)
+      {
+         NByteStage += (long)NPatchLocal[lv]*NFieldStored*CUBE(PS1)*sizeof(real);
+#        ifdef MHD
+         NByteStage += (long)NPatchLocal[lv]*NCOMP_MAG*PS1P1*SQR(PS1)*sizeof(real);
+#        endif
+      }
+#     ifdef PARTICLE
+      NByteStage += amr->Par->NPar_Active*PAR_NATT_STORED*sizeof(real);
+#     endif
+
+      const int CanStage = Output_DumpData_Async_Reserve( NByteStage );
+      int CanStage_AllRank;
+
+      MPI_Allreduce( &CanStage, &CanStage_AllRank, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD );
+
+      UseAsync = CanStage_AllRank;
+
+      if ( !UseAsync  &&  MPI_Rank == 0 )
+         Aux_Message( stderr, "WARNING : staging size exceeds OUTPUT_ASYNC_MAX_MB --> use the synchronous output !!\n" );
+   }
+
+   const bool UseMPIIO = ( OPT__OUTPUT_HDF5_MPIIO  &&  !UseAsync );
+
 
 
 // 2. prepare all HDF5 variables
@@ -360,7 +432,7 @@ void Output_DumpData_Total_HDF5( const char *FileName )
    hid_t   H5_SetID_KeyInfo, H5_SetID_Makefile, H5_SetID_SymConst, H5_SetID_InputPara;
    hid_t   H5_SpaceID_Scalar, H5_SpaceID_LBIdx, H5_SpaceID_Cr, H5_SpaceID_Fa, H5_SpaceID_Son, H5_SpaceID_Sib, H5_SpaceID_Field;
    hid_t   H5_TypeID_Com_KeyInfo, H5_TypeID_Com_Makefile, H5_TypeID_Com_SymConst, H5_TypeID_Com_InputPara;
-   hid_t   H5_DataCreatePropList;
+   hid_t   H5_DataCreatePropList, H5_FileAccPropList, H5_DataXferPropList;
    hid_t   H5_AttID_Cvt2Phy;
    herr_t  H5_Status;
 #  ifdef PARTICLE
@@ -376,13 +448,41 @@ void Output_DumpData_Total_HDF5( const char *FileName )
    H5_DataCreatePropList = H5Pcreate( H5P_DATASET_CREATE );
    H5_Status             = H5Pset_fill_time( H5_DataCreatePropList, H5D_FILL_TIME_NEVER );
 
-// 2-2. create the "compound" datatype
+// 2-2. set the file-access and data-transfer property lists for the collective MPI-IO
+//      --> must also allocate the dataset storage when creating datasets since datasets are created by rank 0 alone
+//      --> the same applies to the asynchronous output, which writes to the dataset offsets directly
+   H5_FileAccPropList  = H5P_DEFAULT;
+   H5_DataXferPropList = H5P_DEFAULT;
+
+   if ( UseAsync )   H5_Status = H5Pset_alloc_time( H5_DataCreatePropList, H5D_ALLOC_TIME_EARLY );
+
+#  if ( !defined SERIAL  &&  defined H5_HAVE_PARALLEL )
+   if ( UseMPIIO )
+   {
+      H5_FileAccPropList  = H5Pcreate( H5P_FILE_ACCESS );
+      H5_Status           = H5Pset_fapl_mpio( H5_FileAccPropList, MPI_COMM_WORLD, MPI_INFO_NULL );
+      if ( H5_Status < 0 )    Aux_Error( ERROR_INFO, "failed to set the MPI-IO file driver !!\n" );
+
+      H5_DataXferPropList = H5Pcreate( H5P_DATASET_XFER );
+      H5_Status           = H5Pset_dxpl_mpio( H5_DataXferPropList, H5FD_MPIO_COLLECTIVE );
+      if ( H5_Status < 0 )    Aux_Error( ERROR_INFO, "failed to set the collective data transfer mode !!\n" );
+
+      H5_Status           = H5Pset_alloc_time( H5_DataCreatePropList, H5D_ALLOC_TIME_EARLY );
+   }
+#  endif
+
+// number of rounds for writing the grid and particle data
+// --> one rank at a time for the serialized output and all ranks at once for MPI-IO and the asynchronous output
+   const bool AllRankWrite = ( UseMPIIO  ||  UseAsync );
+   const int  NWriteRound  = ( AllRankWrite ) ? 1 : MPI_NRank;
+
+// 2-3. create the "compound" datatype
    GetCompound_KeyInfo  ( H5_TypeID_Com_KeyInfo   );
    GetCompound_Makefile ( H5_TypeID_Com_Makefile  );
    GetCompound_SymConst ( H5_TypeID_Com_SymConst  );
    GetCompound_InputPara( H5_TypeID_Com_InputPara, NFieldStored );
 
-// 2-3. create the "scalar" dataspace
+// 2-4. create the "scalar" dataspace
    H5_SpaceID_Scalar = H5Screate( H5S_SCALAR );
 
 
@@ -396,7 +496,7 @@ void Output_DumpData_Total_HDF5( const char *FileName )
       SymConst_t  SymConst;
       InputPara_t InputPara;
 
-      FillIn_KeyInfo  ( KeyInfo, NFieldStored );
+      FillIn_KeyInfo  ( KeyInfo, NFieldStored, NPatchAlloc );
       FillIn_Makefile ( Makefile );
       FillIn_SymConst ( SymConst );
       FillIn_InputPara( InputPara, NFieldStored, FieldLabelOut );
@@ -532,7 +632,7 @@ void Output_DumpData_Total_HDF5( const char *FileName )
 
 // sort list and get the corresponding index table (for calculating GID later)
    for (int lv=0; lv<NLEVEL; lv++)
-      Mis_Heapsort( NPatchTotal[lv], LBIdxList_Sort[lv], LBIdxList_Sort_IdxTable[lv] );
+      Mis_RadixSort( NPatchTotal[lv], LBIdxList_Sort[lv], LBIdxList_Sort_IdxTable[lv] );
 
 
 // 4-3. store the local tree
@@ -881,6 +981,12 @@ void Output_DumpData_Total_HDF5( const char *FileName )
    }
 #  endif
 
+// file offsets of all datasets for the asynchronous output
+   long FieldFileOffset[NFIELD_STORED_MAX];
+#  ifdef MHD
+   long FCMagFileOffset[NCOMP_MAG];
+#  endif
+
    if ( MPI_Rank == 0 )
    {
 //    HDF5 file must be synchronized before being written by the next rank
@@ -899,6 +1005,7 @@ void Output_DumpData_Total_HDF5( const char *FileName )
          H5_SetID_Field = H5Dcreate( H5_GroupID_GridData, FieldLabelOut[v], H5T_GAMER_REAL, H5_SpaceID_Field,
                                      H5P_DEFAULT, H5_DataCreatePropList, H5P_DEFAULT );
          if ( H5_SetID_Field < 0 )  Aux_Error( ERROR_INFO, "failed to create the dataset \"%s\" !!\n", FieldLabelOut[v] );
+         if ( UseAsync )   FieldFileOffset[v] = GetDatasetOffset( H5_SetID_Field, FieldLabelOut[v] );
          H5_Status = H5Dclose( H5_SetID_Field );
       }
 
@@ -909,6 +1016,7 @@ void Output_DumpData_Total_HDF5( const char *FileName )
          H5_SetID_FCMag = H5Dcreate( H5_GroupID_GridData, MagLabel[v], H5T_GAMER_REAL, H5_SpaceID_FCMag[v],
                                      H5P_DEFAULT, H5_DataCreatePropList, H5P_DEFAULT );
          if ( H5_SetID_FCMag < 0 )  Aux_Error( ERROR_INFO, "failed to create the dataset \"%s\" !!\n", MagLabel[v] );
+         if ( UseAsync )   FCMagFileOffset[v] = GetDatasetOffset( H5_SetID_FCMag, MagLabel[v] );
          H5_Status = H5Dclose( H5_SetID_FCMag );
       }
 #     endif
@@ -918,8 +1026,16 @@ void Output_DumpData_Total_HDF5( const char *FileName )
       H5_Status = H5Fclose( H5_FileID );
    } // if ( MPI_Rank == 0 )
 
+   if ( UseAsync )
+   {
+      MPI_Bcast( FieldFileOffset, NFieldStored, MPI_LONG, 0, MPI_COMM_WORLD );
+#     ifdef MHD
+      MPI_Bcast( FCMagFileOffset, NCOMP_MAG,    MPI_LONG, 0, MPI_COMM_WORLD );
+#     endif
+   }
+
 
-// 5-2. start to dump data (serial instead of parallel)
+// 5-2. start to dump data (serial or collective MPI-IO)
    const bool IntPhase_No         = false;
    const bool DE_Consistency_No   = false;
    const real MinDens_No          = -1.0;
@@ -958,6 +1074,9 @@ void Output_DumpData_Total_HDF5( const char *FileName )
    real (*Der_FluInTmp) = new real [ Der_NP*NCOMP_TOTAL*CUBE(DER_NXT) ];
 
 
+// the file must be closed by rank 0 before being reopened by all ranks collectively
+   if ( UseMPIIO )   MPI_Barrier( MPI_COMM_WORLD );
+
 // output one level at a time so that data at the same level are consecutive on disk (even for multiple ranks)
    for (int lv=0; lv<NLEVEL; lv++)
    {
@@ -976,19 +1095,23 @@ void Output_DumpData_Total_HDF5( const char *FileName )
       }
 #     endif
 
-      for (int TRank=0; TRank<MPI_NRank; TRank++)
+      for (int TRank=0; TRank<NWriteRound; TRank++)
       {
-         if ( MPI_Rank == TRank )
+         if ( MPI_Rank == TRank  ||  AllRankWrite )
          {
-//          HDF5 file must be synchronized before being written by the next rank
-            SyncHDF5File( FileName );
+//          reopen the file and group (collectively for MPI-IO)
+//          --> not required for the asynchronous output
+            if ( !UseAsync )
+            {
+//             HDF5 file must be synchronized before being written by the next rank
+               if ( !UseMPIIO )  SyncHDF5File( FileName );
 
-//          reopen the file and group
-            H5_FileID = H5Fopen( FileName, H5F_ACC_RDWR, H5P_DEFAULT );
-            if ( H5_FileID < 0 )    Aux_Error( ERROR_INFO, "failed to open the HDF5 file \"%s\" !!\n", FileName );
+               H5_FileID = H5Fopen( FileName, H5F_ACC_RDWR, H5_FileAccPropList );
+               if ( H5_FileID < 0 )    Aux_Error( ERROR_INFO, "failed to open the HDF5 file \"%s\" !!\n", FileName );
 
-            H5_GroupID_GridData = H5Gopen( H5_FileID, "GridData", H5P_DEFAULT );
-            if ( H5_GroupID_GridData < 0 )   Aux_Error( ERROR_INFO, "failed to open the group \"%s\" !!\n", "GridData" );
+               H5_GroupID_GridData = H5Gopen( H5_FileID, "GridData", H5P_DEFAULT );
+               if ( H5_GroupID_GridData < 0 )   Aux_Error( ERROR_INFO, "failed to open the group \"%s\" !!\n", "GridData" );
+            }
 
 
 //          5-2-1. dump cell-centered data
@@ -1016,6 +1139,13 @@ void Output_DumpData_Total_HDF5( const char *FileName )
             H5_Status = H5Sselect_hyperslab( H5_SpaceID_Field, H5S_SELECT_SET, H5_Offset_Field, NULL, H5_Count_Field, NULL );
             if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to create a hyperslab for the grid data !!\n" );
 
+//          ranks without any patch must still participate in the collective write
+            if ( amr->NPatchComma[lv][1] == 0 )
+            {
+               H5Sselect_none( H5_MemID_Field );
+               H5Sselect_none( H5_SpaceID_Field );
+            }
+
 
 //          output one field at one level in one rank at a time
             FieldData = new real [ amr->NPatchComma[lv][1] ][PS1][PS1][PS1];
@@ -1315,12 +1445,24 @@ void Output_DumpData_Total_HDF5( const char *FileName )
 
 
 //             5-2-1-4. write data to disk
-               H5_SetID_Field = H5Dopen( H5_GroupID_GridData, FieldLabelOut[v], H5P_DEFAULT );
+//                      --> hand over the buffer to the I/O thread and allocate a new one for the asynchronous output
+               if ( UseAsync )
+               {
+                  Output_DumpData_Async_Stage( FieldFileOffset[v] + (long)GID_Offset[lv]*FieldSizeOnePatch,
+                                               (long)amr->NPatchComma[lv][1]*CUBE(PS1), FieldData[0][0][0] );
+
+                  FieldData = new real [ amr->NPatchComma[lv][1] ][PS1][PS1][PS1];
+               }
+
+               else
+               {
+                  H5_SetID_Field = H5Dopen( H5_GroupID_GridData, FieldLabelOut[v], H5P_DEFAULT );
 
-               H5_Status = H5Dwrite( H5_SetID_Field, H5T_GAMER_REAL, H5_MemID_Field, H5_SpaceID_Field, H5P_DEFAULT, FieldData );
-               if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to write a field (lv %d, v %d) !!\n", lv, v );
+                  H5_Status = H5Dwrite( H5_SetID_Field, H5T_GAMER_REAL, H5_MemID_Field, H5_SpaceID_Field, H5_DataXferPropList, FieldData );
+                  if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to write a field (lv %d, v %d) !!\n", lv, v );
 
-               H5_Status = H5Dclose( H5_SetID_Field );
+                  H5_Status = H5Dclose( H5_SetID_Field );
+               }
             } // for (int v=0; v<NFieldStored; v++)
 
 
@@ -1370,6 +1512,12 @@ void Output_DumpData_Total_HDF5( const char *FileName )
                H5_Status = H5Sselect_hyperslab( H5_SpaceID_FCMag[v], H5S_SELECT_SET, H5_Offset_FCMag, NULL, H5_Count_FCMag, NULL );
                if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to create a hyperslab for the magnetic field !!\n" );
 
+               if ( amr->NPatchComma[lv][1] == 0 )
+               {
+                  H5Sselect_none( H5_MemID_FCMag );
+                  H5Sselect_none( H5_SpaceID_FCMag[v] );
+               }
+
 
 //             5-2-2-3. collect the target B component from all patches at the current target level
                for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
@@ -1377,12 +1525,24 @@ void Output_DumpData_Total_HDF5( const char *FileName )
 
 
 //             5-2-2-4. write data to disk
-               H5_SetID_FCMag = H5Dopen( H5_GroupID_GridData, MagLabel[v], H5P_DEFAULT );
+               if ( UseAsync )
+               {
+                  Output_DumpData_Async_Stage( FCMagFileOffset[v] + (long)GID_Offset[lv]*FCMagSizeOnePatch,
+                                               (long)amr->NPatchComma[lv][1]*PS1P1*SQR(PS1), FCMagData[0] );
 
-               H5_Status = H5Dwrite( H5_SetID_FCMag, H5T_GAMER_REAL, H5_MemID_FCMag, H5_SpaceID_FCMag[v], H5P_DEFAULT, FCMagData );
-               if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to write magnetic field (lv %d, v %d) !!\n", lv, v );
+                  FCMagData = new real [ amr->NPatchComma[lv][1] ][ PS1P1*SQR(PS1) ];
+               }
+
+               else
+               {
+                  H5_SetID_FCMag = H5Dopen( H5_GroupID_GridData, MagLabel[v], H5P_DEFAULT );
+
+                  H5_Status = H5Dwrite( H5_SetID_FCMag, H5T_GAMER_REAL, H5_MemID_FCMag, H5_SpaceID_FCMag[v], H5_DataXferPropList, FCMagData );
+                  if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to write magnetic field (lv %d, v %d) !!\n", lv, v );
+
+                  H5_Status = H5Dclose( H5_SetID_FCMag );
+               }
 
-               H5_Status = H5Dclose( H5_SetID_FCMag );
                H5_Status = H5Sclose( H5_MemID_FCMag );
             } // for (int v=0; v<NCOMP_MAG; v++)
 
@@ -1391,13 +1551,16 @@ void Output_DumpData_Total_HDF5( const char *FileName )
             delete [] FCMagData;
 #           endif // #ifdef MHD
 
-            H5_Status = H5Gclose( H5_GroupID_GridData );
-            H5_Status = H5Fclose( H5_FileID );
-         } // if ( MPI_Rank == TRank )
+            if ( !UseAsync )
+            {
+               H5_Status = H5Gclose( H5_GroupID_GridData );
+               H5_Status = H5Fclose( H5_FileID );
+            }
+         } // if ( MPI_Rank == TRank  ||  AllRankWrite )
 
          MPI_Barrier( MPI_COMM_WORLD );
 
-      } // for (int TRank=0; TRank<MPI_NRank; TRank++)
+      } // for (int TRank=0; TRank<NWriteRound; TRank++)
 
       delete [] PID0List;
    } // for (int lv=0; lv<NLEVEL; lv++)
@@ -1436,7 +1599,8 @@ void Output_DumpData_Total_HDF5( const char *FileName )
    MaxNPar1Lv = 0;
    for (int lv=0; lv<NLEVEL; lv++)  MaxNPar1Lv = MAX( MaxNPar1Lv, amr->Par->NPar_Lv[lv] );
 
-   ParBuf1v1Lv = new real [MaxNPar1Lv];
+// --> allocated separately for each attribute and level for the asynchronous output since buffers are handed over to the I/O thread
+   ParBuf1v1Lv = ( UseAsync ) ? NULL : new real [MaxNPar1Lv];
 
 // 6-1-2. get the starting global particle index (i.e., GParID_Offset[NLEVEL]) for particles at each level in this rank
    MPI_Allgather( amr->Par->NPar_Lv, NLEVEL, MPI_LONG, NParLv_EachRank[0], NLEVEL, MPI_LONG, MPI_COMM_WORLD );
@@ -1458,6 +1622,9 @@ void Output_DumpData_Total_HDF5( const char *FileName )
    H5_SpaceID_ParData    = H5Screate_simple( 1, H5_SetDims_ParData, NULL );
    if ( H5_SpaceID_ParData < 0 )    Aux_Error( ERROR_INFO, "failed to create the space \"%s\" !!\n", "H5_SpaceID_ParData" );
 
+// file offsets of all datasets for the asynchronous output
+   long ParDataFileOffset[PAR_NATT_STORED];
+
    if ( MPI_Rank == 0 )
    {
 //    HDF5 file must be synchronized before being written by the next rank
@@ -1476,6 +1643,8 @@ void Output_DumpData_Total_HDF5( const char *FileName )
          H5_SetID_ParData = H5Dcreate( H5_GroupID_Particle, ParAttLabel[v], H5T_GAMER_REAL, H5_SpaceID_ParData,
                                        H5P_DEFAULT, H5_DataCreatePropList, H5P_DEFAULT );
          if ( H5_SetID_ParData < 0 )   Aux_Error( ERROR_INFO, "failed to create the dataset \"%s\" !!\n", ParAttLabel[v] );
+         if ( UseAsync  &&  amr->Par->NPar_Active_AllRank > 0 )
+            ParDataFileOffset[v] = GetDatasetOffset( H5_SetID_ParData, ParAttLabel[v] );
          H5_Status = H5Dclose( H5_SetID_ParData );
       }
 
@@ -1484,23 +1653,32 @@ void Output_DumpData_Total_HDF5( const char *FileName )
       H5_Status = H5Fclose( H5_FileID );
    } // if ( MPI_Rank == 0 )
 
+   if ( UseAsync )   MPI_Bcast( ParDataFileOffset, PAR_NATT_STORED, MPI_LONG, 0, MPI_COMM_WORLD );
+
 
 // 6-3. start to dump particle data (one level, one rank, and one attribute at a time)
 //      --> note that particles must be outputted in the same order as their associated patches
+//      --> all ranks write simultaneously for MPI-IO
+   if ( UseMPIIO )   MPI_Barrier( MPI_COMM_WORLD );
+
    for (int lv=0; lv<NLEVEL; lv++)
-   for (int TRank=0; TRank<MPI_NRank; TRank++)
+   for (int TRank=0; TRank<NWriteRound; TRank++)
    {
-      if ( MPI_Rank == TRank )
+      if ( MPI_Rank == TRank  ||  AllRankWrite )
       {
-//       HDF5 file must be synchronized before being written by the next rank
-         SyncHDF5File( FileName );
+//       reopen the file and group (collectively for MPI-IO)
+//       --> not required for the asynchronous output
+         if ( !UseAsync )
+         {
+//          HDF5 file must be synchronized before being written by the next rank
+            if ( !UseMPIIO )  SyncHDF5File( FileName );
 
-//       reopen the file and group
-         H5_FileID = H5Fopen( FileName, H5F_ACC_RDWR, H5P_DEFAULT );
-         if ( H5_FileID < 0 )    Aux_Error( ERROR_INFO, "failed to open the HDF5 file \"%s\" !!\n", FileName );
+            H5_FileID = H5Fopen( FileName, H5F_ACC_RDWR, H5_FileAccPropList );
+            if ( H5_FileID < 0 )    Aux_Error( ERROR_INFO, "failed to open the HDF5 file \"%s\" !!\n", FileName );
 
-         H5_GroupID_Particle = H5Gopen( H5_FileID, "Particle", H5P_DEFAULT );
-         if ( H5_GroupID_Particle < 0 )   Aux_Error( ERROR_INFO, "failed to open the group \"%s\" !!\n", "Particle" );
+            H5_GroupID_Particle = H5Gopen( H5_FileID, "Particle", H5P_DEFAULT );
+            if ( H5_GroupID_Particle < 0 )   Aux_Error( ERROR_INFO, "failed to open the group \"%s\" !!\n", "Particle" );
+         }
 
 
 //       6-3-1. determine the memory space
@@ -1516,12 +1694,20 @@ void Output_DumpData_Total_HDF5( const char *FileName )
          H5_Status = H5Sselect_hyperslab( H5_SpaceID_ParData, H5S_SELECT_SET, H5_Offset_ParData, NULL, H5_Count_ParData, NULL );
          if ( H5_Status < 0 )   Aux_Error( ERROR_INFO, "failed to create a hyperslab for the particle data !!\n" );
 
+         if ( amr->Par->NPar_Lv[lv] == 0 )
+         {
+            H5Sselect_none( H5_MemID_ParData );
+            H5Sselect_none( H5_SpaceID_ParData );
+         }
+
 
 //       output one particle attribute at one level in one rank at a time
 //       --> skip the last PAR_NATT_UNSTORED attributes since we do not want to store them on disk
          for (int v=0; v<PAR_NATT_STORED; v++)
          {
 //          6-3-3. collect particle data from all patches at the current target level
+            if ( UseAsync )   ParBuf1v1Lv = new real [ amr->Par->NPar_Lv[lv] ];
+
             NParInBuf = 0;
 
             for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
@@ -1539,24 +1725,39 @@ void Output_DumpData_Total_HDF5( const char *FileName )
 
 
 //          6-3-4. write data to disk
-            H5_SetID_ParData = H5Dopen( H5_GroupID_Particle, ParAttLabel[v], H5P_DEFAULT );
+//                 --> hand over the buffer to the I/O thread and allocate a new one for the asynchronous output
+            if ( UseAsync )
+            {
+               Output_DumpData_Async_Stage( ParDataFileOffset[v] + GParID_Offset[lv]*(long)sizeof(real),
+                                            amr->Par->NPar_Lv[lv], ParBuf1v1Lv );
 
-            H5_Status = H5Dwrite( H5_SetID_ParData, H5T_GAMER_REAL, H5_MemID_ParData, H5_SpaceID_ParData, H5P_DEFAULT, ParBuf1v1Lv );
-            if ( H5_Status < 0 )
-               Aux_Error( ERROR_INFO, "failed to write a particle attribute (lv %d, v %d) !!\n", lv, v );
+               ParBuf1v1Lv = NULL;
+            }
 
-            H5_Status = H5Dclose( H5_SetID_ParData );
+            else
+            {
+               H5_SetID_ParData = H5Dopen( H5_GroupID_Particle, ParAttLabel[v], H5P_DEFAULT );
+
+               H5_Status = H5Dwrite( H5_SetID_ParData, H5T_GAMER_REAL, H5_MemID_ParData, H5_SpaceID_ParData, H5_DataXferPropList, ParBuf1v1Lv );
+               if ( H5_Status < 0 )
+                  Aux_Error( ERROR_INFO, "failed to write a particle attribute (lv %d, v %d) !!\n", lv, v );
+
+               H5_Status = H5Dclose( H5_SetID_ParData );
+            }
          } // for (int v=0; v<PAR_NATT_STORED; v++)
 
 //       free resource
          H5_Status = H5Sclose( H5_MemID_ParData );
-         H5_Status = H5Gclose( H5_GroupID_Particle );
-         H5_Status = H5Fclose( H5_FileID );
-      } // if ( MPI_Rank == TRank )
+         if ( !UseAsync )
+         {
+            H5_Status = H5Gclose( H5_GroupID_Particle );
+            H5_Status = H5Fclose( H5_FileID );
+         }
+      } // if ( MPI_Rank == TRank  ||  AllRankWrite )
 
       MPI_Barrier( MPI_COMM_WORLD );
 
-   } // for (int TRank=0; TRank<MPI_NRank; TRank++) ... for (int lv=0; lv<NLEVEL; lv++)
+   } // for (int TRank=0; TRank<NWriteRound; TRank++) ... for (int lv=0; lv<NLEVEL; lv++)
 
    H5_Status = H5Sclose( H5_SpaceID_ParData );
 
@@ -1566,6 +1767,20 @@ void Output_DumpData_Total_HDF5( const char *FileName )
 
 
 
+// hand over the staged grid and particle data to the I/O thread
+   if ( UseAsync )
+   {
+      Output_DumpData_Async_Launch( FileName );
+
+//    the file must be complete before being validated below
+#     ifdef DEBUG_HDF5
+      Output_DumpData_Async_Wait();
+      MPI_Barrier( MPI_COMM_WORLD );
+#     endif
+   }
+
+
+
 // 7. check
 #  ifdef DEBUG_HDF5
    if ( MPI_Rank == 0 )
@@ -1674,6 +1889,8 @@ void Output_DumpData_Total_HDF5( const char *FileName )
    H5_Status = H5Tclose( H5_TypeID_Com_InputPara );
    H5_Status = H5Sclose( H5_SpaceID_Scalar );
    H5_Status = H5Pclose( H5_DataCreatePropList );
+   if ( H5_FileAccPropList  != H5P_DEFAULT )   H5_Status = H5Pclose( H5_FileAccPropList  );
+   if ( H5_DataXferPropList != H5P_DEFAULT )   H5_Status = H5Pclose( H5_DataXferPropList );
 
    delete [] NPatchAllRank;
 
@@ -1720,13 +1937,14 @@ void Output_DumpData_Total_HDF5( const char *FileName )
 //
 // Parameter   :  KeyInfo      : Pointer to be filled in
 //                NFieldStored : Number of grid fields to be stored on disk
+//                NPatchAlloc  : Number of allocated (active+inactive) patches at each level summed over all ranks
 //-------------------------------------------------------------------------------------------------------
-void FillIn_KeyInfo( KeyInfo_t &KeyInfo, const int NFieldStored )
+void FillIn_KeyInfo( KeyInfo_t &KeyInfo, const int NFieldStored, const int NPatchAlloc[] )
 {
 
    const time_t CalTime = time( NULL );   // calendar time
 
-   KeyInfo.FormatVersion        = 2450;
+   KeyInfo.FormatVersion        = 2466;
    KeyInfo.Model                = MODEL;
    KeyInfo.NLevel               = NLEVEL;
    KeyInfo.NCompFluid           = NCOMP_FLUID;
@@ -1783,6 +2001,7 @@ void FillIn_KeyInfo( KeyInfo_t &KeyInfo, const int NFieldStored )
       KeyInfo.CellScale     [lv] = amr->scale    [lv];
       KeyInfo.NPatch        [lv] = NPatchTotal   [lv];
       KeyInfo.AdvanceCounter[lv] = AdvanceCounter[lv];
+      KeyInfo.NPatchAlloc   [lv] = NPatchAlloc   [lv];
       KeyInfo.dTime_AllLv   [lv] = dTime_AllLv   [lv];
    }
 
@@ -1940,7 +2159,7 @@ void FillIn_Makefile( Makefile_t &Makefile )
    Makefile.RandomNumber           = RANDOM_NUMBER;
 
    Makefile.NLevel                 = NLEVEL;
-   Makefile.MaxPatch               = MAX_PATCH;
+   Makefile.MaxPatch               = -1;   // no compile-time limit on the number of patches
 
 
 // model-dependent options
@@ -2336,6 +2555,8 @@ void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char Fiel
    InputPara.Par_ImproveAcc          = amr->Par->ImproveAcc;
    InputPara.Par_PredictPos          = amr->Par->PredictPos;
    InputPara.Par_TracerVelCorr       = amr->Par->TracerVelCorr;
+   InputPara.Par_FixedPointDepo      = amr->Par->FixedPointDepo;
+   InputPara.Par_SortInterval        = amr->Par->SortInterval;
    InputPara.Par_RemoveCell          = amr->Par->RemoveCell;
    InputPara.Opt__FreezePar          = OPT__FREEZE_PAR;
    InputPara.Par_GhostSize           = amr->Par->GhostSize;
@@ -2373,6 +2594,9 @@ void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char Fiel
    InputPara.Dt__SyncChildrenLv      = DT__SYNC_CHILDREN_LV;
    InputPara.Opt__DtUser             = OPT__DT_USER;
    InputPara.Opt__DtLevel            = OPT__DT_LEVEL;
+#  if ( MODEL == HYDRO )
+   InputPara.Opt__DtFluFused         = OPT__DT_FLU_FUSED;
+#  endif
    InputPara.Opt__RecordDt           = OPT__RECORD_DT;
    InputPara.AutoReduceDt            = AUTO_REDUCE_DT;
    InputPara.AutoReduceDtFactor      = AUTO_REDUCE_DT_FACTOR;
@@ -2420,6 +2644,9 @@ void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char Fiel
 #  endif
    InputPara.Opt__ReuseMemory        = OPT__REUSE_MEMORY;
    InputPara.Opt__MemoryPool         = OPT__MEMORY_POOL;
+   InputPara.MemoryPool_Headroom     = MEMORY_POOL_HEADROOM;
+   InputPara.MemoryPool_MaxMB        = MEMORY_POOL_MAX_MB;
+   InputPara.Opt__SlabAlloc          = OPT__SLAB_ALLOC;
 
 // load balance
 #  ifdef LOAD_BALANCE
@@ -2428,6 +2655,10 @@ void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char Fiel
    InputPara.LB_Par_Weight           = amr->LB->Par_Weight;
 #  endif
    InputPara.Opt__RecordLoadBalance  = OPT__RECORD_LOAD_BALANCE;
+   InputPara.Opt__LB_Diffuse         = OPT__LB_DIFFUSE;
+   InputPara.Opt__LB_MeasureCost     = OPT__LB_MEASURE_COST;
+   InputPara.LB_MeasureCostWeight    = LB_MEASURE_COST_WEIGHT;
+   InputPara.Opt__LB_NeighborMPI     = OPT__LB_NEIGHBOR_MPI;
 #  endif
    InputPara.Opt__MinimizeMPIBarrier = OPT__MINIMIZE_MPI_BARRIER;
 
@@ -2486,6 +2717,10 @@ void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char Fiel
 #  endif
 
    InputPara.Opt__OverlapMPI         = OPT__OVERLAP_MPI;
+   InputPara.Opt__CPU_Pipeline       = OPT__CPU_PIPELINE;
+   InputPara.CPU_Pipeline_NThread    = CPU_PIPELINE_NTHREAD;
+   InputPara.Opt__PrepCache          = OPT__PREP_CACHE;
+   InputPara.PrepCache_MaxMB         = PREP_CACHE_MAX_MB;
    InputPara.Opt__ResetFluid         = OPT__RESET_FLUID;
    InputPara.Opt__FreezeFluid        = OPT__FREEZE_FLUID;
 #  if ( MODEL == HYDRO  ||  MODEL == ELBDM )
@@ -2518,10 +2753,14 @@ void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char Fiel
    InputPara.MG_NPreSmooth           = MG_NPRE_SMOOTH;
    InputPara.MG_NPostSmooth          = MG_NPOST_SMOOTH;
    InputPara.MG_ToleratedError       = MG_TOLERATED_ERROR;
+   InputPara.Opt__PoiLevelMG         = OPT__POI_LEVEL_MG;
 #  endif
    InputPara.Pot_GPU_NPGroup         = POT_GPU_NPGROUP;
    InputPara.Opt__GraP5Gradient      = OPT__GRA_P5_GRADIENT;
    InputPara.Opt__SelfGravity        = OPT__SELF_GRAVITY;
+   InputPara.Opt__FFT_Pencil         = OPT__FFT_PENCIL;
+   InputPara.Opt__FFTW_Startup       = OPT__FFTW_STARTUP;
+   InputPara.Opt__FFTW_Wisdom        = OPT__FFTW_WISDOM;
    InputPara.Opt__ExtAcc             = OPT__EXT_ACC;
    InputPara.Opt__ExtPot             = OPT__EXT_POT;
    InputPara.ExtPotTable_Name        = EXT_POT_TABLE_NAME;
@@ -2665,6 +2904,9 @@ void FillIn_InputPara( InputPara_t &InputPara, const int NFieldStored, char Fiel
    InputPara.Opt__Output_UserField   = OPT__OUTPUT_USER_FIELD;
    InputPara.Opt__Output_Mode        = OPT__OUTPUT_MODE;
    InputPara.Opt__Output_Restart     = OPT__OUTPUT_RESTART;
+   InputPara.Opt__Output_HDF5_MPIIO  = OPT__OUTPUT_HDF5_MPIIO;
+   InputPara.Opt__Output_Async       = OPT__OUTPUT_ASYNC;
+   InputPara.Output_Async_MaxMB      = OUTPUT_ASYNC_MAX_MB;
    InputPara.Opt__Output_Step        = OUTPUT_STEP;
    InputPara.Opt__Output_Dt          = OUTPUT_DT;
    InputPara.Output_PartX            = OUTPUT_PART_X;
@@ -2814,6 +3056,7 @@ void GetCompound_KeyInfo( hid_t &H5_TypeID )
 
    H5Tinsert( H5_TypeID, "Step",                 HOFFSET(KeyInfo_t,Step                ), H5T_NATIVE_LONG         );
    H5Tinsert( H5_TypeID, "AdvanceCounter",       HOFFSET(KeyInfo_t,AdvanceCounter      ), H5_TypeID_Arr_NLvLong   );
+   H5Tinsert( H5_TypeID, "NPatchAlloc",          HOFFSET(KeyInfo_t,NPatchAlloc         ), H5_TypeID_Arr_NLvInt    );
    H5Tinsert( H5_TypeID, "NFieldStored",         HOFFSET(KeyInfo_t,NFieldStored        ), H5T_NATIVE_INT          );
    H5Tinsert( H5_TypeID, "NMagStored",           HOFFSET(KeyInfo_t,NMagStored          ), H5T_NATIVE_INT          );
 #  ifdef PARTICLE
@@ -3181,6 +3424,8 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
    H5Tinsert( H5_TypeID, "Par_ImproveAcc",          HOFFSET(InputPara_t,Par_ImproveAcc         ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "Par_PredictPos",          HOFFSET(InputPara_t,Par_PredictPos         ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "Par_TracerVelCorr",       HOFFSET(InputPara_t,Par_TracerVelCorr      ), H5T_NATIVE_INT     );
+   H5Tinsert( H5_TypeID, "Par_FixedPointDepo",      HOFFSET(InputPara_t,Par_FixedPointDepo     ), H5T_NATIVE_INT     );
+   H5Tinsert( H5_TypeID, "Par_SortInterval",        HOFFSET(InputPara_t,Par_SortInterval       ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "Par_RemoveCell",          HOFFSET(InputPara_t,Par_RemoveCell         ), H5T_NATIVE_DOUBLE  );
    H5Tinsert( H5_TypeID, "Opt__FreezePar",          HOFFSET(InputPara_t,Opt__FreezePar         ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "Par_GhostSize",           HOFFSET(InputPara_t,Par_GhostSize          ), H5T_NATIVE_INT     );
@@ -3226,6 +3471,9 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
    H5Tinsert( H5_TypeID, "Dt__SyncChildrenLv",      HOFFSET(InputPara_t,Dt__SyncChildrenLv     ), H5T_NATIVE_DOUBLE  );
    H5Tinsert( H5_TypeID, "Opt__DtUser",             HOFFSET(InputPara_t,Opt__DtUser            ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "Opt__DtLevel",            HOFFSET(InputPara_t,Opt__DtLevel           ), H5T_NATIVE_INT     );
+#  if ( MODEL == HYDRO )
+   H5Tinsert( H5_TypeID, "Opt__DtFluFused",         HOFFSET(InputPara_t,Opt__DtFluFused        ), H5T_NATIVE_INT     );
+#  endif
    H5Tinsert( H5_TypeID, "Opt__RecordDt",           HOFFSET(InputPara_t,Opt__RecordDt          ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "AutoReduceDt",            HOFFSET(InputPara_t,AutoReduceDt           ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "AutoReduceDtFactor",      HOFFSET(InputPara_t,AutoReduceDtFactor     ), H5T_NATIVE_DOUBLE  );
@@ -3274,6 +3522,9 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
 #  endif
    H5Tinsert( H5_TypeID, "Opt__ReuseMemory",        HOFFSET(InputPara_t,Opt__ReuseMemory       ), H5T_NATIVE_INT     );
    H5Tinsert( H5_TypeID, "Opt__MemoryPool",         HOFFSET(InputPara_t,Opt__MemoryPool        ), H5T_NATIVE_INT     );
+   H5Tinsert( H5_TypeID, "MemoryPool_Headroom",     HOFFSET(InputPara_t,MemoryPool_Headroom    ), H5T_NATIVE_DOUBLE  );
+   H5Tinsert( H5_TypeID, "MemoryPool_MaxMB",        HOFFSET(InputPara_t,MemoryPool_MaxMB       ), H5T_NATIVE_DOUBLE  );
+   H5Tinsert( H5_TypeID, "Opt__SlabAlloc",          HOFFSET(InputPara_t,Opt__SlabAlloc         ), H5T_NATIVE_INT     );
 
 // load balance
 #  ifdef LOAD_BALANCE
@@ -3282,6 +3533,10 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
    H5Tinsert( H5_TypeID, "LB_Par_Weight",           HOFFSET(InputPara_t,LB_Par_Weight          ), H5T_NATIVE_DOUBLE  );
 #  endif
    H5Tinsert( H5_TypeID, "Opt__RecordLoadBalance",  HOFFSET(InputPara_t,Opt__RecordLoadBalance ), H5T_NATIVE_INT     );
+   H5Tinsert( H5_TypeID, "Opt__LB_Diffuse",         HOFFSET(InputPara_t,Opt__LB_Diffuse        ), H5T_NATIVE_INT     );
+   H5Tinsert( H5_TypeID, "Opt__LB_MeasureCost",     HOFFSET(InputPara_t,Opt__LB_MeasureCost    ), H5T_NATIVE_INT     );
+   H5Tinsert( H5_TypeID, "LB_MeasureCostWeight",    HOFFSET(InputPara_t,LB_MeasureCostWeight   ), H5T_NATIVE_DOUBLE  );
+   H5Tinsert( H5_TypeID, "Opt__LB_NeighborMPI",     HOFFSET(InputPara_t,Opt__LB_NeighborMPI    ), H5T_NATIVE_INT     );
 #  endif
    H5Tinsert( H5_TypeID, "Opt__MinimizeMPIBarrier", HOFFSET(InputPara_t,Opt__MinimizeMPIBarrier), H5T_NATIVE_INT     );
 
@@ -3350,6 +3605,10 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
 #  endif
 
    H5Tinsert( H5_TypeID, "Opt__OverlapMPI",         HOFFSET(InputPara_t,Opt__OverlapMPI        ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Opt__CPU_Pipeline",       HOFFSET(InputPara_t,Opt__CPU_Pipeline      ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "CPU_Pipeline_NThread",    HOFFSET(InputPara_t,CPU_Pipeline_NThread   ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Opt__PrepCache",          HOFFSET(InputPara_t,Opt__PrepCache         ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "PrepCache_MaxMB",         HOFFSET(InputPara_t,PrepCache_MaxMB        ), H5T_NATIVE_DOUBLE           );
    H5Tinsert( H5_TypeID, "Opt__ResetFluid",         HOFFSET(InputPara_t,Opt__ResetFluid        ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__FreezeFluid",        HOFFSET(InputPara_t,Opt__FreezeFluid       ), H5T_NATIVE_INT              );
 #  if ( MODEL == HYDRO  ||  MODEL == ELBDM )
@@ -3382,10 +3641,14 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
    H5Tinsert( H5_TypeID, "MG_NPreSmooth",           HOFFSET(InputPara_t,MG_NPreSmooth          ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "MG_NPostSmooth",          HOFFSET(InputPara_t,MG_NPostSmooth         ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "MG_ToleratedError",       HOFFSET(InputPara_t,MG_ToleratedError      ), H5T_NATIVE_DOUBLE           );
+   H5Tinsert( H5_TypeID, "Opt__PoiLevelMG",         HOFFSET(InputPara_t,Opt__PoiLevelMG        ), H5T_NATIVE_INT              );
 #  endif
    H5Tinsert( H5_TypeID, "Pot_GPU_NPGroup",         HOFFSET(InputPara_t,Pot_GPU_NPGroup        ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__GraP5Gradient",      HOFFSET(InputPara_t,Opt__GraP5Gradient     ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__SelfGravity",        HOFFSET(InputPara_t,Opt__SelfGravity       ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Opt__FFT_Pencil",         HOFFSET(InputPara_t,Opt__FFT_Pencil        ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Opt__FFTW_Startup",       HOFFSET(InputPara_t,Opt__FFTW_Startup      ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Opt__FFTW_Wisdom",        HOFFSET(InputPara_t,Opt__FFTW_Wisdom       ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__ExtAcc",             HOFFSET(InputPara_t,Opt__ExtAcc            ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__ExtPot",             HOFFSET(InputPara_t,Opt__ExtPot            ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "ExtPotTable_Name",        HOFFSET(InputPara_t,ExtPotTable_Name       ), H5_TypeID_VarStr            );
@@ -3509,6 +3772,9 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
    H5Tinsert( H5_TypeID, "Opt__Output_UserField",   HOFFSET(InputPara_t,Opt__Output_UserField  ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__Output_Mode",        HOFFSET(InputPara_t,Opt__Output_Mode       ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__Output_Restart",     HOFFSET(InputPara_t,Opt__Output_Restart    ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Opt__Output_HDF5_MPIIO",  HOFFSET(InputPara_t,Opt__Output_HDF5_MPIIO ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Opt__Output_Async",       HOFFSET(InputPara_t,Opt__Output_Async      ), H5T_NATIVE_INT              );
+   H5Tinsert( H5_TypeID, "Output_Async_MaxMB",      HOFFSET(InputPara_t,Output_Async_MaxMB     ), H5T_NATIVE_DOUBLE           );
    H5Tinsert( H5_TypeID, "Opt__Output_Step",        HOFFSET(InputPara_t,Opt__Output_Step       ), H5T_NATIVE_INT              );
    H5Tinsert( H5_TypeID, "Opt__Output_Dt",          HOFFSET(InputPara_t,Opt__Output_Dt         ), H5T_NATIVE_DOUBLE           );
    H5Tinsert( H5_TypeID, "Output_PartX",            HOFFSET(InputPara_t,Output_PartX           ), H5T_NATIVE_DOUBLE           );
@@ -3628,4 +3894,30 @@ void GetCompound_InputPara( hid_t &H5_TypeID, const int NFieldStored )
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  GetDatasetOffset
+// Description :  Return the file offset in bytes of an allocated contiguous dataset
+//
+// Note        :  1. Used by the asynchronous output, which writes raw data to the returned offset directly
+//                2. Dataset storage must be allocated when creating the dataset (i.e., H5D_ALLOC_TIME_EARLY)
+//
+// Parameter   :  H5_SetID : HDF5 dataset ID
+//                SetName  : Name of the dataset (for error messages only)
+//
+// Return      :  File offset of the raw data
+//-------------------------------------------------------------------------------------------------------
+long GetDatasetOffset( const hid_t H5_SetID, const char *SetName )
+{
+
+   const haddr_t Offset = H5Dget_offset( H5_SetID );
+
+   if ( Offset == HADDR_UNDEF )
+      Aux_Error( ERROR_INFO, "failed to get the file offset of the dataset \"%s\" !!\n", SetName );
+
+   return (long)Offset;
+
+} // FUNCTION : GetDatasetOffset
+
+
+
 #endif // #ifdef SUPPORT_HDF5
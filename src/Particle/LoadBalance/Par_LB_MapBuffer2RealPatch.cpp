@@ -174,7 +174,7 @@ void Par_LB_MapBuffer2RealPatch( const int lv, const int  Buff_NPatchTotal, int
 #  endif
 
 // 2-1. sort the received LBIdxlist again and find the matching real patch indices
-   Mis_Heapsort( Real_NPatchTotal, Real_LBIdxList_Sort, Real_LBIdxList_Sort_IdxTable );
+   Mis_RadixSort( Real_NPatchTotal, Real_LBIdxList_Sort, Real_LBIdxList_Sort_IdxTable );
 
    Mis_Matching_int( amr->NPatchComma[lv][1], amr->LB->IdxList_Real[lv], Real_NPatchTotal, Real_LBIdxList_Sort,
                      Match_LBIdxList );
@@ -82,7 +82,7 @@ void Par_FindHomePatch_UniformGrid( const int lv, const bool OldParOnly,
    }
 
 // sort the LBIdx list
-   Mis_Heapsort( NTarPar, HomeLBIdx, HomeLBIdx_IdxTable );
+   Mis_RadixSort( NTarPar, HomeLBIdx, HomeLBIdx_IdxTable );
 
 // construct and sort the LBIdx list of all real patches
 // --> do not use amr->LB->IdxList_Real[] since it may not be constructed yet
@@ -91,7 +91,7 @@ void Par_FindHomePatch_UniformGrid( const int lv, const bool OldParOnly,
 
    for (int PID=0; PID<NReal; PID++)   RealPatchLBIdx[PID] = amr->patch[0][lv][PID]->LB_Idx;
 
-   Mis_Heapsort( NReal, RealPatchLBIdx, RealPatchLBIdx_IdxTable );
+   Mis_RadixSort( NReal, RealPatchLBIdx, RealPatchLBIdx_IdxTable );
 
 // LBIdx --> home (real) patch indices
    Mis_Matching_int( NReal, RealPatchLBIdx, NTarPar, HomeLBIdx, MatchIdx );
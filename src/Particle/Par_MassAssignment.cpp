@@ -9,6 +9,12 @@ static bool FarAwayParticle( real ParPosX, real ParPosY, real ParPosZ, const boo
 void SortParticle( const long NPar, const real *PosX, const real *PosY, const real *PosZ, int *IdxTable );
 #endif
 
+// fixed-point accumulator for amr->Par->FixedPointDepo
+// --> the maximum particle density in each call is mapped to below 2^FIXED_POINT_NBIT, which leaves
+//     127-FIXED_POINT_NBIT bits for accumulating the contributions of different particles to the same cell
+typedef __int128 FixedPoint_t;
+#define FIXED_POINT_NBIT   86
+
 
 
 
@@ -39,6 +45,13 @@ void SortParticle( const long NPar, const real *PosX, const real *PosY, const re
 //                   --> This is the reason for the check "if ( Periodic[d]  &&  RhoSize > PeriodicSize[d] ) ..."
 //                6. For bitwise reproducibility, particles are sorted by their position before mass deposition
 //                   --> Also refer to the note of the routine SortParticle[]
+//                7. For amr->Par->FixedPointDepo (PAR_FIXED_POINT_DEPO), the mass density is first accumulated
+//                   with fixed-point numbers and then added to Rho[]
+//                   --> Integer addition is associative, so the result does not depend on the particle order and
+//                       particles are NOT sorted even for bitwise reproducibility
+//                   --> The fixed-point scale is set by the maximum particle density in each call, which also
+//                       does not depend on the particle order
+//                   --> Contributions smaller than 2^-FIXED_POINT_NBIT of that density are truncated
 //
 // Parameter   :  ParList         : List of target particle IDs
 //                NPar            : Number of particles
@@ -159,10 +172,18 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
 
 // 3-1/2: sort particles by their position to fix the order of mass assignment
 //        --> necessary for achieving bitwise reproducibility
+//        --> unnecessary for FixedPointDepo
+   const bool FixedPoint = amr->Par->FixedPointDepo;
+
 #  ifdef BITWISE_REPRODUCIBILITY
-   int *Sort_IdxTable = new int [NPar];   // it will fail if "long" is actually required for NPar
+   int *Sort_IdxTable = NULL;
+
+   if ( !FixedPoint )
+   {
+      Sort_IdxTable = new int [NPar];   // it will fail if "long" is actually required for NPar
 
-   SortParticle( NPar, Pos[0], Pos[1], Pos[2], Sort_IdxTable );
+      SortParticle( NPar, Pos[0], Pos[1], Pos[2], Sort_IdxTable );
+   }
 #  endif
 
 
@@ -174,6 +195,40 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
    typedef real (*vla)[RhoSize][RhoSize];
    vla Rho3D = ( vla )Rho;
 
+// fixed-point accumulators for FixedPointDepo
+// --> contribution c is stored as c*2^FP_Shift, where FP_Shift is set by the maximum particle density
+//     so that all contributions are smaller than 2^FIXED_POINT_NBIT
+   typedef FixedPoint_t (*vla_fp)[RhoSize][RhoSize];
+   FixedPoint_t *RhoFP    = NULL;
+   int           FP_Shift = 0;
+
+   if ( FixedPoint )
+   {
+      real MaxDens = (real)0.0;
+
+      if ( UnitDens )   MaxDens = (real)1.0;
+      else
+      {
+         for (long p=0; p<NPar; p++)
+         {
+            if ( PType[p] == PTYPE_TRACER )  continue;
+
+            const real ParDens = Mass[p]*_dh3;
+            MaxDens = MAX( MaxDens, ParDens );
+         }
+      }
+
+      int MaxDens_Exp;
+      frexp( (double)MaxDens, &MaxDens_Exp );   // MaxDens < 2^MaxDens_Exp
+      FP_Shift = FIXED_POINT_NBIT - MaxDens_Exp;
+
+      RhoFP = new FixedPoint_t [ CUBE(RhoSize) ];
+
+      for (int t=0; t<CUBE(RhoSize); t++)    RhoFP[t] = 0;
+   }
+
+   vla_fp RhoFP3D = ( vla_fp )RhoFP;
+
    int  idx[3];      // array index for Rho
    real ParDens;     // mass density of the cloud
    real EdgeWithGhostL[3], EdgeWithGhostR[3], PeriodicSize_Phy[3];
@@ -196,7 +251,7 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
          for (long p=0; p<NPar; p++)
          {
 #           ifdef BITWISE_REPRODUCIBILITY
-            Idx = Sort_IdxTable[p];
+            Idx = ( FixedPoint ) ? p : Sort_IdxTable[p];
 #           else
             Idx = p;
 #           endif
@@ -240,7 +295,12 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
             else              ParDens = Mass[Idx]*_dh3;
 
             if (  WithinRho( idx, RhoSize )  )
-               Rho3D[ idx[2] ][ idx[1] ][ idx[0] ] += ParDens;
+            {
+               if ( FixedPoint )
+                  RhoFP3D[ idx[2] ][ idx[1] ][ idx[0] ] += (FixedPoint_t)ldexp( (double)ParDens, FP_Shift );
+               else
+                  Rho3D  [ idx[2] ][ idx[1] ][ idx[0] ] += ParDens;
+            }
          } // for (long p=0; p<NPar; p++)
       } // PAR_INTERP_NGP
       break;
@@ -256,7 +316,7 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
          for (long p=0; p<NPar; p++)
          {
 #           ifdef BITWISE_REPRODUCIBILITY
-            Idx = Sort_IdxTable[p];
+            Idx = ( FixedPoint ) ? p : Sort_IdxTable[p];
 #           else
             Idx = p;
 #           endif
@@ -314,7 +374,12 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
             for (int i=0; i<2; i++) {  idx[0] = idxLR[i][0];
 
                if (  WithinRho( idx, RhoSize )  )
-                  Rho3D[ idx[2] ][ idx[1] ][ idx[0] ] += ParDens*Frac[i][0]*Frac[j][1]*Frac[k][2];
+               {
+                  if ( FixedPoint )
+                     RhoFP3D[ idx[2] ][ idx[1] ][ idx[0] ] += (FixedPoint_t)ldexp( ParDens*Frac[i][0]*Frac[j][1]*Frac[k][2], FP_Shift );
+                  else
+                     Rho3D  [ idx[2] ][ idx[1] ][ idx[0] ] += ParDens*Frac[i][0]*Frac[j][1]*Frac[k][2];
+               }
 
             }}}
          } // for (long p=0; p<NPar; p++)
@@ -332,7 +397,7 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
          for (long p=0; p<NPar; p++)
          {
 #           ifdef BITWISE_REPRODUCIBILITY
-            Idx = Sort_IdxTable[p];
+            Idx = ( FixedPoint ) ? p : Sort_IdxTable[p];
 #           else
             Idx = p;
 #           endif
@@ -392,7 +457,12 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
             for (int i=0; i<3; i++) {  idx[0] = idxLCR[i][0];
 
                if (  WithinRho( idx, RhoSize )  )
-                  Rho3D[ idx[2] ][ idx[1] ][ idx[0] ] += ParDens*Frac[i][0]*Frac[j][1]*Frac[k][2];
+               {
+                  if ( FixedPoint )
+                     RhoFP3D[ idx[2] ][ idx[1] ][ idx[0] ] += (FixedPoint_t)ldexp( ParDens*Frac[i][0]*Frac[j][1]*Frac[k][2], FP_Shift );
+                  else
+                     Rho3D  [ idx[2] ][ idx[1] ][ idx[0] ] += ParDens*Frac[i][0]*Frac[j][1]*Frac[k][2];
+               }
             }}}
          } // for (long p=0; p<NPar; p++)
       } // PAR_INTERP_TSC
@@ -402,7 +472,16 @@ void Par_MassAssignment( const long *ParList, const long NPar, const ParInterp_t
    } // switch ( IntScheme )
 
 
-// 5. free memory
+// 5. add the fixed-point accumulators to Rho[]
+   if ( FixedPoint )
+   {
+      for (int t=0; t<CUBE(RhoSize); t++)    Rho[t] += (real)ldexp( (double)RhoFP[t], -FP_Shift );
+
+      delete [] RhoFP;
+   }
+
+
+// 6. free memory
    if ( !UseInputMassPos )
    {
       delete [] Mass;
@@ -511,7 +590,7 @@ bool FarAwayParticle( real ParPosX, real ParPosY, real ParPosZ, const bool Perio
 //                   created at different time but the same position may still have the same position for a
 //                   while if velocity*dt is on the order of round-off errors
 //                   --> Not supported yet since we may not have the velocity information (e.g., when InputMassPos is adopted)
-//                2. Currently IdxTable has the type "int" instead of "long" since Mis_Heapsort() doesn't
+//                2. Currently IdxTable has the type "int" instead of "long" since Mis_RadixSort() doesn't
 //                   support "long" yet...
 //
 // Parameter   :  NPar     : Number of particles
@@ -532,7 +611,7 @@ void SortParticle( const long NPar, const real *PosX, const real *PosY, const re
 
 
 // 1. sort by x
-   Mis_Heapsort( NPar, PosX_Sorted, IdxTable );
+   Mis_RadixSort( NPar, PosX_Sorted, IdxTable );
 
 
 // 2. sort by y
@@ -555,7 +634,7 @@ void SortParticle( const long NPar, const real *PosX, const real *PosY, const re
             PosY_Sorted     [y] = PosY[ SortByX_IdxTable[y] ];
          }
 
-         Mis_Heapsort( NParSameX, PosY_Sorted, SortByY_IdxTable );
+         Mis_RadixSort( NParSameX, PosY_Sorted, SortByY_IdxTable );
 
          for (long y=0; y<NParSameX; y++)    IdxTable[ x + y ] = SortByX_IdxTable[ SortByY_IdxTable[y] ];
 
@@ -579,7 +658,7 @@ void SortParticle( const long NPar, const real *PosX, const real *PosY, const re
                   PosZ_Sorted     [z] = PosZ[ SortByY_IdxTable[z] ];
                }
 
-               Mis_Heapsort( NParSameY, PosZ_Sorted, SortByZ_IdxTable );
+               Mis_RadixSort( NParSameY, PosZ_Sorted, SortByZ_IdxTable );
 
                for (long z=0; z<NParSameY; z++)    IdxTable[ x + y + z ] = SortByY_IdxTable[ SortByZ_IdxTable[z] ];
 
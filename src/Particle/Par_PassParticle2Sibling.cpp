@@ -65,9 +65,33 @@ void Par_PassParticle2Sibling( const int lv, const bool TimingSendPar )
       }
    }
 
+// shared variables for removing the particles lying outside the active region of all threads at once
+#  ifdef OPENMP
+   const int NT = omp_get_max_threads();
+#  else
+   const int NT = 1;
+#  endif
+   long *NPar_Outside_Thread = new long [NT];   // number of particles outside the active region found by each thread
+   long *OutsideParID_All    = NULL;            // IDs of all particles outside the active region
+   long  NPar_Outside_All    = 0;
+
+   for (int t=0; t<NT; t++)   NPar_Outside_Thread[t] = 0;
+
 #  pragma omp parallel private( NPar, NGuess, NPar_Remove, ArraySize, ijk, TSib, ParID, RemoveParList, EdgeL, EdgeR )
    {
 
+#  ifdef OPENMP
+   const int TID = omp_get_thread_num();
+#  else
+   const int TID = 0;
+#  endif
+
+// per-thread staging buffer of the particles lying outside the active region
+// --> they will be removed from the particle repository only once after looping over all patches
+   long  Stage_NParMax = 0;
+   long  Stage_NPar    = 0;
+   long *Stage_ParID   = NULL;
+
 #  pragma omp for reduction( +:NPar_Remove_Tot ) schedule( PAR_OMP_SCHED, PAR_OMP_SCHED_CHUNK )
 // loop over all **real** patches
    for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
@@ -154,13 +178,15 @@ void Par_PassParticle2Sibling( const int lv, const bool TimingSendPar )
             RemoveParList[ NPar_Remove ++ ] = p;
             NPar_Remove_Tot ++;
 
-//          use OpenMP critical construct since RemoveOneParticle will modify NPar_Active/Inactive, which are global variables
-//          --> note that the order of which thread calls RemoveOneParticle() is nondeterministic and may change from run to run
-//              --> order of particles stored in the particle repository (i.e., their particle ID) may change from run to run
-//              --> particle text file may change from run to run since it's dumped according to the order of particle ID
-//          --> but it's not an issue since the actual data of each particle will not be affected
-#           pragma omp critical
-            amr->Par->RemoveOneParticle( ParID, PAR_INACTIVE_OUTSIDE );
+//          record the particle in the staging buffer instead of calling RemoveOneParticle() here, which would
+//          require an OpenMP critical construct since it modifies NPar_Active/Inactive
+            if ( Stage_NPar >= Stage_NParMax )
+            {
+               Stage_NParMax = MAX( 2*Stage_NParMax, (long)NGuess );
+               Stage_ParID   = (long*)realloc( Stage_ParID, Stage_NParMax*sizeof(long) );
+            }
+
+            Stage_ParID[ Stage_NPar ++ ] = ParID;
 
             if ( OPT__VERBOSE )
                Aux_Message( stderr, "\nWARNING : removing particle %10d (Pos = [%14.7e, %14.7e, %14.7e], Time = %13.7e)\n",
@@ -218,7 +244,7 @@ void Par_PassParticle2Sibling( const int lv, const bool TimingSendPar )
       } // for (int p=0; p<NPar; p++)
 
 
-//    3. remove the escaping particles (set amr->Par->NPar_Lv later due to OpenMP)
+//    3-1. remove the escaping particles from the patch (set amr->Par->NPar_Lv later due to OpenMP)
       const real *PType = amr->Par->Type;
       amr->patch[0][lv][PID]->RemoveParticle( NPar_Remove, RemoveParList, NULL,
                                               RemoveAllPar_No, PType );
@@ -226,27 +252,62 @@ void Par_PassParticle2Sibling( const int lv, const bool TimingSendPar )
 
    } // for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
 
+
+// 3-2. collect the particles lying outside the active region from all threads
+//      --> each thread copies its staging buffer to the segment of OutsideParID_All[] given by the prefix sum
+//          of NPar_Outside_Thread[]
+   NPar_Outside_Thread[TID] = Stage_NPar;
+
+#  pragma omp barrier
+
+#  pragma omp single
+   {
+      for (int t=0; t<NT; t++)   NPar_Outside_All += NPar_Outside_Thread[t];
+
+      OutsideParID_All = new long [NPar_Outside_All];
+   } // implicit barrier
+
+   long Stage_Offset = 0;
+   for (int t=0; t<TID; t++)  Stage_Offset += NPar_Outside_Thread[t];
+
+   for (long p=0; p<Stage_NPar; p++)   OutsideParID_All[ Stage_Offset + p ] = Stage_ParID[p];
+
+   free( Stage_ParID );
+
    } // end of OpenMP parallel region
 
 
+// 3-3. remove these particles from the particle repository at once
+//      --> order of particles stored in InactiveParList[] follows the thread ID and may change with the
+//          OpenMP schedule, but it's not an issue since the actual data of each particle will not be affected
+   amr->Par->RemoveParticles( NPar_Outside_All, OutsideParID_All, PAR_INACTIVE_OUTSIDE );
+
+   delete [] NPar_Outside_Thread;
+   delete [] OutsideParID_All;
+
+
 // update the global variable NPar_Lv after the OpenMP parallel region
    amr->Par->NPar_Lv[lv] -= NPar_Remove_Tot;
 
 
    if ( NPar_Remove_Tot > 0 )
    {
+//    OpenMP is applied since each target patch only receives particles from its own sibling patches
+//    --> AddParticle() modifies amr->Par->NPar_Lv[], which is accumulated by NPar_Add_Tot and updated later
+      long NPar_Add_Tot = 0;
+
 //    loop over all real **and buffer** patches
+#     pragma omp parallel for reduction( +:NPar_Add_Tot ) schedule( PAR_OMP_SCHED, PAR_OMP_SCHED_CHUNK )
       for (int PID=0; PID<amr->num[lv]; PID++)
       {
 //       4. gather the escaping particles from the 26 sibling patches (coarse --> coarse)
          for (int s=0; s<26; s++)
          {
-            SibPID = amr->patch[0][lv][PID]->sibling[s];
+            const int SibPID = amr->patch[0][lv][PID]->sibling[s];
 
 //          SibPID can be negative for non-periodic BC.
             if ( SibPID >= 0  &&  amr->patch[0][lv][SibPID]->NPar_Escp[ MirSib[s] ] > 0 )
             {
-//###NOTE : No OpenMP since AddParticle will modify amr->Par->NPar_Lv[]
 #              ifdef DEBUG_PARTICLE
                if ( SibPID >= amr->NPatchComma[lv][1] )
                   Aux_Error( ERROR_INFO, "buffer patch cannot have escaping particles (PID %d, s %d, SibPID %d, NPar_Escp %d) !!\n",
@@ -256,12 +317,12 @@ void Par_PassParticle2Sibling( const int lv, const bool TimingSendPar )
                sprintf( Comment, "%s C->C", __FUNCTION__ );
                amr->patch[0][lv][PID]->AddParticle( amr->patch[0][lv][SibPID]->NPar_Escp   [ MirSib[s] ],
                                                     amr->patch[0][lv][SibPID]->ParList_Escp[ MirSib[s] ],
-                                                   &amr->Par->NPar_Lv[lv], PType,
+                                                   &NPar_Add_Tot, PType,
                                                     (const real **)ParPos, amr->Par->NPar_AcPlusInac, Comment );
 #              else
                amr->patch[0][lv][PID]->AddParticle( amr->patch[0][lv][SibPID]->NPar_Escp   [ MirSib[s] ],
                                                     amr->patch[0][lv][SibPID]->ParList_Escp[ MirSib[s] ],
-                                                   &amr->Par->NPar_Lv[lv], PType );
+                                                   &NPar_Add_Tot, PType );
 #              endif
             }
          } // for (int s=0; s<26; s++)
@@ -273,6 +334,8 @@ void Par_PassParticle2Sibling( const int lv, const bool TimingSendPar )
 //       if ( amr->patch[0][lv][PID]->son != -1 )  Par_PassParticle2Son_SinglePatch( lv, PID );
       } // for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
 
+      amr->Par->NPar_Lv[lv] += NPar_Add_Tot;
+
 
 //###NOTE : NO OpenMP since particles from different patches can enter the same father-sibling patch
 //    6. pass particles to the father-sibling patches (fine --> coarse)
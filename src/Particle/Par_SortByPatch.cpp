@@ -0,0 +1,229 @@
+#include "GAMER.h"
+
+#ifdef PARTICLE
+
+static ulong Morton3D( const ulong x, const ulong y, const ulong z );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Par_SortByPatch
+// Description :  Sort the particle repository so that the particles of each patch are stored contiguously
+//
+// Note        :  1. Patches are ordered along the Morton curve of their corners, and particles within each
+//                   patch are ordered along the Morton curve of the cells they reside in
+//                   --> Per-particle routines looping over the ParList[] of a patch (e.g., Par_MassAssignment(),
+//                       Par_UpdateParticle(), and Par_MapMesh2Particles()) then access the particle attributes
+//                       contiguously instead of randomly
+//                2. ParList[] of all patches are rewritten accordingly and all inactive particles are discarded
+//                   --> Particle IDs are NOT preserved
+//                3. Must be invoked when no particles are collected from other patches (i.e., NPar_Copy == -1)
+//                   and when no other data structures refer to the particle IDs
+//                   --> Invoked by Init_GAMER() and main() when PAR_SORT_INTERVAL > 0
+//                4. Only sort the particles in this MPI rank
+//
+// Parameter   :  None
+//
+// Return      :  amr->Par->Attribute[], amr->patch->ParList[]
+//-------------------------------------------------------------------------------------------------------
+void Par_SortByPatch()
+{
+
+// check
+#  ifdef DEBUG_PARTICLE
+   for (int lv=0; lv<NLEVEL; lv++)
+   for (int PID=0; PID<amr->NPatchComma[lv][27]; PID++)
+   {
+      if ( amr->patch[0][lv][PID]->NPar_Copy != -1 )
+         Aux_Error( ERROR_INFO, "lv %d, PID %d, NPar_Copy = %d != -1 !!\n", lv, PID, amr->patch[0][lv][PID]->NPar_Copy );
+   }
+#  endif
+
+
+// 1. collect all patches with particles
+   int NPatch = 0;
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   for (int PID=0; PID<amr->NPatchComma[lv][27]; PID++)
+      if ( amr->patch[0][lv][PID]->NPar > 0 )   NPatch ++;
+
+   int   *PatchLv  = new int   [NPatch];
+   int   *PatchPID = new int   [NPatch];
+   ulong *PatchKey = new ulong [NPatch];
+   int   *PatchIdx = new int   [NPatch];
+   long  *Offset   = new long  [NPatch];
+
+// scale the patch corners to at most 21 bits per dimension for the 63-bit Morton keys
+   const int MaxCr = MAX( amr->BoxScale[0], MAX( amr->BoxScale[1], amr->BoxScale[2] ) ) / PS1;
+   int Shift = 0;
+   while ( (MaxCr>>Shift) >= (1<<21) )    Shift ++;
+
+   NPatch = 0;
+
+   for (int lv=0; lv<NLEVEL; lv++)
+   for (int PID=0; PID<amr->NPatchComma[lv][27]; PID++)
+   {
+      const patch_t *Patch = amr->patch[0][lv][PID];
+
+      if ( Patch->NPar <= 0 )    continue;
+
+      PatchLv [NPatch] = lv;
+      PatchPID[NPatch] = PID;
+      PatchKey[NPatch] = Morton3D( (ulong)( (Patch->corner[0]/PS1)>>Shift ),
+                                   (ulong)( (Patch->corner[1]/PS1)>>Shift ),
+                                   (ulong)( (Patch->corner[2]/PS1)>>Shift ) );
+      NPatch ++;
+   }
+
+
+// 2. sort patches along the Morton curve and set the offset of each patch in the new particle repository
+   Mis_RadixSort( NPatch, PatchKey, PatchIdx );
+
+   long NPar_Sorted = 0;
+   for (int t=0; t<NPatch; t++)
+   {
+      Offset[t]    = NPar_Sorted;
+      NPar_Sorted += amr->patch[0][ PatchLv[ PatchIdx[t] ] ][ PatchPID[ PatchIdx[t] ] ]->NPar;
+   }
+
+   if ( NPar_Sorted > amr->Par->NPar_Active )
+      Aux_Error( ERROR_INFO, "number of particles in all patches (%ld) > NPar_Active (%ld) !!\n",
+                 NPar_Sorted, amr->Par->NPar_Active );
+
+
+// 3. sort particles within each patch along the Morton curve of cells and record their old IDs
+   long *OldParID = new long [ amr->Par->NPar_Active ];
+
+#  pragma omp parallel
+   {
+      ulong *ParKey  = NULL;
+      int   *ParIdx  = NULL;
+      int    MemSize = 0;
+
+#     pragma omp for schedule( dynamic, 1 )
+      for (int t=0; t<NPatch; t++)
+      {
+         const int      lv     = PatchLv[ PatchIdx[t] ];
+         const patch_t *Patch  = amr->patch[0][lv][ PatchPID[ PatchIdx[t] ] ];
+         const int      NPar   = Patch->NPar;
+         const real    *Pos[3] = { amr->Par->PosX, amr->Par->PosY, amr->Par->PosZ };
+         const double  _dh     = 1.0 / amr->dh[lv];
+
+         if ( NPar > MemSize )
+         {
+            delete [] ParKey;
+            delete [] ParIdx;
+
+            MemSize = NPar;
+            ParKey  = new ulong [MemSize];
+            ParIdx  = new int   [MemSize];
+         }
+
+         for (int p=0; p<NPar; p++)
+         {
+            const long ParID = Patch->ParList[p];
+            int Cell[3];
+
+            for (int d=0; d<3; d++)
+            {
+               Cell[d] = (int)floor( ( (double)Pos[d][ParID] - Patch->EdgeL[d] )*_dh );
+               Cell[d] = MIN( MAX( Cell[d], 0 ), PS1-1 );
+            }
+
+            ParKey[p] = Morton3D( Cell[0], Cell[1], Cell[2] );
+         }
+
+//       stable sort --> particles in the same cell keep their original order so that the result is deterministic
+         Mis_RadixSort( NPar, ParKey, ParIdx );
+
+         for (int p=0; p<NPar; p++)    OldParID[ Offset[t] + p ] = Patch->ParList[ ParIdx[p] ];
+      } // for (int t=0; t<NPatch; t++)
+
+      delete [] ParKey;
+      delete [] ParIdx;
+   } // OpenMP parallel region
+
+
+// 4. check for duplicate particles and append active particles not associated with any patch
+   const real *Mass     = amr->Par->Mass;
+   bool       *Listed   = new bool [ amr->Par->NPar_AcPlusInac ];
+   long        NPar_New = NPar_Sorted;
+
+   for (long ParID=0; ParID<amr->Par->NPar_AcPlusInac; ParID++)   Listed[ParID] = false;
+
+   for (long p=0; p<NPar_Sorted; p++)
+   {
+      const long ParID = OldParID[p];
+
+      if ( Listed[ParID] )    Aux_Error( ERROR_INFO, "particle %ld is associated with multiple patches !!\n", ParID );
+      if ( Mass[ParID] < (real)0.0 )
+         Aux_Error( ERROR_INFO, "inactive particle %ld (mass = %14.7e) is associated with a patch !!\n", ParID, Mass[ParID] );
+
+      Listed[ParID] = true;
+   }
+
+   for (long ParID=0; ParID<amr->Par->NPar_AcPlusInac; ParID++)
+   {
+      if ( !Listed[ParID]  &&  Mass[ParID] >= (real)0.0 )
+      {
+         if ( NPar_New >= amr->Par->NPar_Active )
+            Aux_Error( ERROR_INFO, "number of active particles > NPar_Active (%ld) !!\n", amr->Par->NPar_Active );
+
+         OldParID[ NPar_New ++ ] = ParID;
+      }
+   }
+
+   if ( NPar_New != amr->Par->NPar_Active )
+      Aux_Error( ERROR_INFO, "number of active particles (%ld) != NPar_Active (%ld) !!\n", NPar_New, amr->Par->NPar_Active );
+
+
+// 5. reorder the particle repository and rewrite the particle lists of all patches
+   amr->Par->Reorder( NPar_New, OldParID );
+
+#  pragma omp parallel for schedule( static )
+   for (int t=0; t<NPatch; t++)
+   {
+      patch_t *Patch = amr->patch[0][ PatchLv[ PatchIdx[t] ] ][ PatchPID[ PatchIdx[t] ] ];
+
+      for (int p=0; p<Patch->NPar; p++)   Patch->ParList[p] = Offset[t] + p;
+   }
+
+
+   delete [] PatchLv;
+   delete [] PatchPID;
+   delete [] PatchKey;
+   delete [] PatchIdx;
+   delete [] Offset;
+   delete [] OldParID;
+   delete [] Listed;
+
+} // FUNCTION : Par_SortByPatch
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Morton3D
+// Description :  Return the Morton (Z-order) index of the input 3D coordinates
+//
+// Note        :  1. Only the lowest 21 bits of each coordinate are used
+//
+// Parameter   :  x/y/z : Non-negative integer coordinates
+//
+// Return      :  Morton index
+//-------------------------------------------------------------------------------------------------------
+ulong Morton3D( const ulong x, const ulong y, const ulong z )
+{
+
+   ulong Key = 0;
+
+   for (int b=0; b<21; b++)
+      Key |= ( ((x>>b)&1UL) << (3*b) ) | ( ((y>>b)&1UL) << (3*b+1) ) | ( ((z>>b)&1UL) << (3*b+2) );
+
+   return Key;
+
+} // FUNCTION : Morton3D
+
+
+
+#endif // #ifdef PARTICLE
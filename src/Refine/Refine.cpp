@@ -24,6 +24,14 @@ void ELBDM_GetPhase_DebugOnly( real *CData, const int CSize );
 void Refine( const int lv, const UseLBFunc_t UseLBFunc )
 {
 
+// patches at lv+1 will be created/removed and the patch relation at lv will change
+// --> clear the data cached by Prepare_PatchData()
+   PrepCache_Invalidate( lv );
+
+// the maximum CFL speed accumulated by the fluid solver for OPT__DT_FLU_FUSED is outdated at lv+1
+   Flu_FusedMaxCFL_Invalidate( lv+1 );
+
+
 // invoke the load-balance refine function
 #  ifdef LOAD_BALANCE
    if ( UseLBFunc == USELB_YES )
@@ -6,12 +6,13 @@
 
 static void FFT_Periodic( real *RhoK, const real Poi_Coeff, const int j_start, const int dj, const int RhoK_Size );
 static void FFT_Isolated( real *RhoK, const real *gFuncK, const real Poi_Coeff, const int RhoK_Size );
-static int ZIndex2Rank( const int IndexZ, const int *List_z_start, const int TRank_Guess );
+static int Index2Rank( const int Index, const int *List_start, const int NRank, const int TRank_Guess );
 
 #ifdef SERIAL
 extern rfftwnd_plan     FFTW_Plan, FFTW_Plan_Inv;
 #else
 extern rfftwnd_mpi_plan FFTW_Plan, FFTW_Plan_Inv;
+extern FFT_Pencil_t    *FFT_Pencil;
 #endif
 
 extern real (*Poi_AddExtraMassForGravity_Ptr)( const double x, const double y, const double z, const double Time,
@@ -24,6 +25,13 @@ extern real (*Poi_AddExtraMassForGravity_Ptr)( const double x, const double y, c
 // Function    :  Patch2Slab
 // Description :  Patch-based data --> slab domain decomposition (for density)
 //
+// Note        :  1. Also work with the pencil decomposition (OPT__FFT_PENCIL), for which the slab of each z range
+//                   is further divided along y
+//                   --> Rank "ZRank*NRank_y + YRank" stores the data in [ List_y_start[YRank], List_y_start[YRank+1] )
+//                       and [ List_z_start[ZRank], List_z_start[ZRank+1] ]
+//                   --> For the slab decomposition, set NRank_y = 1 and List_y_start[] = { 0, FFT_Size[1] }
+//                2. List_y_start[] must be aligned with PATCH_SIZE
+//
 // Parameter   :  RhoK           : In-place FFT array
 //                SendBuf_Rho    : Sending MPI buffer of density
 //                RecvBuf_Rho    : Receiving MPI buffer of density
@@ -33,15 +41,15 @@ extern real (*Poi_AddExtraMassForGravity_Ptr)( const double x, const double y, c
 //                List_k         : Local z coordinate of each patch slice sent to each rank
 //                List_NSend_Rho : Size of density data sent to each rank
 //                List_NRecv_Rho : Size of density data received from each rank
+//                List_y_start   : Starting y coordinate of each rank along y in the pencil decomposition
 //                List_z_start   : Starting z coordinate of each rank in the FFTW slab decomposition
-//                local_nz       : Slab thickness of this MPI rank
+//                NRank_y        : Number of ranks along y (1 for the slab decomposition)
 //                FFT_Size       : Size of the FFT operation including the zero-padding regions
-//                NRecvSlice     : Total number of z slices received from other ranks (could be zero in the isolated BC)
 //                PrepTime       : Physical time for preparing the density field
 //-------------------------------------------------------------------------------------------------------
 void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf_SIdx, long *RecvBuf_SIdx,
                  int **List_PID, int **List_k, int *List_NSend_Rho, int *List_NRecv_Rho,
-                 const int *List_z_start, const int local_nz, const int FFT_Size[], const int NRecvSlice,
+                 const int *List_y_start, const int *List_z_start, const int NRank_y, const int FFT_Size[],
                  const double PrepTime )
 {
 
@@ -49,23 +57,31 @@ void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf
    if ( OPT__GRAVITY_EXTRA_MASS  &&  Poi_AddExtraMassForGravity_Ptr == NULL )
       Aux_Error( ERROR_INFO, "Poi_AddExtraMassForGravity_Ptr == NULL for OPT__GRAVITY_EXTRA_MASS !!\n" );
 
+   if ( MPI_NRank % NRank_y != 0 )
+      Aux_Error( ERROR_INFO, "MPI_NRank (%d) %% NRank_y (%d) != 0 !!\n", MPI_NRank, NRank_y );
+
 #  ifdef GAMER_DEBUG
-   if ( List_z_start[MPI_Rank+1] - List_z_start[MPI_Rank] != local_nz )
-      Aux_Error( ERROR_INFO, "local_nz (%d) != expectation (%d) !!\n",
-                 local_nz, List_z_start[MPI_Rank+1] - List_z_start[MPI_Rank] );
-#  endif // GAMER_DEBUG
+   for (int r=0; r<NRank_y; r++)
+      if ( List_y_start[r] % PS1 != 0 )
+         Aux_Error( ERROR_INFO, "List_y_start[%d] (%d) %% PATCH_SIZE (%d) != 0 !!\n", r, List_y_start[r], PS1 );
+#  endif
 
 
-   const int SSize[2]   = { 2*(FFT_Size[0]/2+1), FFT_Size[1] };   // padded slab size in the x and y directions
+   const int NRank_z    = MPI_NRank / NRank_y;
+   const int SSizeX     = 2*(FFT_Size[0]/2+1);                    // padded slab size in the x direction
    const int PSSize     = PS1*PS1;                                // patch slice size
 // const int MemUnit    = amr->NPatchComma[0][1]*PS1/MPI_NRank;   // set arbitrarily
    const int MemUnit    = amr->NPatchComma[0][1]*PS1;             // set arbitrarily
-   const int AveNz      = FFT_Size[2]/MPI_NRank + ( (FFT_Size[2]%MPI_NRank == 0 ) ? 0 : 1 );    // average slab thickness
+   const int AveNy      = FFT_Size[1]/NRank_y + ( (FFT_Size[1]%NRank_y == 0 ) ? 0 : 1 );        // average pencil width
+   const int AveNz      = FFT_Size[2]/NRank_z + ( (FFT_Size[2]%NRank_z == 0 ) ? 0 : 1 );        // average slab thickness
    const int Scale0     = amr->scale[0];
 
    int   Cr[3];                        // corner coordinates of each patch normalized to the base-level grid size
    int   BPos_z;                       // z coordinate of each patch slice in the simulation box
+   int   SPos_y;                       // y coordinate of each patch slice in the slab
    int   SPos_z;                       // z coordinate of each patch slice in the slab
+   int   SSizeY;                       // slab size in the y direction of the target rank
+   int   YRank, ZRank;                 // target rank along y and z
    long  SIdx;                         // 1D coordinate of each patch slice in the slab
    int   List_NSend_SIdx[MPI_NRank];   // number of patch slices sent to each rank
    int   List_NRecv_SIdx[MPI_NRank];   // number of patch slices received from each rank
@@ -140,17 +156,26 @@ void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf
       {
          for (int d=0; d<3; d++)    Cr[d] = amr->patch[0][0][PID]->corner[d] / Scale0;
 
+//       all slices in a patch belong to the same rank along y
+         YRank  = Index2Rank( Cr[1], List_y_start, NRank_y, Cr[1]/AveNy );
+         SPos_y = Cr[1] - List_y_start[YRank];
+         SSizeY = List_y_start[YRank+1] - List_y_start[YRank];
+
          for (int k=0; k<PS1; k++)
          {
             BPos_z      = Cr[2] + k;
             TRank_Guess = BPos_z / AveNz;
-            TRank       = ZIndex2Rank( BPos_z, List_z_start, TRank_Guess );
-            SPos_z      = BPos_z - List_z_start[TRank];
-            SIdx        = ( (long)SPos_z*SSize[1] + Cr[1] )*SSize[0] + Cr[0];
+            ZRank       = Index2Rank( BPos_z, List_z_start, NRank_z, TRank_Guess );
+            TRank       = ZRank*NRank_y + YRank;
+            SPos_z      = BPos_z - List_z_start[ZRank];
+            SIdx        = ( (long)SPos_z*SSizeY + SPos_y )*SSizeX + Cr[0];
 
 #           ifdef GAMER_DEBUG
-            if ( SPos_z < 0  ||  SPos_z >= List_z_start[TRank+1] - List_z_start[TRank] )
+            if ( SPos_z < 0  ||  SPos_z >= List_z_start[ZRank+1] - List_z_start[ZRank] )
                Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "SPos_z", SPos_z );
+
+            if ( SPos_y < 0  ||  SPos_y+PS1 > SSizeY )
+               Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "SPos_y", SPos_y );
 #           endif
 
 //          allocate enough memory
@@ -222,10 +247,14 @@ void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf
 
 // check
 #  ifdef GAMER_DEBUG
+   const int YRank_Me     = MPI_Rank % NRank_y;
+   const int ZRank_Me     = MPI_Rank / NRank_y;
+   const int NRecvY       = MIN( List_y_start[YRank_Me+1], NX0_TOT[1] ) - MIN( List_y_start[YRank_Me], NX0_TOT[1] );
+   const int NRecvZ       = MIN( List_z_start[ZRank_Me+1], NX0_TOT[2] ) - MIN( List_z_start[ZRank_Me], NX0_TOT[2] );
    const int NSend_Total  = Send_Disp_Rho[MPI_NRank-1] + List_NSend_Rho[MPI_NRank-1];
    const int NRecv_Total  = Recv_Disp_Rho[MPI_NRank-1] + List_NRecv_Rho[MPI_NRank-1];
    const int NSend_Expect = amr->NPatchComma[0][1]*CUBE(PS1);
-   const int NRecv_Expect = NX0_TOT[0]*NX0_TOT[1]*NRecvSlice;
+   const int NRecv_Expect = NX0_TOT[0]*NRecvY*NRecvZ;
 
    if ( NSend_Total != NSend_Expect )  Aux_Error( ERROR_INFO, "NSend_Total = %d != expected value = %d !!\n",
                                                   NSend_Total, NSend_Expect );
@@ -265,7 +294,7 @@ void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf
 
 
 // 5. store the received density to the padded array "RhoK" for FFTW
-   const long NPSlice = (long)NX0_TOT[0]*NX0_TOT[1]*NRecvSlice/PSSize;  // total number of received patch slices
+   const long NPSlice = (long)Recv_Disp_SIdx[MPI_NRank-1] + List_NRecv_SIdx[MPI_NRank-1];   // total number of received patch slices
    long  dSIdx, Counter = 0;
    real *RhoK_Ptr = NULL;
 
@@ -277,7 +306,7 @@ void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf
       for (int j=0; j<PS1; j++)
       for (int i=0; i<PS1; i++)
       {
-         dSIdx           = j*SSize[0] + i;
+         dSIdx           = j*SSizeX + i;
          RhoK_Ptr[dSIdx] = RecvBuf_Rho[ Counter ++ ];
       }
    }
@@ -295,53 +324,48 @@ void Patch2Slab( real *RhoK, real *SendBuf_Rho, real *RecvBuf_Rho, long *SendBuf
 
 
 //-------------------------------------------------------------------------------------------------------
-// Function    :  ZIndex2Rank
-// Description :  Return the MPI rank which the input z coordinates belongs to in the FFTW slab decomposition
+// Function    :  Index2Rank
+// Description :  Return the rank along the target direction which the input coordinate belongs to in the FFTW
+//                slab (or pencil) decomposition
 //
-// Note        :  1. "List_z_start[r] <= IndexZ < List_z_start[r+1]" belongs to rank r
-//                2. List_z_start[MPI_NRank] can be set to any value >= FFT_Size[2]
+// Note        :  1. "List_start[r] <= Index < List_start[r+1]" belongs to rank r
+//                   --> Ranks with empty ranges are skipped automatically
+//                2. List_start[NRank] can be set to any value >= FFT_Size along the target direction
 //
-// Parameter   :  IndexZ       : Input z coordinate
-//                List_z_start : Starting z coordinate of each rank in the FFTW slab decomposition
-//                TRank_Guess  : First guess of the targeting MPI rank
+// Parameter   :  Index       : Input coordinate
+//                List_start  : Starting coordinate of each rank along the target direction
+//                NRank       : Number of ranks along the target direction
+//                TRank_Guess : First guess of the targeting rank
 //
-// Return      :  MPI rank
+// Return      :  Rank along the target direction
 //-------------------------------------------------------------------------------------------------------
-int ZIndex2Rank( const int IndexZ, const int *List_z_start, const int TRank_Guess )
+int Index2Rank( const int Index, const int *List_start, const int NRank, const int TRank_Guess )
 {
 
 // check
 #  ifdef GAMER_DEBUG
-   const int FFT_SizeZ = ( OPT__BC_POT == BC_POT_ISOLATED ) ? 2*NX0_TOT[2] : NX0_TOT[2];
-
-   if ( IndexZ < 0  ||  IndexZ >= NX0_TOT[2] )
-      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "IndexZ", IndexZ );
-
-   if ( List_z_start[MPI_NRank] < FFT_SizeZ )
-      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "List_z_start[MPI_NRank]", List_z_start[MPI_NRank] );
-
-   if ( TRank_Guess < 0  ||  TRank_Guess >= MPI_NRank )
-      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "TRank_Guess", TRank_Guess );
+   if ( Index < 0  ||  Index >= List_start[NRank] )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "Index", Index );
 #  endif
 
 
-   int TRank = TRank_Guess;   // have a first guess to improve the performance
+   int TRank = MIN( MAX( TRank_Guess, 0 ), NRank-1 );    // have a first guess to improve the performance
 
    while ( true )
    {
 #     ifdef GAMER_DEBUG
-      if ( TRank < 0  ||  TRank >= MPI_NRank )  Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "TRank", TRank );
+      if ( TRank < 0  ||  TRank >= NRank )   Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "TRank", TRank );
 #     endif
 
-      if ( IndexZ < List_z_start[TRank] )    TRank --;
+      if ( Index < List_start[TRank] )    TRank --;
       else
       {
-         if ( IndexZ < List_z_start[TRank+1] )  return TRank;
-         else                                   TRank ++;
+         if ( Index < List_start[TRank+1] )  return TRank;
+         else                                TRank ++;
       }
    }
 
-} // FUNCTION : ZIndex2Rank
+} // FUNCTION : Index2Rank
 
 
 
@@ -349,6 +373,9 @@ int ZIndex2Rank( const int IndexZ, const int *List_z_start, const int TRank_Gues
 // Function    :  Slab2Patch
 // Description :  Slab domain decomposition --> patch-based data (for potential)
 //
+// Note        :  Also work with the pencil decomposition (OPT__FFT_PENCIL) since List_SIdx[] recorded by
+//                Patch2Slab() already takes into account the slab size along y
+//
 // Parameter   :  RhoK       : In-place FFT array
 //                SendBuf    : Sending MPI buffer of potential
 //                RecvBuf    : Receiving MPI buffer of potential
@@ -358,22 +385,21 @@ int ZIndex2Rank( const int IndexZ, const int *List_z_start, const int TRank_Gues
 //                List_k     : Local z coordinate of each patch slice sent to each rank
 //                List_NSend : Size of potential data sent to each rank
 //                List_NRecv : Size of potential data received from each rank
-//                local_nz   : Slab thickness of this MPI rank
 //                FFT_Size   : Size of the FFT operation including the zero-padding regions
-//                NSendSlice : Total number of z slices need to be sent to other ranks (could be zero in the isolated BC)
 //-------------------------------------------------------------------------------------------------------
 void Slab2Patch( const real *RhoK, real *SendBuf, real *RecvBuf, const int SaveSg, const long *List_SIdx,
-                 int **List_PID, int **List_k, int *List_NSend, int *List_NRecv, const int local_nz, const int FFT_Size[],
-                 const int NSendSlice )
+                 int **List_PID, int **List_k, int *List_NSend, int *List_NRecv, const int FFT_Size[] )
 {
 
 // 1. store the evaluated potential to the send buffer
-   const int   SSize[2]   = { 2*(FFT_Size[0]/2+1), FFT_Size[1] };             // padded slab size in the x and y directions
+   const int   SSizeX     = 2*(FFT_Size[0]/2+1);                              // padded slab size in the x direction
    const int   PSSize     = PS1*PS1;                                          // patch slice size
-   const long  NPSlice    = (long)NX0_TOT[0]*NX0_TOT[1]*NSendSlice/PSSize;    // total number of patch slices to be sent
    const real *RhoK_Ptr   = NULL;
 
-   long SIdx, dSIdx, Counter = 0;
+   long SIdx, dSIdx, NPSlice = 0, Counter = 0;
+
+// total number of patch slices to be sent
+   for (int r=0; r<MPI_NRank; r++)  NPSlice += List_NSend[r]/PSSize;
 
    for (long t=0; t<NPSlice; t++)
    {
@@ -383,7 +409,7 @@ void Slab2Patch( const real *RhoK, real *SendBuf, real *RecvBuf, const int SaveS
       for (int j=0; j<PS1; j++)
       for (int i=0; i<PS1; i++)
       {
-         dSIdx                 = j*SSize[0] + i;
+         dSIdx                 = j*SSizeX + i;
          SendBuf[ Counter ++ ] = RhoK_Ptr[dSIdx];
       }
    }
@@ -444,8 +470,10 @@ void Slab2Patch( const real *RhoK, real *SendBuf, real *RecvBuf, const int SaveS
 // Function    :  FFT_Periodic
 // Description :  Evaluate the gravitational potential by FFT for the periodic BC
 //
-// Note        :  Effect from the homogenerous background density (DC) will be ignored by setting the k=0 mode
-//                equal to zero
+// Note        :  1. Effect from the homogenerous background density (DC) will be ignored by setting the k=0 mode
+//                   equal to zero
+//                2. For OPT__FFT_PENCIL, the k-space data are stored in the z pencils with the layout [x][y][z]
+//                   --> j_start and dj are the y range of this rank in the z pencils
 //
 // Parameter   :  RhoK      : Array storing the input density and output potential
 //                Poi_Coeff : Coefficient in front of density in the Poisson equation (4*Pi*Newton_G*a)
@@ -469,7 +497,8 @@ void FFT_Periodic( real *RhoK, const real Poi_Coeff, const int j_start, const in
 #  ifdef SERIAL
    rfftwnd_one_real_to_complex( FFTW_Plan, RhoK, NULL );
 #  else
-   rfftwnd_mpi( FFTW_Plan, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
+   if ( OPT__FFT_PENCIL )  FFT_Pencil_Forward( FFT_Pencil, RhoK );
+   else                    rfftwnd_mpi( FFTW_Plan, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
 #  endif
 
 
@@ -491,6 +520,40 @@ void FFT_Periodic( real *RhoK, const real Poi_Coeff, const int j_start, const in
 
 // divide the Rho_K by -k^2
    long ID;
+
+#  ifndef SERIAL
+// pencil mode: [i][j][k] in the z pencils
+   if ( OPT__FFT_PENCIL )
+   {
+      const int i_start = FFT_Pencil->K_Start[0][ FFT_Pencil->Coord[0]   ];
+      const int di      = FFT_Pencil->K_Start[0][ FFT_Pencil->Coord[0]+1 ] - i_start;
+      int i, j;
+
+#     pragma omp parallel for private( i, j, ID, Deno ) schedule( static )
+      for (int ii=0; ii<di; ii++)   {  i = i_start + ii;
+      for (int jj=0; jj<dj; jj++)   {  j = j_start + jj;
+      for (int k=0;  k<Nz;  k++)    {
+
+         ID   = ( (long)ii*dj + jj )*Nz + k;
+         Deno = -4.0 * ( sinkx2[i] + sinky2[j] + sinkz2[k] );
+
+         if ( Deno == 0.0 )
+         {
+            cdata[ID].re = 0.0;
+            cdata[ID].im = 0.0;
+         }
+
+         else
+         {
+            cdata[ID].re =  cdata[ID].re * Poi_Coeff / Deno;
+            cdata[ID].im =  cdata[ID].im * Poi_Coeff / Deno;
+         }
+      }}} // i,j,k
+   } // if ( OPT__FFT_PENCIL )
+
+   else
+#  endif // #ifndef SERIAL
+   {
 #  ifdef SERIAL // serial mode
 
    for (int k=0; k<Nz; k++)
@@ -534,19 +597,22 @@ void FFT_Periodic( real *RhoK, const real Poi_Coeff, const int j_start, const in
          }
       } // i,j,k
    } // i,j,k
+   } // if ( OPT__FFT_PENCIL ) ... else ...
 
 
 // backward FFT
 #  ifdef SERIAL
    rfftwnd_one_complex_to_real( FFTW_Plan_Inv, cdata, NULL );
 #  else
-   rfftwnd_mpi( FFTW_Plan_Inv, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
+   if ( OPT__FFT_PENCIL )  FFT_Pencil_Backward( FFT_Pencil, RhoK );
+   else                    rfftwnd_mpi( FFTW_Plan_Inv, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
 #  endif
 
 
 // normalization
    const real norm = dh*dh / ( (real)Nx*Ny*Nz );
 
+#  pragma omp parallel for schedule( static )
    for (int t=0; t<RhoK_Size; t++)  RhoK[t] *= norm;
 
 } // FUNCTION : FFT_Periodic
@@ -560,6 +626,7 @@ void FFT_Periodic( real *RhoK, const real Poi_Coeff, const int j_start, const in
 // Note        :  1. Green's function in the k space has been set by Init_GreenFuncK()
 //                2. 4*PI*NEWTON_G and FFT normalization coefficient has been included in gFuncK
 //                   --> The only coefficient that hasn't been taken into account is the scale factor in the comoving frame
+//                3. gFuncK must adopt the same domain decomposition as RhoK (i.e., slab or pencil)
 //
 // Parameter   :  RhoK      : Array storing the input density and output potential
 //                Poi_Coeff : Coefficient in front of density in the Poisson equation (4*Pi*Newton_G*a)
@@ -577,13 +644,15 @@ void FFT_Isolated( real *RhoK, const real *gFuncK, const real Poi_Coeff, const i
 #  ifdef SERIAL
    rfftwnd_one_real_to_complex( FFTW_Plan, RhoK, NULL );
 #  else
-   rfftwnd_mpi( FFTW_Plan, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
+   if ( OPT__FFT_PENCIL )  FFT_Pencil_Forward( FFT_Pencil, RhoK );
+   else                    rfftwnd_mpi( FFTW_Plan, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
 #  endif
 
 
 // multiply density and Green's function in the k space
    const int RhoK_Size_cplx = RhoK_Size/2;
 
+#  pragma omp parallel for private( Temp_cplx ) schedule( static )
    for (int t=0; t<RhoK_Size_cplx; t++)
    {
       Temp_cplx = RhoK_cplx[t];
@@ -597,7 +666,8 @@ void FFT_Isolated( real *RhoK, const real *gFuncK, const real Poi_Coeff, const i
 #  ifdef SERIAL
    rfftwnd_one_complex_to_real( FFTW_Plan_Inv, RhoK_cplx, NULL );
 #  else
-   rfftwnd_mpi( FFTW_Plan_Inv, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
+   if ( OPT__FFT_PENCIL )  FFT_Pencil_Backward( FFT_Pencil, RhoK );
+   else                    rfftwnd_mpi( FFTW_Plan_Inv, 1, RhoK, NULL, FFTW_TRANSPOSED_ORDER );
 #  endif
 
 
@@ -605,6 +675,7 @@ void FFT_Isolated( real *RhoK, const real *gFuncK, const real Poi_Coeff, const i
 #  ifdef COMOVING
    const real Coeff = Poi_Coeff / ( 4.0*M_PI*NEWTON_G );    // == Time[0] == scale factor at the base level
 
+#  pragma omp parallel for schedule( static )
    for (int t=0; t<RhoK_Size; t++)  RhoK[t] *= Coeff;
 #  endif
 
@@ -643,33 +714,65 @@ void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg, const double
    local_y_start_after_transpose = NULL_INT;
    total_local_size              = 2*(FFT_Size[0]/2+1)*FFT_Size[1]*FFT_Size[2];
 #  else
-   rfftwnd_mpi_local_sizes( FFTW_Plan, &local_nz, &local_z_start, &local_ny_after_transpose,
-                            &local_y_start_after_transpose, &total_local_size );
+   if ( OPT__FFT_PENCIL )
+   {
+      const int Coord1 = FFT_Pencil->Coord[1];
+
+      local_nz                      = FFT_Pencil->R_Start[1][Coord1+1] - FFT_Pencil->R_Start[1][Coord1];
+      local_z_start                 = FFT_Pencil->R_Start[1][Coord1];
+      local_ny_after_transpose      = FFT_Pencil->K_Start[1][Coord1+1] - FFT_Pencil->K_Start[1][Coord1];
+      local_y_start_after_transpose = FFT_Pencil->K_Start[1][Coord1];
+      total_local_size              = (int)FFT_Pencil->LocalSize;
+   }
+
+   else
+      rfftwnd_mpi_local_sizes( FFTW_Plan, &local_nz, &local_z_start, &local_ny_after_transpose,
+                               &local_y_start_after_transpose, &total_local_size );
 #  endif
 
 
-// collect "local_nz" from all ranks and set the corresponding list "List_z_start"
-   int List_nz     [MPI_NRank  ];   // slab thickness of each rank in the FFTW slab decomposition
-   int List_z_start[MPI_NRank+1];   // starting z coordinate of each rank in the FFTW slab decomposition
+// set the lists "List_y_start" and "List_z_start" recording the starting y/z coordinates of all ranks
+// --> for the slab decomposition, collect "local_nz" from all ranks
+   int  NRank_y = 1;
+   int  List_y_start_Slab[2] = { 0, FFT_Size[1] };
+   int  List_nz     [MPI_NRank  ];  // slab thickness of each rank in the FFTW slab decomposition
+   int  List_z_start[MPI_NRank+1];  // starting z coordinate of each rank in the FFTW slab decomposition
+   int *List_y_start = List_y_start_Slab;
+
+#  ifndef SERIAL
+   if ( OPT__FFT_PENCIL )
+   {
+      NRank_y      = FFT_Pencil->NRank[0];
+      List_y_start = FFT_Pencil->R_Start[0];
+
+      for (int r=0; r<=FFT_Pencil->NRank[1]; r++)  List_z_start[r] = FFT_Pencil->R_Start[1][r];
+   }
 
-   MPI_Allgather( &local_nz, 1, MPI_INT, List_nz, 1, MPI_INT, MPI_COMM_WORLD );
+   else
+#  endif
+   {
+      MPI_Allgather( &local_nz, 1, MPI_INT, List_nz, 1, MPI_INT, MPI_COMM_WORLD );
 
-   List_z_start[0] = 0;
-   for (int r=0; r<MPI_NRank; r++)  List_z_start[r+1] = List_z_start[r] + List_nz[r];
+      List_z_start[0] = 0;
+      for (int r=0; r<MPI_NRank; r++)  List_z_start[r+1] = List_z_start[r] + List_nz[r];
 
-   if ( List_z_start[MPI_NRank] != FFT_Size[2] )
-      Aux_Error( ERROR_INFO, "List_z_start[%d] (%d) != expectation (%d) !!\n",
-                 MPI_NRank, List_z_start[MPI_NRank], FFT_Size[2] );
+      if ( List_z_start[MPI_NRank] != FFT_Size[2] )
+         Aux_Error( ERROR_INFO, "List_z_start[%d] (%d) != expectation (%d) !!\n",
+                    MPI_NRank, List_z_start[MPI_NRank], FFT_Size[2] );
+   }
 
 
 // allocate memory (properly taking into account the zero-padding regions, where no data need to be exchanged)
-   const int NRecvSlice = MIN( List_z_start[MPI_Rank]+local_nz, NX0_TOT[2] ) - MIN( List_z_start[MPI_Rank], NX0_TOT[2] );
+   const int  YRank     = MPI_Rank % NRank_y;
+   const int  NRecvY    = MIN( List_y_start[YRank+1], NX0_TOT[1] ) - MIN( List_y_start[YRank], NX0_TOT[1] );
+   const int  NRecvZ    = MIN( local_z_start+local_nz, NX0_TOT[2] ) - MIN( local_z_start, NX0_TOT[2] );
+   const long NRecvCell = (long)NX0_TOT[0]*NRecvY*NRecvZ;
 
    real *RhoK         = new real [ total_local_size ];                           // array storing both density and potential
    real *SendBuf      = new real [ (long)amr->NPatchComma[0][1]*CUBE(PS1) ];     // MPI send buffer for density and potential
-   real *RecvBuf      = new real [ (long)NX0_TOT[0]*NX0_TOT[1]*NRecvSlice ];     // MPI recv buffer for density and potentia
+   real *RecvBuf      = new real [ NRecvCell ];                                  // MPI recv buffer for density and potentia
    long *SendBuf_SIdx = new long [ amr->NPatchComma[0][1]*PS1 ];                 // MPI send buffer for 1D coordinate in slab
-   long *RecvBuf_SIdx = new long [ NX0_TOT[0]*NX0_TOT[1]*NRecvSlice/SQR(PS1) ];  // MPI recv buffer for 1D coordinate in slab
+   long *RecvBuf_SIdx = new long [ NRecvCell/SQR(PS1) ];                         // MPI recv buffer for 1D coordinate in slab
 
    int  *List_PID    [MPI_NRank];   // PID of each patch slice sent to each rank
    int  *List_k      [MPI_NRank];   // local z coordinate of each patch slice sent to each rank
@@ -683,8 +786,8 @@ void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg, const double
 
 
 // rearrange data from patch to slab
-   Patch2Slab( RhoK, SendBuf, RecvBuf, SendBuf_SIdx, RecvBuf_SIdx, List_PID, List_k, List_NSend, List_NRecv, List_z_start,
-               local_nz, FFT_Size, NRecvSlice, PrepTime );
+   Patch2Slab( RhoK, SendBuf, RecvBuf, SendBuf_SIdx, RecvBuf_SIdx, List_PID, List_k, List_NSend, List_NRecv,
+               List_y_start, List_z_start, NRank_y, FFT_Size, PrepTime );
 
 
 // evaluate potential by FFT
@@ -699,8 +802,7 @@ void CPU_PoissonSolver_FFT( const real Poi_Coeff, const int SaveSg, const double
 
 
 // rearrange data from slab back to patch
-   Slab2Patch( RhoK, RecvBuf, SendBuf, SaveSg, RecvBuf_SIdx, List_PID, List_k, List_NRecv, List_NSend,
-               local_nz, FFT_Size, NRecvSlice );
+   Slab2Patch( RhoK, RecvBuf, SendBuf, SaveSg, RecvBuf_SIdx, List_PID, List_k, List_NRecv, List_NSend, FFT_Size );
 
 
    delete [] RhoK;
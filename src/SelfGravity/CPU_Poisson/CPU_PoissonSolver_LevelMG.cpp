@@ -0,0 +1,608 @@
+#include "GAMER.h"
+
+#if ( defined GRAVITY  &&  POT_SCHEME == MG )
+
+
+
+#define MAX_NDEPTH      10    // maximum number of multigrid depths
+#define NBOTTOM_SMOOTH   8    // number of smoothing steps at the bottom of the V-cycle
+
+static void Exchange( const int lv, const int NCell, real *Sol, const int Sg );
+static void Smoothing( const int lv, const int Depth, const int NCell, real *Sol, const real *RHS, const real dh,
+                       const int NStep, const int Sg );
+static void Restrict_Defect( const int NPatch, const int NCell_F, const real *Sol_F, const real *RHS_F, const real dh_F,
+                             real *RHS_C );
+static void Prolongate_and_Correct( const int NPatch, const int NCell_C, const real *Sol_C, real *Sol_F );
+static void EstimateError( const int NPatch, const int NCell, const real *Sol, const real *RHS, const real dh,
+                           double &SumDef, double &SumSol );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  CPU_PoissonSolver_LevelMG
+// Description :  Solve the Poisson equation on all patches at the target level as a single composite domain
+//                using the multigrid scheme (OPT__POI_LEVEL_MG)
+//
+// Note        :  1. Alternative to the patch-based Poisson solver invoked by InvokeSolver() for lv > 0
+//                   --> Avoid the redundant computation in the ghost zones of each patch and let the multigrid
+//                       correction propagate across patch boundaries
+//                2. Cell-centered V-cycle with red-black Gauss-Seidel smoothing
+//                   --> The grid at each depth is coarsened inside each patch (e.g., 8^3 -> 4^3 -> 2^3 -> 1^3)
+//                   --> Each patch stores one ghost layer at each depth, which is filled by its sibling patches
+//                       or set by the boundary condition
+//                3. Boundary conditions
+//                   --> Sibling patches (including buffer patches): data are exchanged by Buf_GetBufferData()
+//                       before each red/black sweep, using patch->pot[Sg] as the MPI buffer
+//                       --> Except for the siblings across the simulation boundaries when OPT__BC_POT is isolated,
+//                           which still exist if the fluid B.C. is periodic
+//                   --> Coarse-fine and non-periodic boundaries: Dirichlet B.C. interpolated from the coarse-grid
+//                       potential prepared by Poi_Prepare_Pot(), which is also adopted as the initial guess
+//                   --> Homogeneous Dirichlet B.C. for the corrections at coarser depths
+//                   --> If lv covers the entire domain with the periodic B.C., the mean of the RHS is removed
+//                       since there is no Dirichlet B.C. at all (same as dropping the k=0 mode in the root-level
+//                       FFT solver)
+//                4. Use MG_MAX_ITER, MG_NPRE_SMOOTH, MG_NPOST_SMOOTH, and MG_TOLERATED_ERROR
+//                   --> The error is estimated in the same way as CPU_PoissonSolver_MG() but summed over all patches
+//                       at lv in all ranks
+//                5. External potential is added after solving the Poisson equation if OPT__EXT_POT is on
+//                6. patch->pot[SaveSg] of both real and buffer patches at lv will be overwritten
+//                   --> Buffer patches must be updated by Buf_GetBufferData() afterward
+//                7. Invoked by Gra_AdvanceDt()
+//
+// Parameter   :  lv        : Target refinement level (must be > 0)
+//                Poi_Coeff : Coefficient in front of the RHS in the Poisson eq.
+//                SaveSg    : Sandglass to store the updated potential
+//                PrepTime  : Physical time for preparing the density and coarse-grid potential
+//
+// Return      :  amr->patch->pot[]
+//-------------------------------------------------------------------------------------------------------
+void CPU_PoissonSolver_LevelMG( const int lv, const real Poi_Coeff, const int SaveSg, const double PrepTime )
+{
+
+// check
+#  ifdef GAMER_DEBUG
+   if ( lv <= 0  ||  lv >= NLEVEL )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "lv", lv );
+
+   if ( SaveSg != 0  &&  SaveSg != 1 )
+      Aux_Error( ERROR_INFO, "incorrect parameter %s = %d !!\n", "SaveSg", SaveSg );
+#  endif
+
+
+// nothing to do if there is no patch at lv in all ranks
+   if ( NPatchTotal[lv] == 0 )   return;
+
+
+   const int  NPatch = amr->NPatchComma[lv][1];
+   const real dh_Min = amr->dh[lv];
+
+
+// 1. solve the Poisson equation for self-gravity
+   if ( OPT__SELF_GRAVITY )
+   {
+//    set the depth of the multigrid V-cycle
+      int  NDepth, NCell[MAX_NDEPTH];
+      real dh[MAX_NDEPTH];
+
+      NDepth   = 1;
+      NCell[0] = PS1;
+      dh   [0] = dh_Min;
+
+      while ( NCell[NDepth-1]%2 == 0  &&  NDepth < MAX_NDEPTH )
+      {
+         NCell[NDepth] = NCell[NDepth-1]/2;
+         dh   [NDepth] = (real)2.0*dh[NDepth-1];
+         NDepth ++;
+      }
+
+      const int BottomDepth = NDepth - 1;
+
+
+//    allocate the solution/correction (with one ghost layer) and RHS arrays of all patches
+      real *Sol[MAX_NDEPTH], *RHS[MAX_NDEPTH];
+
+      for (int d=0; d<NDepth; d++)
+      {
+         Sol[d] = new real [ (long)NPatch*CUBE(NCell[d]+2) ];
+         RHS[d] = new real [ (long)NPatch*CUBE(NCell[d]  ) ];
+      }
+
+
+//    1-1. prepare the RHS and the initial guess (which also provides the B.C.)
+//         --> use the same host arrays as InvokeSolver() and prepare POT_GPU_NPGROUP patch groups at a time
+      const int  IntGhost           = 1;   // interpolation ghost zone (see Poi_Prepare_Pot())
+      const int  CGhost             = ( POT_NXT - PS1/2 )/2;
+      const int  NF                 = PS1 + 4;
+      const int  CSize [3]          = { POT_NXT, POT_NXT, POT_NXT };
+      const int  CStart[3]          = { CGhost-IntGhost, CGhost-IntGhost, CGhost-IntGhost };
+      const int  CRange[3]          = { PS1/2+2, PS1/2+2, PS1/2+2 };
+      const int  FSize [3]          = { NF, NF, NF };
+      const int  FStart[3]          = { 0, 0, 0 };
+      const bool Monotonicity_No    = false;
+      const bool OppSign0thOrder_No = false;
+      const bool PhaseUnwrapping_No = false;
+      const int  NPG_Max            = POT_GPU_NPGROUP;
+      const int  NG0                = NCell[0] + 2;
+
+      int *PID0_List = new int [NPG_Max];
+
+      for (int PID0_Start=0; PID0_Start<NPatch; PID0_Start+=8*NPG_Max)
+      {
+         const int NPG = MIN( NPG_Max, (NPatch-PID0_Start)/8 );
+
+         for (int t=0; t<NPG; t++)  PID0_List[t] = PID0_Start + 8*t;
+
+         Poi_Prepare_Rho( lv, PrepTime, h_Rho_Array_P   [0], NPG, PID0_List );
+         Poi_Prepare_Pot( lv, PrepTime, h_Pot_Array_P_In[0], NPG, PID0_List );
+
+#        pragma omp parallel
+         {
+//          FPot : interpolated fine-grid potential including two ghost layers
+            real (*FPot)[NF][NF] = new real [NF][NF][NF];
+
+#           pragma omp for schedule( runtime )
+            for (int N=0; N<8*NPG; N++)
+            {
+               const long P = PID0_Start + N;
+               real (*Sol0)[NG0][NG0] = ( real(*)[NG0][NG0] )( Sol[0] + P*CUBE(NG0) );
+               real (*RHS0)[PS1][PS1] = ( real(*)[PS1][PS1] )( RHS[0] + P*CUBE(PS1) );
+
+               Interpolate( h_Pot_Array_P_In[0][N][0][0], CSize, CStart, CRange, FPot[0][0], FSize, FStart, 1,
+                            OPT__POT_INT_SCHEME, PhaseUnwrapping_No, &Monotonicity_No, OppSign0thOrder_No,
+                            ALL_CONS_NO, INT_PRIM_NO, INT_FIX_MONO_COEFF, NULL, NULL );
+
+               for (int k=0; k<NG0; k++)
+               for (int j=0; j<NG0; j++)
+               for (int i=0; i<NG0; i++)
+                  Sol0[k][j][i] = FPot[k+1][j+1][i+1];
+
+               for (int k=0; k<PS1; k++)
+               for (int j=0; j<PS1; j++)
+               for (int i=0; i<PS1; i++)
+                  RHS0[k][j][i] = Poi_Coeff*h_Rho_Array_P[0][N][k+RHO_GHOST_SIZE][j+RHO_GHOST_SIZE][i+RHO_GHOST_SIZE];
+            }
+
+            delete [] FPot;
+         } // OpenMP parallel region
+      } // for (int PID0_Start=0; PID0_Start<NPatch; PID0_Start+=8*NPG_Max)
+
+      delete [] PID0_List;
+
+
+//    1-2. remove the mean of the RHS if lv covers the entire periodic domain
+//         --> otherwise the periodic problem has no solution
+      const double NCell_Domain = (double)NX0_TOT[0]*NX0_TOT[1]*NX0_TOT[2]*CUBE( (double)(1<<lv) );
+
+      if ( OPT__BC_POT == BC_POT_PERIODIC  &&  (double)NPatchTotal[lv]*CUBE(PS1) == NCell_Domain )
+      {
+         double RHS_Sum_Local = 0.0, RHS_Sum_All;
+
+         for (long t=0; t<(long)NPatch*CUBE(PS1); t++)   RHS_Sum_Local += RHS[0][t];
+
+         MPI_Allreduce( &RHS_Sum_Local, &RHS_Sum_All, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+
+         const real RHS_Mean = RHS_Sum_All / NCell_Domain;
+
+#        pragma omp parallel for schedule( static )
+         for (long t=0; t<(long)NPatch*CUBE(PS1); t++)   RHS[0][t] -= RHS_Mean;
+      }
+
+
+//    1-3. multigrid V-cycles
+      int    Iter  = 0;
+      double Error = __FLT_MAX__;
+
+      while ( Iter < MG_MAX_ITER  &&  Error > MG_TOLERATED_ERROR )
+      {
+//       V-cycle : finer --> coarser grids
+         for (int d=0; d<BottomDepth; d++)
+         {
+//          pre-smoothing
+            Smoothing( lv, d, NCell[d], Sol[d], RHS[d], dh[d], MG_NPRE_SMOOTH, SaveSg );
+
+//          compute and restrict the defect (use as the RHS at the next depth)
+            Exchange( lv, NCell[d], Sol[d], SaveSg );
+            Restrict_Defect( NPatch, NCell[d], Sol[d], RHS[d], dh[d], RHS[d+1] );
+
+//          initialize the correction (including the ghost layer) at the next depth to zero
+            for (long t=0; t<(long)NPatch*CUBE(NCell[d+1]+2); t++)   Sol[d+1][t] = (real)0.0;
+         }
+
+//       calculate the correction at the bottom depth
+         Smoothing( lv, BottomDepth, NCell[BottomDepth], Sol[BottomDepth], RHS[BottomDepth], dh[BottomDepth],
+                    NBOTTOM_SMOOTH, SaveSg );
+
+//       V-cycle : coarser --> finer grids
+         for (int d=BottomDepth-1; d>=0; d--)
+         {
+//          prolongate the correction (from d+1 to d) and correct the solution/correction at d
+            Exchange( lv, NCell[d+1], Sol[d+1], SaveSg );
+            Prolongate_and_Correct( NPatch, NCell[d+1], Sol[d+1], Sol[d] );
+
+//          post-smoothing
+            Smoothing( lv, d, NCell[d], Sol[d], RHS[d], dh[d], MG_NPOST_SMOOTH, SaveSg );
+         }
+
+//       estimate the error summed over all patches at lv
+         double Sum_Local[2], Sum_All[2];
+
+         Exchange( lv, NCell[0], Sol[0], SaveSg );
+         EstimateError( NPatch, NCell[0], Sol[0], RHS[0], dh[0], Sum_Local[0], Sum_Local[1] );
+
+         MPI_Allreduce( Sum_Local, Sum_All, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+
+         Error = ( Sum_All[1] > 0.0 ) ? SQR(dh[0])*Sum_All[0]/Sum_All[1] : 0.0;
+         Iter ++;
+      } // while ( Iter < MG_MAX_ITER  &&  Error > MG_TOLERATED_ERROR )
+
+      if ( Error > MG_TOLERATED_ERROR  &&  MPI_Rank == 0 )
+         Aux_Message( stderr, "WARNING : lv %d exceeds the maximum tolerated error (error = %13.7e, iteration = %d) !!\n",
+                      lv, Error, Iter );
+
+
+//    1-4. store the solution
+#     pragma omp parallel for schedule( static )
+      for (int PID=0; PID<NPatch; PID++)
+      {
+         const real (*Sol0)[NG0][NG0] = ( real(*)[NG0][NG0] )( Sol[0] + (long)PID*CUBE(NG0) );
+
+         for (int k=0; k<PS1; k++)
+         for (int j=0; j<PS1; j++)
+         for (int i=0; i<PS1; i++)
+            amr->patch[SaveSg][lv][PID]->pot[k][j][i] = Sol0[k+1][j+1][i+1];
+      }
+
+
+      for (int d=0; d<NDepth; d++)
+      {
+         delete [] Sol[d];
+         delete [] RHS[d];
+      }
+   } // if ( OPT__SELF_GRAVITY )
+
+
+// 2. add external potential
+   if ( OPT__EXT_POT )
+   {
+      const double dh_2 = 0.5*amr->dh[lv];
+
+#     pragma omp parallel for schedule( runtime )
+      for (int PID=0; PID<NPatch; PID++)
+      {
+         const double x0 = amr->patch[0][lv][PID]->EdgeL[0] + dh_2;
+         const double y0 = amr->patch[0][lv][PID]->EdgeL[1] + dh_2;
+         const double z0 = amr->patch[0][lv][PID]->EdgeL[2] + dh_2;
+
+         double x, y, z;
+         real   ExtPot;
+
+         for (int k=0; k<PS1; k++)  {  z = z0 + k*amr->dh[lv];
+         for (int j=0; j<PS1; j++)  {  y = y0 + j*amr->dh[lv];
+         for (int i=0; i<PS1; i++)  {  x = x0 + i*amr->dh[lv];
+
+            ExtPot = CPUExtPot_Ptr( x, y, z, PrepTime, ExtPot_AuxArray_Flt, ExtPot_AuxArray_Int,
+                                    EXT_POT_USAGE_ADD, h_ExtPotTable, h_ExtPotGenePtr );
+
+            if ( OPT__SELF_GRAVITY )   amr->patch[SaveSg][lv][PID]->pot[k][j][i] += ExtPot;  // add
+            else                       amr->patch[SaveSg][lv][PID]->pot[k][j][i]  = ExtPot;  // overwrite
+         }}}
+      } // for (int PID=0; PID<NPatch; PID++)
+   } // if ( OPT__EXT_POT )
+
+} // FUNCTION : CPU_PoissonSolver_LevelMG
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Exchange
+// Description :  Fill up the ghost layer of the solution/correction of all real patches from their sibling patches
+//
+// Note        :  1. Boundary layers of each real patch are first copied to patch->pot[Sg] and then transferred to
+//                   the buffer patches by Buf_GetBufferData() with ParaBuf = 1
+//                   --> At depths coarser than the patch resolution, a coarse cell "i" is stored in the
+//                       fine-grid cell "i*(PS1/NCell)" along each direction
+//                2. Ghost cells without sibling patches are not modified
+//                   --> Same for the ghost cells outside the simulation domain when OPT__BC_POT is isolated
+//
+// Parameter   :  lv    : Target refinement level
+//                NCell : Number of cells along each direction in each patch at the target depth
+//                Sol   : Solution/correction array of all real patches at the target depth
+//                Sg    : Sandglass of patch->pot[] to be used as the MPI buffer
+//-------------------------------------------------------------------------------------------------------
+void Exchange( const int lv, const int NCell, real *Sol, const int Sg )
+{
+
+   const int NPatch = amr->NPatchComma[lv][1];
+   const int NG     = NCell + 2;
+   const int r      = PS1/NCell;
+   const int Idx[2] = { 0, PS1-1 };    // boundary layers of pot[] on the left/right sides
+   const int PScale = PS1*amr->scale[lv];
+
+
+// 1. copy the boundary layers of each real patch to pot[Sg]
+#  pragma omp parallel for schedule( static )
+   for (int PID=0; PID<NPatch; PID++)
+   {
+      const real (*S)[NG][NG] = ( real(*)[NG][NG] )( Sol + (long)PID*CUBE(NG) );
+      real (*Pot)[PS1][PS1]   = amr->patch[Sg][lv][PID]->pot;
+
+      for (int b=0; b<2; b++)
+      {
+         const int n = ( b == 0 ) ? 1 : NCell;
+
+         for (int u=0; u<NCell; u++)
+         for (int v=0; v<NCell; v++)
+         {
+            Pot[ v*r    ][ u*r    ][ Idx[b] ] = S[ v+1 ][ u+1 ][ n   ];
+            Pot[ v*r    ][ Idx[b] ][ u*r    ] = S[ v+1 ][ n   ][ u+1 ];
+            Pot[ Idx[b] ][ v*r    ][ u*r    ] = S[ n   ][ v+1 ][ u+1 ];
+         }
+      }
+   }
+
+
+// 2. transfer data to the buffer patches
+   Buf_GetBufferData( lv, NULL_INT, NULL_INT, Sg, POT_FOR_POISSON, _POTE, _NONE, 1, USELB_YES );
+
+
+// 3. fill up the ghost layers from the sibling patches
+#  pragma omp parallel for schedule( static )
+   for (int PID=0; PID<NPatch; PID++)
+   {
+      real (*S)[NG][NG] = ( real(*)[NG][NG] )( Sol + (long)PID*CUBE(NG) );
+      const int *Corner = amr->patch[0][lv][PID]->corner;
+
+      for (int s=0; s<6; s++)
+      {
+         const int SibPID = amr->patch[0][lv][PID]->sibling[s];
+
+         if ( SibPID < 0 )    continue;
+
+//       skip the periodic siblings across the simulation boundaries for the isolated B.C.
+         if ( OPT__BC_POT == BC_POT_ISOLATED )
+         {
+            const int d = s/2;
+
+            if (  ( s%2 == 0  &&  Corner[d] == 0 )  ||  ( s%2 == 1  &&  Corner[d] + PScale == amr->BoxScale[d] )  )
+               continue;
+         }
+
+         const real (*SibPot)[PS1][PS1] = amr->patch[Sg][lv][SibPID]->pot;
+         const int  b_In  = 1 - s%2;                  // read the opposite boundary layer of the sibling patch
+         const int  g_Out = ( s%2 == 0 ) ? 0 : NG-1;  // ghost layer to be filled
+
+         for (int u=0; u<NCell; u++)
+         for (int v=0; v<NCell; v++)
+         {
+            switch ( s/2 )
+            {
+               case 0:  S[ v+1  ][ u+1  ][ g_Out ] = SibPot[ v*r        ][ u*r        ][ Idx[b_In] ];   break;
+               case 1:  S[ v+1  ][ g_Out ][ u+1  ] = SibPot[ v*r        ][ Idx[b_In] ][ u*r        ];   break;
+               case 2:  S[ g_Out ][ v+1  ][ u+1  ] = SibPot[ Idx[b_In] ][ v*r        ][ u*r        ];   break;
+            }
+         }
+      } // for (int s=0; s<6; s++)
+   } // for (int PID=0; PID<NPatch; PID++)
+
+} // FUNCTION : Exchange
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Smoothing
+// Description :  Use the red-black Gauss-Seidel method for smoothing
+//
+// Note        :  1. The red-black ordering is defined by the global cell indices at the target depth so that
+//                   the result does not depend on the patch decomposition
+//                2. Invoke Exchange() before each red/black sweep
+//
+// Parameter   :  lv    : Target refinement level
+//                Depth : Target multigrid depth
+//                NCell : Number of cells along each direction in each patch at the target depth
+//                Sol   : Solution/correction array of all real patches at the target depth
+//                RHS   : RHS array of all real patches at the target depth
+//                dh    : Cell size at the target depth
+//                NStep : Number of smoothing steps
+//                Sg    : Sandglass of patch->pot[] to be used as the MPI buffer
+//-------------------------------------------------------------------------------------------------------
+void Smoothing( const int lv, const int Depth, const int NCell, real *Sol, const real *RHS, const real dh,
+                const int NStep, const int Sg )
+{
+
+   const int  NPatch  = amr->NPatchComma[lv][1];
+   const int  NG      = NCell + 2;
+   const real dh2     = dh*dh;
+   const real One_Six = (real)1.0/(real)6.0;
+
+
+   for (int Step=0; Step<NStep; Step++)
+   for (int Color=0; Color<2; Color++)
+   {
+      Exchange( lv, NCell, Sol, Sg );
+
+#     pragma omp parallel for schedule( static )
+      for (int PID=0; PID<NPatch; PID++)
+      {
+               real (*S)[NG   ][NG   ] = ( real(*)[NG   ][NG   ] )( Sol + (long)PID*CUBE(NG   ) );
+         const real (*R)[NCell][NCell] = ( real(*)[NCell][NCell] )( RHS + (long)PID*CUBE(NCell) );
+
+//       parity of the first cell in this patch
+         int Parity0 = 0;
+         for (int d=0; d<3; d++)    Parity0 += ( amr->patch[0][lv][PID]->corner[d]/amr->scale[lv] ) >> Depth;
+
+         for (int k=0; k<NCell; k++)
+         for (int j=0; j<NCell; j++)
+         {
+            const int i_start = ( Parity0 + k + j + Color ) & 1;
+
+            for (int i=i_start; i<NCell; i+=2)
+            {
+               const int ii = i + 1;
+               const int jj = j + 1;
+               const int kk = k + 1;
+
+               S[kk][jj][ii] = One_Six*(   S[kk+1][jj  ][ii  ] + S[kk-1][jj  ][ii  ]
+                                         + S[kk  ][jj+1][ii  ] + S[kk  ][jj-1][ii  ]
+                                         + S[kk  ][jj  ][ii+1] + S[kk  ][jj  ][ii-1] - dh2*R[k][j][i]  );
+            }
+         }
+      } // for (int PID=0; PID<NPatch; PID++)
+   } // for Step, Color
+
+} // FUNCTION : Smoothing
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Restrict_Defect
+// Description :  Compute the defect at the fine depth and restrict it to be the RHS at the coarse depth
+//
+// Note        :  1. Ghost layer of Sol_F must be filled in advance
+//                2. Cell-centered restriction (i.e., average over 8 fine cells)
+//
+// Parameter   :  NPatch  : Number of real patches
+//                NCell_F : Number of cells along each direction in each patch at the fine depth
+//                Sol_F   : Solution/correction array at the fine depth
+//                RHS_F   : RHS array at the fine depth
+//                dh_F    : Cell size at the fine depth
+//                RHS_C   : RHS array at the coarse depth to be filled
+//-------------------------------------------------------------------------------------------------------
+void Restrict_Defect( const int NPatch, const int NCell_F, const real *Sol_F, const real *RHS_F, const real dh_F,
+                      real *RHS_C )
+{
+
+   const int  NCell_C = NCell_F/2;
+   const int  NG      = NCell_F + 2;
+   const real _dh2    = (real)-1.0/(dh_F*dh_F);
+   const real Const_8 = (real)1.0/(real)8.0;
+
+
+#  pragma omp parallel for schedule( static )
+   for (int PID=0; PID<NPatch; PID++)
+   {
+      const real (*S )[NG     ][NG     ] = ( real(*)[NG     ][NG     ] )( Sol_F + (long)PID*CUBE(NG     ) );
+      const real (*RF)[NCell_F][NCell_F] = ( real(*)[NCell_F][NCell_F] )( RHS_F + (long)PID*CUBE(NCell_F) );
+            real (*RC)[NCell_C][NCell_C] = ( real(*)[NCell_C][NCell_C] )( RHS_C + (long)PID*CUBE(NCell_C) );
+
+      for (int k=0; k<NCell_C; k++)
+      for (int j=0; j<NCell_C; j++)
+      for (int i=0; i<NCell_C; i++)
+         RC[k][j][i] = (real)0.0;
+
+      for (int k=0; k<NCell_F; k++)    {  const int kk = k + 1;
+      for (int j=0; j<NCell_F; j++)    {  const int jj = j + 1;
+      for (int i=0; i<NCell_F; i++)    {  const int ii = i + 1;
+
+         const real Def = _dh2*(   S[kk+1][jj  ][ii  ] + S[kk-1][jj  ][ii  ]
+                                 + S[kk  ][jj+1][ii  ] + S[kk  ][jj-1][ii  ]
+                                 + S[kk  ][jj  ][ii+1] + S[kk  ][jj  ][ii-1] - (real)6.0*S[kk][jj][ii] ) + RF[k][j][i];
+
+         RC[k/2][j/2][i/2] += Const_8*Def;
+      }}}
+   } // for (int PID=0; PID<NPatch; PID++)
+
+} // FUNCTION : Restrict_Defect
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Prolongate_and_Correct
+// Description :  Prolongate the coarse-grid correction to correct the fine-grid solution/correction
+//
+// Note        :  1. Cell-centered trilinear interpolation
+//                2. Ghost layer of Sol_C must be filled in advance
+//
+// Parameter   :  NPatch  : Number of real patches
+//                NCell_C : Number of cells along each direction in each patch at the coarse depth
+//                Sol_C   : Correction array at the coarse depth
+//                Sol_F   : Solution/correction array at the fine depth to be corrected
+//-------------------------------------------------------------------------------------------------------
+void Prolongate_and_Correct( const int NPatch, const int NCell_C, const real *Sol_C, real *Sol_F )
+{
+
+   const int  NCell_F = 2*NCell_C;
+   const int  NG_C    = NCell_C + 2;
+   const int  NG_F    = NCell_F + 2;
+   const real W[2]    = { (real)0.75, (real)0.25 };
+
+
+#  pragma omp parallel for schedule( static )
+   for (int PID=0; PID<NPatch; PID++)
+   {
+      const real (*C)[NG_C][NG_C] = ( real(*)[NG_C][NG_C] )( Sol_C + (long)PID*CUBE(NG_C) );
+            real (*F)[NG_F][NG_F] = ( real(*)[NG_F][NG_F] )( Sol_F + (long)PID*CUBE(NG_F) );
+
+      for (int k=0; k<NCell_F; k++)    {  const int kc = k/2 + 1;    const int dk = ( k%2 == 0 ) ? -1 : +1;
+      for (int j=0; j<NCell_F; j++)    {  const int jc = j/2 + 1;    const int dj = ( j%2 == 0 ) ? -1 : +1;
+      for (int i=0; i<NCell_F; i++)    {  const int ic = i/2 + 1;    const int di = ( i%2 == 0 ) ? -1 : +1;
+
+         real Corr = (real)0.0;
+
+         for (int c=0; c<2; c++)
+         for (int b=0; b<2; b++)
+         for (int a=0; a<2; a++)
+            Corr += W[c]*W[b]*W[a]*C[ kc + c*dk ][ jc + b*dj ][ ic + a*di ];
+
+         F[k+1][j+1][i+1] += Corr;
+      }}}
+   } // for (int PID=0; PID<NPatch; PID++)
+
+} // FUNCTION : Prolongate_and_Correct
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  EstimateError
+// Description :  Compute the L1 norms of the defect and solution of all local patches
+//
+// Note        :  1. Ghost layer of Sol must be filled in advance
+//                2. Error = dh^2*SumDef/SumSol after summing over all ranks (see ComputeDefect() in
+//                   CPU_PoissonSolver_MG.cpp)
+//
+// Parameter   :  NPatch : Number of real patches
+//                NCell  : Number of cells along each direction in each patch
+//                Sol    : Solution array
+//                RHS    : RHS array
+//                dh     : Cell size
+//                SumDef : Sum of |defect| to be returned
+//                SumSol : Sum of |solution| to be returned
+//-------------------------------------------------------------------------------------------------------
+void EstimateError( const int NPatch, const int NCell, const real *Sol, const real *RHS, const real dh,
+                    double &SumDef, double &SumSol )
+{
+
+   const int  NG   = NCell + 2;
+   const real _dh2 = (real)-1.0/(dh*dh);
+
+   double SumDef_Local = 0.0;
+   double SumSol_Local = 0.0;
+
+
+#  pragma omp parallel for reduction( +:SumDef_Local, SumSol_Local ) schedule( static )
+   for (int PID=0; PID<NPatch; PID++)
+   {
+      const real (*S)[NG   ][NG   ] = ( real(*)[NG   ][NG   ] )( Sol + (long)PID*CUBE(NG   ) );
+      const real (*R)[NCell][NCell] = ( real(*)[NCell][NCell] )( RHS + (long)PID*CUBE(NCell) );
+
+      for (int k=0; k<NCell; k++)      {  const int kk = k + 1;
+      for (int j=0; j<NCell; j++)      {  const int jj = j + 1;
+      for (int i=0; i<NCell; i++)      {  const int ii = i + 1;
+
+         const real Def = _dh2*(   S[kk+1][jj  ][ii  ] + S[kk-1][jj  ][ii  ]
+                                 + S[kk  ][jj+1][ii  ] + S[kk  ][jj-1][ii  ]
+                                 + S[kk  ][jj  ][ii+1] + S[kk  ][jj  ][ii-1] - (real)6.0*S[kk][jj][ii] ) + R[k][j][i];
+
+         SumDef_Local += FABS( Def );
+         SumSol_Local += FABS( S[kk][jj][ii] );
+      }}}
+   }
+
+   SumDef = SumDef_Local;
+   SumSol = SumSol_Local;
+
+} // FUNCTION : EstimateError
+
+
+
+#endif // #if ( defined GRAVITY  &&  POT_SCHEME == MG )
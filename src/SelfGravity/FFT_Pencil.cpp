@@ -0,0 +1,517 @@
+#include "GAMER.h"
+
+#if ( defined GRAVITY  &&  !defined SERIAL )
+
+
+
+static void SplitRange( const int N, const int Unit, const int NPart, int *Start );
+static void Transpose_XY( const FFT_Pencil_t *Pencil, fftw_complex *cdata, const bool Forward );
+static void Transpose_YZ( const FFT_Pencil_t *Pencil, fftw_complex *cdata, const bool Forward );
+static void Alltoallv_Complex( fftw_complex *SendBuf, int *NSend, fftw_complex *RecvBuf, int *NRecv, MPI_Comm Comm );
+
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  FFT_Pencil_Init
+// Description :  Set up the 2D pencil domain decomposition and the 1D FFTW plans for the base-level FFT
+//
+// Note        :  1. Invoked by Init_FFTW() for OPT__FFT_PENCIL
+//                2. The process grid "NRank[0]*NRank[1] == MPI_NRank" is chosen to be as square as possible
+//                   while keeping all ranks busy
+//                   --> NRank[0] <= MIN( N[1]/PATCH_SIZE, N[0]/2+1 ) and NRank[1] <= MIN( N[2], N[1] )
+//                   --> Fall back to the most square process grid if no such grid exists, in which case
+//                       some ranks will be idle
+//                3. See FFT_Pencil.h for the data layouts
+//
+// Parameter   :  Pencil   : FFT_Pencil_t object to be initialized
+//                FFT_Size : Size of the FFT operation including the zero-padding regions
+//                PlanFlag : FFTW planner flag (e.g., FFTW_ESTIMATE, FFTW_MEASURE, FFTW_USE_WISDOM)
+//-------------------------------------------------------------------------------------------------------
+void FFT_Pencil_Init( FFT_Pencil_t *Pencil, const int FFT_Size[], const int PlanFlag )
+{
+
+// check
+   if ( FFT_Size[1] % PS1 != 0 )
+      Aux_Error( ERROR_INFO, "FFT_Size[1] (%d) %% PATCH_SIZE (%d) != 0 !!\n", FFT_Size[1], PS1 );
+
+
+   for (int d=0; d<3; d++)    Pencil->N[d] = FFT_Size[d];
+
+   Pencil->Nx_Padded = Pencil->N[0]/2 + 1;
+
+
+// 1. set the process grid
+   const int NRank0_Max = MIN( Pencil->N[1]/PS1, Pencil->Nx_Padded );
+   const int NRank1_Max = MIN( Pencil->N[2],     Pencil->N[1]      );
+
+   int  NRank0_Best = -1, NRank1_Best = -1, NRank0_Square = -1, NRank1_Square = -1;
+
+   for (int NRank1=1; NRank1<=MPI_NRank; NRank1++)
+   {
+      if ( MPI_NRank % NRank1 != 0 )   continue;
+
+      const int NRank0 = MPI_NRank / NRank1;
+
+//    most square grid with all ranks busy (prefer more ranks along z when tied)
+      if ( NRank0 <= NRank0_Max  &&  NRank1 <= NRank1_Max )
+         if ( NRank0_Best < 0  ||  abs(NRank0-NRank1) <= abs(NRank0_Best-NRank1_Best) )
+         {
+            NRank0_Best = NRank0;
+            NRank1_Best = NRank1;
+         }
+
+//    most square grid regardless of idle ranks
+      if ( NRank0_Square < 0  ||  abs(NRank0-NRank1) <= abs(NRank0_Square-NRank1_Square) )
+      {
+         NRank0_Square = NRank0;
+         NRank1_Square = NRank1;
+      }
+   }
+
+   if ( NRank0_Best < 0 )
+   {
+      NRank0_Best = NRank0_Square;
+      NRank1_Best = NRank1_Square;
+
+      if ( MPI_Rank == 0 )
+         Aux_Message( stderr, "WARNING : some ranks will be idle in the pencil FFT (FFT size %d x %d x %d, process grid %d x %d) !!\n",
+                      Pencil->N[0], Pencil->N[1], Pencil->N[2], NRank0_Best, NRank1_Best );
+   }
+
+   Pencil->NRank[0] = NRank0_Best;
+   Pencil->NRank[1] = NRank1_Best;
+   Pencil->Coord[0] = MPI_Rank % Pencil->NRank[0];
+   Pencil->Coord[1] = MPI_Rank / Pencil->NRank[0];
+
+
+// 2. set the data ranges of all ranks
+   for (int d=0; d<2; d++)
+   {
+      Pencil->R_Start[d] = new int [ Pencil->NRank[d]+1 ];
+      Pencil->K_Start[d] = new int [ Pencil->NRank[d]+1 ];
+   }
+
+   SplitRange( Pencil->N[1],      PS1, Pencil->NRank[0], Pencil->R_Start[0] );
+   SplitRange( Pencil->N[2],      1,   Pencil->NRank[1], Pencil->R_Start[1] );
+   SplitRange( Pencil->Nx_Padded, 1,   Pencil->NRank[0], Pencil->K_Start[0] );
+   SplitRange( Pencil->N[1],      1,   Pencil->NRank[1], Pencil->K_Start[1] );
+
+   const long NY_R = Pencil->R_Start[0][ Pencil->Coord[0]+1 ] - Pencil->R_Start[0][ Pencil->Coord[0] ];
+   const long NZ_R = Pencil->R_Start[1][ Pencil->Coord[1]+1 ] - Pencil->R_Start[1][ Pencil->Coord[1] ];
+   const long NX_K = Pencil->K_Start[0][ Pencil->Coord[0]+1 ] - Pencil->K_Start[0][ Pencil->Coord[0] ];
+   const long NY_K = Pencil->K_Start[1][ Pencil->Coord[1]+1 ] - Pencil->K_Start[1][ Pencil->Coord[1] ];
+
+   long NCplx_Max = 1;
+   NCplx_Max = MAX( NCplx_Max, NZ_R*NY_R*Pencil->Nx_Padded );   // x pencil
+   NCplx_Max = MAX( NCplx_Max, NZ_R*NX_K*Pencil->N[1]      );   // y pencil
+   NCplx_Max = MAX( NCplx_Max, NX_K*NY_K*Pencil->N[2]      );   // z pencil
+
+   Pencil->LocalSize = 2*NCplx_Max;
+
+
+// 3. create the sub-communicators
+// --> ranks in Comm[d] are ordered by Coord[d]
+   MPI_Comm_split( MPI_COMM_WORLD, Pencil->Coord[1], Pencil->Coord[0], &Pencil->Comm[0] );
+   MPI_Comm_split( MPI_COMM_WORLD, Pencil->Coord[0], Pencil->Coord[1], &Pencil->Comm[1] );
+
+
+// 4. create the 1D FFTW plans
+   Pencil->Plan_X_Fw = rfftw_create_plan( Pencil->N[0], FFTW_REAL_TO_COMPLEX, PlanFlag );
+   Pencil->Plan_X_Bw = rfftw_create_plan( Pencil->N[0], FFTW_COMPLEX_TO_REAL, PlanFlag );
+   Pencil->Plan_Y_Fw = fftw_create_plan ( Pencil->N[1], FFTW_FORWARD,         PlanFlag | FFTW_IN_PLACE );
+   Pencil->Plan_Y_Bw = fftw_create_plan ( Pencil->N[1], FFTW_BACKWARD,        PlanFlag | FFTW_IN_PLACE );
+   Pencil->Plan_Z_Fw = fftw_create_plan ( Pencil->N[2], FFTW_FORWARD,         PlanFlag | FFTW_IN_PLACE );
+   Pencil->Plan_Z_Bw = fftw_create_plan ( Pencil->N[2], FFTW_BACKWARD,        PlanFlag | FFTW_IN_PLACE );
+
+} // FUNCTION : FFT_Pencil_Init
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  FFT_Pencil_End
+// Description :  Free the memory, communicators, and FFTW plans allocated by FFT_Pencil_Init()
+//
+// Parameter   :  Pencil : FFT_Pencil_t object to be freed
+//-------------------------------------------------------------------------------------------------------
+void FFT_Pencil_End( FFT_Pencil_t *Pencil )
+{
+
+   for (int d=0; d<2; d++)
+   {
+      delete [] Pencil->R_Start[d];    Pencil->R_Start[d] = NULL;
+      delete [] Pencil->K_Start[d];    Pencil->K_Start[d] = NULL;
+
+      MPI_Comm_free( &Pencil->Comm[d] );
+   }
+
+   rfftw_destroy_plan( Pencil->Plan_X_Fw );
+   rfftw_destroy_plan( Pencil->Plan_X_Bw );
+   fftw_destroy_plan ( Pencil->Plan_Y_Fw );
+   fftw_destroy_plan ( Pencil->Plan_Y_Bw );
+   fftw_destroy_plan ( Pencil->Plan_Z_Fw );
+   fftw_destroy_plan ( Pencil->Plan_Z_Bw );
+
+} // FUNCTION : FFT_Pencil_End
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  FFT_Pencil_Forward
+// Description :  Real-to-complex forward FFT with the pencil decomposition
+//
+// Note        :  1. Input  : real    data in the x-pencil layout [z][y][2*(N[0]/2+1)]
+//                   Output: complex data in the z-pencil layout [x][y][z]
+//                2. Unnormalized, same as rfftwnd
+//                3. 1D FFTs are distributed among OpenMP threads
+//                   --> Executing the same FFTW plan concurrently is thread-safe
+//
+// Parameter   :  Pencil : FFT_Pencil_t object set by FFT_Pencil_Init()
+//                Data   : In-place FFT array with at least Pencil->LocalSize elements
+//-------------------------------------------------------------------------------------------------------
+void FFT_Pencil_Forward( const FFT_Pencil_t *Pencil, real *Data )
+{
+
+   const int  Nx    = Pencil->N[0];
+   const int  Nxp   = Pencil->Nx_Padded;
+   const long NY_R  = Pencil->R_Start[0][ Pencil->Coord[0]+1 ] - Pencil->R_Start[0][ Pencil->Coord[0] ];
+   const long NZ_R  = Pencil->R_Start[1][ Pencil->Coord[1]+1 ] - Pencil->R_Start[1][ Pencil->Coord[1] ];
+   const long NX_K  = Pencil->K_Start[0][ Pencil->Coord[0]+1 ] - Pencil->K_Start[0][ Pencil->Coord[0] ];
+   const long NY_K  = Pencil->K_Start[1][ Pencil->Coord[1]+1 ] - Pencil->K_Start[1][ Pencil->Coord[1] ];
+
+   fftw_complex *cdata = (fftw_complex*)Data;
+
+
+// 1. x-FFT: convert the half-complex output of rfftw to fftw_complex
+#  pragma omp parallel
+   {
+      real *HC = new real [Nx];
+
+#     pragma omp for schedule( static )
+      for (long t=0; t<NZ_R*NY_R; t++)
+      {
+         real         *Line  = Data + t*2*Nxp;
+         fftw_complex *cLine = (fftw_complex*)Line;
+
+         rfftw_one( Pencil->Plan_X_Fw, Line, HC );
+
+         cLine[0].re = HC[0];
+         cLine[0].im = (real)0.0;
+
+         for (int i=1; i<(Nx+1)/2; i++)
+         {
+            cLine[i].re = HC[i];
+            cLine[i].im = HC[Nx-i];
+         }
+
+         if ( Nx%2 == 0 )
+         {
+            cLine[Nx/2].re = HC[Nx/2];
+            cLine[Nx/2].im = (real)0.0;
+         }
+      }
+
+      delete [] HC;
+   } // OpenMP parallel region
+
+
+// 2. x pencil -> y pencil and y-FFT
+   Transpose_XY( Pencil, cdata, true );
+
+#  pragma omp parallel for schedule( static )
+   for (long t=0; t<NZ_R*NX_K; t++)
+      fftw( Pencil->Plan_Y_Fw, 1, cdata+t*Pencil->N[1], 1, 0, NULL, 0, 0 );
+
+
+// 3. y pencil -> z pencil and z-FFT
+   Transpose_YZ( Pencil, cdata, true );
+
+#  pragma omp parallel for schedule( static )
+   for (long t=0; t<NX_K*NY_K; t++)
+      fftw( Pencil->Plan_Z_Fw, 1, cdata+t*Pencil->N[2], 1, 0, NULL, 0, 0 );
+
+} // FUNCTION : FFT_Pencil_Forward
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  FFT_Pencil_Backward
+// Description :  Complex-to-real backward FFT with the pencil decomposition
+//
+// Note        :  1. Input  : complex data in the z-pencil layout [x][y][z]
+//                   Output: real    data in the x-pencil layout [z][y][2*(N[0]/2+1)]
+//                2. Unnormalized, same as rfftwnd
+//                3. 1D FFTs are distributed among OpenMP threads
+//
+// Parameter   :  Pencil : FFT_Pencil_t object set by FFT_Pencil_Init()
+//                Data   : In-place FFT array with at least Pencil->LocalSize elements
+//-------------------------------------------------------------------------------------------------------
+void FFT_Pencil_Backward( const FFT_Pencil_t *Pencil, real *Data )
+{
+
+   const int  Nx    = Pencil->N[0];
+   const int  Nxp   = Pencil->Nx_Padded;
+   const long NY_R  = Pencil->R_Start[0][ Pencil->Coord[0]+1 ] - Pencil->R_Start[0][ Pencil->Coord[0] ];
+   const long NZ_R  = Pencil->R_Start[1][ Pencil->Coord[1]+1 ] - Pencil->R_Start[1][ Pencil->Coord[1] ];
+   const long NX_K  = Pencil->K_Start[0][ Pencil->Coord[0]+1 ] - Pencil->K_Start[0][ Pencil->Coord[0] ];
+   const long NY_K  = Pencil->K_Start[1][ Pencil->Coord[1]+1 ] - Pencil->K_Start[1][ Pencil->Coord[1] ];
+
+   fftw_complex *cdata = (fftw_complex*)Data;
+
+
+// 1. z-FFT and z pencil -> y pencil
+#  pragma omp parallel for schedule( static )
+   for (long t=0; t<NX_K*NY_K; t++)
+      fftw( Pencil->Plan_Z_Bw, 1, cdata+t*Pencil->N[2], 1, 0, NULL, 0, 0 );
+
+   Transpose_YZ( Pencil, cdata, false );
+
+
+// 2. y-FFT and y pencil -> x pencil
+#  pragma omp parallel for schedule( static )
+   for (long t=0; t<NZ_R*NX_K; t++)
+      fftw( Pencil->Plan_Y_Bw, 1, cdata+t*Pencil->N[1], 1, 0, NULL, 0, 0 );
+
+   Transpose_XY( Pencil, cdata, false );
+
+
+// 3. x-FFT: convert fftw_complex to the half-complex input of rfftw
+#  pragma omp parallel
+   {
+      real *HC = new real [Nx];
+
+#     pragma omp for schedule( static )
+      for (long t=0; t<NZ_R*NY_R; t++)
+      {
+         real               *Line  = Data + t*2*Nxp;
+         const fftw_complex *cLine = (fftw_complex*)Line;
+
+         HC[0] = cLine[0].re;
+
+         for (int i=1; i<(Nx+1)/2; i++)
+         {
+            HC[i   ] = cLine[i].re;
+            HC[Nx-i] = cLine[i].im;
+         }
+
+         if ( Nx%2 == 0 )  HC[Nx/2] = cLine[Nx/2].re;
+
+         rfftw_one( Pencil->Plan_X_Bw, HC, Line );
+      }
+
+      delete [] HC;
+   } // OpenMP parallel region
+
+} // FUNCTION : FFT_Pencil_Backward
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SplitRange
+// Description :  Split the range [0,N) into NPart contiguous segments aligned with Unit
+//
+// Note        :  1. Segment p covers [ Start[p], Start[p+1] )
+//                2. N must be a multiple of Unit
+//                3. Some segments will be empty if N/Unit < NPart
+//
+// Parameter   :  N     : Size of the range
+//                Unit  : Alignment of the segment boundaries
+//                NPart : Number of segments
+//                Start : Starting index of each segment [NPart+1]
+//-------------------------------------------------------------------------------------------------------
+void SplitRange( const int N, const int Unit, const int NPart, int *Start )
+{
+
+   const long NUnit = N / Unit;
+
+   for (int p=0; p<=NPart; p++)  Start[p] = Unit*(int)(  ( (long)p*NUnit + NPart - 1 ) / NPart  );
+
+} // FUNCTION : SplitRange
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Transpose_XY
+// Description :  Transpose between the x pencils [z][y][x] and y pencils [z][x][y] within Pencil->Comm[0]
+//
+// Parameter   :  Pencil  : FFT_Pencil_t object set by FFT_Pencil_Init()
+//                cdata   : Complex data array to be transposed in place
+//                Forward : true/false --> x pencil -> y pencil / y pencil -> x pencil
+//-------------------------------------------------------------------------------------------------------
+void Transpose_XY( const FFT_Pencil_t *Pencil, fftw_complex *cdata, const bool Forward )
+{
+
+   const int   NRank  = Pencil->NRank[0];
+   const int   MyRank = Pencil->Coord[0];
+   const int  *Y0     = Pencil->R_Start[0];
+   const int  *X0     = Pencil->K_Start[0];
+   const int   Nxp    = Pencil->Nx_Padded;
+   const int   Ny     = Pencil->N[1];
+   const long  NZ     = Pencil->R_Start[1][ Pencil->Coord[1]+1 ] - Pencil->R_Start[1][ Pencil->Coord[1] ];
+   const long  NY_Me  = Y0[MyRank+1] - Y0[MyRank];
+   const long  NX_Me  = X0[MyRank+1] - X0[MyRank];
+   const long  NCplx  = NZ*MAX( NY_Me*Nxp, NX_Me*Ny );
+
+   fftw_complex *SendBuf = new fftw_complex [NCplx];
+   fftw_complex *RecvBuf = new fftw_complex [NCplx];
+   fftw_complex *Ptr     = NULL;
+   int NSend[NRank], NRecv[NRank];
+
+// all buffers are arranged as [z][y][x] for each rank
+// --> forward : send x in X0[r] and y in Y0[MyRank]; receive x in X0[MyRank] and y in Y0[r]
+//     backward: the other way around
+   Ptr = SendBuf;
+   for (int r=0; r<NRank; r++)
+   {
+      const int NY = ( Forward ) ? NY_Me : Y0[r+1]-Y0[r];
+      const int NX = ( Forward ) ? X0[r+1]-X0[r] : NX_Me;
+
+      for (int k=0; k<NZ; k++)
+      for (int j=0; j<NY; j++)
+      for (int i=0; i<NX; i++)
+      {
+         if ( Forward )    *Ptr++ = cdata[ ( (long)k*NY_Me + j )*Nxp + X0[r] + i ];
+         else              *Ptr++ = cdata[ ( (long)k*NX_Me + i )*Ny  + Y0[r] + j ];
+      }
+
+      NSend[r] = NZ*NY*NX;
+      NRecv[r] = ( Forward ) ? NZ*( Y0[r+1]-Y0[r] )*NX_Me : NZ*NY_Me*( X0[r+1]-X0[r] );
+   }
+
+   Alltoallv_Complex( SendBuf, NSend, RecvBuf, NRecv, Pencil->Comm[0] );
+
+   Ptr = RecvBuf;
+   for (int r=0; r<NRank; r++)
+   {
+      const int NY = ( Forward ) ? Y0[r+1]-Y0[r] : NY_Me;
+      const int NX = ( Forward ) ? NX_Me : X0[r+1]-X0[r];
+
+      for (int k=0; k<NZ; k++)
+      for (int j=0; j<NY; j++)
+      for (int i=0; i<NX; i++)
+      {
+         if ( Forward )    cdata[ ( (long)k*NX_Me + i )*Ny  + Y0[r] + j ] = *Ptr++;
+         else              cdata[ ( (long)k*NY_Me + j )*Nxp + X0[r] + i ] = *Ptr++;
+      }
+   }
+
+   delete [] SendBuf;
+   delete [] RecvBuf;
+
+} // FUNCTION : Transpose_XY
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Transpose_YZ
+// Description :  Transpose between the y pencils [z][x][y] and z pencils [x][y][z] within Pencil->Comm[1]
+//
+// Parameter   :  Pencil  : FFT_Pencil_t object set by FFT_Pencil_Init()
+//                cdata   : Complex data array to be transposed in place
+//                Forward : true/false --> y pencil -> z pencil / z pencil -> y pencil
+//-------------------------------------------------------------------------------------------------------
+void Transpose_YZ( const FFT_Pencil_t *Pencil, fftw_complex *cdata, const bool Forward )
+{
+
+   const int   NRank  = Pencil->NRank[1];
+   const int   MyRank = Pencil->Coord[1];
+   const int  *Z0     = Pencil->R_Start[1];
+   const int  *Y0     = Pencil->K_Start[1];
+   const int   Ny     = Pencil->N[1];
+   const int   Nz     = Pencil->N[2];
+   const long  NX     = Pencil->K_Start[0][ Pencil->Coord[0]+1 ] - Pencil->K_Start[0][ Pencil->Coord[0] ];
+   const long  NZ_Me  = Z0[MyRank+1] - Z0[MyRank];
+   const long  NY_Me  = Y0[MyRank+1] - Y0[MyRank];
+   const long  NCplx  = NX*MAX( NZ_Me*Ny, NY_Me*Nz );
+
+   fftw_complex *SendBuf = new fftw_complex [NCplx];
+   fftw_complex *RecvBuf = new fftw_complex [NCplx];
+   fftw_complex *Ptr     = NULL;
+   int NSend[NRank], NRecv[NRank];
+
+// all buffers are arranged as [z][x][y] for each rank
+// --> forward : send y in Y0[r] and z in Z0[MyRank]; receive y in Y0[MyRank] and z in Z0[r]
+//     backward: the other way around
+   Ptr = SendBuf;
+   for (int r=0; r<NRank; r++)
+   {
+      const int NZ = ( Forward ) ? NZ_Me : Z0[r+1]-Z0[r];
+      const int NY = ( Forward ) ? Y0[r+1]-Y0[r] : NY_Me;
+
+      for (int k=0; k<NZ; k++)
+      for (int i=0; i<NX; i++)
+      for (int j=0; j<NY; j++)
+      {
+         if ( Forward )    *Ptr++ = cdata[ ( (long)k*NX + i )*Ny    + Y0[r] + j ];
+         else              *Ptr++ = cdata[ ( (long)i*NY_Me + j )*Nz + Z0[r] + k ];
+      }
+
+      NSend[r] = NZ*NX*NY;
+      NRecv[r] = ( Forward ) ? ( Z0[r+1]-Z0[r] )*NX*NY_Me : NZ_Me*NX*( Y0[r+1]-Y0[r] );
+   }
+
+   Alltoallv_Complex( SendBuf, NSend, RecvBuf, NRecv, Pencil->Comm[1] );
+
+   Ptr = RecvBuf;
+   for (int r=0; r<NRank; r++)
+   {
+      const int NZ = ( Forward ) ? Z0[r+1]-Z0[r] : NZ_Me;
+      const int NY = ( Forward ) ? NY_Me : Y0[r+1]-Y0[r];
+
+      for (int k=0; k<NZ; k++)
+      for (int i=0; i<NX; i++)
+      for (int j=0; j<NY; j++)
+      {
+         if ( Forward )    cdata[ ( (long)i*NY_Me + j )*Nz + Z0[r] + k ] = *Ptr++;
+         else              cdata[ ( (long)k*NX + i )*Ny    + Y0[r] + j ] = *Ptr++;
+      }
+   }
+
+   delete [] SendBuf;
+   delete [] RecvBuf;
+
+} // FUNCTION : Transpose_YZ
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  Alltoallv_Complex
+// Description :  MPI_Alltoallv for the fftw_complex arrays
+//
+// Parameter   :  SendBuf : Send buffer
+//                NSend   : Number of complex numbers sent to each rank in Comm
+//                RecvBuf : Receive buffer
+//                NRecv   : Number of complex numbers received from each rank in Comm
+//                Comm    : Target communicator
+//-------------------------------------------------------------------------------------------------------
+void Alltoallv_Complex( fftw_complex *SendBuf, int *NSend, fftw_complex *RecvBuf, int *NRecv, MPI_Comm Comm )
+{
+
+   int NRank;
+   MPI_Comm_size( Comm, &NRank );
+
+   int SendCount[NRank], RecvCount[NRank], SendDisp[NRank], RecvDisp[NRank];
+
+// each complex number consists of two real numbers
+   for (int r=0; r<NRank; r++)
+   {
+      SendCount[r] = 2*NSend[r];
+      RecvCount[r] = 2*NRecv[r];
+   }
+
+   SendDisp[0] = 0;
+   RecvDisp[0] = 0;
+   for (int r=1; r<NRank; r++)
+   {
+      SendDisp[r] = SendDisp[r-1] + SendCount[r-1];
+      RecvDisp[r] = RecvDisp[r-1] + RecvCount[r-1];
+   }
+
+   MPI_Alltoallv( SendBuf, SendCount, SendDisp, MPI_GAMER_REAL,
+                  RecvBuf, RecvCount, RecvDisp, MPI_GAMER_REAL, Comm );
+
+} // FUNCTION : Alltoallv_Complex
+
+
+
+#endif // #if ( defined GRAVITY  &&  !defined SERIAL )
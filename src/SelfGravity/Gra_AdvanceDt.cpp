@@ -18,13 +18,20 @@ extern void (*Poi_UserWorkBeforePoisson_Ptr)( const double Time, const int lv );
 // Description :  Solve the Poisson equation and advance the fluid variables by the gravitational acceleration
 //
 // Note        :  1. Poisson solver : lv = 0 : invoke CPU_PoissonSolver_FFT()
-//                                    lv > 0 : invoke InvokeSolver()
+//                                    lv > 0 : invoke InvokeSolver(), or CPU_PoissonSolver_LevelMG() if
+//                                             OPT__POI_LEVEL_MG is on
 //                2. Gravity solver : invoke InvokeSolver()
 //                3. The updated potential and fluid variables will be stored in the same sandglass
 //                4. PotSg at lv=0 will be updated here, but PotSg at at lv>0 and FluSg at lv>=0 will NOT be updated
 //                   (they will be updated in EvolveLevel instead)
 //                   --> It is because the lv-0 Poisson and Gravity solvers are invoked separately, and Gravity solver
 //                       needs to call Prepare_PatchData to get the updated potential
+//                   --> The same applies to PotSg at lv>0 when OPT__POI_LEVEL_MG is on
+//                5. For OverlapMPI (lv>0 only), this function must be invoked twice, first with Overlap_Sync=true and
+//                   then with Overlap_Sync=false
+//                   --> The first call collects particles and the second call frees the particle arrays
+//                   --> The second call invokes no MPI function so that it can run concurrently with the MPI
+//                       communication of the patches already advanced
 //
 // Parameter   :  lv           : Target refinement level
 //                TimeNew      : Target physical time to reach
@@ -66,10 +73,19 @@ void Gra_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, co
       Aux_Message( stderr, "WARNING : Poisson=off but Gravity=on --> ARE YOU SURE ?!\n" );
 
 
+   if ( OverlapMPI  &&  lv == 0 )
+      Aux_Error( ERROR_INFO, "OverlapMPI is NOT supported at the base level !!\n" );
+
+
 // whether we actually need potential
    const bool UsePot = (  Poisson  &&  ( OPT__SELF_GRAVITY || OPT__EXT_POT )  );
 
 
+// for OverlapMPI, initialize and finalize only once
+   const bool Initialize = ( !OverlapMPI  ||   Overlap_Sync );
+   const bool Finalize   = ( !OverlapMPI  ||  !Overlap_Sync );
+
+
 // coefficient in front of the RHS in the Poisson eq.
 #  ifdef COMOVING
    const double Poi_Coeff = 4.0*M_PI*NEWTON_G*TimeNew;   // use TimeNew for calculating potential
@@ -92,7 +108,7 @@ void Gra_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, co
    const bool FaSibBufPatch     = NULL_BOOL;
 #  endif
 
-   if ( UsePot )
+   if ( UsePot  &&  Initialize )
    {
       TIMING_FUNC(   Prepare_PatchData_InitParticleDensityArray( lv ),
                      Timer_Par_Collect[lv],   Timing   );
@@ -106,7 +122,7 @@ void Gra_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, co
 
 // user-specified work before invoking the Poisson/gravity solvers
 // --> call it even when UsePot==false in order to support external acceleration (OPT__EXT_ACC)
-   if ( Poi_UserWorkBeforePoisson_Ptr != NULL )
+   if ( Poi_UserWorkBeforePoisson_Ptr != NULL  &&  Initialize )
       TIMING_FUNC(   Poi_UserWorkBeforePoisson_Ptr( TimeNew, lv ),
                      Timer_Gra_Advance[lv],   ( Timing && lv == 0 )   );
 
@@ -159,6 +175,31 @@ void Gra_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, co
 
    else // lv > 0
    {
+//    solve the Poisson equation on all patches at lv at once (OPT__POI_LEVEL_MG)
+//    --> similar to the base-level solver, update PotSg and fill up the buffer patches here so that
+//        the Gravity solver can call Prepare_PatchData to get the updated potential
+#     if ( POT_SCHEME == MG )
+      if ( OPT__POI_LEVEL_MG  &&  UsePot )
+      {
+         CPU_PoissonSolver_LevelMG( lv, Poi_Coeff, SaveSg_Pot, TimeNew );
+
+         amr->PotSg    [lv]             = SaveSg_Pot;
+         amr->PotSgTime[lv][SaveSg_Pot] = TimeNew;
+
+         Buf_GetBufferData( lv, NULL_INT, NULL_INT, SaveSg_Pot, POT_FOR_POISSON, _POTE, _NONE, Pot_ParaBuf, USELB_YES );
+
+//       must call Poi_StorePotWithGhostZone AFTER collecting potential for buffer patches
+#        ifdef STORE_POT_GHOST
+         Poi_StorePotWithGhostZone( lv, SaveSg_Pot, true );
+#        endif
+
+         if ( Gravity )
+            InvokeSolver( GRAVITY_SOLVER, lv, TimeNew, TimeOld, dt, NULL_REAL, SaveSg_Flu, NULL_INT, NULL_INT,
+                          false, false );
+      }
+
+      else
+#     endif // #if ( POT_SCHEME == MG )
       if      (  Poisson  &&  !Gravity )
          InvokeSolver( POISSON_SOLVER,             lv, TimeNew, TimeOld, NULL_REAL, Poi_Coeff, NULL_INT,   NULL_INT, SaveSg_Pot,
                        OverlapMPI, Overlap_Sync );
@@ -175,7 +216,7 @@ void Gra_AdvanceDt( const int lv, const double TimeNew, const double TimeOld, co
 
 // free memory for collecting particles from other ranks and levels, and free density arrays with ghost zones (rho_ext)
 #  ifdef PARTICLE
-   if ( UsePot )
+   if ( UsePot  &&  Finalize )
    {
 //    don't use the TIMING_FUNC macro since we don't want to call MPI_Barrier here even when OPT__TIMING_BARRIER is on
 //    --> otherwise OPT__TIMING_BALANCE will fail because all ranks are synchronized before and after Gra_AdvanceDt
@@ -8,14 +8,29 @@
 rfftwnd_plan     FFTW_Plan, FFTW_Plan_Inv, FFTW_Plan_PS;    // PS : plan for calculating the power spectrum
 #else
 rfftwnd_mpi_plan FFTW_Plan, FFTW_Plan_Inv, FFTW_Plan_PS;
+FFT_Pencil_t    *FFT_Pencil = NULL, *FFT_Pencil_PS = NULL;   // for OPT__FFT_PENCIL
 #endif
 
+static void LoadWisdom( const char *FileName );
+static void SaveWisdom( const char *FileName );
+
+// FFTW wisdom file for OPT__FFTW_WISDOM
+#define FFTW_WISDOM_FILENAME  "FFTW_Wisdom"
+
 
 
 
 //-------------------------------------------------------------------------------------------------------
 // Function    :  Init_FFTW
 // Description :  Create the FFTW plans
+//
+// Note        :  1. For OPT__FFT_PENCIL, create the pencil decomposition "FFT_Pencil" and "FFT_Pencil_PS" instead
+//                   of the rfftwnd_mpi plans
+//                2. Planning strategy is set by OPT__FFTW_STARTUP
+//                   --> FFTW_STARTUP_MEASURE can take a long time for large FFTs, which can be amortized by
+//                       OPT__FFTW_WISDOM
+//                3. For OPT__FFTW_WISDOM, load the wisdom from the file FFTW_WISDOM_FILENAME (if it exists) before
+//                   creating the plans and save the wisdom of all ranks back to the same file afterwards
 //-------------------------------------------------------------------------------------------------------
 void Init_FFTW()
 {
@@ -38,21 +53,41 @@ void Init_FFTW()
    }
 
 
+// set the planner flag
+   int PlanFlag = ( OPT__FFTW_STARTUP == FFTW_STARTUP_MEASURE ) ? FFTW_MEASURE : FFTW_ESTIMATE;
+
+   if ( OPT__FFTW_WISDOM )
+   {
+      PlanFlag |= FFTW_USE_WISDOM;
+
+      LoadWisdom( FFTW_WISDOM_FILENAME );
+   }
+
+
 // create plans for the self-gravity solver
 #  ifdef SERIAL
    FFTW_Plan     = rfftw3d_create_plan( FFT_Size[2], FFT_Size[1], FFT_Size[0], FFTW_REAL_TO_COMPLEX,
-                                        FFTW_ESTIMATE | FFTW_IN_PLACE );
+                                        PlanFlag | FFTW_IN_PLACE );
 
    FFTW_Plan_Inv = rfftw3d_create_plan( FFT_Size[2], FFT_Size[1], FFT_Size[0], FFTW_COMPLEX_TO_REAL,
-                                        FFTW_ESTIMATE | FFTW_IN_PLACE );
+                                        PlanFlag | FFTW_IN_PLACE );
 
 #  else
 
+   if ( OPT__FFT_PENCIL )
+   {
+      FFT_Pencil = new FFT_Pencil_t;
+      FFT_Pencil_Init( FFT_Pencil, FFT_Size, PlanFlag );
+   }
+
+   else
+   {
    FFTW_Plan     = rfftw3d_mpi_create_plan( MPI_COMM_WORLD, FFT_Size[2], FFT_Size[1], FFT_Size[0],
-                                            FFTW_REAL_TO_COMPLEX, FFTW_ESTIMATE );
+                                            FFTW_REAL_TO_COMPLEX, PlanFlag );
 
    FFTW_Plan_Inv = rfftw3d_mpi_create_plan( MPI_COMM_WORLD, FFT_Size[2], FFT_Size[1], FFT_Size[0],
-                                            FFTW_COMPLEX_TO_REAL, FFTW_ESTIMATE );
+                                            FFTW_COMPLEX_TO_REAL, PlanFlag );
+   }
 #  endif
 
 
@@ -61,15 +96,31 @@ void Init_FFTW()
    {
 #     ifdef SERIAL
       FFTW_Plan_PS = rfftw3d_create_plan( NX0_TOT[2], NX0_TOT[1], NX0_TOT[0], FFTW_REAL_TO_COMPLEX,
-                                          FFTW_ESTIMATE | FFTW_IN_PLACE );
+                                          PlanFlag | FFTW_IN_PLACE );
 #     else
+      if ( OPT__FFT_PENCIL )
+      {
+         FFT_Pencil_PS = new FFT_Pencil_t;
+         FFT_Pencil_Init( FFT_Pencil_PS, NX0_TOT, PlanFlag );
+      }
+
+      else
       FFTW_Plan_PS = rfftw3d_mpi_create_plan( MPI_COMM_WORLD, NX0_TOT[2], NX0_TOT[1], NX0_TOT[0],
-                                              FFTW_REAL_TO_COMPLEX, FFTW_ESTIMATE );
+                                              FFTW_REAL_TO_COMPLEX, PlanFlag );
 #     endif
    }
 
    else
-      FFTW_Plan_PS = FFTW_Plan;
+   {
+      FFTW_Plan_PS  = FFTW_Plan;
+#     ifndef SERIAL
+      FFT_Pencil_PS = FFT_Pencil;
+#     endif
+   }
+
+
+// save the wisdom accumulated during planning
+   if ( OPT__FFTW_WISDOM )    SaveWisdom( FFTW_WISDOM_FILENAME );
 
 
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
@@ -94,11 +145,29 @@ void End_FFTW()
    rfftwnd_destroy_plan    ( FFTW_Plan     );
    rfftwnd_destroy_plan    ( FFTW_Plan_Inv );
 #  else
+   if ( OPT__FFT_PENCIL )
+   {
+      if ( FFT_Pencil_PS != FFT_Pencil )
+      {
+         FFT_Pencil_End( FFT_Pencil_PS );
+         delete FFT_Pencil_PS;
+      }
+
+      FFT_Pencil_End( FFT_Pencil );
+      delete FFT_Pencil;
+
+      FFT_Pencil    = NULL;
+      FFT_Pencil_PS = NULL;
+   }
+
+   else
+   {
    if ( FFTW_Plan_PS != FFTW_Plan )
    rfftwnd_mpi_destroy_plan( FFTW_Plan_PS  );
 
    rfftwnd_mpi_destroy_plan( FFTW_Plan     );
    rfftwnd_mpi_destroy_plan( FFTW_Plan_Inv );
+   }
 #  endif
 
    if ( MPI_Rank == 0 )    Aux_Message( stdout, "done\n" );
@@ -107,4 +176,129 @@ void End_FFTW()
 
 
 
+//-------------------------------------------------------------------------------------------------------
+// Function    :  LoadWisdom
+// Description :  Load the FFTW wisdom from the target file
+//
+// Note        :  1. Only the root rank reads the file, which is then broadcast to all ranks
+//                2. Do nothing if the file does not exist
+//                3. Invalid wisdom (e.g., generated by a different version or precision of FFTW) will be ignored
+//
+// Parameter   :  FileName : Name of the wisdom file
+//-------------------------------------------------------------------------------------------------------
+void LoadWisdom( const char *FileName )
+{
+
+   long  Size   = 0;
+   char *Wisdom = NULL;
+
+// root rank reads the file
+   if ( MPI_Rank == 0  &&  Aux_CheckFileExist(FileName) )
+   {
+      FILE *File = fopen( FileName, "r" );
+
+      fseek( File, 0, SEEK_END );
+      Size = ftell( File );
+      rewind( File );
+
+      Wisdom = new char [Size+1];
+      Size   = fread( Wisdom, sizeof(char), Size, File );
+      Wisdom[Size] = '\0';
+
+      fclose( File );
+   }
+
+// broadcast to all ranks
+   MPI_Bcast( &Size, 1, MPI_LONG, 0, MPI_COMM_WORLD );
+
+   if ( Size == 0 )  return;
+
+   if ( MPI_Rank != 0 )    Wisdom = new char [Size+1];
+
+   MPI_Bcast( Wisdom, Size+1, MPI_CHAR, 0, MPI_COMM_WORLD );
+
+   if ( fftw_import_wisdom_from_string( Wisdom ) != FFTW_SUCCESS  &&  MPI_Rank == 0 )
+      Aux_Message( stderr, "WARNING : failed to import the FFTW wisdom from \"%s\" --> ignored !!\n", FileName );
+
+   delete [] Wisdom;
+
+} // FUNCTION : LoadWisdom
+
+
+
+//-------------------------------------------------------------------------------------------------------
+// Function    :  SaveWisdom
+// Description :  Save the FFTW wisdom of all ranks to the target file
+//
+// Note        :  1. Different ranks may accumulate different wisdom since their local FFT sizes can differ
+//                   --> Collect and merge the wisdom of all ranks to the root rank before output
+//                2. Overwrite the existing file
+//
+// Parameter   :  FileName : Name of the wisdom file
+//-------------------------------------------------------------------------------------------------------
+void SaveWisdom( const char *FileName )
+{
+
+// get the wisdom of this rank
+   char *Wisdom_ThisRank = fftw_export_wisdom_to_string();
+   int   Size_ThisRank   = ( Wisdom_ThisRank == NULL ) ? 0 : strlen( Wisdom_ThisRank ) + 1;
+
+// collect the wisdom of all ranks
+   int  *Size_AllRank   = NULL;
+   int  *Disp_AllRank   = NULL;
+   char *Wisdom_AllRank = NULL;
+
+   if ( MPI_Rank == 0 )
+   {
+      Size_AllRank = new int [MPI_NRank];
+      Disp_AllRank = new int [MPI_NRank];
+   }
+
+   MPI_Gather( &Size_ThisRank, 1, MPI_INT, Size_AllRank, 1, MPI_INT, 0, MPI_COMM_WORLD );
+
+   if ( MPI_Rank == 0 )
+   {
+      Disp_AllRank[0] = 0;
+      for (int r=1; r<MPI_NRank; r++)  Disp_AllRank[r] = Disp_AllRank[r-1] + Size_AllRank[r-1];
+
+      Wisdom_AllRank = new char [ Disp_AllRank[MPI_NRank-1] + Size_AllRank[MPI_NRank-1] ];
+   }
+
+   MPI_Gatherv( Wisdom_ThisRank, Size_ThisRank, MPI_CHAR, Wisdom_AllRank, Size_AllRank, Disp_AllRank, MPI_CHAR,
+                0, MPI_COMM_WORLD );
+
+   if ( Wisdom_ThisRank != NULL )   fftw_free( Wisdom_ThisRank );
+
+// merge and output the wisdom of all ranks
+   if ( MPI_Rank == 0 )
+   {
+      for (int r=1; r<MPI_NRank; r++)
+         if ( Size_AllRank[r] > 0 )    fftw_import_wisdom_from_string( Wisdom_AllRank + Disp_AllRank[r] );
+
+      char *Wisdom = fftw_export_wisdom_to_string();
+
+      if ( Wisdom != NULL )
+      {
+         FILE *File = fopen( FileName, "w" );
+
+         if ( File == NULL )
+            Aux_Message( stderr, "WARNING : cannot open the FFTW wisdom file \"%s\" !!\n", FileName );
+         else
+         {
+            fputs( Wisdom, File );
+            fclose( File );
+         }
+
+         fftw_free( Wisdom );
+      }
+
+      delete [] Size_AllRank;
+      delete [] Disp_AllRank;
+      delete [] Wisdom_AllRank;
+   }
+
+} // FUNCTION : SaveWisdom
+
+
+
 #endif // #ifdef GRAVITY
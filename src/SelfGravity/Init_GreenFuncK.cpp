@@ -6,6 +6,7 @@
 extern rfftwnd_plan     FFTW_Plan;
 #else
 extern rfftwnd_mpi_plan FFTW_Plan;
+extern FFT_Pencil_t    *FFT_Pencil;
 #endif
 
 
@@ -18,6 +19,7 @@ extern rfftwnd_mpi_plan FFTW_Plan;
 // Note        :  1. We only need to calculate it once during the initialization stage
 //                2. The zero-padding method is implemented
 //                3. Slab decomposition is assumed in FFTW
+//                   --> Except for OPT__FFT_PENCIL, for which the pencil decomposition in FFT_Pencil is adopted
 //
 // Parameter   :  None
 //-------------------------------------------------------------------------------------------------------
@@ -34,11 +36,12 @@ void Init_GreenFuncK()
 
 // 1. get the array indices used by FFTW
    const int FFT_Size[3] = { 2*NX0_TOT[0], 2*NX0_TOT[1], 2*NX0_TOT[2] };
-   int local_nx, local_ny, local_nz, local_z_start, local_ny_after_transpose, local_y_start_after_transpose, total_local_size;
+   int local_nx, local_ny, local_nz, local_y_start, local_z_start, local_ny_after_transpose, local_y_start_after_transpose, total_local_size;
 
 // note: total_local_size is NOT necessary to be equal to local_nx*local_ny*local_nz
-   local_nx = 2*( FFT_Size[0]/2 + 1 );
-   local_ny = FFT_Size[1];
+   local_nx      = 2*( FFT_Size[0]/2 + 1 );
+   local_ny      = FFT_Size[1];
+   local_y_start = 0;
 
 #  ifdef SERIAL
    local_nz                      = FFT_Size[2];
@@ -47,6 +50,19 @@ void Init_GreenFuncK()
    local_y_start_after_transpose = NULL_INT;
    total_local_size              = local_nx*local_ny*local_nz;
 #  else
+   if ( OPT__FFT_PENCIL )
+   {
+      const int Coord0 = FFT_Pencil->Coord[0];
+      const int Coord1 = FFT_Pencil->Coord[1];
+
+      local_ny         = FFT_Pencil->R_Start[0][Coord0+1] - FFT_Pencil->R_Start[0][Coord0];
+      local_y_start    = FFT_Pencil->R_Start[0][Coord0];
+      local_nz         = FFT_Pencil->R_Start[1][Coord1+1] - FFT_Pencil->R_Start[1][Coord1];
+      local_z_start    = FFT_Pencil->R_Start[1][Coord1];
+      total_local_size = (int)FFT_Pencil->LocalSize;
+   }
+
+   else
    rfftwnd_mpi_local_sizes( FFTW_Plan, &local_nz, &local_z_start, &local_ny_after_transpose,
                             &local_y_start_after_transpose, &total_local_size );
 
@@ -57,14 +73,15 @@ void Init_GreenFuncK()
    const double dh0   = amr->dh[0];
    const double Coeff = -NEWTON_G*CUBE(dh0)/( (double)FFT_Size[0]*FFT_Size[1]*FFT_Size[2] );
    double x, y, z, r;
-   int    kk;
+   int    jj, kk;
    long   idx;
 
    GreenFuncK = new real [ total_local_size ];
 
    for (int k=0; k<local_nz; k++)   {  kk = k + local_z_start;
                                        z  = ( kk <= NX0_TOT[2] ) ? kk*dh0 : (FFT_Size[2]-kk)*dh0;
-   for (int j=0; j<local_ny; j++)   {  y  = ( j  <= NX0_TOT[1] ) ? j *dh0 : (FFT_Size[1]-j )*dh0;
+   for (int j=0; j<local_ny; j++)   {  jj = j + local_y_start;
+                                       y  = ( jj <= NX0_TOT[1] ) ? jj*dh0 : (FFT_Size[1]-jj)*dh0;
    for (int i=0; i<local_nx; i++)   {  x  = ( i  <= NX0_TOT[0] ) ? i *dh0 : (FFT_Size[0]-i )*dh0;
 
       r   = sqrt( x*x + y*y + z*z );
@@ -77,14 +94,18 @@ void Init_GreenFuncK()
 
 // 3. reset the Green's function at the origin
 // ***by setting it equal to zero, we ignore the contribution from the mass within the same cell***
-   if ( MPI_Rank == 0 )    GreenFuncK[0] = GFUNC_COEFF0*Coeff/dh0;
+// --> the origin is stored in the rank with local_y_start == local_z_start == 0, which may not be rank 0
+//     for OPT__FFT_PENCIL
+   if ( local_y_start == 0  &&  local_z_start == 0  &&  local_ny > 0  &&  local_nz > 0 )
+      GreenFuncK[0] = GFUNC_COEFF0*Coeff/dh0;
 
 
 // 4. convert the Green's function to the k space
 #  ifdef SERIAL
    rfftwnd_one_real_to_complex( FFTW_Plan, GreenFuncK, NULL );
 #  else
-   rfftwnd_mpi( FFTW_Plan, 1, GreenFuncK, NULL, FFTW_TRANSPOSED_ORDER );
+   if ( OPT__FFT_PENCIL )  FFT_Pencil_Forward( FFT_Pencil, GreenFuncK );
+   else                    rfftwnd_mpi( FFTW_Plan, 1, GreenFuncK, NULL, FFTW_TRANSPOSED_ORDER );
 #  endif
 
 
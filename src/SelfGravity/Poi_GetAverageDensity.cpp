@@ -123,7 +123,7 @@ void Poi_GetAverageDensity()
    if ( MPI_Rank == 0 )
    {
 //    sort
-      Mis_Heapsort( NPatch_Sum, Cr1D_All, Cr1D_IdxTable );
+      Mis_RadixSort( NPatch_Sum, Cr1D_All, Cr1D_IdxTable );
 
 //    get average density
       for (int t=0; t<NPatch_Sum; t++)    AveDensity_Init += Rho_All[ Cr1D_IdxTable[t] ];
@@ -166,7 +166,7 @@ void Poi_GetAverageDensity()
    if ( MPI_Rank == 0 )
    {
 //    sort
-      Mis_Heapsort( NPar_AcPlusInac_Sum, ParMass_AllRank, NULL );
+      Mis_RadixSort( NPar_AcPlusInac_Sum, ParMass_AllRank, NULL );
 
 //    add average particle density
       ParMassSum = 0.0;
@@ -75,6 +75,18 @@ void SF_CreateStar_AGORA( const int lv, const real TimeNew, const real dt, Rando
 // const real   GraConst       = ( OPT__GRA_P5_GRADIENT ) ? -1.0/(12.0*dh) : -1.0/(2.0*dh);
    const real   GraConst       = ( false                ) ? -1.0/(12.0*dh) : -1.0/(2.0*dh); // P5 is NOT supported yet
 
+// shared variables for adding the new particles of all threads at once
+#  ifdef OPENMP
+   const int NT = omp_get_max_threads();
+#  else
+   const int NT = 1;
+#  endif
+   long *NNewPar_Thread = new long [NT];     // number of new particles created by each thread
+   long *NewParID_All   = NULL;              // IDs of all new particles
+   long  NNewPar_All    = 0;
+
+   for (int t=0; t<NT; t++)   NNewPar_Thread[t] = 0;
+
 
 // start of OpenMP parallel region
 #  pragma omp parallel
@@ -94,11 +106,19 @@ void SF_CreateStar_AGORA( const int lv, const real TimeNew, const real dt, Rando
    real   (*pot_ext)[GRA_NXT][GRA_NXT] = NULL;
 #  endif
 
+// per-thread staging buffers storing the new particles of all patches handled by this thread
+// --> they will be added to the particle repository only once after looping over all patches in order to
+//     avoid the OpenMP synchronization for every patch
    const int MaxNewParPerPatch = CUBE(PS1);
-   real   (*NewParAtt)[PAR_NATT_TOTAL] = new real [MaxNewParPerPatch][PAR_NATT_TOTAL];
-   long    *NewParID                   = new long [MaxNewParPerPatch];
+   long   Stage_NParMax = MaxNewParPerPatch;
+   long   Stage_NPar    = 0;
+   int    Stage_NPatch  = 0;
+   real (*Stage_ParAtt)[PAR_NATT_TOTAL] = ( real (*)[PAR_NATT_TOTAL] )malloc( Stage_NParMax*PAR_NATT_TOTAL*sizeof(real) );
+   int   *Stage_PID     = new int [ amr->NPatchComma[lv][1] ];
+   int   *Stage_NNewPar = new int [ amr->NPatchComma[lv][1] ];
 
-   int NNewPar;
+   real (*NewParAtt)[PAR_NATT_TOTAL] = NULL;
+   int    NNewPar;
 
 
 // loop over all real patches
@@ -133,6 +153,15 @@ void SF_CreateStar_AGORA( const int lv, const real TimeNew, const real dt, Rando
       z0      = amr->patch[0][lv][PID]->EdgeL[2] + 0.5*dh;
       NNewPar = 0;
 
+//    make sure that the staging buffer can hold all new particles in this patch
+      if ( Stage_NPar + MaxNewParPerPatch > Stage_NParMax )
+      {
+         Stage_NParMax = MAX( 2*Stage_NParMax, Stage_NPar + MaxNewParPerPatch );
+         Stage_ParAtt  = ( real (*)[PAR_NATT_TOTAL] )realloc( Stage_ParAtt, Stage_NParMax*PAR_NATT_TOTAL*sizeof(real) );
+      }
+
+      NewParAtt = Stage_ParAtt + Stage_NPar;
+
       for (int k=0; k<PS1; k++)
       for (int j=0; j<PS1; j++)
       for (int i=0; i<PS1; i++)
@@ -180,7 +209,7 @@ void SF_CreateStar_AGORA( const int lv, const real TimeNew, const real dt, Rando
 
 
 //       2. store the information of new star particles
-//       --> we will not create these new particles until looping over all cells in a patch in order to reduce
+//       --> we will not create these new particles until looping over all patches in order to reduce
 //           the OpenMP synchronization overhead
 //       ===========================================================================================================
 //       check
@@ -259,46 +288,89 @@ void SF_CreateStar_AGORA( const int lv, const real TimeNew, const real dt, Rando
 
 
 
-//    4. create new star particles
+//    4. record the number of new particles in this patch
 //    ===========================================================================================================
-//    use OpenMP critical construct since both amr->Par->AddOneParticle() and amr->patch[0][lv][PID]->AddParticle()
-//    will modify some global variables
-//    --> note that the order of which thread calls amr->Par->AddOneParticle() is nondeterministic and may change from run to run
-//        --> order of particles stored in the particle repository (i.e., their particle ID) may change from run to run
-//        --> particle text file may change from run to run since it's dumped according to the order of particle ID
-//    --> but it's not an issue since the actual data of each particle will not be affected
-#     pragma omp critical
+      if ( NNewPar > 0 )
       {
-//       4-1. add particles to the particle repository
-         for (int p=0; p<NNewPar; p++)
-            NewParID[p] = amr->Par->AddOneParticle( NewParAtt[p] );
-
-
-//       4-2. add particles to the patch
-         const real *PType = amr->Par->Type;
-#        ifdef DEBUG_PARTICLE
-//       do not set ParPos too early since pointers to the particle repository (e.g., amr->Par->PosX)
-//       may change after calling amr->Par->AddOneParticle()
-         const real *ParPos[3] = { amr->Par->PosX, amr->Par->PosY, amr->Par->PosZ };
-         char Comment[100];
-         sprintf( Comment, "%s", __FUNCTION__ );
-
-         amr->patch[0][lv][PID]->AddParticle( NNewPar, NewParID, &amr->Par->NPar_Lv[lv],
-                                              PType, ParPos, amr->Par->NPar_AcPlusInac, Comment );
-#        else
-         amr->patch[0][lv][PID]->AddParticle( NNewPar, NewParID, &amr->Par->NPar_Lv[lv], PType );
-#        endif
-      } // pragma omp critical
-
+         Stage_PID    [Stage_NPatch] = PID;
+         Stage_NNewPar[Stage_NPatch] = NNewPar;
+         Stage_NPatch ++;
+         Stage_NPar += NNewPar;
+      }
    } // for (int PID=0; PID<amr->NPatchComma[lv][1]; PID++)
 
+
+
+// 5. create new star particles
+// ===========================================================================================================
+// 5-1. add the new particles of all threads to the particle repository at once
+//      --> each thread takes a contiguous segment of NewParID_All[] given by the prefix sum of NNewPar_Thread[]
+//      --> particle IDs are deterministic when running with the same numbers of OpenMP threads and MPI ranks
+   NNewPar_Thread[TID] = Stage_NPar;
+
+#  pragma omp barrier
+
+#  pragma omp single
+   {
+      for (int t=0; t<NT; t++)   NNewPar_All += NNewPar_Thread[t];
+
+      NewParID_All = new long [NNewPar_All];
+
+      amr->Par->AddParticles( NNewPar_All, NewParID_All );
+   } // implicit barrier
+
+   long Stage_Offset = 0;
+   for (int t=0; t<TID; t++)  Stage_Offset += NNewPar_Thread[t];
+
+   const long *NewParID = NewParID_All + Stage_Offset;
+
+
+// 5-2. set the particle attributes
+//      --> do not set pointers to the particle repository (e.g., amr->Par->PosX) before calling AddParticles()
+//          since they may be reallocated
+   for (long p=0; p<Stage_NPar; p++)
+   for (int v=0; v<PAR_NATT_TOTAL; v++)
+      amr->Par->Attribute[v][ NewParID[p] ] = Stage_ParAtt[p][v];
+
+
+// 5-3. add particles to the patches
+//      --> each patch is handled by exactly one thread
+//      --> amr->Par->NPar_Lv[lv] is updated after the OpenMP parallel region
+   const real *PType = amr->Par->Type;
+   long NPar_Lv_Dummy = 0;
+
+   for (int t=0; t<Stage_NPatch; t++)
+   {
+      const int PID = Stage_PID[t];
+
+#     ifdef DEBUG_PARTICLE
+      const real *ParPos[3] = { amr->Par->PosX, amr->Par->PosY, amr->Par->PosZ };
+      char Comment[100];
+      sprintf( Comment, "%s", __FUNCTION__ );
+
+      amr->patch[0][lv][PID]->AddParticle( Stage_NNewPar[t], NewParID, &NPar_Lv_Dummy,
+                                           PType, ParPos, amr->Par->NPar_AcPlusInac, Comment );
+#     else
+      amr->patch[0][lv][PID]->AddParticle( Stage_NNewPar[t], NewParID, &NPar_Lv_Dummy, PType );
+#     endif
+
+      NewParID += Stage_NNewPar[t];
+   }
+
 // free memory
-   delete [] NewParAtt;
-   delete [] NewParID;
+   free( Stage_ParAtt );
+   delete [] Stage_PID;
+   delete [] Stage_NNewPar;
 
    } // end of OpenMP parallel region
 
 
+   amr->Par->NPar_Lv[lv] += NNewPar_All;
+
+   delete [] NNewPar_Thread;
+   delete [] NewParID_All;
+
+
 // get the total number of active particles in all MPI ranks
    MPI_Allreduce( &amr->Par->NPar_Active, &amr->Par->NPar_Active_AllRank, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD );
 